@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_BinaryTestOutput_h
+#define D_BinaryTestOutput_h
+
+#include "CppUTest/SimpleString.hpp"
+#include "CppUTest/TestOutput.hpp"
+
+namespace cpputest
+{
+    struct BinaryTestOutputImpl;
+
+    // Writes the test run as a compact stream of records that can later be
+    // replayed into any other TestOutput. Every record is a kind byte and a
+    // four byte little endian payload length followed by the payload;
+    // numbers in the payload are LEB128 encoded and strings are a length
+    // followed by the characters. Unknown record kinds are skipped.
+    class BinaryTestOutput : public TestOutput
+    {
+    public:
+        enum RecordKind
+        {
+            record_testsStarted = 1,
+            record_groupStarted = 2,
+            record_testStarted = 3,
+            record_failure = 4,
+            record_testEnded = 5,
+            record_groupEnded = 6,
+            record_testsEnded = 7,
+            record_print = 8
+        };
+
+        BinaryTestOutput();
+        virtual ~BinaryTestOutput() override;
+
+        virtual void printTestsStarted() override;
+        virtual void printTestsEnded(const TestResult& result) override;
+        virtual void printCurrentTestStarted(const UtestShell& test) override;
+        virtual void printCurrentTestEnded(const TestResult& res) override;
+        virtual void printCurrentGroupStarted(const UtestShell& test) override;
+        virtual void printCurrentGroupEnded(const TestResult& res) override;
+
+        virtual void printBuffer(const char*) override;
+        virtual void printFailure(const TestFailure& failure) override;
+
+        virtual void flush() override;
+
+        virtual SimpleString createFileName();
+        void setPackageName(const SimpleString& package);
+
+        // Feeds a log written by BinaryTestOutput to output as if the tests
+        // were running now. Returns false when the log cannot be opened or
+        // is truncated; everything up to that point has been replayed.
+        static bool replay(
+            const SimpleString& fileName,
+            TestOutput& output,
+            size_t& failureCount
+        );
+
+    protected:
+        BinaryTestOutputImpl* impl_;
+
+        virtual void openFileForWrite(const SimpleString& fileName);
+        virtual void writeToFile(const void* buffer, size_t size);
+        virtual void closeFile();
+
+    private:
+        void writeRecord(RecordKind kind);
+        void writeTest(const UtestShell& test);
+
+        BinaryTestOutput(const BinaryTestOutput&);
+        BinaryTestOutput& operator=(const BinaryTestOutput&);
+    };
+}
+
+#endif
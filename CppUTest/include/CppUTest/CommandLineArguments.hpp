@@ -51,15 +51,29 @@ namespace cpputest
         bool isListingTestLocations() const;
         bool isRunIgnored() const;
         size_t getRepeatCount() const;
+        size_t getWorkerCount() const;
         bool isReversing() const;
         bool isCrashingOnFail() const;
         bool isRethrowingExceptions() const;
         const TestFilter* getGroupFilters() const;
         const TestFilter* getNameFilters() const;
         bool isJUnitOutput() const;
+        bool isJUnitSuitesOutput() const;
         bool isEclipseOutput() const;
         bool isTeamCityOutput() const;
+        bool isBinaryOutput() const;
         const SimpleString& getPackageName() const;
+        bool isMergingJUnitFiles() const;
+        const SimpleString& getJUnitMergeOutputFile() const;
+        const char* const* getJUnitMergeInputFiles() const;
+        size_t getJUnitMergeInputFileCount() const;
+        bool isConvertingBinaryLog() const;
+        const SimpleString& getBinaryLogFileName() const;
+        const SimpleString& getJournalFileName() const;
+        const SimpleString& getResumeJournalFileName() const;
+        const SimpleString& getResultCacheFileName() const;
+        bool isIgnoringResultCache() const;
+        const SimpleString& getRunOptions() const;
         const char* usage() const;
         const char* help() const;
 
@@ -68,7 +82,9 @@ namespace cpputest
         {
             OUTPUT_ECLIPSE,
             OUTPUT_JUNIT,
-            OUTPUT_TEAMCITY
+            OUTPUT_JUNIT_SUITES,
+            OUTPUT_TEAMCITY,
+            OUTPUT_BINARY
         };
 
         int ac_;
@@ -86,10 +102,20 @@ namespace cpputest
         bool crashOnFail_;
         bool rethrowExceptions_;
         size_t repeat_;
+        size_t workers_;
         TestFilter* groupFilters_;
         TestFilter* nameFilters_;
         OutputType outputType_;
         SimpleString packageName_;
+        SimpleString junitMergeOutputFile_;
+        const char* const* junitMergeInputFiles_;
+        size_t junitMergeInputFileCount_;
+        SimpleString binaryLogFileName_;
+        SimpleString journalFileName_;
+        SimpleString resumeJournalFileName_;
+        SimpleString resultCacheFileName_;
+        bool ignoringResultCache_;
+        SimpleString runOptions_;
 
         SimpleString getParameterField(
             int ac,
@@ -98,6 +124,7 @@ namespace cpputest
             const SimpleString& parameterName
         );
         void setRepeatCount(int ac, const char* const* av, int& index);
+        bool setWorkerCount(int ac, const char* const* av, int& index);
         void addGroupFilter(int ac, const char* const* av, int& index);
         bool addGroupDotNameFilter(
             int ac,
@@ -121,6 +148,12 @@ namespace cpputest
         );
         bool setOutputType(int ac, const char* const* av, int& index);
         void setPackageName(int ac, const char* const* av, int& index);
+        bool setJUnitMergeFiles(int ac, const char* const* av, int& index);
+        bool setBinaryLogToConvert(int ac, const char* const* av, int& index);
+        bool setJournalFile(int ac, const char* const* av, int& index);
+        bool setResumeJournalFile(int ac, const char* const* av, int& index);
+        bool setResultCacheFile(int ac, const char* const* av, int& index);
+        void addRunOptions(int first, int last);
 
         CommandLineArguments(const CommandLineArguments&);
         CommandLineArguments& operator=(const CommandLineArguments&);
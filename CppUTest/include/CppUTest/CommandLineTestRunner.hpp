@@ -54,6 +54,24 @@ namespace cpputest
     protected:
         virtual TestOutput* createTeamCityOutput();
         virtual TestOutput* createJUnitOutput(const SimpleString& packageName);
+        virtual TestOutput*
+        createJUnitSuitesOutput(const SimpleString& packageName);
+        virtual bool mergeJUnitFiles(
+            const SimpleString& outputFileName,
+            const char* const* inputFileNames,
+            size_t inputFileCount
+        );
+        virtual TestOutput* createBinaryOutput(const SimpleString& packageName);
+        virtual bool replayBinaryLog(
+            const SimpleString& logFileName, size_t& failureCount
+        );
+        virtual TestOutput* createJournalOutput(const SimpleString& fileName);
+        virtual bool findJournalResumePoint(
+            const SimpleString& journalFileName,
+            SimpleString& group,
+            SimpleString& name,
+            bool& finished
+        );
         virtual TestOutput* createConsoleOutput();
         virtual TestOutput*
         createCompositeOutput(TestOutput* outputOne, TestOutput* outputTwo);
@@ -67,6 +85,7 @@ namespace cpputest
         bool parseArguments(TestPlugin*);
         int runAllTests();
         void initializeTestRun();
+        void resumeFromJournal(const SimpleString& journalFileName);
     };
 }
 
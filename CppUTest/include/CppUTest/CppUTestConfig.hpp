@@ -58,4 +58,22 @@
         #define CPPUTEST_HAVE_EXCEPTIONS 1
     #endif
 #endif
+
+/*
+ * Detection of thread_local support. Compilers for targets without threads
+ * need not have it, in which case every thread shares the variable.
+ */
+#ifndef CPPUTEST_HAVE_THREAD_LOCAL
+    #if defined(__STDCPP_THREADS__) || defined(_MSC_VER)
+        #define CPPUTEST_HAVE_THREAD_LOCAL 1
+    #else
+        #define CPPUTEST_HAVE_THREAD_LOCAL 0
+    #endif
+#endif
+
+#if CPPUTEST_HAVE_THREAD_LOCAL
+    #define CPPUTEST_THREAD_LOCAL thread_local
+#else
+    #define CPPUTEST_THREAD_LOCAL
+#endif
 #endif
@@ -44,6 +44,7 @@ namespace cpputest
 
         virtual void printTestsStarted() override;
         virtual void printTestsEnded(const TestResult& result) override;
+        virtual void printTestRun(size_t number, size_t total) override;
         virtual void printCurrentTestStarted(const UtestShell& test) override;
         virtual void printCurrentTestEnded(const TestResult& res) override;
         virtual void printCurrentGroupStarted(const UtestShell& test) override;
@@ -58,8 +59,22 @@ namespace cpputest
         virtual void flush() override;
 
         virtual SimpleString createFileName(const SimpleString& group);
+        virtual SimpleString createSuitesFileName();
         void setPackageName(const SimpleString& package);
 
+        // Write every group as a testsuite of one testsuites file instead
+        // of one file per group.
+        void setSingleFileOutput(bool singleFile);
+
+        // Concatenate the testsuites of several JUnit files into one
+        // testsuites file. Inputs are streamed, not parsed; returns false
+        // when the output or any of the inputs cannot be opened.
+        static bool mergeFiles(
+            const SimpleString& outputFileName,
+            const char* const* inputFileNames,
+            size_t inputFileCount
+        );
+
     protected:
         JUnitTestOutputImpl* impl_;
         void resetTestGroupResult();
@@ -73,6 +88,7 @@ namespace cpputest
         virtual void writeTestSuiteSummary();
         virtual void writeProperties();
         virtual void writeTestCases();
+        virtual void writeTestCase(JUnitTestCaseResultNode* node);
         virtual SimpleString encodeXmlText(const SimpleString& textbody);
         virtual SimpleString encodeFileName(const SimpleString& fileName);
         virtual void writeFailure(JUnitTestCaseResultNode* node);
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_JournalTestOutput_h
+#define D_JournalTestOutput_h
+
+#include "CppUTest/SimpleString.hpp"
+#include "CppUTest/TestOutput.hpp"
+
+namespace cpputest
+{
+    struct JournalTestOutputImpl;
+
+    // Appends a record for every test start, end and failure and hands it
+    // to the operating system straight away, so the journal still names the
+    // test that was running when the process died.
+    class JournalTestOutput : public TestOutput
+    {
+    public:
+        explicit JournalTestOutput(const SimpleString& fileName);
+        virtual ~JournalTestOutput() override;
+
+        virtual void printTestsStarted() override;
+        virtual void printCurrentTestStarted(const UtestShell& test) override;
+        virtual void printCurrentTestEnded(const TestResult& res) override;
+        virtual void printFailure(const TestFailure& failure) override;
+
+        virtual void printBuffer(const char*) override;
+        virtual void flush() override;
+
+        // Finds the last test the journal saw starting and whether it also
+        // ended. Returns false when the journal cannot be read or names no
+        // test at all.
+        static bool findLastStartedTest(
+            const SimpleString& fileName,
+            SimpleString& group,
+            SimpleString& name,
+            bool& finished
+        );
+
+    protected:
+        JournalTestOutputImpl* impl_;
+
+        virtual void writeRecord(
+            char kind,
+            const SimpleString& group,
+            const SimpleString& name,
+            const SimpleString& detail
+        );
+
+    private:
+        JournalTestOutput(const JournalTestOutput&);
+        JournalTestOutput& operator=(const JournalTestOutput&);
+    };
+}
+
+#endif
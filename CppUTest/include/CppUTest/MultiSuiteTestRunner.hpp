@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef D_MultiSuiteTestRunner_h
+#define D_MultiSuiteTestRunner_h
+
+#include "CppUTest/SimpleString.hpp"
+
+namespace cpputest
+{
+    class TestRegistry;
+    class TestServer;
+
+    // Runs the tests of several shared libraries as one test run. Every
+    // library is loaded like a TestServer loads it and its groups are
+    // renamed to "<suite>.<group>", where the suite is the file name of
+    // the library without "lib" and extension. All tests then go through
+    // one registry, so there is one output, one result and one set of
+    // JUnit files for all the suites. With "-j <#>" the tests of all the
+    // suites are shared out among that many child processes.
+    //
+    // As with the TestServer, the libraries must use the CppUTest of the
+    // runner process.
+    class MultiSuiteTestRunner
+    {
+    public:
+        // Usage: <runner> <testLibrary>... [-- <test arguments>]
+        static int RunAllSuites(int ac, const char* const* av);
+
+        MultiSuiteTestRunner();
+        virtual ~MultiSuiteTestRunner();
+
+        bool addSuite(const SimpleString& libraryPath);
+        size_t countSuites() const;
+        size_t countTests() const;
+
+        int runAllSuites(int ac, const char* const* av);
+
+        static SimpleString suiteNameOf(const SimpleString& libraryPath);
+
+    protected:
+        virtual int
+        runTests(int ac, const char* const* av, TestRegistry* registry);
+
+    private:
+        struct Suite;
+        Suite* firstSuite_;
+        Suite* lastSuite_;
+
+        MultiSuiteTestRunner(const MultiSuiteTestRunner&);
+        MultiSuiteTestRunner& operator=(const MultiSuiteTestRunner&);
+    };
+}
+
+#endif
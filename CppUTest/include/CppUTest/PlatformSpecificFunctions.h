@@ -72,6 +72,7 @@ extern int (*PlatformSpecificVSNprintf)(
 typedef void* PlatformSpecificFile;
 
 extern PlatformSpecificFile PlatformSpecificStdOut;
+extern PlatformSpecificFile PlatformSpecificStdIn;
 
 extern PlatformSpecificFile (*PlatformSpecificFOpen)(
     const char* filename, const char* flag
@@ -80,9 +81,48 @@ extern void (*PlatformSpecificFPuts)(
     const char* str, PlatformSpecificFile file
 );
 extern void (*PlatformSpecificFClose)(PlatformSpecificFile file);
+extern size_t (*PlatformSpecificFRead)(
+    void* buffer, size_t size, PlatformSpecificFile file
+);
+extern void (*PlatformSpecificFWrite)(
+    const void* buffer, size_t size, PlatformSpecificFile file
+);
+extern void (*PlatformSpecificFFlush)(PlatformSpecificFile file);
 
 extern void (*PlatformSpecificFlush)(void);
 
+/* Thread synchronisation. Platforms without threads may do nothing */
+typedef void* PlatformSpecificMutex;
+extern PlatformSpecificMutex (*PlatformSpecificMutexCreate)(void);
+extern void (*PlatformSpecificMutexLock)(PlatformSpecificMutex mutex);
+extern void (*PlatformSpecificMutexUnlock)(PlatformSpecificMutex mutex);
+extern void (*PlatformSpecificMutexDestroy)(PlatformSpecificMutex mutex);
+
+/* Process operations. Platforms without processes return -1 from
+ * PlatformSpecificFork and PlatformSpecificWaitAnyChild, and NULL from
+ * PlatformSpecificTempFile. PlatformSpecificWaitPid returns the exit status
+ * of the child, or minus the signal that killed it.
+ * PlatformSpecificWaitAnyChild waits for whichever child exits first,
+ * stores its status the same way and returns its pid.
+ */
+extern int (*PlatformSpecificFork)(void);
+extern int (*PlatformSpecificWaitPid)(int pid);
+extern int (*PlatformSpecificWaitAnyChild)(int* status);
+extern void (*PlatformSpecificExitChild)(int status);
+extern PlatformSpecificFile (*PlatformSpecificTempFile)(void);
+extern void (*PlatformSpecificRewind)(PlatformSpecificFile file);
+
+/* Shared library operations. Platforms without them return NULL from
+ * PlatformSpecificLibraryOpen and PlatformSpecificLibraryPathOf, which
+ * names the executable or library that holds an address.
+ * PlatformSpecificFileStamp returns a value that changes when the file is
+ * rewritten, or 0 when it does not exist. */
+typedef void* PlatformSpecificLibrary;
+extern PlatformSpecificLibrary (*PlatformSpecificLibraryOpen)(const char* path);
+extern void (*PlatformSpecificLibraryClose)(PlatformSpecificLibrary library);
+extern const char* (*PlatformSpecificLibraryPathOf)(const void* address);
+extern long (*PlatformSpecificFileStamp)(const char* path);
+
 #ifdef __cplusplus
 }
 #endif
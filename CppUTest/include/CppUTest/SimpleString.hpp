@@ -116,6 +116,8 @@ namespace cpputest
         static const char* StrStr(const char* s1, const char* s2);
         static char ToLower(char ch);
         static int MemCmp(const void* s1, const void* s2, size_t n);
+        static size_t
+        FirstMismatch(const void* s1, const void* s2, size_t n);
         static char*
         allocStringBuffer(size_t size, const char* file, size_t line);
         static void deallocStringBuffer(
@@ -46,6 +46,7 @@ namespace cpputest
 {
     class UtestShell;
     class TestOutput;
+    class DoublesTolerance;
 
     class TestFailure
     {
@@ -80,6 +81,16 @@ namespace cpputest
             const SimpleString& actual, size_t offset, size_t reportedPosition
         );
         SimpleString createUserText(const SimpleString& text);
+        SimpleString createStringExcerptDifferenceString(
+            const char* expected, const char* actual, bool ignoreCase
+        );
+        SimpleString createBinaryExcerptDifferenceString(
+            const unsigned char* expected,
+            const unsigned char* actual,
+            size_t size
+        );
+        SimpleString
+        createLineDiffString(const char* expected, const char* actual);
 
         SimpleString testName_;
         SimpleString testNameOnly_;
@@ -127,6 +138,35 @@ namespace cpputest
         );
     };
 
+    class DoublesArrayEqualFailure : public TestFailure
+    {
+    public:
+        DoublesArrayEqualFailure(
+            UtestShell*,
+            const char* fileName,
+            size_t lineNumber,
+            const double* expected,
+            const double* actual,
+            size_t count,
+            const DoublesTolerance& tolerance,
+            const SimpleString& text
+        );
+    };
+
+    class LongsArrayEqualFailure : public TestFailure
+    {
+    public:
+        LongsArrayEqualFailure(
+            UtestShell*,
+            const char* fileName,
+            size_t lineNumber,
+            const long* expected,
+            const long* actual,
+            size_t count,
+            const SimpleString& text
+        );
+    };
+
     class CheckEqualFailure : public TestFailure
     {
     public:
@@ -189,6 +189,7 @@ namespace cpputest
 
         virtual void printTestsStarted() override;
         virtual void printTestsEnded(const TestResult& result) override;
+        virtual void printTestRun(size_t number, size_t total) override;
 
         virtual void printCurrentTestStarted(const UtestShell& test) override;
         virtual void printCurrentTestEnded(const TestResult& res) override;
@@ -43,6 +43,7 @@ namespace cpputest
     class UtestShell;
     class TestResult;
     class TestPlugin;
+    class TestResultCache;
 
     class TestRegistry
     {
@@ -77,12 +78,43 @@ namespace cpputest
         virtual void setCurrentRegistry(TestRegistry* registry);
 
         virtual void setRunTestsInSeperateProcess();
+        // Runs up to <workers> tests at the same time, each in a child
+        // process of its own. What they report is replayed in test order.
+        virtual void setWorkerCount(size_t workers);
         int getCurrentRepetition();
         void setRunIgnored();
+        // Skips the tests up to and including the named one in the next
+        // run. A test that did not finish is reported as a failure.
+        virtual void resumeAfterTest(
+            const SimpleString& group, const SimpleString& name, bool finished
+        );
+        virtual void setResultCache(TestResultCache* cache);
 
     private:
+        struct PendingStep;
+
         bool testShouldRun(UtestShell* test, TestResult& result);
         bool endOfGroup(UtestShell* test);
+        UtestShell* findResumePoint(bool& finished);
+        bool isCachedPass(UtestShell* test);
+        void reportCrashedTest(UtestShell* test, TestResult& result);
+        void runTest(
+            UtestShell* test,
+            TestResult& result,
+            bool setUpGroup,
+            bool& groupSetupFailed
+        );
+        void startTest(
+            UtestShell* test, TestResult& result, bool groupSetupFailed
+        );
+        void recordResult(
+            UtestShell* test, TestResult& result, size_t failureCount
+        );
+        void schedule(PendingStep* step, TestResult& result);
+        void report(PendingStep* step, TestResult& result);
+        void waitForWorker(TestResult& result);
+        void reportFirstStep(TestResult& result);
+        void reportPendingSteps(TestResult& result);
 
         UtestShell* tests_;
         const TestFilter* nameFilters_;
@@ -92,6 +124,14 @@ namespace cpputest
         bool runInSeperateProcess_;
         int currentRepetition_;
         bool runIgnored_;
+        SimpleString resumeAfterGroup_;
+        SimpleString resumeAfterName_;
+        bool resumeAfterFinished_;
+        TestResultCache* resultCache_;
+        size_t workers_;
+        PendingStep* firstPendingStep_;
+        PendingStep* lastPendingStep_;
+        size_t runningChildren_;
     };
 }
 
@@ -61,8 +61,11 @@ namespace cpputest
         virtual void countTest();
         virtual void countRun();
         virtual void countCheck();
+        virtual void addChecks(size_t amount);
         virtual void countFilteredOut();
         virtual void countIgnored();
+        virtual void countCached();
+        virtual void countSkipped();
         virtual void addFailure(const TestFailure& failure);
         virtual void print(const char* text);
         virtual void printVeryVerbose(const char* text);
@@ -87,6 +90,14 @@ namespace cpputest
         {
             return ignoredCount_;
         }
+        size_t getCachedCount() const
+        {
+            return cachedCount_;
+        }
+        size_t getSkippedCount() const
+        {
+            return skippedCount_;
+        }
         size_t getFailureCount() const
         {
             return failureCount_;
@@ -95,14 +106,18 @@ namespace cpputest
         bool isFailure() const
         {
             return (getFailureCount() != 0) ||
-                   (getRunCount() + getIgnoredCount() == 0);
+                   (getRunCount() + getIgnoredCount() + getCachedCount() +
+                        getSkippedCount() ==
+                    0);
         }
 
         size_t getTotalExecutionTime() const;
         void setTotalExecutionTime(size_t exTime);
 
         size_t getCurrentTestTotalExecutionTime() const;
+        void setCurrentTestTotalExecutionTime(size_t exTime);
         size_t getCurrentGroupTotalExecutionTime() const;
+        void setCurrentGroupTotalExecutionTime(size_t exTime);
 
     private:
         TestOutput& output_;
@@ -112,6 +127,8 @@ namespace cpputest
         size_t failureCount_;
         size_t filteredOutCount_;
         size_t ignoredCount_;
+        size_t cachedCount_;
+        size_t skippedCount_;
         size_t totalExecutionTime_;
         size_t timeStarted_;
         size_t currentTestTimeStarted_;
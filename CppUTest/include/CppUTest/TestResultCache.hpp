@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef D_TestResultCache_h
+#define D_TestResultCache_h
+
+#include "CppUTest/SimpleString.hpp"
+
+namespace cpputest
+{
+    class UtestShell;
+    struct TestResultCacheEntry;
+    struct TestResultCacheLibrary;
+
+    // Remembers which tests passed. A test is keyed on its group and name
+    // and the options of the run that can change its outcome, such as the
+    // repeat count, and its result is only valid for the
+    // digest of the executable or library that holds the test, so any
+    // rebuild of that binary runs its tests again. The cache file keeps
+    // one line per test that passed.
+    class TestResultCache
+    {
+    public:
+        TestResultCache(
+            const SimpleString& fileName, const SimpleString& runOptions
+        );
+        virtual ~TestResultCache();
+
+        // Returns false when there is no cache file yet or it cannot be
+        // read, which leaves the cache empty.
+        bool load();
+        bool save();
+
+        // Makes every test run, while still recording the passes.
+        void ignoreCachedResults();
+
+        virtual bool hasPassed(const UtestShell& test);
+        virtual void recordPass(const UtestShell& test);
+        virtual void recordFailure(const UtestShell& test);
+
+    private:
+        SimpleString fileName_;
+        SimpleString runOptions_;
+        bool ignoringCachedResults_;
+        TestResultCacheEntry** buckets_;
+        TestResultCacheLibrary* libraries_;
+
+        void addCachedLine(const char* line);
+        unsigned long long keyOf(const UtestShell& test) const;
+        bool libraryDigestOf(
+            const UtestShell& test, unsigned long long& digest
+        );
+        TestResultCacheEntry* find(unsigned long long key) const;
+        TestResultCacheEntry* findOrAdd(unsigned long long key);
+
+        TestResultCache(const TestResultCache&);
+        TestResultCache& operator=(const TestResultCache&);
+    };
+}
+
+#endif
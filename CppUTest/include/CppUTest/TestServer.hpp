@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_TestServer_h
+#define D_TestServer_h
+
+#include "CppUTest/PlatformSpecificFunctions.h"
+#include "CppUTest/SimpleString.hpp"
+#include "CppUTest/TestOutput.hpp"
+
+namespace cpputest
+{
+    class TestRegistry;
+
+    // Keeps the tests of a shared library loaded in a long lived process.
+    // The library is opened with a fresh TestRegistry as the current one,
+    // so its TestInstallers register there, and that registry is dropped
+    // before the library is closed. Every request is a line of command
+    // line arguments, run as if they were given to a test executable. The
+    // library is loaded again when its file has changed since the last
+    // request, and "quit" or the end of the input stops the server.
+    //
+    // The library must use the CppUTest of the server process, so link
+    // the server with exported symbols and leave CppUTest out of the
+    // library.
+    class TestServer
+    {
+    public:
+        // Usage: <server> <testLibrary>, with the requests on stdin.
+        static int RunServer(int ac, const char* const* av);
+
+        explicit TestServer(const SimpleString& libraryPath);
+        virtual ~TestServer();
+
+        bool load();
+        void unload();
+        bool isLoaded() const;
+        bool reloadIfChanged();
+        TestRegistry* getRegistry() const;
+        // Why the last load failed, empty when it did not.
+        const SimpleString& getLoadError() const;
+
+        int runRequest(const SimpleString& request);
+        int serve(PlatformSpecificFile requests, TestOutput& output);
+
+    protected:
+        // Called for every fresh registry, before the library is opened.
+        virtual void installPlugins(TestRegistry* registry);
+        virtual int
+        runTests(int ac, const char* const* av, TestRegistry* registry);
+
+    private:
+        SimpleString libraryPath_;
+        PlatformSpecificLibrary library_;
+        TestRegistry* registry_;
+        long libraryStamp_;
+        SimpleString loadError_;
+
+        bool readRequest(PlatformSpecificFile requests, SimpleString& request);
+
+        TestServer(const TestServer&);
+        TestServer& operator=(const TestServer&);
+    };
+}
+
+#endif
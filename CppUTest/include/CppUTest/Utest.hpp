@@ -42,9 +42,44 @@ namespace cpputest
     class TestFailure;
     class TestFilter;
     class TestTerminator;
+    struct UtestChildProcess;
 
     extern bool doubles_equal(double d1, double d2, double threshold);
 
+    // Describes how close two doubles must be for DOUBLES_ARRAY_EQUAL.
+    // NaN never matches anything unless withNanEqualsNan() is used. An
+    // infinity only matches an infinity of the same sign, while
+    // DOUBLES_EQUAL takes any two infinities as equal.
+    class DoublesTolerance
+    {
+    public:
+        static DoublesTolerance absolute(double threshold);
+        static DoublesTolerance relative(double fraction);
+        static DoublesTolerance ulps(unsigned long long maxUlps);
+
+        DoublesTolerance withNanEqualsNan() const;
+
+        bool matches(double expected, double actual) const;
+        SimpleString toString() const;
+
+    private:
+        enum Mode
+        {
+            ABSOLUTE,
+            RELATIVE,
+            ULPS
+        };
+
+        DoublesTolerance(
+            Mode mode, double threshold, unsigned long long maxUlps
+        );
+
+        Mode mode_;
+        double threshold_;
+        unsigned long long maxUlps_;
+        bool nanEqualsNan_;
+    };
+
     //////////////////// Utest
 
     class UtestShell;
@@ -59,6 +94,12 @@ namespace cpputest
         virtual void setup();
         virtual void teardown();
         virtual void testBody();
+
+        // Run once around the selected tests of a group, see
+        // TEST_GROUP_SETUP_ONCE(). They are static as no test object exists.
+        static void groupSetupOnce();
+        static void groupTeardownOnce();
+        static bool groupRunsInSnapshots();
     };
 
     //////////////////// TestTerminator
@@ -253,6 +294,25 @@ namespace cpputest
             size_t lineNumber,
             const TestTerminator& testTerminator = getCurrentTestTerminator()
         );
+        virtual void assertDoublesArrayEqual(
+            const double* expected,
+            const double* actual,
+            size_t count,
+            const DoublesTolerance& tolerance,
+            const char* text,
+            const char* fileName,
+            size_t lineNumber,
+            const TestTerminator& testTerminator = getCurrentTestTerminator()
+        );
+        virtual void assertLongsArrayEqual(
+            const long* expected,
+            const long* actual,
+            size_t count,
+            const char* text,
+            const char* fileName,
+            size_t lineNumber,
+            const TestTerminator& testTerminator = getCurrentTestTerminator()
+        );
         virtual void assertEquals(
             bool failed,
             const char* expected,
@@ -327,6 +387,26 @@ namespace cpputest
         virtual void runOneTest(TestPlugin* plugin, TestResult& result);
         virtual void
         runOneTestInCurrentProcess(TestPlugin* plugin, TestResult& result);
+        virtual bool
+        runOneTestInChildProcess(TestPlugin* plugin, TestResult& result);
+        // Forks a child process that runs the test, or returns nullptr
+        // when none can be started. finishInChildProcess() waits for the
+        // child, replays what it reported and releases it.
+        virtual UtestChildProcess* startInChildProcess(TestPlugin* plugin);
+        virtual void
+        finishInChildProcess(UtestChildProcess* child, TestResult& result);
+        // Waits until any of the children exits and returns it, or nullptr
+        // when there is none left to wait for.
+        static UtestChildProcess* waitForAnyChildProcess(
+            UtestChildProcess* const* children, size_t count
+        );
+
+        virtual void setupGroupOnce();
+        virtual void teardownGroupOnce();
+        virtual bool hasGroupFixture() const;
+        // Returns false when the setup failed.
+        virtual bool runGroupSetupOnce(TestResult& result);
+        virtual void runGroupTeardownOnce(TestResult& result);
 
         virtual void failWith(const TestFailure& failure);
         virtual void
@@ -358,6 +438,7 @@ namespace cpputest
 
         void setTestResult(TestResult* result);
         void setCurrentTest(UtestShell* test);
+        bool runGroupFixture(TestResult& result, bool setup);
         bool match(const char* target, const TestFilter* filters) const;
 
         static UtestShell* currentTest_;
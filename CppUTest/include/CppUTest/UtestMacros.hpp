@@ -53,6 +53,22 @@
 
 #define TEST_TEARDOWN() virtual void teardown() override
 
+/* Static, as they run before the first and after the last selected test of
+ * the group. Shared fixtures must live in static members. */
+#define TEST_GROUP_SETUP_ONCE() static void groupSetupOnce()
+
+#define TEST_GROUP_TEARDOWN_ONCE() static void groupTeardownOnce()
+
+/* Like TEST_GROUP_SETUP_ONCE(), but every test of the group then runs in a
+ * child process forked from the set up fixture. Each test starts from a
+ * copy-on-write snapshot of it, so tests may change the fixture freely. */
+#define TEST_GROUP_SNAPSHOT_SETUP_ONCE()                                       \
+    static bool groupRunsInSnapshots()                                         \
+    {                                                                          \
+        return true;                                                           \
+    }                                                                          \
+    TEST_GROUP_SETUP_ONCE()
+
 #define TEST(testGroup, testName)                                              \
     /* External declarations for strict compilers */                           \
     class TEST_##testGroup##_##testName##_TestShell;                           \
@@ -76,6 +92,27 @@
         {                                                                      \
             return new TEST_##testGroup##_##testName##_Test;                   \
         }                                                                      \
+        virtual void setupGroupOnce() override                                 \
+        {                                                                      \
+            TEST_##testGroup##_##testName##_Test::groupSetupOnce();            \
+        }                                                                      \
+        virtual void teardownGroupOnce() override                              \
+        {                                                                      \
+            TEST_##testGroup##_##testName##_Test::groupTeardownOnce();         \
+        }                                                                      \
+        virtual bool hasGroupFixture() const override                          \
+        {                                                                      \
+            return &TEST_##testGroup##_##testName##_Test::groupSetupOnce !=    \
+                       &cpputest::Utest::groupSetupOnce ||                     \
+                   &TEST_##testGroup##_##testName##_Test::groupTeardownOnce != \
+                       &cpputest::Utest::groupTeardownOnce;                    \
+        }                                                                      \
+        virtual bool isRunInSeperateProcess() const override                   \
+        {                                                                      \
+            return TEST_##testGroup##_##testName##_Test::                      \
+                       groupRunsInSnapshots() ||                               \
+                   cpputest::UtestShell::isRunInSeperateProcess();             \
+        }                                                                      \
     } TEST_##testGroup##_##testName##_TestShell_instance;                      \
     static cpputest::TestInstaller TEST_##testGroup##_##testName##_Installer(  \
         TEST_##testGroup##_##testName##_TestShell_instance, #testGroup,        \
@@ -108,6 +145,27 @@
         {                                                                      \
             return new IGNORE##testGroup##_##testName##_Test;                  \
         }                                                                      \
+        virtual void setupGroupOnce() override                                 \
+        {                                                                      \
+            IGNORE##testGroup##_##testName##_Test::groupSetupOnce();           \
+        }                                                                      \
+        virtual void teardownGroupOnce() override                              \
+        {                                                                      \
+            IGNORE##testGroup##_##testName##_Test::groupTeardownOnce();        \
+        }                                                                      \
+        virtual bool hasGroupFixture() const override                          \
+        {                                                                      \
+            return &IGNORE##testGroup##_##testName##_Test::groupSetupOnce !=   \
+                       &cpputest::Utest::groupSetupOnce ||                     \
+                   &IGNORE##testGroup##_##testName##_Test::groupTeardownOnce !=\
+                       &cpputest::Utest::groupTeardownOnce;                    \
+        }                                                                      \
+        virtual bool isRunInSeperateProcess() const override                   \
+        {                                                                      \
+            return IGNORE##testGroup##_##testName##_Test::                     \
+                       groupRunsInSnapshots() ||                               \
+                   cpputest::IgnoredUtestShell::isRunInSeperateProcess();      \
+        }                                                                      \
     } IGNORE##testGroup##_##testName##_TestShell_instance;                     \
     static cpputest::TestInstaller TEST_##testGroup##testName##_Installer(     \
         IGNORE##testGroup##_##testName##_TestShell_instance, #testGroup,       \
@@ -454,6 +512,62 @@
         );                                                                     \
     } while (0)
 
+// Check two arrays of doubles element by element, by default within an
+// absolute threshold or within a cpputest::DoublesTolerance. Unlike
+// DOUBLES_EQUAL, infinities of opposite sign are not equal.
+#define DOUBLES_ARRAY_EQUAL(expected, actual, count, threshold)                \
+    DOUBLES_ARRAY_EQUAL_LOCATION(                                              \
+        expected, actual, count,                                               \
+        cpputest::DoublesTolerance::absolute(threshold), nullptr, __FILE__,    \
+        __LINE__                                                               \
+    )
+
+#define DOUBLES_ARRAY_EQUAL_TEXT(expected, actual, count, threshold, text)     \
+    DOUBLES_ARRAY_EQUAL_LOCATION(                                              \
+        expected, actual, count,                                               \
+        cpputest::DoublesTolerance::absolute(threshold), text, __FILE__,       \
+        __LINE__                                                               \
+    )
+
+#define DOUBLES_ARRAY_EQUAL_TOLERANCE(expected, actual, count, tolerance)      \
+    DOUBLES_ARRAY_EQUAL_LOCATION(                                              \
+        expected, actual, count, tolerance, nullptr, __FILE__, __LINE__        \
+    )
+
+#define DOUBLES_ARRAY_EQUAL_TOLERANCE_TEXT(                                    \
+    expected, actual, count, tolerance, text                                   \
+)                                                                              \
+    DOUBLES_ARRAY_EQUAL_LOCATION(                                              \
+        expected, actual, count, tolerance, text, __FILE__, __LINE__           \
+    )
+
+#define DOUBLES_ARRAY_EQUAL_LOCATION(                                          \
+    expected, actual, count, tolerance, text, file, line                       \
+)                                                                              \
+    do {                                                                       \
+        cpputest::UtestShell::getCurrent()->assertDoublesArrayEqual(           \
+            expected, actual, count, tolerance, text, file, line               \
+        );                                                                     \
+    } while (0)
+
+// Check two arrays of long integers element by element
+#define LONGS_ARRAY_EQUAL(expected, actual, count)                             \
+    LONGS_ARRAY_EQUAL_LOCATION(                                                \
+        expected, actual, count, nullptr, __FILE__, __LINE__                   \
+    )
+
+#define LONGS_ARRAY_EQUAL_TEXT(expected, actual, count, text)                  \
+    LONGS_ARRAY_EQUAL_LOCATION(                                                \
+        expected, actual, count, text, __FILE__, __LINE__                      \
+    )
+
+#define LONGS_ARRAY_EQUAL_LOCATION(expected, actual, count, text, file, line)  \
+    do {                                                                       \
+        cpputest::UtestShell::getCurrent()->assertLongsArrayEqual(             \
+            expected, actual, count, text, file, line                          \
+        );                                                                     \
+    } while (0)
+
 #define MEMCMP_EQUAL(expected, actual, size)                                   \
     MEMCMP_EQUAL_LOCATION(expected, actual, size, nullptr, __FILE__, __LINE__)
 
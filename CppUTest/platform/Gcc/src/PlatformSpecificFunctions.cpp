@@ -35,6 +35,24 @@
     #include <sys/time.h>
 #endif
 
+#ifdef CPPUTEST_HAVE_PTHREAD_MUTEX_LOCK
+    #include <pthread.h>
+#endif
+
+#ifdef CPPUTEST_HAVE_FORK
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+#if defined(CPPUTEST_HAVE_DLOPEN) || defined(CPPUTEST_HAVE_DLADDR)
+    #include <dlfcn.h>
+#endif
+
+#ifdef CPPUTEST_HAVE_STAT
+    #include <sys/stat.h>
+#endif
+
+#include <errno.h>
 #include <setjmp.h>
 #include <stdarg.h>
 #include <stdio.h>
@@ -128,12 +146,32 @@ static void PlatformSpecificFCloseImplementation(PlatformSpecificFile file)
     fclose(reinterpret_cast<FILE*>(file));
 }
 
+static size_t PlatformSpecificFReadImplementation(
+    void* buffer, size_t size, PlatformSpecificFile file
+)
+{
+    return fread(buffer, 1, size, reinterpret_cast<FILE*>(file));
+}
+
+static void PlatformSpecificFWriteImplementation(
+    const void* buffer, size_t size, PlatformSpecificFile file
+)
+{
+    fwrite(buffer, 1, size, reinterpret_cast<FILE*>(file));
+}
+
+static void PlatformSpecificFFlushImplementation(PlatformSpecificFile file)
+{
+    fflush(reinterpret_cast<FILE*>(file));
+}
+
 static void PlatformSpecificFlushImplementation()
 {
     fflush(stdout);
 }
 
 PlatformSpecificFile PlatformSpecificStdOut = stdout;
+PlatformSpecificFile PlatformSpecificStdIn = stdin;
 
 PlatformSpecificFile (*PlatformSpecificFOpen)(const char*, const char*) =
     PlatformSpecificFOpenImplementation;
@@ -141,5 +179,218 @@ void (*PlatformSpecificFPuts)(const char*, PlatformSpecificFile) =
     PlatformSpecificFPutsImplementation;
 void (*PlatformSpecificFClose)(PlatformSpecificFile
 ) = PlatformSpecificFCloseImplementation;
+size_t (*PlatformSpecificFRead)(void*, size_t, PlatformSpecificFile) =
+    PlatformSpecificFReadImplementation;
+void (*PlatformSpecificFWrite)(const void*, size_t, PlatformSpecificFile) =
+    PlatformSpecificFWriteImplementation;
+void (*PlatformSpecificFFlush)(PlatformSpecificFile) =
+    PlatformSpecificFFlushImplementation;
 
 void (*PlatformSpecificFlush)() = PlatformSpecificFlushImplementation;
+
+#ifdef CPPUTEST_HAVE_PTHREAD_MUTEX_LOCK
+
+static PlatformSpecificMutex PThreadMutexCreate()
+{
+    pthread_mutex_t* mutex = new pthread_mutex_t;
+    pthread_mutex_init(mutex, nullptr);
+    return reinterpret_cast<PlatformSpecificMutex>(mutex);
+}
+
+static void PThreadMutexLock(PlatformSpecificMutex mutex)
+{
+    pthread_mutex_lock(reinterpret_cast<pthread_mutex_t*>(mutex));
+}
+
+static void PThreadMutexUnlock(PlatformSpecificMutex mutex)
+{
+    pthread_mutex_unlock(reinterpret_cast<pthread_mutex_t*>(mutex));
+}
+
+static void PThreadMutexDestroy(PlatformSpecificMutex mutex)
+{
+    pthread_mutex_t* pthreadMutex = reinterpret_cast<pthread_mutex_t*>(mutex);
+    pthread_mutex_destroy(pthreadMutex);
+    delete pthreadMutex;
+}
+
+PlatformSpecificMutex (*PlatformSpecificMutexCreate)() = PThreadMutexCreate;
+void (*PlatformSpecificMutexLock)(PlatformSpecificMutex) = PThreadMutexLock;
+void (*PlatformSpecificMutexUnlock)(PlatformSpecificMutex) =
+    PThreadMutexUnlock;
+void (*PlatformSpecificMutexDestroy)(PlatformSpecificMutex) =
+    PThreadMutexDestroy;
+
+#else
+
+static PlatformSpecificMutex DummyMutexCreate()
+{
+    return nullptr;
+}
+
+static void DummyMutexLock(PlatformSpecificMutex) {}
+
+static void DummyMutexUnlock(PlatformSpecificMutex) {}
+
+static void DummyMutexDestroy(PlatformSpecificMutex) {}
+
+PlatformSpecificMutex (*PlatformSpecificMutexCreate)() = DummyMutexCreate;
+void (*PlatformSpecificMutexLock)(PlatformSpecificMutex) = DummyMutexLock;
+void (*PlatformSpecificMutexUnlock)(PlatformSpecificMutex) = DummyMutexUnlock;
+void (*PlatformSpecificMutexDestroy)(PlatformSpecificMutex) =
+    DummyMutexDestroy;
+
+#endif
+
+#ifdef CPPUTEST_HAVE_FORK
+
+static int ForkImplementation()
+{
+    return static_cast<int>(fork());
+}
+
+static int exitStatusOf(int status)
+{
+    if (WIFSIGNALED(status))
+        return -WTERMSIG(status);
+    return WEXITSTATUS(status);
+}
+
+static int WaitPidImplementation(int pid)
+{
+    int status = 0;
+    while (waitpid(static_cast<pid_t>(pid), &status, 0) < 0) {
+        if (errno != EINTR)
+            return -1;
+    }
+    return exitStatusOf(status);
+}
+
+static int WaitAnyChildImplementation(int* status)
+{
+    int rawStatus = 0;
+    pid_t pid;
+    while ((pid = waitpid(-1, &rawStatus, 0)) < 0) {
+        if (errno != EINTR)
+            return -1;
+    }
+    *status = exitStatusOf(rawStatus);
+    return static_cast<int>(pid);
+}
+
+static void ExitChildImplementation(int status)
+{
+    _exit(status);
+}
+
+static PlatformSpecificFile TempFileImplementation()
+{
+    return tmpfile();
+}
+
+static void RewindImplementation(PlatformSpecificFile file)
+{
+    rewind(static_cast<FILE*>(file));
+}
+
+int (*PlatformSpecificFork)() = ForkImplementation;
+int (*PlatformSpecificWaitPid)(int) = WaitPidImplementation;
+int (*PlatformSpecificWaitAnyChild)(int*) = WaitAnyChildImplementation;
+void (*PlatformSpecificExitChild)(int) = ExitChildImplementation;
+PlatformSpecificFile (*PlatformSpecificTempFile)() = TempFileImplementation;
+void (*PlatformSpecificRewind)(PlatformSpecificFile) = RewindImplementation;
+
+#else
+
+static int DummyFork()
+{
+    return -1;
+}
+
+static int DummyWaitPid(int)
+{
+    return 0;
+}
+
+static int DummyWaitAnyChild(int*)
+{
+    return -1;
+}
+
+static void DummyExitChild(int) {}
+
+static PlatformSpecificFile DummyTempFile()
+{
+    return nullptr;
+}
+
+static void DummyRewind(PlatformSpecificFile) {}
+
+int (*PlatformSpecificFork)() = DummyFork;
+int (*PlatformSpecificWaitPid)(int) = DummyWaitPid;
+int (*PlatformSpecificWaitAnyChild)(int*) = DummyWaitAnyChild;
+void (*PlatformSpecificExitChild)(int) = DummyExitChild;
+PlatformSpecificFile (*PlatformSpecificTempFile)() = DummyTempFile;
+void (*PlatformSpecificRewind)(PlatformSpecificFile) = DummyRewind;
+
+#endif
+
+#ifdef CPPUTEST_HAVE_DLOPEN
+
+static PlatformSpecificLibrary LibraryOpenImplementation(const char* path)
+{
+    return dlopen(path, RTLD_NOW | RTLD_LOCAL);
+}
+
+static void LibraryCloseImplementation(PlatformSpecificLibrary library)
+{
+    dlclose(library);
+}
+
+#else
+
+static PlatformSpecificLibrary LibraryOpenImplementation(const char*)
+{
+    return nullptr;
+}
+
+static void LibraryCloseImplementation(PlatformSpecificLibrary) {}
+
+#endif
+
+static const char* LibraryPathOfImplementation(const void* address)
+{
+#ifdef CPPUTEST_HAVE_DLADDR
+    Dl_info info;
+    if (dladdr(address, &info) == 0 || info.dli_fname == nullptr ||
+        info.dli_fname[0] == '\0')
+        return nullptr;
+    return info.dli_fname;
+#else
+    (void)address;
+    return nullptr;
+#endif
+}
+
+static long FileStampImplementation(const char* path)
+{
+#ifdef CPPUTEST_HAVE_STAT
+    struct stat info;
+    if (stat(path, &info) != 0)
+        return 0;
+    return static_cast<long>(info.st_mtime) ^
+           (static_cast<long>(info.st_size) << 1) ^
+           static_cast<long>(info.st_ino);
+#else
+    (void)path;
+    return 0;
+#endif
+}
+
+PlatformSpecificLibrary (*PlatformSpecificLibraryOpen)(const char*) =
+    LibraryOpenImplementation;
+void (*PlatformSpecificLibraryClose)(PlatformSpecificLibrary) =
+    LibraryCloseImplementation;
+const char* (*PlatformSpecificLibraryPathOf)(const void*) =
+    LibraryPathOfImplementation;
+long (*PlatformSpecificFileStamp)(const char*) = FileStampImplementation;
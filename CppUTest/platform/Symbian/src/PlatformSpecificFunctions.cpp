@@ -86,6 +86,7 @@ void PlatformSpecificFlush()
 }
 
 PlatformSpecificFile PlatformSpecificStdOut = stdout;
+PlatformSpecificFile PlatformSpecificStdIn = stdin;
 
 PlatformSpecificFile
 PlatformSpecificFOpen(const char* filename, const char* flag)
@@ -102,3 +103,93 @@ void PlatformSpecificFClose(PlatformSpecificFile file)
 {
     fclose((FILE*)file);
 }
+
+size_t
+PlatformSpecificFRead(void* buffer, size_t size, PlatformSpecificFile file)
+{
+    return fread(buffer, 1, size, (FILE*)file);
+}
+
+void PlatformSpecificFWrite(
+    const void* buffer, size_t size, PlatformSpecificFile file
+)
+{
+    fwrite(buffer, 1, size, (FILE*)file);
+}
+
+void PlatformSpecificFFlush(PlatformSpecificFile file)
+{
+    fflush((FILE*)file);
+}
+
+static PlatformSpecificMutex DummyMutexCreate()
+{
+    return nullptr;
+}
+
+static void DummyMutexLock(PlatformSpecificMutex) {}
+
+static void DummyMutexUnlock(PlatformSpecificMutex) {}
+
+static void DummyMutexDestroy(PlatformSpecificMutex) {}
+
+PlatformSpecificMutex (*PlatformSpecificMutexCreate)() = DummyMutexCreate;
+void (*PlatformSpecificMutexLock)(PlatformSpecificMutex) = DummyMutexLock;
+void (*PlatformSpecificMutexUnlock)(PlatformSpecificMutex) = DummyMutexUnlock;
+void (*PlatformSpecificMutexDestroy)(PlatformSpecificMutex) =
+    DummyMutexDestroy;
+
+static int DummyFork()
+{
+    return -1;
+}
+
+static int DummyWaitPid(int)
+{
+    return 0;
+}
+
+static int DummyWaitAnyChild(int*)
+{
+    return -1;
+}
+
+static void DummyExitChild(int) {}
+
+static PlatformSpecificFile DummyTempFile()
+{
+    return nullptr;
+}
+
+static void DummyRewind(PlatformSpecificFile) {}
+
+int (*PlatformSpecificFork)() = DummyFork;
+int (*PlatformSpecificWaitPid)(int) = DummyWaitPid;
+int (*PlatformSpecificWaitAnyChild)(int*) = DummyWaitAnyChild;
+void (*PlatformSpecificExitChild)(int) = DummyExitChild;
+PlatformSpecificFile (*PlatformSpecificTempFile)() = DummyTempFile;
+void (*PlatformSpecificRewind)(PlatformSpecificFile) = DummyRewind;
+
+static PlatformSpecificLibrary DummyLibraryOpen(const char*)
+{
+    return nullptr;
+}
+
+static void DummyLibraryClose(PlatformSpecificLibrary) {}
+
+static const char* DummyLibraryPathOf(const void*)
+{
+    return nullptr;
+}
+
+static long DummyFileStamp(const char*)
+{
+    return 0;
+}
+
+PlatformSpecificLibrary (*PlatformSpecificLibraryOpen)(const char*) =
+    DummyLibraryOpen;
+void (*PlatformSpecificLibraryClose)(PlatformSpecificLibrary) =
+    DummyLibraryClose;
+const char* (*PlatformSpecificLibraryPathOf)(const void*) = DummyLibraryPathOf;
+long (*PlatformSpecificFileStamp)(const char*) = DummyFileStamp;
@@ -140,13 +140,38 @@ static void VisualCppFClose(PlatformSpecificFile file)
     fclose(reinterpret_cast<FILE*>(file));
 }
 
+static size_t
+VisualCppFRead(void* buffer, size_t size, PlatformSpecificFile file)
+{
+    return fread(buffer, 1, size, reinterpret_cast<FILE*>(file));
+}
+
+static void
+VisualCppFWrite(const void* buffer, size_t size, PlatformSpecificFile file)
+{
+    fwrite(buffer, 1, size, reinterpret_cast<FILE*>(file));
+}
+
+static void VisualCppFFlush(PlatformSpecificFile file)
+{
+    fflush(reinterpret_cast<FILE*>(file));
+}
+
 PlatformSpecificFile PlatformSpecificStdOut = stdout;
+PlatformSpecificFile PlatformSpecificStdIn = stdin;
 PlatformSpecificFile (*PlatformSpecificFOpen)(
     const char* filename, const char* flag
 ) = VisualCppFOpen;
 void (*PlatformSpecificFPuts)(const char* str, PlatformSpecificFile file) =
     VisualCppFPuts;
 void (*PlatformSpecificFClose)(PlatformSpecificFile file) = VisualCppFClose;
+size_t (*PlatformSpecificFRead)(
+    void* buffer, size_t size, PlatformSpecificFile file
+) = VisualCppFRead;
+void (*PlatformSpecificFWrite)(
+    const void* buffer, size_t size, PlatformSpecificFile file
+) = VisualCppFWrite;
+void (*PlatformSpecificFFlush)(PlatformSpecificFile file) = VisualCppFFlush;
 
 static void VisualCppFlush()
 {
@@ -154,3 +179,92 @@ static void VisualCppFlush()
 }
 
 void (*PlatformSpecificFlush)(void) = VisualCppFlush;
+
+static PlatformSpecificMutex VisualCppMutexCreate()
+{
+    CRITICAL_SECTION* critical_section = new CRITICAL_SECTION;
+    InitializeCriticalSection(critical_section);
+    return reinterpret_cast<PlatformSpecificMutex>(critical_section);
+}
+
+static void VisualCppMutexLock(PlatformSpecificMutex mutex)
+{
+    EnterCriticalSection(reinterpret_cast<CRITICAL_SECTION*>(mutex));
+}
+
+static void VisualCppMutexUnlock(PlatformSpecificMutex mutex)
+{
+    LeaveCriticalSection(reinterpret_cast<CRITICAL_SECTION*>(mutex));
+}
+
+static void VisualCppMutexDestroy(PlatformSpecificMutex mutex)
+{
+    CRITICAL_SECTION* critical_section =
+        reinterpret_cast<CRITICAL_SECTION*>(mutex);
+    DeleteCriticalSection(critical_section);
+    delete critical_section;
+}
+
+PlatformSpecificMutex (*PlatformSpecificMutexCreate)(void) =
+    VisualCppMutexCreate;
+void (*PlatformSpecificMutexLock)(PlatformSpecificMutex mutex) =
+    VisualCppMutexLock;
+void (*PlatformSpecificMutexUnlock)(PlatformSpecificMutex mutex) =
+    VisualCppMutexUnlock;
+void (*PlatformSpecificMutexDestroy)(PlatformSpecificMutex mutex) =
+    VisualCppMutexDestroy;
+
+static int DummyFork()
+{
+    return -1;
+}
+
+static int DummyWaitPid(int)
+{
+    return 0;
+}
+
+static int DummyWaitAnyChild(int*)
+{
+    return -1;
+}
+
+static void DummyExitChild(int) {}
+
+static PlatformSpecificFile DummyTempFile()
+{
+    return nullptr;
+}
+
+static void DummyRewind(PlatformSpecificFile) {}
+
+int (*PlatformSpecificFork)() = DummyFork;
+int (*PlatformSpecificWaitPid)(int) = DummyWaitPid;
+int (*PlatformSpecificWaitAnyChild)(int*) = DummyWaitAnyChild;
+void (*PlatformSpecificExitChild)(int) = DummyExitChild;
+PlatformSpecificFile (*PlatformSpecificTempFile)() = DummyTempFile;
+void (*PlatformSpecificRewind)(PlatformSpecificFile) = DummyRewind;
+
+static PlatformSpecificLibrary DummyLibraryOpen(const char*)
+{
+    return nullptr;
+}
+
+static void DummyLibraryClose(PlatformSpecificLibrary) {}
+
+static const char* DummyLibraryPathOf(const void*)
+{
+    return nullptr;
+}
+
+static long DummyFileStamp(const char*)
+{
+    return 0;
+}
+
+PlatformSpecificLibrary (*PlatformSpecificLibraryOpen)(const char*) =
+    DummyLibraryOpen;
+void (*PlatformSpecificLibraryClose)(PlatformSpecificLibrary) =
+    DummyLibraryClose;
+const char* (*PlatformSpecificLibraryPathOf)(const void*) = DummyLibraryPathOf;
+long (*PlatformSpecificFileStamp)(const char*) = DummyFileStamp;
@@ -115,17 +115,115 @@ static void PlatformSpecificFCloseImplementation(PlatformSpecificFile file)
     fclose((FILE*)file);
 }
 
+static size_t PlatformSpecificFReadImplementation(
+    void* buffer, size_t size, PlatformSpecificFile file
+)
+{
+    return fread(buffer, 1, size, (FILE*)file);
+}
+
+static void PlatformSpecificFWriteImplementation(
+    const void* buffer, size_t size, PlatformSpecificFile file
+)
+{
+    fwrite(buffer, 1, size, (FILE*)file);
+}
+
+static void PlatformSpecificFFlushImplementation(PlatformSpecificFile file)
+{
+    fflush((FILE*)file);
+}
+
 static void PlatformSpecificFlushImplementation()
 {
     fflush(stdout);
 }
 
 PlatformSpecificFile PlatformSpecificStdOut = stdout;
+PlatformSpecificFile PlatformSpecificStdIn = stdin;
 PlatformSpecificFile (*PlatformSpecificFOpen)(const char*, const char*) =
     PlatformSpecificFOpenImplementation;
 void (*PlatformSpecificFPuts)(const char*, PlatformSpecificFile) =
     PlatformSpecificFPutsImplementation;
 void (*PlatformSpecificFClose)(PlatformSpecificFile
 ) = PlatformSpecificFCloseImplementation;
+size_t (*PlatformSpecificFRead)(void*, size_t, PlatformSpecificFile) =
+    PlatformSpecificFReadImplementation;
+void (*PlatformSpecificFWrite)(const void*, size_t, PlatformSpecificFile) =
+    PlatformSpecificFWriteImplementation;
+void (*PlatformSpecificFFlush)(PlatformSpecificFile) =
+    PlatformSpecificFFlushImplementation;
 
 void (*PlatformSpecificFlush)() = PlatformSpecificFlushImplementation;
+
+static PlatformSpecificMutex DummyMutexCreate()
+{
+    return nullptr;
+}
+
+static void DummyMutexLock(PlatformSpecificMutex) {}
+
+static void DummyMutexUnlock(PlatformSpecificMutex) {}
+
+static void DummyMutexDestroy(PlatformSpecificMutex) {}
+
+PlatformSpecificMutex (*PlatformSpecificMutexCreate)() = DummyMutexCreate;
+void (*PlatformSpecificMutexLock)(PlatformSpecificMutex) = DummyMutexLock;
+void (*PlatformSpecificMutexUnlock)(PlatformSpecificMutex) = DummyMutexUnlock;
+void (*PlatformSpecificMutexDestroy)(PlatformSpecificMutex) =
+    DummyMutexDestroy;
+
+static int DummyFork()
+{
+    return -1;
+}
+
+static int DummyWaitPid(int)
+{
+    return 0;
+}
+
+static int DummyWaitAnyChild(int*)
+{
+    return -1;
+}
+
+static void DummyExitChild(int) {}
+
+static PlatformSpecificFile DummyTempFile()
+{
+    return nullptr;
+}
+
+static void DummyRewind(PlatformSpecificFile) {}
+
+int (*PlatformSpecificFork)() = DummyFork;
+int (*PlatformSpecificWaitPid)(int) = DummyWaitPid;
+int (*PlatformSpecificWaitAnyChild)(int*) = DummyWaitAnyChild;
+void (*PlatformSpecificExitChild)(int) = DummyExitChild;
+PlatformSpecificFile (*PlatformSpecificTempFile)() = DummyTempFile;
+void (*PlatformSpecificRewind)(PlatformSpecificFile) = DummyRewind;
+
+static PlatformSpecificLibrary DummyLibraryOpen(const char*)
+{
+    return nullptr;
+}
+
+static void DummyLibraryClose(PlatformSpecificLibrary) {}
+
+static const char* DummyLibraryPathOf(const void*)
+{
+    return nullptr;
+}
+
+static long DummyFileStamp(const char*)
+{
+    return 0;
+}
+
+PlatformSpecificLibrary (*PlatformSpecificLibraryOpen)(const char*) =
+    DummyLibraryOpen;
+void (*PlatformSpecificLibraryClose)(PlatformSpecificLibrary) =
+    DummyLibraryClose;
+const char* (*PlatformSpecificLibraryPathOf)(const void*) = DummyLibraryPathOf;
+long (*PlatformSpecificFileStamp)(const char*) = DummyFileStamp;
@@ -0,0 +1,596 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/BinaryTestOutput.hpp"
+#include "CppUTest/PlatformSpecificFunctions.h"
+#include "CppUTest/TestFailure.hpp"
+#include "CppUTest/TestResult.hpp"
+
+namespace cpputest
+{
+    static const size_t binaryLogFlushThreshold = 64 * 1024;
+    static const size_t binaryLogRecordHeaderSize = 5;
+    static const size_t binaryLogMagicSize = 8;
+    static const unsigned char binaryLogVersion = 1;
+    static const unsigned char binaryLogMagic[binaryLogMagicSize] = {
+        'C', 'p', 'p', 'U', 'L', 'o', 'g', binaryLogVersion
+    };
+
+    static const size_t binaryLogReadChunkSize = 4096;
+
+    struct BinaryLogBuffer
+    {
+        BinaryLogBuffer() : data_(nullptr), size_(0), capacity_(0) {}
+        ~BinaryLogBuffer()
+        {
+            delete[] data_;
+        }
+
+        unsigned char* resize(size_t size)
+        {
+            if (size > capacity_) {
+                size_t newCapacity = (capacity_ == 0) ? 256 : capacity_;
+                while (newCapacity < size)
+                    newCapacity *= 2;
+
+                unsigned char* newData = new unsigned char[newCapacity];
+                for (size_t i = 0; i < size_; i++)
+                    newData[i] = data_[i];
+                delete[] data_;
+                data_ = newData;
+                capacity_ = newCapacity;
+            }
+            size_ = size;
+            return data_;
+        }
+
+        void append(const void* bytes, size_t length)
+        {
+            size_t offset = size_;
+            unsigned char* destination = resize(size_ + length) + offset;
+            const unsigned char* source =
+                static_cast<const unsigned char*>(bytes);
+            for (size_t i = 0; i < length; i++)
+                destination[i] = source[i];
+        }
+
+        void appendByte(unsigned char byte)
+        {
+            append(&byte, 1);
+        }
+
+        void appendNumber(size_t number)
+        {
+            while (number >= 0x80) {
+                appendByte(static_cast<unsigned char>((number & 0x7f) | 0x80));
+                number >>= 7;
+            }
+            appendByte(static_cast<unsigned char>(number));
+        }
+
+        void appendString(const SimpleString& text)
+        {
+            appendNumber(text.size());
+            append(text.asCharString(), text.size());
+        }
+
+        const unsigned char* data() const
+        {
+            return data_;
+        }
+
+        size_t size() const
+        {
+            return size_;
+        }
+
+        void clear()
+        {
+            size_ = 0;
+        }
+
+    private:
+        unsigned char* data_;
+        size_t size_;
+        size_t capacity_;
+
+        BinaryLogBuffer(const BinaryLogBuffer&);
+        BinaryLogBuffer& operator=(const BinaryLogBuffer&);
+    };
+
+    struct BinaryTestOutputImpl
+    {
+        BinaryTestOutputImpl() : file_(nullptr), openFailed_(false) {}
+
+        PlatformSpecificFile file_;
+        bool openFailed_;
+        SimpleString package_;
+        BinaryLogBuffer payload_;
+        BinaryLogBuffer fileBuffer_;
+    };
+
+    BinaryTestOutput::BinaryTestOutput() : impl_(new BinaryTestOutputImpl) {}
+
+    BinaryTestOutput::~BinaryTestOutput()
+    {
+        flush();
+        if (impl_->file_ != nullptr)
+            closeFile();
+        delete impl_;
+    }
+
+    SimpleString BinaryTestOutput::createFileName()
+    {
+        SimpleString fileName = "cpputest";
+        if (!impl_->package_.isEmpty()) {
+            fileName += "_";
+            fileName += impl_->package_;
+        }
+        // same forbidden characters as the JUnit file names
+        static const char* const forbiddenCharacters = "/\\?%*:|\"<>";
+        for (const char* sym = forbiddenCharacters; *sym; ++sym) {
+            fileName.replace(*sym, '_');
+        }
+        return fileName + ".bin";
+    }
+
+    void BinaryTestOutput::setPackageName(const SimpleString& package)
+    {
+        impl_->package_ = package;
+    }
+
+    void BinaryTestOutput::writeRecord(RecordKind kind)
+    {
+        size_t length = impl_->payload_.size();
+        unsigned char header[binaryLogRecordHeaderSize] = {
+            static_cast<unsigned char>(kind),
+            static_cast<unsigned char>(length & 0xff),
+            static_cast<unsigned char>((length >> 8) & 0xff),
+            static_cast<unsigned char>((length >> 16) & 0xff),
+            static_cast<unsigned char>((length >> 24) & 0xff)
+        };
+        impl_->fileBuffer_.append(header, binaryLogRecordHeaderSize);
+        impl_->fileBuffer_.append(impl_->payload_.data(), length);
+        impl_->payload_.clear();
+
+        if (impl_->fileBuffer_.size() >= binaryLogFlushThreshold)
+            flush();
+    }
+
+    void BinaryTestOutput::writeTest(const UtestShell& test)
+    {
+        impl_->payload_.appendString(test.getGroup());
+        impl_->payload_.appendString(test.getName());
+        impl_->payload_.appendString(test.getFile());
+        impl_->payload_.appendNumber(test.getLineNumber());
+        impl_->payload_.appendByte(test.willRun() ? 0 : 1);
+    }
+
+    void BinaryTestOutput::printTestsStarted()
+    {
+        writeRecord(record_testsStarted);
+    }
+
+    void BinaryTestOutput::printCurrentGroupStarted(const UtestShell& test)
+    {
+        writeTest(test);
+        writeRecord(record_groupStarted);
+    }
+
+    void BinaryTestOutput::printCurrentTestStarted(const UtestShell& test)
+    {
+        writeTest(test);
+        writeRecord(record_testStarted);
+    }
+
+    void BinaryTestOutput::printFailure(const TestFailure& failure)
+    {
+        impl_->payload_.appendString(failure.getFileName());
+        impl_->payload_.appendNumber(failure.getFailureLineNumber());
+        impl_->payload_.appendString(failure.getMessage());
+        writeRecord(record_failure);
+    }
+
+    void BinaryTestOutput::printCurrentTestEnded(const TestResult& res)
+    {
+        impl_->payload_.appendNumber(res.getCurrentTestTotalExecutionTime());
+        impl_->payload_.appendNumber(res.getCheckCount());
+        writeRecord(record_testEnded);
+    }
+
+    void BinaryTestOutput::printCurrentGroupEnded(const TestResult& res)
+    {
+        impl_->payload_.appendNumber(res.getCurrentGroupTotalExecutionTime());
+        writeRecord(record_groupEnded);
+        flush();
+    }
+
+    void BinaryTestOutput::printTestsEnded(const TestResult& result)
+    {
+        impl_->payload_.appendNumber(result.getTestCount());
+        impl_->payload_.appendNumber(result.getRunCount());
+        impl_->payload_.appendNumber(result.getCheckCount());
+        impl_->payload_.appendNumber(result.getIgnoredCount());
+        impl_->payload_.appendNumber(result.getFilteredOutCount());
+        impl_->payload_.appendNumber(result.getTotalExecutionTime());
+        writeRecord(record_testsEnded);
+        flush();
+    }
+
+    void BinaryTestOutput::printBuffer(const char* text)
+    {
+        impl_->payload_.appendString(text);
+        writeRecord(record_print);
+    }
+
+    void BinaryTestOutput::flush()
+    {
+        if (impl_->fileBuffer_.size() == 0)
+            return;
+
+        if (impl_->file_ == nullptr && !impl_->openFailed_) {
+            openFileForWrite(createFileName());
+            impl_->openFailed_ = (impl_->file_ == nullptr);
+            if (!impl_->openFailed_)
+                writeToFile(binaryLogMagic, binaryLogMagicSize);
+        }
+        if (impl_->file_ != nullptr)
+            writeToFile(impl_->fileBuffer_.data(), impl_->fileBuffer_.size());
+        impl_->fileBuffer_.clear();
+    }
+
+    void BinaryTestOutput::openFileForWrite(const SimpleString& fileName)
+    {
+        impl_->file_ = PlatformSpecificFOpen(fileName.asCharString(), "wb");
+    }
+
+    void BinaryTestOutput::writeToFile(const void* buffer, size_t size)
+    {
+        PlatformSpecificFWrite(buffer, size, impl_->file_);
+    }
+
+    void BinaryTestOutput::closeFile()
+    {
+        PlatformSpecificFClose(impl_->file_);
+    }
+
+    class BinaryLogReader
+    {
+    public:
+        explicit BinaryLogReader(PlatformSpecificFile file) :
+            file_(file),
+            position_(0),
+            malformed_(false)
+        {
+        }
+
+        bool readMagic()
+        {
+            unsigned char magic[binaryLogMagicSize];
+            if (!readExactly(magic, binaryLogMagicSize))
+                return false;
+            return SimpleString::MemCmp(
+                       magic, binaryLogMagic, binaryLogMagicSize - 1
+                   ) == 0 &&
+                   magic[binaryLogMagicSize - 1] <= binaryLogVersion;
+        }
+
+        // Returns false at the end of the log, or when the last record was
+        // cut short.
+        bool readRecord(int& kind)
+        {
+            if (malformed_)
+                return false;
+
+            unsigned char header[binaryLogRecordHeaderSize];
+            size_t headerLength = read(header, binaryLogRecordHeaderSize);
+            if (headerLength != binaryLogRecordHeaderSize) {
+                malformed_ = (headerLength != 0);
+                return false;
+            }
+
+            kind = header[0];
+            size_t length = static_cast<size_t>(header[1]) |
+                            (static_cast<size_t>(header[2]) << 8) |
+                            (static_cast<size_t>(header[3]) << 16) |
+                            (static_cast<size_t>(header[4]) << 24);
+            position_ = 0;
+            if (!readPayload(length)) {
+                malformed_ = true;
+                return false;
+            }
+            return true;
+        }
+
+        size_t readNumber()
+        {
+            size_t number = 0;
+            for (unsigned shift = 0; shift < sizeof(size_t) * 8; shift += 7) {
+                if (position_ >= payload_.size())
+                    break;
+                unsigned char byte = payload_.data()[position_++];
+                number |= static_cast<size_t>(byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0)
+                    return number;
+            }
+            malformed_ = true;
+            return 0;
+        }
+
+        SimpleString readString()
+        {
+            size_t length = readNumber();
+            if (length > payload_.size() - position_) {
+                malformed_ = true;
+                return "";
+            }
+            char* text = new char[length + 1];
+            for (size_t i = 0; i < length; i++)
+                text[i] = static_cast<char>(payload_.data()[position_ + i]);
+            text[length] = '\0';
+            position_ += length;
+
+            SimpleString result(text);
+            delete[] text;
+            return result;
+        }
+
+        unsigned char readByte()
+        {
+            if (position_ >= payload_.size()) {
+                malformed_ = true;
+                return 0;
+            }
+            return payload_.data()[position_++];
+        }
+
+        bool isMalformed() const
+        {
+            return malformed_;
+        }
+
+    private:
+        size_t read(void* buffer, size_t size)
+        {
+            unsigned char* destination = static_cast<unsigned char*>(buffer);
+            size_t total = 0;
+            while (total < size) {
+                size_t length = PlatformSpecificFRead(
+                    destination + total, size - total, file_
+                );
+                if (length == 0)
+                    break;
+                total += length;
+            }
+            return total;
+        }
+
+        bool readExactly(void* buffer, size_t size)
+        {
+            return read(buffer, size) == size;
+        }
+
+        // The payload grows with the bytes actually read, so a corrupt
+        // length cannot allocate much more than the log still holds.
+        bool readPayload(size_t length)
+        {
+            payload_.clear();
+            while (payload_.size() < length) {
+                size_t offset = payload_.size();
+                size_t chunk = length - offset;
+                if (chunk > binaryLogReadChunkSize)
+                    chunk = binaryLogReadChunkSize;
+                unsigned char* destination =
+                    payload_.resize(offset + chunk) + offset;
+                if (!readExactly(destination, chunk))
+                    return false;
+            }
+            return true;
+        }
+
+        PlatformSpecificFile file_;
+        BinaryLogBuffer payload_;
+        size_t position_;
+        bool malformed_;
+    };
+
+    // Reports the recorded durations instead of measuring the replay.
+    class BinaryLogTestResult : public TestResult
+    {
+    public:
+        explicit BinaryLogTestResult(TestOutput& output) :
+            TestResult(output),
+            output_(output)
+        {
+        }
+
+        virtual void currentTestEnded(UtestShell* /*test*/) override
+        {
+            output_.printCurrentTestEnded(*this);
+        }
+
+        virtual void currentGroupEnded(UtestShell* /*test*/) override
+        {
+            output_.printCurrentGroupEnded(*this);
+        }
+
+        virtual void testsEnded() override
+        {
+            output_.printTestsEnded(*this);
+        }
+
+    private:
+        TestOutput& output_;
+    };
+
+    class BinaryLogTest
+    {
+    public:
+        BinaryLogTest() : line_(0), shell_(nullptr) {}
+        ~BinaryLogTest()
+        {
+            delete shell_;
+        }
+
+        UtestShell* read(BinaryLogReader& reader)
+        {
+            delete shell_;
+            group_ = reader.readString();
+            name_ = reader.readString();
+            file_ = reader.readString();
+            line_ = reader.readNumber();
+            bool ignored = reader.readByte() != 0;
+
+            if (ignored)
+                shell_ = new IgnoredUtestShell(
+                    group_.asCharString(), name_.asCharString(),
+                    file_.asCharString(), line_
+                );
+            else
+                shell_ = new UtestShell(
+                    group_.asCharString(), name_.asCharString(),
+                    file_.asCharString(), line_
+                );
+            return shell_;
+        }
+
+        UtestShell* shell() const
+        {
+            return shell_;
+        }
+
+    private:
+        SimpleString group_;
+        SimpleString name_;
+        SimpleString file_;
+        size_t line_;
+        UtestShell* shell_;
+
+        BinaryLogTest(const BinaryLogTest&);
+        BinaryLogTest& operator=(const BinaryLogTest&);
+    };
+
+    static void replayTestsEnded(BinaryLogReader& reader, TestResult& result)
+    {
+        size_t testCount = reader.readNumber();
+        size_t runCount = reader.readNumber();
+        size_t checkCount = reader.readNumber();
+        size_t ignoredCount = reader.readNumber();
+        size_t filteredOutCount = reader.readNumber();
+        result.setTotalExecutionTime(reader.readNumber());
+
+        while (result.getTestCount() < testCount)
+            result.countTest();
+        while (result.getRunCount() < runCount)
+            result.countRun();
+        if (result.getCheckCount() < checkCount)
+            result.addChecks(checkCount - result.getCheckCount());
+        while (result.getIgnoredCount() < ignoredCount)
+            result.countIgnored();
+        while (result.getFilteredOutCount() < filteredOutCount)
+            result.countFilteredOut();
+        result.testsEnded();
+    }
+
+    static bool replayRecords(
+        BinaryLogReader& reader, TestOutput& output, size_t& failureCount
+    )
+    {
+        BinaryLogTestResult* result = nullptr;
+        BinaryLogTest test;
+        int kind = 0;
+        bool consistent = true;
+
+        while (consistent && reader.readRecord(kind)) {
+            if (kind == BinaryTestOutput::record_print) {
+                output.print(reader.readString().asCharString());
+                continue;
+            }
+            if (kind == BinaryTestOutput::record_testsStarted) {
+                delete result;
+                result = nullptr;
+            }
+            if (result == nullptr)
+                result = new BinaryLogTestResult(output);
+
+            if (kind == BinaryTestOutput::record_testsStarted) {
+                result->testsStarted();
+            } else if (kind == BinaryTestOutput::record_groupStarted) {
+                result->currentGroupStarted(test.read(reader));
+            } else if (kind == BinaryTestOutput::record_testStarted) {
+                result->currentTestStarted(test.read(reader));
+            } else if (kind == BinaryTestOutput::record_failure) {
+                SimpleString file = reader.readString();
+                size_t line = reader.readNumber();
+                SimpleString message = reader.readString();
+                consistent = (test.shell() != nullptr);
+                if (consistent) {
+                    result->addFailure(TestFailure(
+                        test.shell(), file.asCharString(), line, message
+                    ));
+                    failureCount++;
+                }
+            } else if (kind == BinaryTestOutput::record_testEnded) {
+                result->setCurrentTestTotalExecutionTime(reader.readNumber());
+                size_t checkCount = reader.readNumber();
+                if (result->getCheckCount() < checkCount)
+                    result->addChecks(checkCount - result->getCheckCount());
+                consistent = (test.shell() != nullptr);
+                if (consistent)
+                    result->currentTestEnded(test.shell());
+            } else if (kind == BinaryTestOutput::record_groupEnded) {
+                result->setCurrentGroupTotalExecutionTime(reader.readNumber());
+                consistent = (test.shell() != nullptr);
+                if (consistent)
+                    result->currentGroupEnded(test.shell());
+            } else if (kind == BinaryTestOutput::record_testsEnded) {
+                replayTestsEnded(reader, *result);
+            }
+        }
+
+        delete result;
+        return consistent && !reader.isMalformed();
+    }
+
+    bool BinaryTestOutput::replay(
+        const SimpleString& fileName, TestOutput& output, size_t& failureCount
+    )
+    {
+        failureCount = 0;
+        PlatformSpecificFile file =
+            PlatformSpecificFOpen(fileName.asCharString(), "rb");
+        if (file == nullptr)
+            return false;
+
+        BinaryLogReader reader(file);
+        bool replayed =
+            reader.readMagic() && replayRecords(reader, output, failureCount);
+        PlatformSpecificFClose(file);
+        return replayed;
+    }
+}
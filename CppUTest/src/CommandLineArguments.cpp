@@ -46,9 +46,13 @@ namespace cpputest
         crashOnFail_(false),
         rethrowExceptions_(true),
         repeat_(1),
+        workers_(1),
         groupFilters_(nullptr),
         nameFilters_(nullptr),
-        outputType_(OUTPUT_ECLIPSE)
+        outputType_(OUTPUT_ECLIPSE),
+        junitMergeInputFiles_(nullptr),
+        junitMergeInputFileCount_(0),
+        ignoringResultCache_(false)
     {
     }
 
@@ -66,10 +70,23 @@ namespace cpputest
         }
     }
 
+    // Only the options that can change the outcome of a test key the
+    // result cache. A pass still counts when just the filters, the output
+    // or the number of workers differ.
+    static bool changesTestOutcome(const SimpleString& argument)
+    {
+        if (argument.startsWith("-resume"))
+            return false;
+        return argument.startsWith("-r") || argument.startsWith("-p") ||
+               argument == "-b" || argument == "-f" || argument == "-e" ||
+               argument == "-ci";
+    }
+
     bool CommandLineArguments::parse(TestPlugin* plugin)
     {
         bool correctParameters = true;
         for (int i = 1; i < ac_; i++) {
+            const int first = i;
             SimpleString argument = av_[i];
 
             if (argument == "-h") {
@@ -95,8 +112,22 @@ namespace cpputest
                 crashOnFail_ = true;
             else if ((argument == "-e") || (argument == "-ci"))
                 rethrowExceptions_ = false;
+            else if (argument == "-nocache")
+                ignoringResultCache_ = true;
+            else if (argument == "-mergejunit")
+                correctParameters = setJUnitMergeFiles(ac_, av_, i);
+            else if (argument.startsWith("-convert"))
+                correctParameters = setBinaryLogToConvert(ac_, av_, i);
+            else if (argument.startsWith("-resume"))
+                correctParameters = setResumeJournalFile(ac_, av_, i);
+            else if (argument.startsWith("-journal"))
+                correctParameters = setJournalFile(ac_, av_, i);
+            else if (argument.startsWith("-cache"))
+                correctParameters = setResultCacheFile(ac_, av_, i);
             else if (argument.startsWith("-r"))
                 setRepeatCount(ac_, av_, i);
+            else if (argument.startsWith("-j"))
+                correctParameters = setWorkerCount(ac_, av_, i);
             else if (argument.startsWith("-g"))
                 addGroupFilter(ac_, av_, i);
             else if (argument.startsWith("-t"))
@@ -141,6 +172,8 @@ namespace cpputest
             if (correctParameters == false) {
                 return false;
             }
+            if (changesTestOutcome(argument))
+                addRunOptions(first, i);
         }
         return true;
     }
@@ -150,10 +183,13 @@ namespace cpputest
         return
             // clang-format off
             "use -h for more extensive help\n"
-            "usage [-h] [-v] [-vv] [-c] [-lg] [-ln] [-ll] [-ri] [-r[<#>]] [-f] [-e] [-ci]\n"
+            "usage [-h] [-v] [-vv] [-c] [-lg] [-ln] [-ll] [-ri] [-r[<#>]] [-j <#>] [-f] [-e] [-ci]\n"
             "      [-g|sg|xg|xsg <groupName>]... [-n|sn|xn|xsn <testName>]... [-t|st|xt|xst <groupName>.<testName>]...\n"
             "      [-b] [-s [<seed>]] [\"[IGNORE_]TEST(<groupName>, <testName>)\"]...\n"
-            "      [-o{normal|eclipse|junit|teamcity}] [-k <packageName>]\n"
+            "      [-o{normal|eclipse|junit|junitsuites|teamcity|binary}] [-k <packageName>]\n"
+            "      [-mergejunit <mergedFile> <junitFile>...] [-convert <binaryLog>]\n"
+            "      [-journal <journalFile>] [-resume <journalFile>]\n"
+            "      [-cache <cacheFile>] [-nocache]\n"
             // clang-format on
             ;
     }
@@ -180,6 +216,8 @@ namespace cpputest
             "  -oeclipse         - equivalent to -onormal\n"
             "  -oteamcity        - output to xml files (as the name suggests, for TeamCity)\n"
             "  -ojunit           - output to JUnit ant plugin style xml files (for CI systems)\n"
+            "  -ojunitsuites     - output to a single JUnit xml file with one testsuite per group\n"
+            "  -obinary          - also write a compact binary result log (for fan-in and trend storage)\n"
             "  -k <packageName>  - add a package name in JUnit output (for classification in CI systems)\n"
             "\n"
             "\n"
@@ -203,9 +241,19 @@ namespace cpputest
             "Options that control how the tests are run:\n"
             "  -b                - run the tests backwards, reversing the normal way\n"
             "  -r[<#>]           - repeat the tests <#> times (or twice if <#> is not specified)\n"
+            "  -j <#>            - run <#> tests at the same time, each in a child process of its own\n"
             "  -f                - Cause the tests to crash on failure (to allow the test to be debugged if necessary)\n"
             "  -e                - do not rethrow unexpected exceptions on failure\n"
             "  -ci               - continuous integration mode (equivalent to -e)\n"
+            "  -journal <file>   - record every test start and end in a journal that survives crashes\n"
+            "  -resume <file>    - skip the tests up to and including the last test started in the journal\n"
+            "  -cache <file>     - skip the tests that passed before with the same binary and -r, -b, -f, -e and -p options, and record the passes\n"
+            "  -nocache          - run all tests even though -cache is given, still recording the passes\n"
+            "\n"
+            "Options that do not run tests but process results:\n"
+            "  -mergejunit <mergedFile> <junitFile>...\n"
+            "                    - combine the testsuites of several JUnit xml files into one file\n"
+            "  -convert <log>    - replay a binary result log through the output selected with -o\n"
             // clang-format off
         ;
     }
@@ -255,6 +303,11 @@ namespace cpputest
         return repeat_;
     }
 
+    size_t CommandLineArguments::getWorkerCount() const
+    {
+        return workers_;
+    }
+
     bool CommandLineArguments::isReversing() const
     {
         return reversing_;
@@ -298,6 +351,14 @@ namespace cpputest
             repeat_ = 2;
     }
 
+    bool
+    CommandLineArguments::setWorkerCount(int ac, const char* const* av, int& i)
+    {
+        SimpleString workers = getParameterField(ac, av, i, "-j");
+        workers_ = SimpleString::AtoU(workers.asCharString());
+        return workers_ > 0;
+    }
+
     SimpleString CommandLineArguments::getParameterField(
         int ac, const char* const* av, int& i, const SimpleString& parameterName
     )
@@ -449,6 +510,60 @@ namespace cpputest
         packageName_ = packageName;
     }
 
+    bool CommandLineArguments::setJUnitMergeFiles(
+        int ac, const char* const* av, int& i
+    )
+    {
+        if (i + 2 >= ac)
+            return false;
+
+        junitMergeOutputFile_ = av[i + 1];
+        junitMergeInputFiles_ = av + i + 2;
+        junitMergeInputFileCount_ = static_cast<size_t>(ac - (i + 2));
+        i = ac;
+        return true;
+    }
+
+    bool CommandLineArguments::setBinaryLogToConvert(
+        int ac, const char* const* av, int& i
+    )
+    {
+        binaryLogFileName_ = getParameterField(ac, av, i, "-convert");
+        return !binaryLogFileName_.isEmpty();
+    }
+
+    bool
+    CommandLineArguments::setJournalFile(int ac, const char* const* av, int& i)
+    {
+        journalFileName_ = getParameterField(ac, av, i, "-journal");
+        return !journalFileName_.isEmpty();
+    }
+
+    bool CommandLineArguments::setResultCacheFile(
+        int ac, const char* const* av, int& i
+    )
+    {
+        resultCacheFileName_ = getParameterField(ac, av, i, "-cache");
+        return !resultCacheFileName_.isEmpty();
+    }
+
+    void CommandLineArguments::addRunOptions(int first, int last)
+    {
+        for (int i = first; i <= last && i < ac_; i++) {
+            if (!runOptions_.isEmpty())
+                runOptions_ += " ";
+            runOptions_ += av_[i];
+        }
+    }
+
+    bool CommandLineArguments::setResumeJournalFile(
+        int ac, const char* const* av, int& i
+    )
+    {
+        resumeJournalFileName_ = getParameterField(ac, av, i, "-resume");
+        return !resumeJournalFileName_.isEmpty();
+    }
+
     bool
     CommandLineArguments::setOutputType(int ac, const char* const* av, int& i)
     {
@@ -464,10 +579,18 @@ namespace cpputest
             outputType_ = OUTPUT_JUNIT;
             return true;
         }
+        if (outputType == "junitsuites") {
+            outputType_ = OUTPUT_JUNIT_SUITES;
+            return true;
+        }
         if (outputType == "teamcity") {
             outputType_ = OUTPUT_TEAMCITY;
             return true;
         }
+        if (outputType == "binary") {
+            outputType_ = OUTPUT_BINARY;
+            return true;
+        }
 
         return false;
     }
@@ -482,13 +605,78 @@ namespace cpputest
         return outputType_ == OUTPUT_JUNIT;
     }
 
+    bool CommandLineArguments::isJUnitSuitesOutput() const
+    {
+        return outputType_ == OUTPUT_JUNIT_SUITES;
+    }
+
     bool CommandLineArguments::isTeamCityOutput() const
     {
         return outputType_ == OUTPUT_TEAMCITY;
     }
 
+    bool CommandLineArguments::isBinaryOutput() const
+    {
+        return outputType_ == OUTPUT_BINARY;
+    }
+
     const SimpleString& CommandLineArguments::getPackageName() const
     {
         return packageName_;
     }
+
+    bool CommandLineArguments::isMergingJUnitFiles() const
+    {
+        return junitMergeInputFiles_ != nullptr;
+    }
+
+    const SimpleString& CommandLineArguments::getJUnitMergeOutputFile() const
+    {
+        return junitMergeOutputFile_;
+    }
+
+    const char* const* CommandLineArguments::getJUnitMergeInputFiles() const
+    {
+        return junitMergeInputFiles_;
+    }
+
+    size_t CommandLineArguments::getJUnitMergeInputFileCount() const
+    {
+        return junitMergeInputFileCount_;
+    }
+
+    bool CommandLineArguments::isConvertingBinaryLog() const
+    {
+        return !binaryLogFileName_.isEmpty();
+    }
+
+    const SimpleString& CommandLineArguments::getBinaryLogFileName() const
+    {
+        return binaryLogFileName_;
+    }
+
+    const SimpleString& CommandLineArguments::getJournalFileName() const
+    {
+        return journalFileName_;
+    }
+
+    const SimpleString& CommandLineArguments::getResumeJournalFileName() const
+    {
+        return resumeJournalFileName_;
+    }
+
+    const SimpleString& CommandLineArguments::getResultCacheFileName() const
+    {
+        return resultCacheFileName_;
+    }
+
+    bool CommandLineArguments::isIgnoringResultCache() const
+    {
+        return ignoringResultCache_;
+    }
+
+    const SimpleString& CommandLineArguments::getRunOptions() const
+    {
+        return runOptions_;
+    }
 }
@@ -26,13 +26,16 @@
  */
 
 #include "CppUTest/CommandLineTestRunner.hpp"
+#include "CppUTest/BinaryTestOutput.hpp"
 #include "CppUTest/JUnitTestOutput.hpp"
+#include "CppUTest/JournalTestOutput.hpp"
 #include "CppUTest/PlatformSpecificFunctions.hpp"
 #include "CppUTest/TeamCityTestOutput.hpp"
 #include "CppUTest/TestOutput.hpp"
 #include "CppUTest/TestPlugin.hpp"
 #include "CppUTest/TestRegistry.hpp"
 #include "CppUTest/TestResult.hpp"
+#include "CppUTest/TestResultCache.hpp"
 #include "CppUTest/Utest.hpp"
 
 namespace cpputest
@@ -103,6 +106,8 @@ namespace cpputest
             output_->color();
         if (arguments_->isRunIgnored())
             registry_->setRunIgnored();
+        if (arguments_->getWorkerCount() > 1)
+            registry_->setWorkerCount(arguments_->getWorkerCount());
         if (arguments_->isCrashingOnFail())
             UtestShell::setCrashOnFail();
 
@@ -111,6 +116,33 @@ namespace cpputest
 
     int CommandLineTestRunner::runAllTests()
     {
+        if (arguments_->isMergingJUnitFiles()) {
+            if (mergeJUnitFiles(
+                    arguments_->getJUnitMergeOutputFile(),
+                    arguments_->getJUnitMergeInputFiles(),
+                    arguments_->getJUnitMergeInputFileCount()
+                ))
+                return 0;
+            output_->print("Could not merge JUnit files into ");
+            output_->print(
+                arguments_->getJUnitMergeOutputFile().asCharString()
+            );
+            output_->print("\n");
+            return 1;
+        }
+
+        if (arguments_->isConvertingBinaryLog()) {
+            size_t failureCount = 0;
+            if (replayBinaryLog(
+                    arguments_->getBinaryLogFileName(), failureCount
+                ))
+                return static_cast<int>(failureCount);
+            output_->print("Could not read binary test log ");
+            output_->print(arguments_->getBinaryLogFileName().asCharString());
+            output_->print("\n");
+            return static_cast<int>(failureCount != 0 ? failureCount : 1);
+        }
+
         initializeTestRun();
         size_t loopCount = 0;
         size_t failedTestCount = 0;
@@ -138,6 +170,21 @@ namespace cpputest
         if (arguments_->isReversing())
             registry_->reverseTests();
 
+        if (!arguments_->getResumeJournalFileName().isEmpty())
+            resumeFromJournal(arguments_->getResumeJournalFileName());
+
+        TestResultCache* resultCache = nullptr;
+        if (!arguments_->getResultCacheFileName().isEmpty()) {
+            resultCache = new TestResultCache(
+                arguments_->getResultCacheFileName(),
+                arguments_->getRunOptions()
+            );
+            resultCache->load();
+            if (arguments_->isIgnoringResultCache())
+                resultCache->ignoreCachedResults();
+            registry_->setResultCache(resultCache);
+        }
+
         while (loopCount++ < repeatCount) {
 
             output_->printTestRun(loopCount, repeatCount);
@@ -148,11 +195,45 @@ namespace cpputest
                 failedExecutionCount++;
             }
         }
+
+        if (resultCache != nullptr) {
+            registry_->setResultCache(nullptr);
+            if (!resultCache->save()) {
+                output_->print("Could not write result cache ");
+                output_->print(
+                    arguments_->getResultCacheFileName().asCharString()
+                );
+                output_->print("\n");
+            }
+            delete resultCache;
+        }
         return static_cast<int>(
             failedTestCount != 0 ? failedTestCount : failedExecutionCount
         );
     }
 
+    void CommandLineTestRunner::resumeFromJournal(
+        const SimpleString& journalFileName
+    )
+    {
+        SimpleString group;
+        SimpleString name;
+        bool finished = false;
+        if (!findJournalResumePoint(journalFileName, group, name, finished)) {
+            output_->print("No test to resume after in ");
+            output_->print(journalFileName.asCharString());
+            output_->print(", running all tests\n");
+            return;
+        }
+
+        registry_->resumeAfterTest(group, name, finished);
+        SimpleString notice = StringFromFormat(
+            "Resuming after TEST(%s, %s)%s\n", group.asCharString(),
+            name.asCharString(), finished ? "" : ", which did not finish"
+        );
+        output_->print(notice.asCharString());
+    }
+
     TestOutput* CommandLineTestRunner::createTeamCityOutput()
     {
         return new TeamCityTestOutput;
@@ -168,6 +249,60 @@ namespace cpputest
         return junitOutput;
     }
 
+    TestOutput* CommandLineTestRunner::createJUnitSuitesOutput(
+        const SimpleString& packageName
+    )
+    {
+        JUnitTestOutput* junitOutput = new JUnitTestOutput;
+        junitOutput->setPackageName(packageName);
+        junitOutput->setSingleFileOutput(true);
+        return junitOutput;
+    }
+
+    bool CommandLineTestRunner::mergeJUnitFiles(
+        const SimpleString& outputFileName,
+        const char* const* inputFileNames,
+        size_t inputFileCount
+    )
+    {
+        return JUnitTestOutput::mergeFiles(
+            outputFileName, inputFileNames, inputFileCount
+        );
+    }
+
+    TestOutput*
+    CommandLineTestRunner::createBinaryOutput(const SimpleString& packageName)
+    {
+        BinaryTestOutput* binaryOutput = new BinaryTestOutput;
+        binaryOutput->setPackageName(packageName);
+        return binaryOutput;
+    }
+
+    bool CommandLineTestRunner::replayBinaryLog(
+        const SimpleString& logFileName, size_t& failureCount
+    )
+    {
+        return BinaryTestOutput::replay(logFileName, *output_, failureCount);
+    }
+
+    TestOutput*
+    CommandLineTestRunner::createJournalOutput(const SimpleString& fileName)
+    {
+        return new JournalTestOutput(fileName);
+    }
+
+    bool CommandLineTestRunner::findJournalResumePoint(
+        const SimpleString& journalFileName,
+        SimpleString& group,
+        SimpleString& name,
+        bool& finished
+    )
+    {
+        return JournalTestOutput::findLastStartedTest(
+            journalFileName, group, name, finished
+        );
+    }
+
     TestOutput* CommandLineTestRunner::createConsoleOutput()
     {
         return new ConsoleTestOutput;
@@ -194,14 +329,27 @@ namespace cpputest
             return false;
         }
 
-        if (arguments_->isJUnitOutput()) {
-            output_ = createJUnitOutput(arguments_->getPackageName());
+        if (arguments_->isJUnitOutput() || arguments_->isJUnitSuitesOutput()) {
+            if (arguments_->isJUnitSuitesOutput())
+                output_ = createJUnitSuitesOutput(arguments_->getPackageName());
+            else
+                output_ = createJUnitOutput(arguments_->getPackageName());
             if (arguments_->isVerbose() || arguments_->isVeryVerbose())
                 output_ = createCompositeOutput(output_, createConsoleOutput());
         } else if (arguments_->isTeamCityOutput()) {
             output_ = createTeamCityOutput();
+        } else if (arguments_->isBinaryOutput()) {
+            output_ = createCompositeOutput(
+                createConsoleOutput(),
+                createBinaryOutput(arguments_->getPackageName())
+            );
         } else
             output_ = createConsoleOutput();
+
+        if (!arguments_->getJournalFileName().isEmpty())
+            output_ = createCompositeOutput(
+                output_, createJournalOutput(arguments_->getJournalFileName())
+            );
         return true;
     }
 }
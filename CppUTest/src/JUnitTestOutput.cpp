@@ -32,6 +32,110 @@
 
 namespace cpputest
 {
+    static const size_t fileBufferFlushThreshold = 64 * 1024;
+    static const size_t mergeReadChunkSize = 16 * 1024;
+    static const size_t mergeLineHeadLength = 32;
+
+    struct JUnitOutputBuffer
+    {
+        JUnitOutputBuffer() : data_(nullptr), size_(0), capacity_(0) {}
+        ~JUnitOutputBuffer()
+        {
+            delete[] data_;
+        }
+
+        void reserve(size_t extra)
+        {
+            if (size_ + extra < capacity_)
+                return;
+
+            size_t newCapacity = (capacity_ == 0) ? 256 : capacity_;
+            while (newCapacity <= size_ + extra)
+                newCapacity *= 2;
+
+            char* newData = new char[newCapacity];
+            for (size_t i = 0; i < size_; i++)
+                newData[i] = data_[i];
+            newData[size_] = '\0';
+            delete[] data_;
+            data_ = newData;
+            capacity_ = newCapacity;
+        }
+
+        void append(const char* text, size_t length)
+        {
+            reserve(length);
+            for (size_t i = 0; i < length; i++)
+                data_[size_ + i] = text[i];
+            size_ += length;
+            data_[size_] = '\0';
+        }
+
+        void append(const char* text)
+        {
+            append(text, SimpleString::StrLen(text));
+        }
+
+        void appendXmlEncoded(const char* text)
+        {
+            const char* runStart = text;
+            const char* cur = text;
+            for (; *cur; cur++) {
+                const char* replacement = nullptr;
+                if (*cur == '&')
+                    replacement = "&amp;";
+                else if (*cur == '"')
+                    replacement = "&quot;";
+                else if (*cur == '<')
+                    replacement = "&lt;";
+                else if (*cur == '>')
+                    replacement = "&gt;";
+                else if (*cur == '\n')
+                    replacement = "{newline}";
+
+                if (replacement) {
+                    append(runStart, static_cast<size_t>(cur - runStart));
+                    append(replacement);
+                    runStart = cur + 1;
+                }
+            }
+            append(runStart, static_cast<size_t>(cur - runStart));
+        }
+
+        const char* asCharString() const
+        {
+            return (data_ == nullptr) ? "" : data_;
+        }
+
+        size_t size() const
+        {
+            return size_;
+        }
+
+        void clear()
+        {
+            size_ = 0;
+            if (data_)
+                data_[0] = '\0';
+        }
+
+        void flushTo(PlatformSpecificFile file)
+        {
+            if (size_ == 0)
+                return;
+            PlatformSpecificFPuts(data_, file);
+            clear();
+        }
+
+    private:
+        char* data_;
+        size_t size_;
+        size_t capacity_;
+
+        JUnitOutputBuffer(const JUnitOutputBuffer&);
+        JUnitOutputBuffer& operator=(const JUnitOutputBuffer&);
+    };
+
     struct JUnitTestCaseResultNode
     {
         JUnitTestCaseResultNode() :
@@ -39,8 +143,7 @@ namespace cpputest
             failure_(nullptr),
             ignored_(false),
             lineNumber_(0),
-            checkCount_(0),
-            next_(nullptr)
+            checkCount_(0)
         {
         }
 
@@ -51,7 +154,6 @@ namespace cpputest
         SimpleString file_;
         size_t lineNumber_;
         size_t checkCount_;
-        JUnitTestCaseResultNode* next_;
     };
 
     struct JUnitTestGroupResult
@@ -61,9 +163,7 @@ namespace cpputest
             failureCount_(0),
             totalCheckCount_(0),
             startTime_(0),
-            groupExecTime_(0),
-            head_(nullptr),
-            tail_(nullptr)
+            groupExecTime_(0)
         {
         }
 
@@ -73,16 +173,30 @@ namespace cpputest
         size_t startTime_;
         size_t groupExecTime_;
         SimpleString group_;
-        JUnitTestCaseResultNode* head_;
-        JUnitTestCaseResultNode* tail_;
+        JUnitTestCaseResultNode current_;
+        JUnitOutputBuffer testCases_;
     };
 
     struct JUnitTestOutputImpl
     {
+        JUnitTestOutputImpl() :
+            file_(nullptr),
+            singleFile_(false),
+            suitesFileOpen_(false),
+            lastRun_(true),
+            target_(&fileBuffer_)
+        {
+        }
+
         JUnitTestGroupResult results_;
         PlatformSpecificFile file_;
         SimpleString package_;
         SimpleString stdOutput_;
+        bool singleFile_;
+        bool suitesFileOpen_;
+        bool lastRun_;
+        JUnitOutputBuffer fileBuffer_;
+        JUnitOutputBuffer* target_;
     };
 
     JUnitTestOutput::JUnitTestOutput() : impl_(new JUnitTestOutputImpl) {}
@@ -98,18 +212,29 @@ namespace cpputest
         impl_->results_.testCount_ = 0;
         impl_->results_.failureCount_ = 0;
         impl_->results_.group_ = "";
-        JUnitTestCaseResultNode* cur = impl_->results_.head_;
-        while (cur) {
-            JUnitTestCaseResultNode* tmp = cur->next_;
-            delete cur->failure_;
-            delete cur;
-            cur = tmp;
-        }
-        impl_->results_.head_ = nullptr;
-        impl_->results_.tail_ = nullptr;
+        impl_->results_.testCases_.clear();
+        impl_->stdOutput_ = "";
+        delete impl_->results_.current_.failure_;
+        impl_->results_.current_.failure_ = nullptr;
     }
 
-    void JUnitTestOutput::printTestsStarted() {}
+    // The testsuites file stays open over the repetitions of a run, so
+    // that it holds the groups of every repetition.
+    void JUnitTestOutput::printTestsStarted()
+    {
+        if (!impl_->singleFile_ || impl_->suitesFileOpen_)
+            return;
+
+        openFileForWrite(createSuitesFileName());
+        impl_->suitesFileOpen_ = true;
+        writeXmlHeader();
+        writeToFile("<testsuites>\n");
+    }
+
+    void JUnitTestOutput::printTestRun(size_t number, size_t total)
+    {
+        impl_->lastRun_ = (number >= total);
+    }
 
     void JUnitTestOutput::printCurrentGroupStarted(const UtestShell& /*test*/)
     {
@@ -117,12 +242,27 @@ namespace cpputest
 
     void JUnitTestOutput::printCurrentTestEnded(const TestResult& result)
     {
-        impl_->results_.tail_->execTime_ =
-            result.getCurrentTestTotalExecutionTime();
-        impl_->results_.tail_->checkCount_ = result.getCheckCount();
+        JUnitTestCaseResultNode& current = impl_->results_.current_;
+        current.execTime_ = result.getCurrentTestTotalExecutionTime();
+        current.checkCount_ = result.getCheckCount();
+
+        impl_->target_ = &impl_->results_.testCases_;
+        writeTestCase(&current);
+        impl_->target_ = &impl_->fileBuffer_;
+
+        delete current.failure_;
+        current.failure_ = nullptr;
     }
 
-    void JUnitTestOutput::printTestsEnded(const TestResult& /*result*/) {}
+    void JUnitTestOutput::printTestsEnded(const TestResult& /*result*/)
+    {
+        if (!impl_->singleFile_ || !impl_->lastRun_)
+            return;
+
+        writeToFile("</testsuites>\n");
+        closeFile();
+        impl_->suitesFileOpen_ = false;
+    }
 
     void JUnitTestOutput::printCurrentGroupEnded(const TestResult& result)
     {
@@ -139,19 +279,13 @@ namespace cpputest
         impl_->results_.startTime_ =
             static_cast<size_t>(GetPlatformSpecificTimeInMillis());
 
-        if (impl_->results_.tail_ == nullptr) {
-            impl_->results_.head_ = impl_->results_.tail_ =
-                new JUnitTestCaseResultNode;
-        } else {
-            impl_->results_.tail_->next_ = new JUnitTestCaseResultNode;
-            impl_->results_.tail_ = impl_->results_.tail_->next_;
-        }
-        impl_->results_.tail_->name_ = test.getName();
-        impl_->results_.tail_->file_ = test.getFile();
-        impl_->results_.tail_->lineNumber_ = test.getLineNumber();
-        if (!test.willRun()) {
-            impl_->results_.tail_->ignored_ = true;
-        }
+        JUnitTestCaseResultNode& current = impl_->results_.current_;
+        current.name_ = test.getName();
+        current.file_ = test.getFile();
+        current.lineNumber_ = test.getLineNumber();
+        current.ignored_ = !test.willRun();
+        current.execTime_ = 0;
+        current.checkCount_ = 0;
     }
 
     SimpleString JUnitTestOutput::createFileName(const SimpleString& group)
@@ -165,6 +299,16 @@ namespace cpputest
         return encodeFileName(fileName) + ".xml";
     }
 
+    SimpleString JUnitTestOutput::createSuitesFileName()
+    {
+        SimpleString fileName = "cpputest";
+        if (!impl_->package_.isEmpty()) {
+            fileName += "_";
+            fileName += impl_->package_;
+        }
+        return encodeFileName(fileName) + ".xml";
+    }
+
     SimpleString JUnitTestOutput::encodeFileName(const SimpleString& fileName)
     {
         // special character list based on:
@@ -185,6 +329,11 @@ namespace cpputest
         }
     }
 
+    void JUnitTestOutput::setSingleFileOutput(bool singleFile)
+    {
+        impl_->singleFile_ = singleFile;
+    }
+
     void JUnitTestOutput::writeXmlHeader()
     {
         writeToFile("<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n");
@@ -213,46 +362,43 @@ namespace cpputest
 
     SimpleString JUnitTestOutput::encodeXmlText(const SimpleString& textbody)
     {
-        SimpleString buf = textbody.asCharString();
-        buf.replace("&", "&amp;");
-        buf.replace("\"", "&quot;");
-        buf.replace("<", "&lt;");
-        buf.replace(">", "&gt;");
-        buf.replace("\n", "{newline}");
-        return buf;
+        JUnitOutputBuffer encoded;
+        encoded.appendXmlEncoded(textbody.asCharString());
+        return encoded.asCharString();
     }
 
     void JUnitTestOutput::writeTestCases()
     {
-        JUnitTestCaseResultNode* cur = impl_->results_.head_;
-
-        while (cur) {
-            SimpleString buf = StringFromFormat(
-                "<testcase classname=\"%s%s%s\" name=\"%s\" assertions=\"%d\" "
-                "time=\"%d.%03d\" file=\"%s\" line=\"%d\">\n",
-                impl_->package_.asCharString(),
-                impl_->package_.isEmpty() ? "" : ".",
-                impl_->results_.group_.asCharString(),
-                cur->name_.asCharString(),
-                static_cast<int>(
-                    cur->checkCount_ - impl_->results_.totalCheckCount_
-                ),
-                static_cast<int>(cur->execTime_ / 1000),
-                static_cast<int>(cur->execTime_ % 1000),
-                cur->file_.asCharString(), static_cast<int>(cur->lineNumber_)
-            );
-            writeToFile(buf.asCharString());
-
-            impl_->results_.totalCheckCount_ = cur->checkCount_;
-
-            if (cur->failure_) {
-                writeFailure(cur);
-            } else if (cur->ignored_) {
-                writeToFile("<skipped />\n");
-            }
-            writeToFile("</testcase>\n");
-            cur = cur->next_;
+        JUnitOutputBuffer& testCases = impl_->results_.testCases_;
+        impl_->target_->append(testCases.asCharString(), testCases.size());
+        testCases.clear();
+    }
+
+    void JUnitTestOutput::writeTestCase(JUnitTestCaseResultNode* node)
+    {
+        SimpleString buf = StringFromFormat(
+            "<testcase classname=\"%s%s%s\" name=\"%s\" assertions=\"%d\" "
+            "time=\"%d.%03d\" file=\"%s\" line=\"%d\">\n",
+            impl_->package_.asCharString(),
+            impl_->package_.isEmpty() ? "" : ".",
+            impl_->results_.group_.asCharString(), node->name_.asCharString(),
+            static_cast<int>(
+                node->checkCount_ - impl_->results_.totalCheckCount_
+            ),
+            static_cast<int>(node->execTime_ / 1000),
+            static_cast<int>(node->execTime_ % 1000),
+            node->file_.asCharString(), static_cast<int>(node->lineNumber_)
+        );
+        writeToFile(buf.asCharString());
+
+        impl_->results_.totalCheckCount_ = node->checkCount_;
+
+        if (node->failure_) {
+            writeFailure(node);
+        } else if (node->ignored_) {
+            writeToFile("<skipped />\n");
         }
+        writeToFile("</testcase>\n");
     }
 
     void JUnitTestOutput::writeFailure(JUnitTestCaseResultNode* node)
@@ -278,13 +424,16 @@ namespace cpputest
 
     void JUnitTestOutput::writeTestGroupToFile()
     {
-        openFileForWrite(createFileName(impl_->results_.group_));
-        writeXmlHeader();
+        if (!impl_->singleFile_) {
+            openFileForWrite(createFileName(impl_->results_.group_));
+            writeXmlHeader();
+        }
         writeTestSuiteSummary();
         writeProperties();
         writeTestCases();
         writeFileEnding();
-        closeFile();
+        if (!impl_->singleFile_)
+            closeFile();
     }
 
     // LCOV_EXCL_START
@@ -306,9 +455,9 @@ namespace cpputest
 
     void JUnitTestOutput::printFailure(const TestFailure& failure)
     {
-        if (impl_->results_.tail_->failure_ == nullptr) {
+        if (impl_->results_.current_.failure_ == nullptr) {
             impl_->results_.failureCount_++;
-            impl_->results_.tail_->failure_ = new TestFailure(failure);
+            impl_->results_.current_.failure_ = new TestFailure(failure);
         }
     }
 
@@ -319,11 +468,111 @@ namespace cpputest
 
     void JUnitTestOutput::writeToFile(const SimpleString& buffer)
     {
-        PlatformSpecificFPuts(buffer.asCharString(), impl_->file_);
+        impl_->target_->append(buffer.asCharString(), buffer.size());
+        if (impl_->target_ == &impl_->fileBuffer_ &&
+            impl_->fileBuffer_.size() >= fileBufferFlushThreshold)
+            impl_->fileBuffer_.flushTo(impl_->file_);
     }
 
     void JUnitTestOutput::closeFile()
     {
+        impl_->fileBuffer_.flushTo(impl_->file_);
         PlatformSpecificFClose(impl_->file_);
     }
+
+    static bool isJUnitMergeEnvelope(const char* line)
+    {
+        while (*line == ' ' || *line == '\t')
+            line++;
+        return SimpleString::StrNCmp(line, "<?xml", 5) == 0 ||
+               SimpleString::StrNCmp(line, "<testsuites", 11) == 0 ||
+               SimpleString::StrNCmp(line, "</testsuites", 12) == 0;
+    }
+
+    static void mergeJUnitFile(
+        PlatformSpecificFile input,
+        PlatformSpecificFile output,
+        JUnitOutputBuffer& outputBuffer
+    )
+    {
+        char* chunk = new char[mergeReadChunkSize];
+        JUnitOutputBuffer lineHead;
+        bool decided = false;
+        bool dropping = false;
+
+        size_t length;
+        while ((length = PlatformSpecificFRead(
+                    chunk, mergeReadChunkSize, input
+                )) > 0) {
+            size_t pos = 0;
+            while (pos < length) {
+                if (decided) {
+                    size_t end = pos;
+                    while (end < length && chunk[end] != '\n')
+                        end++;
+                    bool endOfLine = end < length;
+                    if (endOfLine)
+                        end++;
+                    if (!dropping)
+                        outputBuffer.append(chunk + pos, end - pos);
+                    pos = end;
+                    if (endOfLine)
+                        decided = false;
+                    continue;
+                }
+
+                char ch = chunk[pos++];
+                lineHead.append(&ch, 1);
+                if (ch != '\n' && lineHead.size() < mergeLineHeadLength)
+                    continue;
+
+                dropping = isJUnitMergeEnvelope(lineHead.asCharString());
+                if (!dropping)
+                    outputBuffer.append(
+                        lineHead.asCharString(), lineHead.size()
+                    );
+                lineHead.clear();
+                decided = (ch != '\n');
+            }
+            if (outputBuffer.size() >= fileBufferFlushThreshold)
+                outputBuffer.flushTo(output);
+        }
+
+        if (!decided && !isJUnitMergeEnvelope(lineHead.asCharString()))
+            outputBuffer.append(lineHead.asCharString(), lineHead.size());
+        delete[] chunk;
+    }
+
+    bool JUnitTestOutput::mergeFiles(
+        const SimpleString& outputFileName,
+        const char* const* inputFileNames,
+        size_t inputFileCount
+    )
+    {
+        PlatformSpecificFile output =
+            PlatformSpecificFOpen(outputFileName.asCharString(), "w");
+        if (output == nullptr)
+            return false;
+
+        JUnitOutputBuffer outputBuffer;
+        outputBuffer.append("<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n");
+        outputBuffer.append("<testsuites>\n");
+
+        bool allInputsRead = true;
+        for (size_t i = 0; i < inputFileCount; i++) {
+            PlatformSpecificFile input =
+                PlatformSpecificFOpen(inputFileNames[i], "r");
+            if (input == nullptr) {
+                allInputsRead = false;
+                continue;
+            }
+            mergeJUnitFile(input, output, outputBuffer);
+            PlatformSpecificFClose(input);
+        }
+
+        outputBuffer.append("</testsuites>\n");
+        outputBuffer.flushTo(output);
+        PlatformSpecificFClose(output);
+        return allInputsRead;
+    }
 }
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/JournalTestOutput.hpp"
+#include "CppUTest/PlatformSpecificFunctions.h"
+#include "CppUTest/TestFailure.hpp"
+#include "CppUTest/TestResult.hpp"
+
+namespace cpputest
+{
+    // Record layout: the kind character, then the group, name and detail
+    // fields, each written as "<length>:<text>" after a space, and a
+    // newline so the journal stays readable with a pager. The lengths let
+    // a record hold names of any size and show where a torn record ends.
+    // Longer fields, such as the message of a failure that lists every
+    // expectation of a mock, are cut to the limit the reader accepts.
+    static const size_t journalFieldLimit = 65536;
+
+    static const char journalHeader = 'J';
+    static const char journalTestStarted = 'S';
+    static const char journalTestEnded = 'E';
+    static const char journalFailure = 'F';
+    static const char* const journalVersion = "CppUTest journal 2";
+
+    struct JournalTestOutputImpl
+    {
+        JournalTestOutputImpl(const SimpleString& fileName) :
+            fileName_(fileName),
+            file_(nullptr),
+            openFailed_(false)
+        {
+        }
+
+        SimpleString fileName_;
+        PlatformSpecificFile file_;
+        bool openFailed_;
+        SimpleString group_;
+        SimpleString name_;
+    };
+
+    JournalTestOutput::JournalTestOutput(const SimpleString& fileName) :
+        impl_(new JournalTestOutputImpl(fileName))
+    {
+    }
+
+    JournalTestOutput::~JournalTestOutput()
+    {
+        if (impl_->file_ != nullptr)
+            PlatformSpecificFClose(impl_->file_);
+        delete impl_;
+    }
+
+    static void
+    appendJournalField(SimpleString& record, const SimpleString& value)
+    {
+        if (value.size() > journalFieldLimit) {
+            appendJournalField(record, value.subString(0, journalFieldLimit));
+            return;
+        }
+        record += StringFromFormat(" %d:", static_cast<int>(value.size()));
+        record += value;
+    }
+
+    static void writeJournalRecord(
+        PlatformSpecificFile file,
+        char kind,
+        const SimpleString& group,
+        const SimpleString& name,
+        const SimpleString& detail
+    )
+    {
+        char kindText[2] = {kind, 0};
+        SimpleString record = kindText;
+        appendJournalField(record, group);
+        appendJournalField(record, name);
+        appendJournalField(record, detail);
+        record += "\n";
+
+        PlatformSpecificFWrite(record.asCharString(), record.size(), file);
+        PlatformSpecificFFlush(file);
+    }
+
+    void JournalTestOutput::writeRecord(
+        char kind,
+        const SimpleString& group,
+        const SimpleString& name,
+        const SimpleString& detail
+    )
+    {
+        printTestsStarted();
+        if (impl_->file_ != nullptr)
+            writeJournalRecord(impl_->file_, kind, group, name, detail);
+    }
+
+    void JournalTestOutput::printTestsStarted()
+    {
+        if (impl_->file_ != nullptr || impl_->openFailed_)
+            return;
+
+        impl_->file_ =
+            PlatformSpecificFOpen(impl_->fileName_.asCharString(), "wb");
+        impl_->openFailed_ = (impl_->file_ == nullptr);
+        if (impl_->file_ != nullptr)
+            writeJournalRecord(
+                impl_->file_, journalHeader, journalVersion, "", ""
+            );
+    }
+
+    void JournalTestOutput::printCurrentTestStarted(const UtestShell& test)
+    {
+        impl_->group_ = test.getGroup();
+        impl_->name_ = test.getName();
+        writeRecord(journalTestStarted, impl_->group_, impl_->name_, "");
+    }
+
+    void JournalTestOutput::printCurrentTestEnded(const TestResult& res)
+    {
+        writeRecord(
+            journalTestEnded, impl_->group_, impl_->name_,
+            StringFromFormat(
+                "%d ms",
+                static_cast<int>(res.getCurrentTestTotalExecutionTime())
+            )
+        );
+    }
+
+    void JournalTestOutput::printFailure(const TestFailure& failure)
+    {
+        writeRecord(
+            journalFailure, impl_->group_, impl_->name_,
+            StringFromFormat(
+                "%s:%d: %s", failure.getFileName().asCharString(),
+                static_cast<int>(failure.getFailureLineNumber()),
+                failure.getMessage().asCharString()
+            )
+        );
+    }
+
+    void JournalTestOutput::printBuffer(const char*) {}
+
+    void JournalTestOutput::flush() {}
+
+    class JournalReader
+    {
+    public:
+        explicit JournalReader(PlatformSpecificFile file) :
+            file_(file),
+            length_(0),
+            position_(0)
+        {
+        }
+
+        // Returns false at the end of the journal, or at a record that the
+        // crash cut short.
+        bool readRecord(
+            char& kind,
+            SimpleString& group,
+            SimpleString& name,
+            SimpleString& detail
+        )
+        {
+            char newline = 0;
+            return readByte(kind) && readField(group) && readField(name) &&
+                   readField(detail) && readByte(newline) && newline == '\n';
+        }
+
+    private:
+        bool readByte(char& byte)
+        {
+            if (position_ == length_) {
+                length_ =
+                    PlatformSpecificFRead(buffer_, sizeof(buffer_), file_);
+                position_ = 0;
+                if (length_ == 0)
+                    return false;
+            }
+            byte = buffer_[position_++];
+            return true;
+        }
+
+        bool readField(SimpleString& value)
+        {
+            char byte = 0;
+            if (!readByte(byte) || byte != ' ')
+                return false;
+
+            size_t length = 0;
+            while (readByte(byte) && byte >= '0' && byte <= '9') {
+                length = length * 10 + static_cast<size_t>(byte - '0');
+                if (length > journalFieldLimit)
+                    return false;
+            }
+            if (byte != ':')
+                return false;
+
+            char* text = new char[length + 1];
+            size_t read = 0;
+            while (read < length && readByte(text[read]))
+                read++;
+            text[read] = '\0';
+            value = text;
+            delete[] text;
+            return read == length;
+        }
+
+        PlatformSpecificFile file_;
+        char buffer_[4096];
+        size_t length_;
+        size_t position_;
+    };
+
+    bool JournalTestOutput::findLastStartedTest(
+        const SimpleString& fileName,
+        SimpleString& group,
+        SimpleString& name,
+        bool& finished
+    )
+    {
+        PlatformSpecificFile file =
+            PlatformSpecificFOpen(fileName.asCharString(), "rb");
+        if (file == nullptr)
+            return false;
+
+        JournalReader reader(file);
+        char kind = 0;
+        SimpleString recordGroup;
+        SimpleString recordName;
+        SimpleString detail;
+        bool found = false;
+        if (reader.readRecord(kind, recordGroup, recordName, detail) &&
+            kind == journalHeader && recordGroup == journalVersion) {
+            while (reader.readRecord(kind, recordGroup, recordName, detail)) {
+                if (kind == journalTestStarted) {
+                    group = recordGroup;
+                    name = recordName;
+                    finished = false;
+                    found = true;
+                } else if (kind == journalTestEnded && found &&
+                           recordGroup == group && recordName == name) {
+                    finished = true;
+                }
+            }
+        }
+        PlatformSpecificFClose(file);
+        return found;
+    }
+}
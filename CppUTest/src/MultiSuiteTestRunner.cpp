@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "CppUTest/MultiSuiteTestRunner.hpp"
+#include "CppUTest/CommandLineTestRunner.hpp"
+#include "CppUTest/TestRegistry.hpp"
+#include "CppUTest/TestServer.hpp"
+#include "CppUTest/Utest.hpp"
+
+namespace cpputest
+{
+    // The tests keep pointers into groupNames, so a suite owns the
+    // qualified names for as long as its library is loaded. The merged
+    // run relinks the tests, so a suite keeps its own list of them.
+    struct MultiSuiteTestRunner::Suite
+    {
+        Suite(const SimpleString& libraryPath) :
+            server(libraryPath),
+            amountOfTests(0),
+            tests(nullptr),
+            groupNames(nullptr),
+            next(nullptr)
+        {
+        }
+
+        ~Suite()
+        {
+            server.unload();
+            delete[] tests;
+            delete[] groupNames;
+        }
+
+        TestServer server;
+        size_t amountOfTests;
+        UtestShell** tests;
+        SimpleString* groupNames;
+        Suite* next;
+    };
+
+    int MultiSuiteTestRunner::RunAllSuites(int ac, const char* const* av)
+    {
+        int separator = 1;
+        while (separator < ac && SimpleString(av[separator]) != "--")
+            separator++;
+
+        ConsoleTestOutput output;
+        if (separator == 1) {
+            output.print("usage: ");
+            output.print((ac > 0) ? av[0] : "runner");
+            output.print(" <testLibrary>... [-- <test arguments>]\n");
+            return 1;
+        }
+
+        MultiSuiteTestRunner runner;
+        for (int i = 1; i < separator; i++) {
+            if (!runner.addSuite(av[i])) {
+                output.print("Could not load ");
+                output.print(av[i]);
+                output.print("\n");
+                return 1;
+            }
+        }
+
+        const char** arguments = new const char*[ac - separator + 1];
+        int amountOfArguments = 0;
+        arguments[amountOfArguments++] = av[0];
+        for (int i = separator + 1; i < ac; i++)
+            arguments[amountOfArguments++] = av[i];
+
+        int result = runner.runAllSuites(amountOfArguments, arguments);
+        delete[] arguments;
+        return result;
+    }
+
+    MultiSuiteTestRunner::MultiSuiteTestRunner() :
+        firstSuite_(nullptr),
+        lastSuite_(nullptr)
+    {
+    }
+
+    MultiSuiteTestRunner::~MultiSuiteTestRunner()
+    {
+        while (firstSuite_ != nullptr) {
+            Suite* next = firstSuite_->next;
+            delete firstSuite_;
+            firstSuite_ = next;
+        }
+    }
+
+    bool MultiSuiteTestRunner::addSuite(const SimpleString& libraryPath)
+    {
+        Suite* suite = new Suite(libraryPath);
+        if (!suite->server.load()) {
+            delete suite;
+            return false;
+        }
+
+        TestRegistry* registry = suite->server.getRegistry();
+        suite->amountOfTests = registry->countTests();
+        suite->tests = new UtestShell*[suite->amountOfTests];
+        suite->groupNames = new SimpleString[suite->amountOfTests];
+
+        SimpleString qualifier = suiteNameOf(libraryPath) + ".";
+        UtestShell* test = registry->getFirstTest();
+        for (size_t i = 0; i < suite->amountOfTests; i++) {
+            suite->tests[i] = test;
+            suite->groupNames[i] = qualifier + test->getGroup();
+            test->setGroupName(suite->groupNames[i].asCharString());
+            test = test->getNext();
+        }
+
+        if (lastSuite_ == nullptr)
+            firstSuite_ = suite;
+        else
+            lastSuite_->next = suite;
+        lastSuite_ = suite;
+        return true;
+    }
+
+    size_t MultiSuiteTestRunner::countSuites() const
+    {
+        size_t count = 0;
+        for (Suite* suite = firstSuite_; suite; suite = suite->next)
+            count++;
+        return count;
+    }
+
+    size_t MultiSuiteTestRunner::countTests() const
+    {
+        size_t count = 0;
+        for (Suite* suite = firstSuite_; suite; suite = suite->next)
+            count += suite->amountOfTests;
+        return count;
+    }
+
+    // A registry prepends what it is given, so the tests are added from
+    // the last one of the last suite on, which keeps the suites and the
+    // tests within each suite in their own order.
+    int MultiSuiteTestRunner::runAllSuites(int ac, const char* const* av)
+    {
+        UtestShell** tests = new UtestShell*[countTests()];
+        size_t amountOfTests = 0;
+        for (Suite* suite = firstSuite_; suite; suite = suite->next)
+            for (size_t i = 0; i < suite->amountOfTests; i++)
+                tests[amountOfTests++] = suite->tests[i];
+
+        TestRegistry registry;
+        while (amountOfTests > 0)
+            registry.addTest(tests[--amountOfTests]);
+        delete[] tests;
+
+        TestRegistry* previous = TestRegistry::getCurrentRegistry();
+        registry.setCurrentRegistry(&registry);
+        int result = runTests(ac, av, &registry);
+        registry.setCurrentRegistry(previous);
+        return result;
+    }
+
+    SimpleString MultiSuiteTestRunner::suiteNameOf(
+        const SimpleString& libraryPath
+    )
+    {
+        SimpleString name = libraryPath;
+        name.replace('\\', '/');
+        for (size_t slash = name.find('/'); slash != SimpleString::npos;
+             slash = name.find('/'))
+            name = name.subString(slash + 1);
+
+        if (name.startsWith("lib") && name.size() > 3)
+            name = name.subString(3);
+        size_t dot = name.find('.');
+        if (dot != SimpleString::npos && dot > 0)
+            name = name.subString(0, dot);
+        return name;
+    }
+
+    int MultiSuiteTestRunner::runTests(
+        int ac, const char* const* av, TestRegistry* registry
+    )
+    {
+        CommandLineTestRunner runner(ac, av, registry);
+        return runner.runAllTestsMain();
+    }
+}
@@ -31,6 +31,7 @@
 
 #include <limits.h>
 #include <math.h>
+#include <string.h>
 
 namespace cpputest
 {
@@ -176,6 +177,29 @@ namespace cpputest
         return 0;
     }
 
+    size_t SimpleString::FirstMismatch(const void* s1, const void* s2, size_t n)
+    {
+        const unsigned char* p1 = reinterpret_cast<const unsigned char*>(s1);
+        const unsigned char* p2 = reinterpret_cast<const unsigned char*>(s2);
+        size_t pos = 0;
+
+        // Compare a machine word at a time and only fall back to bytes
+        // for the word that differs and for the tail.
+        while (n - pos >= sizeof(unsigned long)) {
+            unsigned long word1;
+            unsigned long word2;
+            memcpy(&word1, p1 + pos, sizeof(word1));
+            memcpy(&word2, p2 + pos, sizeof(word2));
+            if (word1 != word2)
+                break;
+            pos += sizeof(unsigned long);
+        }
+
+        while (pos < n && p1[pos] == p2[pos])
+            pos++;
+        return pos;
+    }
+
     void SimpleString::deallocateInternalBuffer()
     {
         if (buffer_) {
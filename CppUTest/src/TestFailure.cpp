@@ -91,7 +91,7 @@ namespace cpputest
         lineNumber_(f.lineNumber_),
         testFileName_(f.testFileName_),
         testLineNumber_(f.testLineNumber_),
-        message_(f.message_)
+        message_(f.getMessage())
     {
     }
 
@@ -201,6 +201,341 @@ namespace cpputest
         return userMessage;
     }
 
+    // Inputs longer than the thresholds are only shown as an excerpt around
+    // the first difference, so the failure message does not grow with the
+    // size of the compared data.
+    static const size_t stringExcerptThreshold = 256;
+    static const size_t stringExcerptContext = 32;
+    static const size_t binaryExcerptThreshold = 128;
+    static const size_t binaryExcerptContext = 16;
+
+    // The line diff gives up once more than maxLineDiffCost lines would have
+    // to be inserted or deleted, and reports at most maxReportedLineDiffs.
+    static const long maxLineDiffCost = 64;
+    static const long maxReportedLineDiffs = 10;
+    static const size_t maxReportedLineLength = 60;
+
+    static size_t boundedStrLen(const char* str, size_t maxLength)
+    {
+        size_t length = 0;
+        while (length < maxLength && str[length])
+            length++;
+        return length;
+    }
+
+    static bool isLongString(const char* str)
+    {
+        return (str) && (boundedStrLen(str, stringExcerptThreshold + 1) >
+                         stringExcerptThreshold);
+    }
+
+    static SimpleString stringExcerpt(const char* str, size_t begin)
+    {
+        if (str == nullptr)
+            return "(null)";
+        size_t length = boundedStrLen(str + begin, 2 * stringExcerptContext);
+        SimpleString result = (begin > 0) ? "..." : "";
+        result +=
+            StringFromFormat("%.*s", static_cast<int>(length), str + begin)
+                .printable();
+        if (str[begin + length])
+            result += "...";
+        return result;
+    }
+
+    static SimpleString
+    binaryExcerpt(const unsigned char* value, size_t size, size_t begin)
+    {
+        if (value == nullptr)
+            return "(null)";
+        size_t amount = size - begin;
+        if (amount > 2 * binaryExcerptContext)
+            amount = 2 * binaryExcerptContext;
+        SimpleString result = (begin > 0) ? "... " : "";
+        result += StringFromBinary(value + begin, amount);
+        if (begin + amount < size)
+            result += " ...";
+        return result;
+    }
+
+    static bool charsEqual(char c1, char c2, bool ignoreCase)
+    {
+        if (ignoreCase)
+            return SimpleString::ToLower(c1) == SimpleString::ToLower(c2);
+        return c1 == c2;
+    }
+
+    static size_t firstStringMismatch(
+        const char* expected, const char* actual, bool ignoreCase
+    )
+    {
+        if (!ignoreCase) {
+            size_t expectedLength = SimpleString::StrLen(expected);
+            size_t actualLength = SimpleString::StrLen(actual);
+            return SimpleString::FirstMismatch(
+                expected, actual,
+                (expectedLength < actualLength) ? expectedLength : actualLength
+            );
+        }
+        size_t pos = 0;
+        while (expected[pos] && charsEqual(expected[pos], actual[pos], true))
+            pos++;
+        return pos;
+    }
+
+    SimpleString TestFailure::createStringExcerptDifferenceString(
+        const char* expected, const char* actual, bool ignoreCase
+    )
+    {
+        size_t failStart =
+            ((expected) && (actual))
+                ? firstStringMismatch(expected, actual, ignoreCase)
+                : 0;
+        size_t begin = (failStart > stringExcerptContext)
+                           ? failStart - stringExcerptContext
+                           : 0;
+
+        SimpleString expectedExcerpt = stringExcerpt(expected, begin);
+        SimpleString actualExcerpt = stringExcerpt(actual, begin);
+
+        SimpleString result =
+            createButWasString(expectedExcerpt, actualExcerpt);
+        if ((expected) && (actual)) {
+            size_t failStartPrintable = 0;
+            while (failStartPrintable < expectedExcerpt.size() &&
+                   failStartPrintable < actualExcerpt.size() &&
+                   charsEqual(
+                       expectedExcerpt.at(failStartPrintable),
+                       actualExcerpt.at(failStartPrintable), ignoreCase
+                   ))
+                failStartPrintable++;
+            result += createDifferenceAtPosString(
+                actualExcerpt, failStartPrintable, failStart
+            );
+            if (!ignoreCase)
+                result += createLineDiffString(expected, actual);
+        }
+        return result;
+    }
+
+    SimpleString TestFailure::createBinaryExcerptDifferenceString(
+        const unsigned char* expected, const unsigned char* actual, size_t size
+    )
+    {
+        size_t failStart =
+            ((expected) && (actual))
+                ? SimpleString::FirstMismatch(expected, actual, size)
+                : 0;
+        size_t begin = (failStart > binaryExcerptContext)
+                           ? failStart - binaryExcerptContext
+                           : 0;
+
+        SimpleString actualExcerpt = binaryExcerpt(actual, size, begin);
+
+        SimpleString result = createButWasString(
+            binaryExcerpt(expected, size, begin), actualExcerpt
+        );
+        if ((expected) && (actual)) {
+            size_t prefixLength = (begin > 0) ? 4 : 0;
+            result += createDifferenceAtPosString(
+                actualExcerpt, prefixLength + (failStart - begin) * 3 + 1,
+                failStart
+            );
+        }
+        return result;
+    }
+
+    struct TextLine
+    {
+        const char* text;
+        size_t length;
+    };
+
+    struct LineEdit
+    {
+        char sign;
+        size_t lineNumber;
+        const TextLine* line;
+    };
+
+    static size_t countLines(const char* str)
+    {
+        size_t count = 1;
+        for (; *str; str++)
+            if (*str == '\n')
+                count++;
+        return count;
+    }
+
+    static TextLine* splitLines(const char* str, size_t count)
+    {
+        TextLine* lines = new TextLine[count];
+        size_t current = 0;
+        lines[current].text = str;
+        for (const char* p = str;; p++) {
+            if (*p == '\n' || *p == '\0') {
+                lines[current].length =
+                    static_cast<size_t>(p - lines[current].text);
+                if (*p == '\0')
+                    break;
+                lines[++current].text = p + 1;
+            }
+        }
+        return lines;
+    }
+
+    static bool linesEqual(const TextLine& line1, const TextLine& line2)
+    {
+        return (line1.length == line2.length) &&
+               (SimpleString::FirstMismatch(
+                    line1.text, line2.text, line1.length
+                ) == line1.length);
+    }
+
+    static SimpleString lineExcerpt(const TextLine& line)
+    {
+        size_t length = (line.length > maxReportedLineLength)
+                            ? maxReportedLineLength
+                            : line.length;
+        SimpleString result =
+            StringFromFormat("%.*s", static_cast<int>(length), line.text)
+                .printable();
+        if (line.length > length)
+            result += "...";
+        return result;
+    }
+
+    // Myers' O(ND) shortest edit script, limited to maxLineDiffCost edits.
+    // Returns the number of edits written to edits, or -1 when the inputs
+    // differ by more lines than the limit.
+    static long findLineEdits(
+        const TextLine* expected,
+        long expectedCount,
+        const TextLine* actual,
+        long actualCount,
+        size_t firstLineNumber,
+        LineEdit* edits
+    )
+    {
+        const long offset = maxLineDiffCost + 1;
+        const long width = 2 * maxLineDiffCost + 3;
+        long* trace =
+            new long[static_cast<size_t>(width * (maxLineDiffCost + 1))];
+        long* v = new long[static_cast<size_t>(width)];
+        for (long i = 0; i < width; i++)
+            v[i] = 0;
+
+        long cost = -1;
+        for (long d = 0; d <= maxLineDiffCost && cost < 0; d++) {
+            for (long k = -d; k <= d; k += 2) {
+                long x = (k == -d || (k != d && v[offset + k - 1] <
+                                                    v[offset + k + 1]))
+                             ? v[offset + k + 1]
+                             : v[offset + k - 1] + 1;
+                long y = x - k;
+                while (x < expectedCount && y < actualCount &&
+                       linesEqual(expected[x], actual[y])) {
+                    x++;
+                    y++;
+                }
+                v[offset + k] = x;
+                if (x >= expectedCount && y >= actualCount) {
+                    cost = d;
+                    break;
+                }
+            }
+            for (long i = 0; i < width; i++)
+                trace[d * width + i] = v[i];
+        }
+
+        long x = expectedCount;
+        long y = actualCount;
+        for (long d = cost; d > 0; d--) {
+            const long* previous = trace + (d - 1) * width;
+            long k = x - y;
+            bool inserted =
+                (k == -d || (k != d && previous[offset + k - 1] <
+                                           previous[offset + k + 1]));
+            long previousK = inserted ? k + 1 : k - 1;
+            long previousX = previous[offset + previousK];
+            long previousY = previousX - previousK;
+
+            LineEdit& edit = edits[d - 1];
+            edit.sign = inserted ? '+' : '-';
+            edit.lineNumber =
+                firstLineNumber +
+                static_cast<size_t>(inserted ? previousY : previousX);
+            edit.line = inserted ? &actual[previousY] : &expected[previousX];
+
+            x = previousX;
+            y = previousY;
+        }
+
+        delete[] v;
+        delete[] trace;
+        return cost;
+    }
+
+    SimpleString
+    TestFailure::createLineDiffString(const char* expected, const char* actual)
+    {
+        size_t expectedCount = countLines(expected);
+        size_t actualCount = countLines(actual);
+        if (expectedCount == 1 && actualCount == 1)
+            return "";
+
+        TextLine* expectedLines = splitLines(expected, expectedCount);
+        TextLine* actualLines = splitLines(actual, actualCount);
+
+        size_t prefix = 0;
+        while (prefix < expectedCount && prefix < actualCount &&
+               linesEqual(expectedLines[prefix], actualLines[prefix]))
+            prefix++;
+        size_t suffix = 0;
+        while (suffix < expectedCount - prefix &&
+               suffix < actualCount - prefix &&
+               linesEqual(
+                   expectedLines[expectedCount - 1 - suffix],
+                   actualLines[actualCount - 1 - suffix]
+               ))
+            suffix++;
+
+        LineEdit* edits = new LineEdit[maxLineDiffCost];
+        long cost = findLineEdits(
+            expectedLines + prefix,
+            static_cast<long>(expectedCount - prefix - suffix),
+            actualLines + prefix,
+            static_cast<long>(actualCount - prefix - suffix), prefix + 1, edits
+        );
+
+        SimpleString result;
+        if (cost < 0) {
+            result = StringFromFormat(
+                "\n\tline diff skipped: more than %ld lines differ",
+                maxLineDiffCost
+            );
+        } else if (cost > 0) {
+            result = "\n\tline diff (- expected, + actual):";
+            for (long i = 0; i < cost && i < maxReportedLineDiffs; i++) {
+                result += StringFromFormat(
+                    "\n\t%c %lu: <%s>", edits[i].sign,
+                    static_cast<unsigned long>(edits[i].lineNumber),
+                    lineExcerpt(*edits[i].line).asCharString()
+                );
+            }
+            if (cost > maxReportedLineDiffs)
+                result += StringFromFormat(
+                    "\n\t... %ld more differing lines",
+                    cost - maxReportedLineDiffs
+                );
+        }
+
+        delete[] edits;
+        delete[] actualLines;
+        delete[] expectedLines;
+        return result;
+    }
+
     EqualsFailure::EqualsFailure(
         UtestShell* test,
         const char* fileName,
@@ -256,6 +591,121 @@ namespace cpputest
             message_ += "\n\tCannot make comparisons with Nan";
     }
 
+    // Array failures list this many mismatching elements, then only count.
+    static const size_t maxReportedArrayMismatches = 5;
+
+    static SimpleString arrayOrNull(const void* array)
+    {
+        return (array) ? HexStringFrom(array) : StringFrom("(null)");
+    }
+
+    DoublesArrayEqualFailure::DoublesArrayEqualFailure(
+        UtestShell* test,
+        const char* fileName,
+        size_t lineNumber,
+        const double* expected,
+        const double* actual,
+        size_t count,
+        const DoublesTolerance& tolerance,
+        const SimpleString& text
+    ) :
+        TestFailure(test, fileName, lineNumber)
+    {
+        message_ = createUserText(text);
+
+        if ((expected == nullptr) || (actual == nullptr)) {
+            message_ +=
+                createButWasString(arrayOrNull(expected), arrayOrNull(actual));
+            return;
+        }
+
+        SimpleString details;
+        size_t mismatches = 0;
+        double maxError = 0.0;
+        for (size_t i = 0; i < count; i++) {
+            if (tolerance.matches(expected[i], actual[i]))
+                continue;
+            if (mismatches < maxReportedArrayMismatches)
+                details += StringFromFormat(
+                    "\n\tindex %lu: expected <%s> but was <%s>",
+                    static_cast<unsigned long>(i),
+                    StringFrom(expected[i], 7).asCharString(),
+                    StringFrom(actual[i], 7).asCharString()
+                );
+            double error = fabs(expected[i] - actual[i]);
+            if (error > maxError)
+                maxError = error;
+            mismatches++;
+        }
+
+        message_ += StringFromFormat(
+            "expected <%lu> elements to be equal within %s\n"
+            "\tbut <%lu> differ, max absolute error <%s>",
+            static_cast<unsigned long>(count),
+            tolerance.toString().asCharString(),
+            static_cast<unsigned long>(mismatches),
+            StringFrom(maxError, 7).asCharString()
+        );
+        message_ += details;
+        if (mismatches > maxReportedArrayMismatches)
+            message_ += "\n\t...";
+    }
+
+    LongsArrayEqualFailure::LongsArrayEqualFailure(
+        UtestShell* test,
+        const char* fileName,
+        size_t lineNumber,
+        const long* expected,
+        const long* actual,
+        size_t count,
+        const SimpleString& text
+    ) :
+        TestFailure(test, fileName, lineNumber)
+    {
+        message_ = createUserText(text);
+
+        if ((expected == nullptr) || (actual == nullptr)) {
+            message_ +=
+                createButWasString(arrayOrNull(expected), arrayOrNull(actual));
+            return;
+        }
+
+        SimpleString details;
+        size_t mismatches = 0;
+        unsigned long maxError = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (expected[i] == actual[i])
+                continue;
+            if (mismatches < maxReportedArrayMismatches)
+                details += StringFromFormat(
+                    "\n\tindex %lu: expected <%ld %s> but was <%ld %s>",
+                    static_cast<unsigned long>(i), expected[i],
+                    BracketsFormattedHexStringFrom(expected[i]).asCharString(),
+                    actual[i],
+                    BracketsFormattedHexStringFrom(actual[i]).asCharString()
+                );
+            unsigned long error =
+                (expected[i] > actual[i])
+                    ? static_cast<unsigned long>(expected[i]) -
+                          static_cast<unsigned long>(actual[i])
+                    : static_cast<unsigned long>(actual[i]) -
+                          static_cast<unsigned long>(expected[i]);
+            if (error > maxError)
+                maxError = error;
+            mismatches++;
+        }
+
+        message_ += StringFromFormat(
+            "expected <%lu> elements to be equal\n"
+            "\tbut <%lu> differ, max absolute difference <%lu>",
+            static_cast<unsigned long>(count),
+            static_cast<unsigned long>(mismatches), maxError
+        );
+        message_ += details;
+        if (mismatches > maxReportedArrayMismatches)
+            message_ += "\n\t...";
+    }
+
     CheckEqualFailure::CheckEqualFailure(
         UtestShell* test,
         const char* fileName,
@@ -486,6 +936,12 @@ namespace cpputest
     {
         message_ = createUserText(text);
 
+        if (isLongString(expected) || isLongString(actual)) {
+            message_ +=
+                createStringExcerptDifferenceString(expected, actual, false);
+            return;
+        }
+
         SimpleString printableExpected = PrintableStringFromOrNull(expected);
         SimpleString printableActual = PrintableStringFromOrNull(actual);
 
@@ -519,6 +975,12 @@ namespace cpputest
     {
         message_ = createUserText(text);
 
+        if (isLongString(expected) || isLongString(actual)) {
+            message_ +=
+                createStringExcerptDifferenceString(expected, actual, true);
+            return;
+        }
+
         SimpleString printableExpected = PrintableStringFromOrNull(expected);
         SimpleString printableActual = PrintableStringFromOrNull(actual);
 
@@ -556,6 +1018,12 @@ namespace cpputest
     {
         message_ = createUserText(text);
 
+        if (size > binaryExcerptThreshold) {
+            message_ +=
+                createBinaryExcerptDifferenceString(expected, actual, size);
+            return;
+        }
+
         SimpleString actualHex = StringFromBinaryOrNull(actual, size);
 
         message_ += createButWasString(
@@ -172,6 +172,14 @@ namespace cpputest
         print(" ignored, ");
         print(result.getFilteredOutCount());
         print(" filtered out, ");
+        if (result.getCachedCount() > 0) {
+            print(result.getCachedCount());
+            print(" cached, ");
+        }
+        if (result.getSkippedCount() > 0) {
+            print(result.getSkippedCount());
+            print(" skipped, ");
+        }
         print(result.getTotalExecutionTime());
         print(" ms)");
         if (color_) {
@@ -338,6 +346,14 @@ namespace cpputest
             outputTwo_->printTestsEnded(result);
     }
 
+    void CompositeTestOutput::printTestRun(size_t number, size_t total)
+    {
+        if (outputOne_)
+            outputOne_->printTestRun(number, total);
+        if (outputTwo_)
+            outputTwo_->printTestRun(number, total);
+    }
+
     void CompositeTestOutput::printCurrentTestStarted(const UtestShell& test)
     {
         if (outputOne_)
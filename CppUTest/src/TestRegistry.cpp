@@ -27,8 +27,10 @@
 
 #include "CppUTest/TestRegistry.hpp"
 #include "CppUTest/PlatformSpecificFunctions.hpp"
+#include "CppUTest/TestFailure.hpp"
 #include "CppUTest/TestPlugin.hpp"
 #include "CppUTest/TestResult.hpp"
+#include "CppUTest/TestResultCache.hpp"
 #include "CppUTest/Utest.hpp"
 
 namespace cpputest
@@ -40,7 +42,13 @@ namespace cpputest
         firstPlugin_(NullTestPlugin::instance()),
         runInSeperateProcess_(false),
         currentRepetition_(0),
-        runIgnored_(false)
+        runIgnored_(false),
+        resumeAfterFinished_(true),
+        resultCache_(nullptr),
+        workers_(1),
+        firstPendingStep_(nullptr),
+        lastPendingStep_(nullptr),
+        runningChildren_(0)
     {
     }
 
@@ -51,9 +59,52 @@ namespace cpputest
         tests_ = test->addTest(tests_);
     }
 
+    /*
+     * With more than one worker, tests are started in child processes as
+     * soon as they are reached, and everything the run reports is queued
+     * as steps. A step is reported once the steps before it are, so the
+     * output is the same as that of a run in test order. The group hooks
+     * run in this process, and their failures must be reported in order,
+     * so the queue is emptied before the hooks of a group that has any.
+     */
+    struct TestRegistry::PendingStep
+    {
+        enum Kind
+        {
+            groupStarted,
+            groupEnded,
+            cachedPass,
+            test
+        };
+
+        PendingStep(Kind stepKind, UtestShell* stepTest) :
+            kind(stepKind),
+            shell(stepTest),
+            child(nullptr),
+            running(false),
+            notRun(false),
+            next(nullptr)
+        {
+        }
+
+        Kind kind;
+        UtestShell* shell;
+        // Started when the step was queued, or nullptr to run the test
+        // when the step is reported.
+        UtestChildProcess* child;
+        // Whether the child still counts against the workers.
+        bool running;
+        bool notRun;
+        PendingStep* next;
+    };
+
     void TestRegistry::runAllTests(TestResult& result)
     {
         bool groupStart = true;
+        UtestShell* groupFixture = nullptr;
+        bool groupSetupFailed = false;
+        bool resumePointFinished = true;
+        UtestShell* resumePoint = findResumePoint(resumePointFinished);
 
         result.testsStarted();
         for (UtestShell* test = tests_; test != nullptr;
@@ -64,22 +115,59 @@ namespace cpputest
                 test->setRunIgnored();
 
             if (groupStart) {
-                result.currentGroupStarted(test);
+                schedule(
+                    new PendingStep(PendingStep::groupStarted, test), result
+                );
                 groupStart = false;
             }
 
             result.countTest();
-            if (testShouldRun(test, result)) {
-                result.currentTestStarted(test);
-                test->runOneTest(firstPlugin_, result);
-                result.currentTestEnded(test);
+            if (resumePoint != nullptr) {
+                if (test == resumePoint && !resumePointFinished)
+                    reportCrashedTest(test, result);
+                else
+                    result.countSkipped();
+                if (test == resumePoint)
+                    resumePoint = nullptr;
+            } else if (testShouldRun(test, result)) {
+                if (isCachedPass(test)) {
+                    schedule(
+                        new PendingStep(PendingStep::cachedPass, test), result
+                    );
+                } else {
+                    // The group fixture is only set up when one of its
+                    // tests will actually run.
+                    bool setUpGroup =
+                        groupFixture == nullptr && test->willRun();
+                    if (setUpGroup)
+                        groupFixture = test;
+                    if (workers_ > 1 &&
+                        !(setUpGroup && test->hasGroupFixture())) {
+                        if (setUpGroup)
+                            groupSetupFailed = !test->runGroupSetupOnce(result);
+                        startTest(test, result, groupSetupFailed);
+                    } else {
+                        reportPendingSteps(result);
+                        runTest(test, result, setUpGroup, groupSetupFailed);
+                    }
+                }
             }
 
             if (endOfGroup(test)) {
+                if (groupFixture != nullptr) {
+                    if (groupFixture->hasGroupFixture())
+                        reportPendingSteps(result);
+                    groupFixture->runGroupTeardownOnce(result);
+                    groupFixture = nullptr;
+                    groupSetupFailed = false;
+                }
                 groupStart = true;
-                result.currentGroupEnded(test);
+                schedule(
+                    new PendingStep(PendingStep::groupEnded, test), result
+                );
             }
         }
+        reportPendingSteps(result);
         result.testsEnded();
         currentRepetition_++;
     }
@@ -206,11 +294,217 @@ namespace cpputest
         runIgnored_ = true;
     }
 
+    void TestRegistry::resumeAfterTest(
+        const SimpleString& group, const SimpleString& name, bool finished
+    )
+    {
+        resumeAfterGroup_ = group;
+        resumeAfterName_ = name;
+        resumeAfterFinished_ = finished;
+    }
+
+    void TestRegistry::setResultCache(TestResultCache* cache)
+    {
+        resultCache_ = cache;
+    }
+
+    // Ignored tests are not run either way, so they are never cached.
+    bool TestRegistry::isCachedPass(UtestShell* test)
+    {
+        return resultCache_ != nullptr && test->willRun() &&
+               resultCache_->hasPassed(*test);
+    }
+
+    static TestFailure notRunFailure(UtestShell* test)
+    {
+        return TestFailure(
+            test, "Not run: TEST_GROUP_SETUP_ONCE of this group failed"
+        );
+    }
+
+    /*
+     * The group setup runs within the first test of the group, so that a
+     * failure in it is reported against that test. The tests of a group
+     * whose setup failed are not run. Each of them fails instead, so that
+     * neither the output nor the result cache shows it as passed.
+     */
+    void TestRegistry::runTest(
+        UtestShell* test,
+        TestResult& result,
+        bool setUpGroup,
+        bool& groupSetupFailed
+    )
+    {
+        size_t failureCount = result.getFailureCount();
+        result.currentTestStarted(test);
+        if (setUpGroup)
+            groupSetupFailed = !test->runGroupSetupOnce(result);
+        else if (groupSetupFailed && test->willRun())
+            result.addFailure(notRunFailure(test));
+        if (!groupSetupFailed || !test->willRun())
+            test->runOneTest(firstPlugin_, result);
+        result.currentTestEnded(test);
+        recordResult(test, result, failureCount);
+    }
+
+    // Starts the test in a child process, once a worker is free. Workers
+    // are freed by whichever child exits first, not in test order.
+    void TestRegistry::startTest(
+        UtestShell* test, TestResult& result, bool groupSetupFailed
+    )
+    {
+        PendingStep* step = new PendingStep(PendingStep::test, test);
+        if (groupSetupFailed && test->willRun())
+            step->notRun = true;
+        else if (test->willRun()) {
+            while (runningChildren_ >= workers_)
+                waitForWorker(result);
+            step->child = test->startInChildProcess(firstPlugin_);
+            if (step->child != nullptr) {
+                step->running = true;
+                runningChildren_++;
+            }
+        }
+        schedule(step, result);
+    }
+
+    void TestRegistry::recordResult(
+        UtestShell* test, TestResult& result, size_t failureCount
+    )
+    {
+        if (resultCache_ == nullptr || !test->willRun())
+            return;
+        if (result.getFailureCount() == failureCount)
+            resultCache_->recordPass(*test);
+        else
+            resultCache_->recordFailure(*test);
+    }
+
+    void TestRegistry::schedule(PendingStep* step, TestResult& result)
+    {
+        if (lastPendingStep_ == nullptr)
+            firstPendingStep_ = step;
+        else
+            lastPendingStep_->next = step;
+        lastPendingStep_ = step;
+        if (workers_ <= 1)
+            reportPendingSteps(result);
+    }
+
+    void TestRegistry::report(PendingStep* step, TestResult& result)
+    {
+        UtestShell* test = step->shell;
+        if (step->kind == PendingStep::groupStarted)
+            result.currentGroupStarted(test);
+        else if (step->kind == PendingStep::groupEnded)
+            result.currentGroupEnded(test);
+        else if (step->kind == PendingStep::cachedPass) {
+            result.currentTestStarted(test);
+            result.countCached();
+            result.currentTestEnded(test);
+        } else {
+            size_t failureCount = result.getFailureCount();
+            result.currentTestStarted(test);
+            if (step->notRun)
+                result.addFailure(notRunFailure(test));
+            else if (step->child != nullptr) {
+                if (step->running)
+                    runningChildren_--;
+                result.countRun();
+                test->finishInChildProcess(step->child, result);
+            } else
+                test->runOneTest(firstPlugin_, result);
+            result.currentTestEnded(test);
+            recordResult(test, result, failureCount);
+        }
+    }
+
+    // Falls back to reporting steps in order when the platform cannot
+    // wait for any child.
+    void TestRegistry::waitForWorker(TestResult& result)
+    {
+        UtestChildProcess** children = new UtestChildProcess*[workers_];
+        size_t count = 0;
+        for (PendingStep* step = firstPendingStep_; step != nullptr;
+             step = step->next) {
+            if (step->running)
+                children[count++] = step->child;
+        }
+        UtestChildProcess* exited =
+            UtestShell::waitForAnyChildProcess(children, count);
+        delete[] children;
+
+        if (exited == nullptr) {
+            reportFirstStep(result);
+            return;
+        }
+        for (PendingStep* step = firstPendingStep_; step != nullptr;
+             step = step->next) {
+            if (step->child == exited) {
+                step->running = false;
+                runningChildren_--;
+            }
+        }
+    }
+
+    void TestRegistry::reportFirstStep(TestResult& result)
+    {
+        PendingStep* step = firstPendingStep_;
+        firstPendingStep_ = step->next;
+        if (firstPendingStep_ == nullptr)
+            lastPendingStep_ = nullptr;
+        report(step, result);
+        delete step;
+    }
+
+    void TestRegistry::reportPendingSteps(TestResult& result)
+    {
+        while (firstPendingStep_ != nullptr)
+            reportFirstStep(result);
+    }
+
+    // The test that was running when the journal ended took the process
+    // down with it. It is reported like any failed test, so that every
+    // output, JUnit and binary logs included, lists it.
+    void TestRegistry::reportCrashedTest(UtestShell* test, TestResult& result)
+    {
+        reportPendingSteps(result);
+        result.currentTestStarted(test);
+        result.addFailure(TestFailure(
+            test, "Crashed: the run that wrote the resumed journal ended here"
+        ));
+        result.currentTestEnded(test);
+    }
+
+    UtestShell* TestRegistry::findResumePoint(bool& finished)
+    {
+        UtestShell* resumePoint = nullptr;
+        if (!resumeAfterName_.isEmpty()) {
+            for (UtestShell* test = tests_;
+                 test != nullptr && resumePoint == nullptr;
+                 test = test->getNext()) {
+                if (test->getGroup() == resumeAfterGroup_ &&
+                    test->getName() == resumeAfterName_)
+                    resumePoint = test;
+            }
+        }
+        finished = resumeAfterFinished_;
+        resumeAfterGroup_ = "";
+        resumeAfterName_ = "";
+        resumeAfterFinished_ = true;
+        return resumePoint;
+    }
+
     void TestRegistry::setRunTestsInSeperateProcess()
     {
         runInSeperateProcess_ = true;
     }
 
+    void TestRegistry::setWorkerCount(size_t workers)
+    {
+        workers_ = workers;
+    }
+
     int TestRegistry::getCurrentRepetition()
     {
         return currentRepetition_;
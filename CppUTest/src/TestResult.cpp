@@ -40,6 +40,8 @@ namespace cpputest
         failureCount_(0),
         filteredOutCount_(0),
         ignoredCount_(0),
+        cachedCount_(0),
+        skippedCount_(0),
         totalExecutionTime_(0),
         timeStarted_(0),
         currentTestTimeStarted_(0),
@@ -112,6 +114,11 @@ namespace cpputest
         checkCount_++;
     }
 
+    void TestResult::addChecks(size_t amount)
+    {
+        checkCount_ += amount;
+    }
+
     void TestResult::countFilteredOut()
     {
         filteredOutCount_++;
@@ -122,6 +129,16 @@ namespace cpputest
         ignoredCount_++;
     }
 
+    void TestResult::countCached()
+    {
+        cachedCount_++;
+    }
+
+    void TestResult::countSkipped()
+    {
+        skippedCount_++;
+    }
+
     void TestResult::testsStarted()
     {
         timeStarted_ = static_cast<size_t>(GetPlatformSpecificTimeInMillis());
@@ -151,8 +168,18 @@ namespace cpputest
         return currentTestTotalExecutionTime_;
     }
 
+    void TestResult::setCurrentTestTotalExecutionTime(size_t exTime)
+    {
+        currentTestTotalExecutionTime_ = exTime;
+    }
+
     size_t TestResult::getCurrentGroupTotalExecutionTime() const
     {
         return currentGroupTotalExecutionTime_;
     }
+
+    void TestResult::setCurrentGroupTotalExecutionTime(size_t exTime)
+    {
+        currentGroupTotalExecutionTime_ = exTime;
+    }
 }
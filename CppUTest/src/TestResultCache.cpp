@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "CppUTest/TestResultCache.hpp"
+#include "CppUTest/PlatformSpecificFunctions.h"
+#include "CppUTest/Utest.hpp"
+
+namespace cpputest
+{
+    static const size_t resultCacheBucketCount = 4096;
+    static const char* const resultCacheVersion = "CppUTest result cache 1";
+
+    // The cached digest comes from the file and decides whether a test
+    // may be skipped; the recorded one is what the next run gets to see.
+    struct TestResultCacheEntry
+    {
+        TestResultCacheEntry(
+            unsigned long long key, TestResultCacheEntry* next
+        ) :
+            key_(key),
+            hasCachedDigest_(false),
+            cachedDigest_(0),
+            hasRecordedDigest_(false),
+            recordedDigest_(0),
+            next_(next)
+        {
+        }
+
+        unsigned long long key_;
+        bool hasCachedDigest_;
+        unsigned long long cachedDigest_;
+        bool hasRecordedDigest_;
+        unsigned long long recordedDigest_;
+        SimpleString testName_;
+        TestResultCacheEntry* next_;
+    };
+
+    // Most tests of a run live in the same binary, so every binary is only
+    // read once.
+    struct TestResultCacheLibrary
+    {
+        TestResultCacheLibrary(
+            const SimpleString& path, TestResultCacheLibrary* next
+        ) :
+            path_(path),
+            readable_(false),
+            digest_(0),
+            next_(next)
+        {
+        }
+
+        SimpleString path_;
+        bool readable_;
+        unsigned long long digest_;
+        TestResultCacheLibrary* next_;
+    };
+
+    // 64 bit FNV-1a.
+    static const unsigned long long resultCacheDigestBasis =
+        0xcbf29ce484222325ULL;
+
+    static unsigned long long
+    addToDigest(unsigned long long digest, const void* data, size_t size)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            digest ^= bytes[i];
+            digest *= 0x100000001b3ULL;
+        }
+        return digest;
+    }
+
+    static unsigned long long
+    addToDigest(unsigned long long digest, const SimpleString& text)
+    {
+        return addToDigest(digest, text.asCharString(), text.size() + 1);
+    }
+
+    static bool
+    digestOfFile(const SimpleString& path, unsigned long long& digest)
+    {
+        PlatformSpecificFile file =
+            PlatformSpecificFOpen(path.asCharString(), "rb");
+        if (file == nullptr)
+            return false;
+
+        digest = resultCacheDigestBasis;
+        char buffer[4096];
+        size_t length;
+        while ((length = PlatformSpecificFRead(buffer, sizeof(buffer), file)) >
+               0)
+            digest = addToDigest(digest, buffer, length);
+        PlatformSpecificFClose(file);
+        return true;
+    }
+
+    static bool readHex(const char*& text, unsigned long long& value)
+    {
+        value = 0;
+        const char* start = text;
+        for (;; text++) {
+            unsigned int nibble;
+            if (*text >= '0' && *text <= '9')
+                nibble = static_cast<unsigned int>(*text - '0');
+            else if (*text >= 'a' && *text <= 'f')
+                nibble = static_cast<unsigned int>(*text - 'a' + 10);
+            else
+                break;
+            value = (value << 4) | nibble;
+        }
+        return text != start;
+    }
+
+    TestResultCache::TestResultCache(
+        const SimpleString& fileName, const SimpleString& runOptions
+    ) :
+        fileName_(fileName),
+        runOptions_(runOptions),
+        ignoringCachedResults_(false),
+        buckets_(new TestResultCacheEntry*[resultCacheBucketCount]()),
+        libraries_(nullptr)
+    {
+    }
+
+    TestResultCache::~TestResultCache()
+    {
+        for (size_t i = 0; i < resultCacheBucketCount; i++) {
+            while (buckets_[i] != nullptr) {
+                TestResultCacheEntry* next = buckets_[i]->next_;
+                delete buckets_[i];
+                buckets_[i] = next;
+            }
+        }
+        delete[] buckets_;
+
+        while (libraries_ != nullptr) {
+            TestResultCacheLibrary* next = libraries_->next_;
+            delete libraries_;
+            libraries_ = next;
+        }
+    }
+
+    // Lines that cannot be read are skipped; at worst their tests run.
+    bool TestResultCache::load()
+    {
+        PlatformSpecificFile file =
+            PlatformSpecificFOpen(fileName_.asCharString(), "rb");
+        if (file == nullptr)
+            return false;
+
+        bool versionRead = false;
+        char line[512];
+        size_t lineLength = 0;
+        char buffer[4096];
+        size_t length;
+        while ((length = PlatformSpecificFRead(buffer, sizeof(buffer), file)) >
+               0) {
+            for (size_t i = 0; i < length; i++) {
+                if (buffer[i] != '\n') {
+                    if (lineLength < sizeof(line) - 1)
+                        line[lineLength++] = buffer[i];
+                    continue;
+                }
+                line[lineLength] = '\0';
+                lineLength = 0;
+                if (!versionRead) {
+                    versionRead = (SimpleString(line) == resultCacheVersion);
+                    if (!versionRead)
+                        break;
+                } else
+                    addCachedLine(line);
+            }
+            if (!versionRead)
+                break;
+        }
+        PlatformSpecificFClose(file);
+        return versionRead;
+    }
+
+    void TestResultCache::addCachedLine(const char* line)
+    {
+        const char* text = line;
+        unsigned long long key;
+        unsigned long long digest;
+        if (!readHex(text, key) || *text++ != ' ' || !readHex(text, digest))
+            return;
+
+        TestResultCacheEntry* entry = findOrAdd(key);
+        entry->hasCachedDigest_ = true;
+        entry->cachedDigest_ = digest;
+        entry->hasRecordedDigest_ = true;
+        entry->recordedDigest_ = digest;
+        entry->testName_ = text;
+    }
+
+    bool TestResultCache::save()
+    {
+        PlatformSpecificFile file =
+            PlatformSpecificFOpen(fileName_.asCharString(), "wb");
+        if (file == nullptr)
+            return false;
+
+        PlatformSpecificFPuts(resultCacheVersion, file);
+        PlatformSpecificFPuts("\n", file);
+        for (size_t i = 0; i < resultCacheBucketCount; i++) {
+            for (TestResultCacheEntry* entry = buckets_[i]; entry;
+                 entry = entry->next_) {
+                if (!entry->hasRecordedDigest_)
+                    continue;
+                SimpleString line = HexStringFrom(entry->key_);
+                line += " ";
+                line += HexStringFrom(entry->recordedDigest_);
+                line += entry->testName_;
+                line += "\n";
+                PlatformSpecificFPuts(line.asCharString(), file);
+            }
+        }
+        PlatformSpecificFClose(file);
+        return true;
+    }
+
+    void TestResultCache::ignoreCachedResults()
+    {
+        ignoringCachedResults_ = true;
+    }
+
+    bool TestResultCache::hasPassed(const UtestShell& test)
+    {
+        unsigned long long digest;
+        if (ignoringCachedResults_ || !libraryDigestOf(test, digest))
+            return false;
+
+        TestResultCacheEntry* entry = find(keyOf(test));
+        return entry != nullptr && entry->hasCachedDigest_ &&
+               entry->cachedDigest_ == digest;
+    }
+
+    void TestResultCache::recordPass(const UtestShell& test)
+    {
+        unsigned long long digest;
+        if (!libraryDigestOf(test, digest))
+            return;
+
+        TestResultCacheEntry* entry = findOrAdd(keyOf(test));
+        entry->hasRecordedDigest_ = true;
+        entry->recordedDigest_ = digest;
+        entry->testName_ = SimpleString(" ") + test.getGroup() + "." +
+                           test.getName();
+    }
+
+    void TestResultCache::recordFailure(const UtestShell& test)
+    {
+        TestResultCacheEntry* entry = find(keyOf(test));
+        if (entry != nullptr)
+            entry->hasRecordedDigest_ = false;
+    }
+
+    unsigned long long TestResultCache::keyOf(const UtestShell& test) const
+    {
+        unsigned long long key = resultCacheDigestBasis;
+        key = addToDigest(key, test.getGroup());
+        key = addToDigest(key, test.getName());
+        return addToDigest(key, runOptions_);
+    }
+
+    bool TestResultCache::libraryDigestOf(
+        const UtestShell& test, unsigned long long& digest
+    )
+    {
+        const char* path = PlatformSpecificLibraryPathOf(&test);
+        if (path == nullptr)
+            return false;
+
+        TestResultCacheLibrary* library = libraries_;
+        while (library != nullptr && library->path_ != path)
+            library = library->next_;
+        if (library == nullptr) {
+            library = libraries_ = new TestResultCacheLibrary(path, libraries_);
+            library->readable_ = digestOfFile(path, library->digest_);
+        }
+
+        digest = library->digest_;
+        return library->readable_;
+    }
+
+    TestResultCacheEntry* TestResultCache::find(unsigned long long key) const
+    {
+        TestResultCacheEntry* entry = buckets_[key % resultCacheBucketCount];
+        while (entry != nullptr && entry->key_ != key)
+            entry = entry->next_;
+        return entry;
+    }
+
+    TestResultCacheEntry* TestResultCache::findOrAdd(unsigned long long key)
+    {
+        TestResultCacheEntry* entry = find(key);
+        if (entry == nullptr) {
+            TestResultCacheEntry*& bucket =
+                buckets_[key % resultCacheBucketCount];
+            entry = bucket = new TestResultCacheEntry(key, bucket);
+        }
+        return entry;
+    }
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestServer.hpp"
+#include "CppUTest/CommandLineTestRunner.hpp"
+#include "CppUTest/TestRegistry.hpp"
+
+namespace cpputest
+{
+    int TestServer::RunServer(int ac, const char* const* av)
+    {
+        ConsoleTestOutput output;
+        if (ac != 2) {
+            output.print("usage: ");
+            output.print((ac > 0) ? av[0] : "server");
+            output.print(" <testLibrary>, with test arguments on stdin\n");
+            return 1;
+        }
+
+        TestServer server(av[1]);
+        return server.serve(PlatformSpecificStdIn, output);
+    }
+
+    TestServer::TestServer(const SimpleString& libraryPath) :
+        libraryPath_(libraryPath),
+        library_(nullptr),
+        registry_(nullptr),
+        libraryStamp_(0)
+    {
+    }
+
+    TestServer::~TestServer()
+    {
+        unload();
+    }
+
+    bool TestServer::load()
+    {
+        unload();
+
+        registry_ = new TestRegistry;
+        installPlugins(registry_);
+
+        TestRegistry* previous = TestRegistry::getCurrentRegistry();
+        registry_->setCurrentRegistry(registry_);
+        libraryStamp_ = PlatformSpecificFileStamp(libraryPath_.asCharString());
+        library_ = PlatformSpecificLibraryOpen(libraryPath_.asCharString());
+        registry_->setCurrentRegistry(previous);
+
+        loadError_ = "";
+        if (library_ == nullptr)
+            loadError_ =
+                SimpleString("Could not load ") + libraryPath_ + "\n";
+        else if (registry_->countTests() == 0) {
+            // The static TestInstallers only run when the library is
+            // really loaded. Without tests it was most likely never
+            // unloaded, and the code it runs would be the old one.
+            loadError_ = libraryPath_ +
+                         " registered no tests. A library that stays "
+                         "loaded after it is closed, such as one with "
+                         "STB_GNU_UNIQUE symbols, does not register them "
+                         "again. Build it with -fno-gnu-unique or restart "
+                         "the server.\n";
+            PlatformSpecificLibraryClose(library_);
+            library_ = nullptr;
+        }
+
+        if (library_ == nullptr) {
+            delete registry_;
+            registry_ = nullptr;
+        }
+        return isLoaded();
+    }
+
+    // The registry only links the library's tests, so it goes first.
+    void TestServer::unload()
+    {
+        delete registry_;
+        registry_ = nullptr;
+        if (library_ != nullptr)
+            PlatformSpecificLibraryClose(library_);
+        library_ = nullptr;
+    }
+
+    bool TestServer::isLoaded() const
+    {
+        return library_ != nullptr;
+    }
+
+    bool TestServer::reloadIfChanged()
+    {
+        if (isLoaded() &&
+            PlatformSpecificFileStamp(libraryPath_.asCharString()) ==
+                libraryStamp_)
+            return false;
+        load();
+        return true;
+    }
+
+    TestRegistry* TestServer::getRegistry() const
+    {
+        return registry_;
+    }
+
+    const SimpleString& TestServer::getLoadError() const
+    {
+        return loadError_;
+    }
+
+    int TestServer::runRequest(const SimpleString& request)
+    {
+        SimpleString line = request;
+        line.replace('\t', ' ');
+        SimpleStringCollection words;
+        line.split(" ", words);
+
+        const char** av = new const char*[words.size() + 1];
+        int ac = 0;
+        av[ac++] = libraryPath_.asCharString();
+        for (size_t i = 0; i < words.size(); i++) {
+            SimpleString& word = words[i];
+            if (word.endsWith(" "))
+                word = word.subString(0, word.size() - 1);
+            if (!word.isEmpty())
+                av[ac++] = word.asCharString();
+        }
+
+        TestRegistry* previous = TestRegistry::getCurrentRegistry();
+        registry_->setCurrentRegistry(registry_);
+        int result = runTests(ac, av, registry_);
+        registry_->setCurrentRegistry(previous);
+
+        delete[] av;
+        return result;
+    }
+
+    int TestServer::serve(PlatformSpecificFile requests, TestOutput& output)
+    {
+        SimpleString request;
+        while (readRequest(requests, request) && request != "quit") {
+            if (reloadIfChanged() && isLoaded()) {
+                output.print("Loaded ");
+                output.print(libraryPath_.asCharString());
+                output.print("\n");
+            }
+
+            int result = 1;
+            if (isLoaded())
+                result = runRequest(request);
+            else
+                output.print(loadError_.asCharString());
+
+            // Tells a client where the output of this request ends.
+            output.print(
+                StringFromFormat("-- done %d\n", result).asCharString()
+            );
+            output.flush();
+        }
+        return 0;
+    }
+
+    void TestServer::installPlugins(TestRegistry*) {}
+
+    int TestServer::runTests(
+        int ac, const char* const* av, TestRegistry* registry
+    )
+    {
+        CommandLineTestRunner runner(ac, av, registry);
+        return runner.runAllTestsMain();
+    }
+
+    bool TestServer::readRequest(
+        PlatformSpecificFile requests, SimpleString& request
+    )
+    {
+        // Bytes are read one at a time, so that a request is run as soon
+        // as its line is complete, but gathered in a buffer before they
+        // are added to the request.
+        request = "";
+        char buffer[256];
+        size_t length = 0;
+        bool complete = false;
+        char c;
+        while (!complete && PlatformSpecificFRead(&c, 1, requests) == 1) {
+            complete = (c == '\n');
+            if (!complete && c != '\r')
+                buffer[length++] = c;
+            if (length == sizeof(buffer) - 1) {
+                buffer[length] = '\0';
+                request += buffer;
+                length = 0;
+            }
+        }
+        buffer[length] = '\0';
+        request += buffer;
+        return complete || !request.isEmpty();
+    }
+}
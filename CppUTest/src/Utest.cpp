@@ -33,8 +33,10 @@
 #include "CppUTest/TestRegistry.hpp"
 #include "CppUTest/TestResult.hpp"
 
+#include <limits.h>
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 
 namespace cpputest
 {
@@ -50,6 +52,96 @@ namespace cpputest
         return fabs(d1 - d2) <= threshold;
     }
 
+    DoublesTolerance::DoublesTolerance(
+        Mode mode, double threshold, unsigned long long maxUlps
+    ) :
+        mode_(mode),
+        threshold_(threshold),
+        maxUlps_(maxUlps),
+        nanEqualsNan_(false)
+    {
+    }
+
+    DoublesTolerance DoublesTolerance::absolute(double threshold)
+    {
+        return DoublesTolerance(ABSOLUTE, threshold, 0);
+    }
+
+    DoublesTolerance DoublesTolerance::relative(double fraction)
+    {
+        return DoublesTolerance(RELATIVE, fraction, 0);
+    }
+
+    DoublesTolerance DoublesTolerance::ulps(unsigned long long maxUlps)
+    {
+        return DoublesTolerance(ULPS, 0.0, maxUlps);
+    }
+
+    DoublesTolerance DoublesTolerance::withNanEqualsNan() const
+    {
+        DoublesTolerance tolerance(*this);
+        tolerance.nanEqualsNan_ = true;
+        return tolerance;
+    }
+
+    // Maps the bit pattern of a double onto a signed integer that increases
+    // monotonically with the value, so that neighbouring doubles differ by 1.
+    static long long orderedBitsOf(double value)
+    {
+        long long bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return (bits < 0) ? LLONG_MIN - bits : bits;
+    }
+
+    static unsigned long long ulpDistance(double d1, double d2)
+    {
+        long long bits1 = orderedBitsOf(d1);
+        long long bits2 = orderedBitsOf(d2);
+        return (bits1 > bits2) ? static_cast<unsigned long long>(bits1) -
+                                     static_cast<unsigned long long>(bits2)
+                               : static_cast<unsigned long long>(bits2) -
+                                     static_cast<unsigned long long>(bits1);
+    }
+
+    bool DoublesTolerance::matches(double expected, double actual) const
+    {
+        if (isnan(expected) || isnan(actual))
+            return nanEqualsNan_ && isnan(expected) && isnan(actual);
+        if (expected == actual)
+            return true;
+        if (isinf(expected) || isinf(actual))
+            return false;
+
+        if (mode_ == RELATIVE) {
+            double largest =
+                (fabs(expected) > fabs(actual)) ? fabs(expected) : fabs(actual);
+            return fabs(expected - actual) <= threshold_ * largest;
+        }
+        if (mode_ == ULPS)
+            return ulpDistance(expected, actual) <= maxUlps_;
+        return fabs(expected - actual) <= threshold_;
+    }
+
+    SimpleString DoublesTolerance::toString() const
+    {
+        SimpleString result;
+        if (mode_ == RELATIVE)
+            result = StringFromFormat(
+                "relative tolerance <%s>", StringFrom(threshold_).asCharString()
+            );
+        else if (mode_ == ULPS)
+            result = StringFromFormat(
+                "tolerance of <%s> ULPs", StringFrom(maxUlps_).asCharString()
+            );
+        else
+            result = StringFromFormat(
+                "absolute tolerance <%s>", StringFrom(threshold_).asCharString()
+            );
+        if (nanEqualsNan_)
+            result += ", NaN equals NaN";
+        return result;
+    }
+
     /* Sometimes stubs use the CppUTest assertions.
      * Its not correct to do so, but this small helper class will prevent a
      * segmentation fault and instead will give an error message and also the
@@ -224,10 +316,350 @@ namespace cpputest
     {
         hasFailed_ = false;
         result.countRun();
+        if (isRunInSeperateProcess() &&
+            runOneTestInChildProcess(plugin, result))
+            return;
         HelperTestRunInfo runInfo(this, plugin, &result);
         PlatformSpecificSetJmp(helperDoRunOneTestInCurrentProcess, &runInfo);
     }
 
+    /*
+     * A test run in a child process reports to a ChildProcessTestResult,
+     * which writes what the test reports to a temporary file as records.
+     * The parent replays them into its own TestResult once the child has
+     * exited, so a child never waits on its parent. Every record is a kind
+     * byte followed by native size_t numbers and length prefixed strings,
+     * as both ends are the same binary. The checks record comes last, and
+     * a child whose records stop before it has crashed.
+     *
+     * A failure crosses over as its location and rendered message, and
+     * is replayed as a plain TestFailure. The subclasses differ only in how
+     * they build that message, so nothing a reporter reads is lost.
+     */
+    enum ChildProcessRecord
+    {
+        childRecord_checks = 'c',
+        childRecord_failure = 'f',
+        childRecord_print = 'p',
+        childRecord_printVeryVerbose = 'v'
+    };
+
+    class ChildProcessTestResult : public TestResult
+    {
+    public:
+        ChildProcessTestResult(
+            TestOutput& output, PlatformSpecificFile records
+        ) :
+            TestResult(output),
+            records_(records),
+            checkCount_(0)
+        {
+        }
+
+        virtual void countCheck() override
+        {
+            checkCount_++;
+        }
+
+        virtual void addChecks(size_t amount) override
+        {
+            checkCount_ += amount;
+        }
+
+        virtual void addFailure(const TestFailure& failure) override
+        {
+            writeKind(childRecord_failure);
+            writeSize(failure.getFailureLineNumber());
+            writeString(failure.getFileName());
+            writeString(failure.getMessage());
+        }
+
+        virtual void print(const char* text) override
+        {
+            writeKind(childRecord_print);
+            writeString(text);
+        }
+
+        virtual void printVeryVerbose(const char* text) override
+        {
+            writeKind(childRecord_printVeryVerbose);
+            writeString(text);
+        }
+
+        // Checks are sent once, when the test is done.
+        void finish()
+        {
+            writeKind(childRecord_checks);
+            writeSize(checkCount_);
+            PlatformSpecificFFlush(records_);
+        }
+
+    private:
+        PlatformSpecificFile records_;
+        size_t checkCount_;
+
+        void writeKind(ChildProcessRecord kind)
+        {
+            unsigned char byte = static_cast<unsigned char>(kind);
+            PlatformSpecificFWrite(&byte, 1, records_);
+        }
+
+        void writeSize(size_t value)
+        {
+            PlatformSpecificFWrite(&value, sizeof(value), records_);
+        }
+
+        void writeString(const SimpleString& str)
+        {
+            writeSize(str.size());
+            PlatformSpecificFWrite(str.asCharString(), str.size(), records_);
+        }
+    };
+
+    static const size_t childRecordReadChunkSize = 4096;
+
+    static bool readSize(PlatformSpecificFile records, size_t& value)
+    {
+        return PlatformSpecificFRead(&value, sizeof(value), records) ==
+               sizeof(value);
+    }
+
+    // The string grows with the bytes actually read, so a corrupt length
+    // cannot allocate much more than the child wrote.
+    static bool readString(PlatformSpecificFile records, SimpleString& str)
+    {
+        size_t size;
+        if (!readSize(records, size))
+            return false;
+        char buffer[childRecordReadChunkSize + 1];
+        str = "";
+        while (size > 0) {
+            size_t chunk = (size < childRecordReadChunkSize)
+                               ? size
+                               : childRecordReadChunkSize;
+            if (PlatformSpecificFRead(buffer, chunk, records) != chunk)
+                return false;
+            buffer[chunk] = '\0';
+            str += buffer;
+            size -= chunk;
+        }
+        return true;
+    }
+
+    // Returns whether the records are complete, which they are only when
+    // the child got to the checks record that ends them.
+    static bool replayChildProcessRecords(
+        UtestShell* test,
+        PlatformSpecificFile records,
+        TestResult& result,
+        bool& failed
+    )
+    {
+        unsigned char kind;
+        while (PlatformSpecificFRead(&kind, 1, records) == 1) {
+            size_t number;
+            SimpleString text;
+            if (kind == childRecord_checks) {
+                if (!readSize(records, number))
+                    return false;
+                result.addChecks(number);
+                return true;
+            } else if (kind == childRecord_failure) {
+                SimpleString fileName;
+                if (!readSize(records, number) ||
+                    !readString(records, fileName) ||
+                    !readString(records, text))
+                    return false;
+                failed = true;
+                result.addFailure(
+                    TestFailure(test, fileName.asCharString(), number, text)
+                );
+            } else if (kind == childRecord_print) {
+                if (!readString(records, text))
+                    return false;
+                result.print(text.asCharString());
+            } else if (kind == childRecord_printVeryVerbose) {
+                if (!readString(records, text))
+                    return false;
+                result.printVeryVerbose(text.asCharString());
+            } else {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    struct UtestChildProcess
+    {
+        int pid;
+        PlatformSpecificFile output;
+        bool exited;
+        int status;
+    };
+
+    bool
+    UtestShell::runOneTestInChildProcess(TestPlugin* plugin, TestResult& result)
+    {
+        UtestChildProcess* child = startInChildProcess(plugin);
+        if (child == nullptr)
+            return false;
+        finishInChildProcess(child, result);
+        return true;
+    }
+
+    UtestChildProcess* UtestShell::startInChildProcess(TestPlugin* plugin)
+    {
+        hasFailed_ = false;
+        PlatformSpecificFile records = PlatformSpecificTempFile();
+        if (records == nullptr)
+            return nullptr;
+
+        PlatformSpecificFlush();
+        int pid = PlatformSpecificFork();
+        if (pid < 0) {
+            PlatformSpecificFClose(records);
+            return nullptr;
+        }
+
+        if (pid == 0) {
+            StringBufferTestOutput unusedOutput;
+            ChildProcessTestResult childResult(unusedOutput, records);
+            HelperTestRunInfo runInfo(this, plugin, &childResult);
+            PlatformSpecificSetJmp(
+                helperDoRunOneTestInCurrentProcess, &runInfo
+            );
+            childResult.finish();
+            PlatformSpecificExitChild(0);
+        }
+
+        UtestChildProcess* child = new UtestChildProcess;
+        child->pid = pid;
+        child->output = records;
+        child->exited = false;
+        child->status = 0;
+        return child;
+    }
+
+    void UtestShell::finishInChildProcess(
+        UtestChildProcess* child, TestResult& result
+    )
+    {
+        int status = child->exited ? child->status
+                                   : PlatformSpecificWaitPid(child->pid);
+        PlatformSpecificRewind(child->output);
+        bool failed = false;
+        bool complete =
+            replayChildProcessRecords(this, child->output, result, failed);
+        if (failed)
+            hasFailed_ = true;
+        PlatformSpecificFClose(child->output);
+        delete child;
+        if (status == 0 && !complete) {
+            hasFailed_ = true;
+            result.addFailure(TestFailure(
+                this,
+                "Failed in separate process - crashed before reporting back"
+            ));
+        } else if (status != 0) {
+            hasFailed_ = true;
+            result.addFailure(TestFailure(
+                this,
+                (status < 0)
+                    ? StringFromFormat(
+                          "Failed in separate process - killed by signal %d",
+                          -status
+                      )
+                    : StringFromFormat(
+                          "Failed in separate process - exited with code %d",
+                          status
+                      )
+            ));
+        }
+    }
+
+    // Children that exit but are not among those given, such as ones a
+    // test started itself, are reaped and passed over.
+    UtestChildProcess* UtestShell::waitForAnyChildProcess(
+        UtestChildProcess* const* children, size_t count
+    )
+    {
+        while (count > 0) {
+            int status = 0;
+            int pid = PlatformSpecificWaitAnyChild(&status);
+            if (pid < 0)
+                return nullptr;
+            for (size_t i = 0; i < count; i++) {
+                if (children[i]->pid == pid) {
+                    children[i]->exited = true;
+                    children[i]->status = status;
+                    return children[i];
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    // Runs a group hook like a test body, so that failures and exceptions
+    // in it are reported the same way.
+    class UtestGroupFixture : public Utest
+    {
+    public:
+        UtestGroupFixture(UtestShell* shell, bool setup) :
+            shell_(shell),
+            setup_(setup)
+        {
+        }
+
+        virtual void testBody() override
+        {
+            if (setup_)
+                shell_->setupGroupOnce();
+            else
+                shell_->teardownGroupOnce();
+        }
+
+    private:
+        UtestShell* shell_;
+        bool setup_;
+    };
+
+    void UtestShell::setupGroupOnce() {}
+
+    // Shells defined by TEST() know; any other shell may have hooks.
+    bool UtestShell::hasGroupFixture() const
+    {
+        return true;
+    }
+
+    void UtestShell::teardownGroupOnce() {}
+
+    bool UtestShell::runGroupSetupOnce(TestResult& result)
+    {
+        return runGroupFixture(result, true);
+    }
+
+    void UtestShell::runGroupTeardownOnce(TestResult& result)
+    {
+        runGroupFixture(result, false);
+    }
+
+    bool UtestShell::runGroupFixture(TestResult& result, bool setup)
+    {
+        size_t failureCount = result.getFailureCount();
+        UtestShell* savedTest = UtestShell::getCurrent();
+        TestResult* savedResult = UtestShell::getTestResult();
+
+        UtestShell::setTestResult(&result);
+        UtestShell::setCurrentTest(this);
+
+        UtestGroupFixture fixture(this, setup);
+        fixture.run();
+
+        UtestShell::setCurrentTest(savedTest);
+        UtestShell::setTestResult(savedResult);
+        return result.getFailureCount() == failureCount;
+    }
+
     Utest* UtestShell::createTest()
     {
         return new Utest();
@@ -736,6 +1168,68 @@ namespace cpputest
             );
     }
 
+    void UtestShell::assertDoublesArrayEqual(
+        const double* expected,
+        const double* actual,
+        size_t count,
+        const DoublesTolerance& tolerance,
+        const char* text,
+        const char* fileName,
+        size_t lineNumber,
+        const TestTerminator& testTerminator
+    )
+    {
+        getTestResult()->countCheck();
+        if (count == 0)
+            return;
+        if (actual == nullptr && expected == nullptr)
+            return;
+
+        // Count instead of stopping at the first mismatch, which keeps the
+        // loop free of early exits on the passing path.
+        size_t mismatches = 0;
+        if (actual != nullptr && expected != nullptr)
+            for (size_t i = 0; i < count; i++)
+                if (!tolerance.matches(expected[i], actual[i]))
+                    mismatches++;
+
+        if (actual == nullptr || expected == nullptr || mismatches != 0)
+            failWith(
+                DoublesArrayEqualFailure(
+                    this, fileName, lineNumber, expected, actual, count,
+                    tolerance, text
+                ),
+                testTerminator
+            );
+    }
+
+    void UtestShell::assertLongsArrayEqual(
+        const long* expected,
+        const long* actual,
+        size_t count,
+        const char* text,
+        const char* fileName,
+        size_t lineNumber,
+        const TestTerminator& testTerminator
+    )
+    {
+        getTestResult()->countCheck();
+        if (count == 0)
+            return;
+        if (actual == nullptr && expected == nullptr)
+            return;
+        if (actual == nullptr || expected == nullptr ||
+            SimpleString::FirstMismatch(
+                expected, actual, count * sizeof(long)
+            ) != count * sizeof(long))
+            failWith(
+                LongsArrayEqualFailure(
+                    this, fileName, lineNumber, expected, actual, count, text
+                ),
+                testTerminator
+            );
+    }
+
     void UtestShell::assertBinaryEqual(
         const void* expected,
         const void* actual,
@@ -1006,6 +1500,15 @@ namespace cpputest
 
     void Utest::teardown() {}
 
+    void Utest::groupSetupOnce() {}
+
+    void Utest::groupTeardownOnce() {}
+
+    bool Utest::groupRunsInSnapshots()
+    {
+        return false;
+    }
+
     /////////////////// Terminators
 
     TestTerminator::~TestTerminator() {}
@@ -0,0 +1,42 @@
+#ifndef D_QuietCommandLineTestRunner_H
+#define D_QuietCommandLineTestRunner_H
+
+#include "CppUTest/CommandLineTestRunner.hpp"
+#include "CppUTest/TestOutput.hpp"
+
+// Runs like a test executable, but keeps the console output in the given
+// string instead of printing it.
+class QuietCommandLineTestRunner : public cpputest::CommandLineTestRunner
+{
+public:
+    QuietCommandLineTestRunner(
+        int ac,
+        const char* const* av,
+        cpputest::TestRegistry* registry,
+        cpputest::SimpleString& output
+    ) :
+        CommandLineTestRunner(ac, av, registry),
+        output_(output),
+        console_(nullptr)
+    {
+    }
+
+    virtual ~QuietCommandLineTestRunner() override
+    {
+        if (console_ != nullptr)
+            output_ = console_->getOutput();
+    }
+
+protected:
+    virtual cpputest::TestOutput* createConsoleOutput() override
+    {
+        console_ = new cpputest::StringBufferTestOutput;
+        return console_;
+    }
+
+private:
+    cpputest::SimpleString& output_;
+    cpputest::StringBufferTestOutput* console_;
+};
+
+#endif /* D_QuietCommandLineTestRunner_H */
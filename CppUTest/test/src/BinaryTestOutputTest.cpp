@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/BinaryTestOutput.hpp"
+#include "CppUTest/PlatformSpecificFunctions.hpp"
+#include "CppUTest/TestHarness.hpp"
+#include "CppUTest/TestResult.hpp"
+
+using cpputest::SimpleString;
+
+static const size_t logCapacity = 8192;
+static unsigned char logData[logCapacity];
+static size_t logSize = 0;
+static size_t logReadPosition = 0;
+static char logFileName[64];
+static int amountOfFWriteCalls = 0;
+
+static PlatformSpecificFile mockFOpen(const char* filename, const char* flag)
+{
+    if (flag[0] == 'r') {
+        if (SimpleString::StrCmp(logFileName, filename) != 0)
+            return nullptr;
+        logReadPosition = 0;
+        return logData;
+    }
+    SimpleString::StrNCpy(logFileName, filename, sizeof(logFileName) - 1);
+    logSize = 0;
+    return logData;
+}
+
+static void mockFWrite(const void* buffer, size_t size, PlatformSpecificFile)
+{
+    amountOfFWriteCalls++;
+    const unsigned char* bytes = static_cast<const unsigned char*>(buffer);
+    for (size_t i = 0; i < size && logSize < logCapacity; i++)
+        logData[logSize++] = bytes[i];
+}
+
+static size_t mockFRead(void* buffer, size_t size, PlatformSpecificFile)
+{
+    unsigned char* bytes = static_cast<unsigned char*>(buffer);
+    size_t length = 0;
+    while (length < size && logReadPosition < logSize)
+        bytes[length++] = logData[logReadPosition++];
+    return length;
+}
+
+static void mockFClose(PlatformSpecificFile) {}
+
+static long millisTime = 0;
+
+static long MockGetPlatformSpecificTimeInMillis()
+{
+    return millisTime;
+}
+
+TEST_GROUP(BinaryTestOutput)
+{
+    cpputest::UtestShell* passingTest;
+    cpputest::UtestShell* failingTest;
+    cpputest::UtestShell* ignoredTest;
+    cpputest::StringBufferTestOutput direct;
+    cpputest::StringBufferTestOutput replayed;
+
+    void setup() override
+    {
+        UT_PTR_SET(PlatformSpecificFOpen, mockFOpen);
+        UT_PTR_SET(PlatformSpecificFWrite, mockFWrite);
+        UT_PTR_SET(PlatformSpecificFRead, mockFRead);
+        UT_PTR_SET(PlatformSpecificFClose, mockFClose);
+        UT_PTR_SET(
+            GetPlatformSpecificTimeInMillis, MockGetPlatformSpecificTimeInMillis
+        );
+        logSize = 0;
+        logFileName[0] = '\0';
+        amountOfFWriteCalls = 0;
+        millisTime = 0;
+
+        passingTest = new cpputest::UtestShell("group", "passes", "file", 10);
+        failingTest = new cpputest::UtestShell("group", "fails", "file", 20);
+        ignoredTest =
+            new cpputest::IgnoredUtestShell("group", "ignored", "file", 30);
+    }
+
+    void teardown() override
+    {
+        delete ignoredTest;
+        delete failingTest;
+        delete passingTest;
+    }
+
+    void runTests(cpputest::TestOutput & output)
+    {
+        cpputest::TestResult result(output);
+        result.testsStarted();
+        result.currentGroupStarted(passingTest);
+
+        result.currentTestStarted(passingTest);
+        millisTime += 5;
+        result.countCheck();
+        result.countCheck();
+        result.print("printed by the test\n");
+        result.currentTestEnded(passingTest);
+
+        result.currentTestStarted(failingTest);
+        millisTime += 7;
+        result.addFailure(cpputest::TestFailure(
+            failingTest, "failfile", 25, "failure message"
+        ));
+        result.currentTestEnded(failingTest);
+
+        result.currentTestStarted(ignoredTest);
+        result.currentTestEnded(ignoredTest);
+        result.currentGroupEnded(ignoredTest);
+
+        for (int i = 0; i < 4; i++)
+            result.countTest();
+        result.countRun();
+        result.countRun();
+        result.countIgnored();
+        result.countFilteredOut();
+        millisTime += 1;
+        result.testsEnded();
+    }
+
+    void writeLog()
+    {
+        cpputest::BinaryTestOutput binaryOutput;
+        runTests(binaryOutput);
+    }
+};
+
+TEST(BinaryTestOutput, logStartsWithMagicAndVersion)
+{
+    writeLog();
+
+    STRCMP_EQUAL("cpputest.bin", logFileName);
+    MEMCMP_EQUAL("CppULog\001", logData, 8);
+}
+
+TEST(BinaryTestOutput, logIsNamedAfterThePackage)
+{
+    cpputest::BinaryTestOutput binaryOutput;
+    binaryOutput.setPackageName("pack/age");
+    runTests(binaryOutput);
+
+    STRCMP_EQUAL("cpputest_pack_age.bin", logFileName);
+}
+
+TEST(BinaryTestOutput, logIsWrittenOncePerGroupAndAtTheEnd)
+{
+    writeLog();
+
+    LONGS_EQUAL(3, amountOfFWriteCalls);
+}
+
+TEST(BinaryTestOutput, replayReproducesTheProgressOutput)
+{
+    runTests(direct);
+    writeLog();
+    size_t failureCount = 0;
+
+    CHECK(cpputest::BinaryTestOutput::replay(
+        "cpputest.bin", replayed, failureCount
+    ));
+    STRCMP_EQUAL(
+        direct.getOutput().asCharString(), replayed.getOutput().asCharString()
+    );
+    LONGS_EQUAL(1, failureCount);
+}
+
+TEST(BinaryTestOutput, replayReproducesTheVerboseOutput)
+{
+    direct.verbose(cpputest::TestOutput::level_verbose);
+    replayed.verbose(cpputest::TestOutput::level_verbose);
+    runTests(direct);
+    writeLog();
+    size_t failureCount = 0;
+
+    CHECK(cpputest::BinaryTestOutput::replay(
+        "cpputest.bin", replayed, failureCount
+    ));
+    STRCMP_EQUAL(
+        direct.getOutput().asCharString(), replayed.getOutput().asCharString()
+    );
+}
+
+TEST(BinaryTestOutput, replaySkipsUnknownRecords)
+{
+    writeLog();
+    static const unsigned char unknownRecord[] = {99, 2, 0, 0, 0, 1, 2};
+    mockFWrite(unknownRecord, sizeof(unknownRecord), nullptr);
+    runTests(direct);
+    size_t failureCount = 0;
+
+    CHECK(cpputest::BinaryTestOutput::replay(
+        "cpputest.bin", replayed, failureCount
+    ));
+    STRCMP_EQUAL(
+        direct.getOutput().asCharString(), replayed.getOutput().asCharString()
+    );
+}
+
+TEST(BinaryTestOutput, replayOfATruncatedLogFailsAfterReplayingWhatIsThere)
+{
+    writeLog();
+    logSize -= 3;
+    size_t failureCount = 0;
+
+    CHECK_FALSE(cpputest::BinaryTestOutput::replay(
+        "cpputest.bin", replayed, failureCount
+    ));
+    STRCMP_CONTAINS("failure message", replayed.getOutput().asCharString());
+    LONGS_EQUAL(1, failureCount);
+}
+
+TEST(BinaryTestOutput, replayOfARecordLongerThanTheLogFails)
+{
+    writeLog();
+    static const unsigned char hugeRecord[] = {99, 0xff, 0xff, 0xff, 0x7f, 1};
+    mockFWrite(hugeRecord, sizeof(hugeRecord), nullptr);
+    size_t failureCount = 0;
+
+    CHECK_FALSE(cpputest::BinaryTestOutput::replay(
+        "cpputest.bin", replayed, failureCount
+    ));
+    LONGS_EQUAL(1, failureCount);
+}
+
+TEST(BinaryTestOutput, replayOfAMissingLogFails)
+{
+    size_t failureCount = 0;
+
+    CHECK_FALSE(cpputest::BinaryTestOutput::replay(
+        "missing.bin", replayed, failureCount
+    ));
+}
+
+TEST(BinaryTestOutput, replayRejectsFilesThatAreNotBinaryLogs)
+{
+    mockFOpen("results.xml", "w");
+    mockFWrite("<?xml version", 13, nullptr);
+    size_t failureCount = 0;
+
+    CHECK_FALSE(cpputest::BinaryTestOutput::replay(
+        "results.xml", replayed, failureCount
+    ));
+    STRCMP_EQUAL("", replayed.getOutput().asCharString());
+}
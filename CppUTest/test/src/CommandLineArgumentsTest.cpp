@@ -114,6 +114,21 @@ TEST(CommandLineArguments, repeatSetDefaultsToTwo)
     LONGS_EQUAL(2, args->getRepeatCount());
 }
 
+TEST(CommandLineArguments, workerCountSet)
+{
+    int argc = 3;
+    const char* argv[] = {"tests.exe", "-j", "4"};
+    CHECK(newArgumentParser(argc, argv));
+    LONGS_EQUAL(4, args->getWorkerCount());
+}
+
+TEST(CommandLineArguments, workerCountNeedsANumber)
+{
+    int argc = 2;
+    const char* argv[] = {"tests.exe", "-j"};
+    CHECK(!newArgumentParser(argc, argv));
+}
+
 TEST(CommandLineArguments, reverseEnabled)
 {
     int argc = 2;
@@ -421,6 +436,138 @@ TEST(CommandLineArguments, setJUnitOutputDifferentParameter)
     CHECK(args->isJUnitOutput());
 }
 
+TEST(CommandLineArguments, setJUnitSuitesOutput)
+{
+    int argc = 2;
+    const char* argv[] = {"tests.exe", "-ojunitsuites"};
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isJUnitSuitesOutput());
+    CHECK(!args->isJUnitOutput());
+}
+
+TEST(CommandLineArguments, mergeJUnitFiles)
+{
+    int argc = 5;
+    const char* argv[] = {
+        "tests.exe", "-mergejunit", "merged.xml", "a.xml", "b.xml"
+    };
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isMergingJUnitFiles());
+    STRCMP_EQUAL("merged.xml", args->getJUnitMergeOutputFile().asCharString());
+    LONGS_EQUAL(2, args->getJUnitMergeInputFileCount());
+    STRCMP_EQUAL("a.xml", args->getJUnitMergeInputFiles()[0]);
+    STRCMP_EQUAL("b.xml", args->getJUnitMergeInputFiles()[1]);
+}
+
+TEST(CommandLineArguments, mergeJUnitFilesNeedsAtLeastOneInput)
+{
+    int argc = 3;
+    const char* argv[] = {"tests.exe", "-mergejunit", "merged.xml"};
+    CHECK(!newArgumentParser(argc, argv));
+}
+
+TEST(CommandLineArguments, setBinaryOutput)
+{
+    int argc = 2;
+    const char* argv[] = {"tests.exe", "-obinary"};
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isBinaryOutput());
+}
+
+TEST(CommandLineArguments, convertBinaryLog)
+{
+    int argc = 4;
+    const char* argv[] = {"tests.exe", "-convert", "cpputest.bin", "-ojunit"};
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isConvertingBinaryLog());
+    STRCMP_EQUAL("cpputest.bin", args->getBinaryLogFileName().asCharString());
+    CHECK(args->isJUnitOutput());
+}
+
+TEST(CommandLineArguments, convertNeedsALogFile)
+{
+    int argc = 2;
+    const char* argv[] = {"tests.exe", "-convert"};
+    CHECK(!newArgumentParser(argc, argv));
+}
+
+TEST(CommandLineArguments, setJournalFile)
+{
+    int argc = 3;
+    const char* argv[] = {"tests.exe", "-journal", "tests.journal"};
+    CHECK(newArgumentParser(argc, argv));
+    STRCMP_EQUAL("tests.journal", args->getJournalFileName().asCharString());
+}
+
+TEST(CommandLineArguments, journalNeedsAFile)
+{
+    int argc = 2;
+    const char* argv[] = {"tests.exe", "-journal"};
+    CHECK(!newArgumentParser(argc, argv));
+}
+
+TEST(CommandLineArguments, resumeFromJournal)
+{
+    int argc = 4;
+    const char* argv[] = {"tests.exe", "-resume", "tests.journal", "-r2"};
+    CHECK(newArgumentParser(argc, argv));
+    STRCMP_EQUAL(
+        "tests.journal", args->getResumeJournalFileName().asCharString()
+    );
+    LONGS_EQUAL(2, args->getRepeatCount());
+}
+
+TEST(CommandLineArguments, resumeNeedsAJournal)
+{
+    int argc = 2;
+    const char* argv[] = {"tests.exe", "-resume"};
+    CHECK(!newArgumentParser(argc, argv));
+}
+
+TEST(CommandLineArguments, setResultCacheFile)
+{
+    int argc = 3;
+    const char* argv[] = {"tests.exe", "-cache", "tests.cache"};
+    CHECK(newArgumentParser(argc, argv));
+    STRCMP_EQUAL("tests.cache", args->getResultCacheFileName().asCharString());
+    CHECK(!args->isIgnoringResultCache());
+}
+
+TEST(CommandLineArguments, resultCacheNeedsAFile)
+{
+    int argc = 2;
+    const char* argv[] = {"tests.exe", "-cache"};
+    CHECK(!newArgumentParser(argc, argv));
+}
+
+TEST(CommandLineArguments, ignoreResultCache)
+{
+    int argc = 3;
+    const char* argv[] = {"tests.exe", "-cachetests.cache", "-nocache"};
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isIgnoringResultCache());
+}
+
+TEST(CommandLineArguments, runOptionsAreTheOptionsThatChangeTestOutcomes)
+{
+    int argc = 10;
+    const char* argv[] = {"tests.exe", "-v",      "-cache", "tests.cache",
+                          "-r3",       "-g",      "MyGroup", "-nocache",
+                          "-f",        "-pmemoryleak"};
+    CHECK(newArgumentParser(argc, argv));
+    STRCMP_EQUAL("-r3 -f -pmemoryleak", args->getRunOptions().asCharString());
+}
+
+TEST(CommandLineArguments, filtersOutputAndWorkersAreNoRunOptions)
+{
+    int argc = 13;
+    const char* argv[] = {"tests.exe", "-vv", "-c",      "-sg", "MyGroup",
+                          "-n",        "foo", "-ojunit", "-k",  "package",
+                          "-j",        "4",   "-resumejournal"};
+    CHECK(newArgumentParser(argc, argv));
+    STRCMP_EQUAL("", args->getRunOptions().asCharString());
+}
+
 TEST(CommandLineArguments, setTeamCityOutputDifferentParameter)
 {
     int argc = 3;
@@ -469,7 +616,12 @@ TEST(CommandLineArguments, printUsage)
         "[-t|st|xt|xst <groupName>.<testName>]...\n"
         "      [-b] [-s [<seed>]] [\"[IGNORE_]TEST(<groupName>, "
         "<testName>)\"]...\n"
-        "      [-o{normal|eclipse|junit|teamcity}] [-k <packageName>]\n",
+        "      [-o{normal|eclipse|junit|junitsuites|teamcity|binary}] "
+        "[-k <packageName>]\n"
+        "      [-mergejunit <mergedFile> <junitFile>...] "
+        "[-convert <binaryLog>]\n"
+        "      [-journal <journalFile>] [-resume <journalFile>]\n"
+        "      [-cache <cacheFile>] [-nocache]\n",
         args->usage()
     );
 }
@@ -498,6 +650,7 @@ TEST(CommandLineArguments, checkDefaultArguments)
     CHECK(newArgumentParser(argc, argv));
     CHECK(!args->isVerbose());
     LONGS_EQUAL(1, args->getRepeatCount());
+    LONGS_EQUAL(1, args->getWorkerCount());
     CHECK(nullptr == args->getGroupFilters());
     CHECK(nullptr == args->getNameFilters());
     CHECK(args->isEclipseOutput());
@@ -513,6 +666,7 @@ TEST(CommandLineArguments, checkContinuousIntegrationMode)
     CHECK(newArgumentParser(argc, argv));
     CHECK(!args->isVerbose());
     LONGS_EQUAL(1, args->getRepeatCount());
+    LONGS_EQUAL(1, args->getWorkerCount());
     CHECK(nullptr == args->getGroupFilters());
     CHECK(nullptr == args->getNameFilters());
     CHECK(args->isEclipseOutput());
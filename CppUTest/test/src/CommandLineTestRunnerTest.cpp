@@ -67,6 +67,16 @@ public:
     cpputest::StringBufferTestOutput* fakeJUnitOutputWhichIsReallyABuffer_;
     cpputest::StringBufferTestOutput* fakeConsoleOutputWhichIsReallyABuffer;
     cpputest::StringBufferTestOutput* fakeTCOutputWhichIsReallyABuffer;
+    bool createdJUnitSuitesOutput;
+    cpputest::SimpleString mergedJUnitFile;
+    size_t mergedJUnitInputFileCount;
+    cpputest::StringBufferTestOutput* fakeBinaryOutputWhichIsReallyABuffer;
+    cpputest::SimpleString replayedBinaryLog;
+    cpputest::StringBufferTestOutput* fakeJournalOutputWhichIsReallyABuffer;
+    cpputest::SimpleString resumedJournal;
+    const char* resumeGroup;
+    const char* resumeName;
+    bool resumePointFinished;
 
     CommandLineTestRunnerWithStringBufferOutput(
         int argc, const char* const* argv, cpputest::TestRegistry* registry
@@ -74,7 +84,14 @@ public:
         CommandLineTestRunner(argc, argv, registry),
         fakeJUnitOutputWhichIsReallyABuffer_(nullptr),
         fakeConsoleOutputWhichIsReallyABuffer(nullptr),
-        fakeTCOutputWhichIsReallyABuffer(nullptr)
+        fakeTCOutputWhichIsReallyABuffer(nullptr),
+        createdJUnitSuitesOutput(false),
+        mergedJUnitInputFileCount(0),
+        fakeBinaryOutputWhichIsReallyABuffer(nullptr),
+        fakeJournalOutputWhichIsReallyABuffer(nullptr),
+        resumeGroup("group1"),
+        resumeName("test1"),
+        resumePointFinished(false)
     {
     }
 
@@ -93,11 +110,68 @@ public:
         return fakeJUnitOutputWhichIsReallyABuffer_;
     }
 
+    cpputest::TestOutput*
+    createJUnitSuitesOutput(const cpputest::SimpleString& packageName) override
+    {
+        createdJUnitSuitesOutput = true;
+        return createJUnitOutput(packageName);
+    }
+
+    bool mergeJUnitFiles(
+        const cpputest::SimpleString& outputFileName,
+        const char* const*,
+        size_t inputFileCount
+    ) override
+    {
+        mergedJUnitFile = outputFileName;
+        mergedJUnitInputFileCount = inputFileCount;
+        return outputFileName != "unwritable.xml";
+    }
+
     cpputest::TestOutput* createTeamCityOutput() override
     {
         fakeTCOutputWhichIsReallyABuffer = new cpputest::StringBufferTestOutput;
         return fakeTCOutputWhichIsReallyABuffer;
     }
+
+    cpputest::TestOutput*
+    createBinaryOutput(const cpputest::SimpleString&) override
+    {
+        fakeBinaryOutputWhichIsReallyABuffer =
+            new cpputest::StringBufferTestOutput;
+        return fakeBinaryOutputWhichIsReallyABuffer;
+    }
+
+    bool replayBinaryLog(
+        const cpputest::SimpleString& logFileName, size_t& failureCount
+    ) override
+    {
+        replayedBinaryLog = logFileName;
+        failureCount = 3;
+        return logFileName != "corrupt.bin";
+    }
+
+    cpputest::TestOutput*
+    createJournalOutput(const cpputest::SimpleString&) override
+    {
+        fakeJournalOutputWhichIsReallyABuffer =
+            new cpputest::StringBufferTestOutput;
+        return fakeJournalOutputWhichIsReallyABuffer;
+    }
+
+    bool findJournalResumePoint(
+        const cpputest::SimpleString& journalFileName,
+        cpputest::SimpleString& group,
+        cpputest::SimpleString& name,
+        bool& finished
+    ) override
+    {
+        resumedJournal = journalFileName;
+        group = resumeGroup;
+        name = resumeName;
+        finished = resumePointFinished;
+        return journalFileName != "empty.journal";
+    }
 };
 
 TEST_GROUP(CommandLineTestRunner)
@@ -241,6 +315,186 @@ TEST(CommandLineTestRunner, JunitOutputEnabled)
     );
 }
 
+TEST(CommandLineTestRunner, JunitSuitesOutputEnabled)
+{
+    const char* argv[] = {"tests.exe", "-ojunitsuites"};
+
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(
+        2, argv, &registry
+    );
+    commandLineTestRunner.runAllTestsMain();
+    CHECK(commandLineTestRunner.createdJUnitSuitesOutput);
+    CHECK(
+        commandLineTestRunner.fakeJUnitOutputWhichIsReallyABuffer_ != nullptr
+    );
+}
+
+TEST(CommandLineTestRunner, mergeJUnitFilesDoesNotRunTests)
+{
+    const char* argv[] = {"tests.exe", "-mergejunit", "merged.xml", "a.xml"};
+
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(
+        4, argv, &registry
+    );
+    LONGS_EQUAL(0, commandLineTestRunner.runAllTestsMain());
+    STRCMP_EQUAL(
+        "merged.xml", commandLineTestRunner.mergedJUnitFile.asCharString()
+    );
+    LONGS_EQUAL(1, commandLineTestRunner.mergedJUnitInputFileCount);
+    STRCMP_EQUAL(
+        "",
+        commandLineTestRunner.fakeConsoleOutputWhichIsReallyABuffer->getOutput()
+            .asCharString()
+    );
+}
+
+TEST(CommandLineTestRunner, failingJUnitMergeReturnsAnError)
+{
+    const char* argv[] = {
+        "tests.exe", "-mergejunit", "unwritable.xml", "a.xml"
+    };
+
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(
+        4, argv, &registry
+    );
+    LONGS_EQUAL(1, commandLineTestRunner.runAllTestsMain());
+    STRCMP_CONTAINS(
+        "Could not merge JUnit files into unwritable.xml",
+        commandLineTestRunner.fakeConsoleOutputWhichIsReallyABuffer->getOutput()
+            .asCharString()
+    );
+}
+
+TEST(CommandLineTestRunner, binaryOutputAlsoPrintsToTheConsole)
+{
+    const char* argv[] = {"tests.exe", "-obinary"};
+
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(
+        2, argv, &registry
+    );
+    commandLineTestRunner.runAllTestsMain();
+    STRCMP_CONTAINS(
+        "OK (",
+        commandLineTestRunner.fakeBinaryOutputWhichIsReallyABuffer->getOutput()
+            .asCharString()
+    );
+    STRCMP_CONTAINS(
+        "OK (",
+        commandLineTestRunner.fakeConsoleOutputWhichIsReallyABuffer->getOutput()
+            .asCharString()
+    );
+}
+
+TEST(CommandLineTestRunner, convertReplaysTheLogAndReturnsItsFailureCount)
+{
+    const char* argv[] = {"tests.exe", "-convert", "cpputest.bin"};
+
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(
+        3, argv, &registry
+    );
+    LONGS_EQUAL(3, commandLineTestRunner.runAllTestsMain());
+    STRCMP_EQUAL(
+        "cpputest.bin", commandLineTestRunner.replayedBinaryLog.asCharString()
+    );
+}
+
+TEST(CommandLineTestRunner, convertReportsAnUnreadableLog)
+{
+    const char* argv[] = {"tests.exe", "-convert", "corrupt.bin"};
+
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(
+        3, argv, &registry
+    );
+    commandLineTestRunner.runAllTestsMain();
+    STRCMP_CONTAINS(
+        "Could not read binary test log corrupt.bin",
+        commandLineTestRunner.fakeConsoleOutputWhichIsReallyABuffer->getOutput()
+            .asCharString()
+    );
+}
+
+TEST(CommandLineTestRunner, journalOutputAlsoPrintsToTheConsole)
+{
+    const char* argv[] = {"tests.exe", "-journal", "tests.journal"};
+
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(
+        3, argv, &registry
+    );
+    commandLineTestRunner.runAllTestsMain();
+    STRCMP_CONTAINS(
+        "OK (",
+        commandLineTestRunner.fakeJournalOutputWhichIsReallyABuffer->getOutput()
+            .asCharString()
+    );
+    STRCMP_CONTAINS(
+        "OK (",
+        commandLineTestRunner.fakeConsoleOutputWhichIsReallyABuffer->getOutput()
+            .asCharString()
+    );
+}
+
+TEST(CommandLineTestRunner, resumeReportsTheCrashedTestAsAFailure)
+{
+    const char* argv[] = {
+        "tests.exe", "-resume", "tests.journal", "-ojunit", "-v"
+    };
+
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(
+        5, argv, &registry
+    );
+    LONGS_EQUAL(1, commandLineTestRunner.runAllTestsMain());
+    STRCMP_EQUAL(
+        "tests.journal", commandLineTestRunner.resumedJournal.asCharString()
+    );
+    STRCMP_CONTAINS(
+        "Resuming after TEST(group1, test1), which did not finish",
+        commandLineTestRunner.fakeConsoleOutputWhichIsReallyABuffer->getOutput()
+            .asCharString()
+    );
+    STRCMP_CONTAINS(
+        "Crashed",
+        commandLineTestRunner.fakeJUnitOutputWhichIsReallyABuffer_->getOutput()
+            .asCharString()
+    );
+}
+
+TEST(CommandLineTestRunner, resumeAfterAFinishedTestIsNotAFailure)
+{
+    const char* argv[] = {"tests.exe", "-resume", "tests.journal"};
+    registry.addTest(test2);
+
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(
+        3, argv, &registry
+    );
+    commandLineTestRunner.resumeGroup = "group2";
+    commandLineTestRunner.resumeName = "test2";
+    commandLineTestRunner.resumePointFinished = true;
+    LONGS_EQUAL(0, commandLineTestRunner.runAllTestsMain());
+    cpputest::SimpleString output =
+        commandLineTestRunner.fakeConsoleOutputWhichIsReallyABuffer
+            ->getOutput();
+    STRCMP_CONTAINS(
+        "Resuming after TEST(group2, test2)\n", output.asCharString()
+    );
+    STRCMP_CONTAINS("1 ran", output.asCharString());
+    STRCMP_CONTAINS("1 skipped", output.asCharString());
+}
+
+TEST(CommandLineTestRunner, resumeWithoutAStartedTestRunsAllTests)
+{
+    const char* argv[] = {"tests.exe", "-resume", "empty.journal"};
+
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(
+        3, argv, &registry
+    );
+    LONGS_EQUAL(0, commandLineTestRunner.runAllTestsMain());
+    STRCMP_CONTAINS(
+        "No test to resume after in empty.journal, running all tests",
+        commandLineTestRunner.fakeConsoleOutputWhichIsReallyABuffer->getOutput()
+            .asCharString()
+    );
+}
+
 TEST(CommandLineTestRunner, JunitOutputAndVerboseEnabled)
 {
     const char* argv[] = {"tests.exe", "-ojunit", "-v"};
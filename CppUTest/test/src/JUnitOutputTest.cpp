@@ -38,6 +38,7 @@ class FileForJUnitOutputTests
     SimpleString name_;
     bool isOpen_;
     SimpleString buffer_;
+    size_t readPosition_;
     FileForJUnitOutputTests* next_;
 
     cpputest::SimpleStringCollection linesOfFile_;
@@ -48,6 +49,7 @@ public:
     ) :
         name_(filename),
         isOpen_(true),
+        readPosition_(0),
         next_(next)
     {
     }
@@ -67,9 +69,21 @@ public:
         buffer_ += buffer;
     }
 
+    size_t read(void* buffer, size_t size)
+    {
+        size_t available = buffer_.size() - readPosition_;
+        size_t length = (size < available) ? size : available;
+        char* destination = static_cast<char*>(buffer);
+        for (size_t i = 0; i < length; i++)
+            destination[i] = buffer_.at(readPosition_ + i);
+        readPosition_ += length;
+        return length;
+    }
+
     void close()
     {
         isOpen_ = false;
+        readPosition_ = 0;
     }
 
     const char* line(size_t lineNumber)
@@ -337,16 +351,28 @@ public:
 
 static FileSystemForJUnitTestOutputTests fileSystem;
 
-static PlatformSpecificFile mockFOpen(const char* filename, const char*)
+static int amountOfFPutsCalls = 0;
+
+static PlatformSpecificFile mockFOpen(const char* filename, const char* flag)
 {
+    if (SimpleString(flag) == "r")
+        return fileSystem.file(filename);
     return fileSystem.openFile(filename);
 }
 
 static void mockFPuts(const char* str, PlatformSpecificFile file)
 {
+    amountOfFPutsCalls++;
     reinterpret_cast<FileForJUnitOutputTests*>(file)->write(str);
 }
 
+static size_t mockFRead(void* buffer, size_t size, PlatformSpecificFile file)
+{
+    return reinterpret_cast<FileForJUnitOutputTests*>(file)->read(
+        buffer, size
+    );
+}
+
 static void mockFClose(PlatformSpecificFile file)
 {
     reinterpret_cast<FileForJUnitOutputTests*>(file)->close();
@@ -364,6 +390,8 @@ TEST_GROUP(JUnitOutputTest)
         UT_PTR_SET(PlatformSpecificFOpen, mockFOpen);
         UT_PTR_SET(PlatformSpecificFPuts, mockFPuts);
         UT_PTR_SET(PlatformSpecificFClose, mockFClose);
+        UT_PTR_SET(PlatformSpecificFRead, mockFRead);
+        amountOfFPutsCalls = 0;
         junitOutput = new cpputest::JUnitTestOutput();
         result = new cpputest::TestResult(*junitOutput);
         testCaseRunner = new JUnitTestOutputTestRunner(*result);
@@ -981,3 +1009,162 @@ TEST(JUnitOutputTest, UTPRINTOutputInJUnitOutputWithSpecials)
         outputFile->lineFromTheBack(3)
     );
 }
+
+TEST(JUnitOutputTest, groupFileIsWrittenWithASinglePut)
+{
+    testCaseRunner->start()
+        .withGroup("groupname")
+        .withTest("firstTest")
+        .withTest("secondTest")
+        .thatFails("Test failed", "thisfile", 10)
+        .withTest("thirdTest")
+        .end();
+
+    LONGS_EQUAL(1, amountOfFPutsCalls);
+}
+
+TEST(JUnitOutputTest, singleFileOutputWritesAllGroupsToOneFile)
+{
+    junitOutput->setSingleFileOutput(true);
+    testCaseRunner->start()
+        .withGroup("groupOne")
+        .withTest("testA")
+        .endGroupAndClearTest()
+        .withGroup("groupTwo")
+        .withTest("testB")
+        .end();
+
+    LONGS_EQUAL(1, fileSystem.amountOfFiles());
+    outputFile = fileSystem.file("cpputest.xml");
+    STRCMP_EQUAL(
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n", outputFile->line(1)
+    );
+    STRCMP_EQUAL("<testsuites>\n", outputFile->line(2));
+    STRCMP_EQUAL(
+        "<testsuite errors=\"0\" failures=\"0\" hostname=\"localhost\" "
+        "name=\"groupOne\" tests=\"1\" time=\"0.000\" "
+        "timestamp=\"1978-10-03T00:00:00\">\n",
+        outputFile->line(3)
+    );
+    STRCMP_EQUAL(
+        "<testcase classname=\"groupOne\" name=\"testA\" assertions=\"0\" "
+        "time=\"0.000\" file=\"file\" line=\"1\">\n",
+        outputFile->line(6)
+    );
+    STRCMP_EQUAL("</testsuite>\n", outputFile->line(10));
+    STRCMP_EQUAL(
+        "<testsuite errors=\"0\" failures=\"0\" hostname=\"localhost\" "
+        "name=\"groupTwo\" tests=\"1\" time=\"0.000\" "
+        "timestamp=\"1978-10-03T00:00:00\">\n",
+        outputFile->line(11)
+    );
+    STRCMP_EQUAL("</testsuites>\n", outputFile->lineFromTheBack(1));
+}
+
+TEST(JUnitOutputTest, singleFileOutputHoldsEveryRepetitionOfARun)
+{
+    junitOutput->setSingleFileOutput(true);
+    junitOutput->printTestRun(1, 2);
+    testCaseRunner->start()
+        .withGroup("groupOne")
+        .withTest("testA")
+        .endGroupAndClearTest();
+    result->testsEnded();
+    junitOutput->printTestRun(2, 2);
+    testCaseRunner->start()
+        .withGroup("groupOne")
+        .withTest("testA")
+        .endGroupAndClearTest();
+    result->testsEnded();
+
+    LONGS_EQUAL(1, fileSystem.amountOfFiles());
+    SimpleString content = fileSystem.file("cpputest.xml")->content();
+    LONGS_EQUAL(1, content.count("<testsuites>"));
+    LONGS_EQUAL(2, content.count("<testsuite "));
+    LONGS_EQUAL(1, content.count("</testsuites>"));
+}
+
+TEST(JUnitOutputTest, singleFileOutputWithAPackageName)
+{
+    junitOutput->setPackageName("packagename");
+    junitOutput->setSingleFileOutput(true);
+    testCaseRunner->start().withGroup("groupname").withTest("testname").end();
+
+    CHECK(fileSystem.fileExists("cpputest_packagename.xml"));
+}
+
+TEST(JUnitOutputTest, singleFileOutputKeepsStdoutOfEachGroupSeparate)
+{
+    junitOutput->setSingleFileOutput(true);
+    testCaseRunner->start()
+        .withGroup("groupOne")
+        .withTest("testA")
+        .thatPrints("first")
+        .endGroupAndClearTest()
+        .withGroup("groupTwo")
+        .withTest("testB")
+        .thatPrints("second")
+        .end();
+
+    outputFile = fileSystem.file("cpputest.xml");
+    STRCMP_EQUAL("<system-out>first</system-out>\n", outputFile->line(10));
+    STRCMP_EQUAL(
+        "<system-out>second</system-out>\n", outputFile->lineFromTheBack(4)
+    );
+}
+
+TEST(JUnitOutputTest, mergeFilesCombinesTheTestSuitesOfAllFiles)
+{
+    fileSystem.openFile("first.xml")
+        ->write(
+            "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n"
+            "<testsuite name=\"one\">\n"
+            "</testsuite>\n"
+        );
+    fileSystem.openFile("second.xml")
+        ->write(
+            "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n"
+            "<testsuites>\n"
+            "<testsuite name=\"two\">\n"
+            "</testsuite>\n"
+            "  </testsuites>"
+        );
+    const char* inputs[] = {"first.xml", "second.xml"};
+
+    CHECK(cpputest::JUnitTestOutput::mergeFiles("merged.xml", inputs, 2));
+
+    STRCMP_EQUAL(
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n"
+        "<testsuites>\n"
+        "<testsuite name=\"one\">\n"
+        "</testsuite>\n"
+        "<testsuite name=\"two\">\n"
+        "</testsuite>\n"
+        "</testsuites>\n",
+        fileSystem.file("merged.xml")->content().asCharString()
+    );
+}
+
+TEST(JUnitOutputTest, mergeFilesCopiesLongLinesUnchanged)
+{
+    SimpleString longLine = SimpleString("<system-out>") +
+                            SimpleString("output ", 100) + "</system-out>\n";
+    fileSystem.openFile("first.xml")->write(longLine);
+    const char* inputs[] = {"first.xml"};
+
+    CHECK(cpputest::JUnitTestOutput::mergeFiles("merged.xml", inputs, 1));
+
+    STRCMP_EQUAL(
+        longLine.asCharString(),
+        fileSystem.file("merged.xml")->lineFromTheBack(2)
+    );
+}
+
+TEST(JUnitOutputTest, mergeFilesFailsWhenAnInputIsMissing)
+{
+    fileSystem.openFile("first.xml")->write("<testsuite>\n</testsuite>\n");
+    const char* inputs[] = {"missing.xml", "first.xml"};
+
+    CHECK_FALSE(cpputest::JUnitTestOutput::mergeFiles("merged.xml", inputs, 2));
+    STRCMP_EQUAL("<testsuite>\n", fileSystem.file("merged.xml")->line(3));
+}
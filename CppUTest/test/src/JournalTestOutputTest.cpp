@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/JournalTestOutput.hpp"
+#include "CppUTest/PlatformSpecificFunctions.hpp"
+#include "CppUTest/TestHarness.hpp"
+#include "CppUTest/TestResult.hpp"
+
+using cpputest::SimpleString;
+
+static const size_t journalCapacity = 128 * 1024;
+static char journalData[journalCapacity + 1];
+static size_t journalSize = 0;
+static size_t journalReadPosition = 0;
+static bool journalExists = false;
+static int amountOfFFlushCalls = 0;
+
+static PlatformSpecificFile mockFOpen(const char*, const char* flag)
+{
+    if (flag[0] == 'r') {
+        journalReadPosition = 0;
+        return journalExists ? journalData : nullptr;
+    }
+    journalExists = true;
+    journalSize = 0;
+    return journalData;
+}
+
+static void mockFWrite(const void* buffer, size_t size, PlatformSpecificFile)
+{
+    const char* bytes = static_cast<const char*>(buffer);
+    for (size_t i = 0; i < size && journalSize < journalCapacity; i++)
+        journalData[journalSize++] = bytes[i];
+}
+
+static void mockFFlush(PlatformSpecificFile)
+{
+    amountOfFFlushCalls++;
+}
+
+static size_t mockFRead(void* buffer, size_t size, PlatformSpecificFile)
+{
+    char* bytes = static_cast<char*>(buffer);
+    size_t length = 0;
+    while (length < size && journalReadPosition < journalSize)
+        bytes[length++] = journalData[journalReadPosition++];
+    return length;
+}
+
+static void mockFClose(PlatformSpecificFile) {}
+
+TEST_GROUP(JournalTestOutput)
+{
+    cpputest::JournalTestOutput* journal;
+    cpputest::TestResult* result;
+    cpputest::UtestShell* firstTest;
+    cpputest::UtestShell* secondTest;
+    SimpleString group;
+    SimpleString name;
+    bool finished;
+
+    void setup() override
+    {
+        UT_PTR_SET(PlatformSpecificFOpen, mockFOpen);
+        UT_PTR_SET(PlatformSpecificFWrite, mockFWrite);
+        UT_PTR_SET(PlatformSpecificFFlush, mockFFlush);
+        UT_PTR_SET(PlatformSpecificFRead, mockFRead);
+        UT_PTR_SET(PlatformSpecificFClose, mockFClose);
+        journalSize = 0;
+        journalExists = false;
+        amountOfFFlushCalls = 0;
+        finished = false;
+
+        journal = new cpputest::JournalTestOutput("journal");
+        result = new cpputest::TestResult(*journal);
+        firstTest = new cpputest::UtestShell("group", "first", "file", 1);
+        secondTest = new cpputest::UtestShell("group", "second", "file", 2);
+    }
+
+    void teardown() override
+    {
+        delete secondTest;
+        delete firstTest;
+        delete result;
+        delete journal;
+    }
+
+    bool findLastStartedTest()
+    {
+        return cpputest::JournalTestOutput::findLastStartedTest(
+            "journal", group, name, finished
+        );
+    }
+};
+
+TEST(JournalTestOutput, everyRecordIsFlushedAsSoonAsItIsWritten)
+{
+    result->testsStarted();
+    result->currentTestStarted(firstTest);
+
+    CHECK(journalSize > 0);
+    LONGS_EQUAL(2, amountOfFFlushCalls);
+}
+
+TEST(JournalTestOutput, recordsAreReadableLines)
+{
+    result->currentTestStarted(firstTest);
+
+    journalData[journalSize] = '\0';
+    STRCMP_CONTAINS("\nS 5:group 5:first 0:\n", journalData);
+}
+
+TEST(JournalTestOutput, failuresAreRecordedWithTheirLocation)
+{
+    result->currentTestStarted(firstTest);
+    result->addFailure(
+        cpputest::TestFailure(firstTest, "failfile", 20, "failure message")
+    );
+
+    journalData[journalSize] = '\0';
+    STRCMP_CONTAINS(
+        "\nF 5:group 5:first 28:failfile:20: failure message\n",
+        journalData
+    );
+}
+
+TEST(JournalTestOutput, findsTheTestThatDidNotFinish)
+{
+    result->testsStarted();
+    result->currentTestStarted(firstTest);
+    result->currentTestEnded(firstTest);
+    result->currentTestStarted(secondTest);
+
+    CHECK(findLastStartedTest());
+    STRCMP_EQUAL("group", group.asCharString());
+    STRCMP_EQUAL("second", name.asCharString());
+    CHECK_FALSE(finished);
+}
+
+TEST(JournalTestOutput, findsTheLastTestOfACompleteRun)
+{
+    result->testsStarted();
+    result->currentTestStarted(firstTest);
+    result->currentTestEnded(firstTest);
+
+    CHECK(findLastStartedTest());
+    STRCMP_EQUAL("first", name.asCharString());
+    CHECK(finished);
+}
+
+TEST(JournalTestOutput, ignoresARecordTornByTheCrash)
+{
+    result->currentTestStarted(firstTest);
+    result->currentTestEnded(firstTest);
+    result->currentTestStarted(secondTest);
+    journalSize -= 3;
+
+    CHECK(findLastStartedTest());
+    STRCMP_EQUAL("first", name.asCharString());
+    CHECK(finished);
+}
+
+TEST(JournalTestOutput, aJournalWithoutTestsHasNothingToResume)
+{
+    result->testsStarted();
+
+    CHECK_FALSE(findLastStartedTest());
+}
+
+TEST(JournalTestOutput, aMissingJournalHasNothingToResume)
+{
+    CHECK_FALSE(findLastStartedTest());
+}
+
+TEST(JournalTestOutput, aFileThatIsNotAJournalHasNothingToResume)
+{
+    mockFOpen("journal", "w");
+    for (size_t i = 0; i < 1024; i++)
+        mockFWrite("S", 1, nullptr);
+
+    CHECK_FALSE(findLastStartedTest());
+}
+
+TEST(JournalTestOutput, findsTestsWithLongNames)
+{
+    SimpleString longGroup("group", 60);
+    SimpleString longName("name", 100);
+    cpputest::UtestShell longTest(
+        longGroup.asCharString(), longName.asCharString(), "file", 3
+    );
+    result->testsStarted();
+    result->currentTestStarted(&longTest);
+
+    CHECK(findLastStartedTest());
+    STRCMP_EQUAL(longGroup.asCharString(), group.asCharString());
+    STRCMP_EQUAL(longName.asCharString(), name.asCharString());
+}
+
+TEST(JournalTestOutput, resumesAfterAFailureLongerThanAField)
+{
+    SimpleString longMessage("message ", 10000);
+    result->testsStarted();
+    result->currentTestStarted(firstTest);
+    result->addFailure(cpputest::TestFailure(
+        firstTest, "failfile", 20, longMessage.asCharString()
+    ));
+    result->currentTestEnded(firstTest);
+    result->currentTestStarted(secondTest);
+
+    CHECK(findLastStartedTest());
+    STRCMP_EQUAL("second", name.asCharString());
+    CHECK_FALSE(finished);
+}
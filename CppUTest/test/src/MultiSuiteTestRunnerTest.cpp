@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "CppUTest/MultiSuiteTestRunner.hpp"
+#include "CppUTest/PlatformSpecificFunctions.hpp"
+#include "CppUTest/TestHarness.hpp"
+#include "CppUTest/TestRegistry.hpp"
+#include "QuietCommandLineTestRunner.h"
+
+using cpputest::MultiSuiteTestRunner;
+using cpputest::SimpleString;
+using cpputest::TestRegistry;
+using cpputest::UtestShell;
+
+static UtestShell mathTest1("Math", "first", "file", 1);
+static UtestShell mathTest2("Math", "second", "file", 2);
+static UtestShell ioTest("Io", "only", "file", 1);
+static int libraryHandle;
+
+// Stands in for dlopen running the static TestInstallers of a library.
+static PlatformSpecificLibrary mockLibraryOpen(const char* path)
+{
+    TestRegistry* registry = TestRegistry::getCurrentRegistry();
+    if (SimpleString(path).contains("math")) {
+        registry->addTest(&mathTest2);
+        registry->addTest(&mathTest1);
+    } else if (SimpleString(path).contains("io")) {
+        registry->addTest(&ioTest);
+    } else
+        return nullptr;
+    return &libraryHandle;
+}
+
+static void mockLibraryClose(PlatformSpecificLibrary) {}
+
+static long mockFileStamp(const char*)
+{
+    return 1;
+}
+
+class MultiSuiteTestRunnerForTest : public MultiSuiteTestRunner
+{
+public:
+    MultiSuiteTestRunnerForTest() :
+        registryDuringRun(nullptr)
+    {
+    }
+
+    SimpleString testsRun;
+    TestRegistry* registryDuringRun;
+
+protected:
+    virtual int
+    runTests(int, const char* const*, TestRegistry* registry) override
+    {
+        registryDuringRun = TestRegistry::getCurrentRegistry();
+        for (UtestShell* test = registry->getFirstTest(); test;
+             test = test->getNext()) {
+            testsRun += test->getFormattedName();
+            testsRun += "\n";
+        }
+        return static_cast<int>(registry->countTests());
+    }
+};
+
+TEST_GROUP(MultiSuiteTestRunner)
+{
+    MultiSuiteTestRunnerForTest* runner;
+
+    void setup() override
+    {
+        UT_PTR_SET(PlatformSpecificLibraryOpen, mockLibraryOpen);
+        UT_PTR_SET(PlatformSpecificLibraryClose, mockLibraryClose);
+        UT_PTR_SET(PlatformSpecificFileStamp, mockFileStamp);
+        runner = new MultiSuiteTestRunnerForTest;
+    }
+
+    void teardown() override
+    {
+        delete runner;
+        mathTest1.setGroupName("Math");
+        mathTest2.setGroupName("Math");
+        ioTest.setGroupName("Io");
+    }
+};
+
+TEST(MultiSuiteTestRunner, suiteIsTheLibraryFileNameWithoutLibAndExtension)
+{
+    STRCMP_EQUAL(
+        "math",
+        MultiSuiteTestRunner::suiteNameOf("build/tests/libmath.so.1")
+            .asCharString()
+    );
+    STRCMP_EQUAL(
+        "io_tests",
+        MultiSuiteTestRunner::suiteNameOf("C:\\build\\io_tests.dll")
+            .asCharString()
+    );
+    STRCMP_EQUAL(
+        "lib", MultiSuiteTestRunner::suiteNameOf("lib").asCharString()
+    );
+}
+
+TEST(MultiSuiteTestRunner, groupsOfAnAddedSuiteAreQualifiedWithTheSuite)
+{
+    CHECK_TRUE(runner->addSuite("libmath.so"));
+
+    LONGS_EQUAL(1, runner->countSuites());
+    LONGS_EQUAL(2, runner->countTests());
+    STRCMP_EQUAL("math.Math", mathTest1.getGroup().asCharString());
+    STRCMP_EQUAL("math.Math", mathTest2.getGroup().asCharString());
+}
+
+TEST(MultiSuiteTestRunner, libraryThatCannotBeLoadedIsNotAdded)
+{
+    CHECK_FALSE(runner->addSuite("libmissing.so"));
+
+    LONGS_EQUAL(0, runner->countSuites());
+    LONGS_EQUAL(0, runner->countTests());
+}
+
+TEST(MultiSuiteTestRunner, allSuitesRunInOneRegistryInTheirOwnOrder)
+{
+    TestRegistry* current = TestRegistry::getCurrentRegistry();
+    runner->addSuite("libmath.so");
+    runner->addSuite("libio.so");
+
+    LONGS_EQUAL(3, runner->runAllSuites(0, nullptr));
+
+    STRCMP_EQUAL(
+        "TEST(math.Math, first)\n"
+        "TEST(math.Math, second)\n"
+        "TEST(io.Io, only)\n",
+        runner->testsRun.asCharString()
+    );
+    CHECK(runner->registryDuringRun != current);
+    POINTERS_EQUAL(current, TestRegistry::getCurrentRegistry());
+}
+
+TEST(MultiSuiteTestRunner, suitesCanBeRunMoreThanOnce)
+{
+    runner->addSuite("libio.so");
+    runner->addSuite("libmath.so");
+    runner->runAllSuites(0, nullptr);
+    runner->testsRun = "";
+
+    LONGS_EQUAL(3, runner->runAllSuites(0, nullptr));
+
+    STRCMP_EQUAL(
+        "TEST(io.Io, only)\n"
+        "TEST(math.Math, first)\n"
+        "TEST(math.Math, second)\n",
+        runner->testsRun.asCharString()
+    );
+}
+
+#ifdef CPPUTEST_OTHER_TEST_LIBRARY
+
+    #include <unistd.h>
+
+// Runs the suites quietly, keeping their output.
+class QuietMultiSuiteTestRunner : public MultiSuiteTestRunner
+{
+public:
+    SimpleString output;
+
+protected:
+    virtual int
+    runTests(int ac, const char* const* av, TestRegistry* registry) override
+    {
+        QuietCommandLineTestRunner runner(ac, av, registry, output);
+        return runner.runAllTestsMain();
+    }
+};
+
+// The process number printed by the next printsItsProcess test.
+static int nextProcess(const char*& output)
+{
+    output = SimpleString::StrStr(output, "<process ");
+    if (output == nullptr)
+        return 0;
+    output += SimpleString::StrLen("<process ");
+    return SimpleString::AtoI(output);
+}
+
+TEST_GROUP(MultiSuiteTestRunnerWithLibraries)
+{
+    QuietMultiSuiteTestRunner runner;
+};
+
+TEST(MultiSuiteTestRunnerWithLibraries, workersRunTheSuitesInOtherProcesses)
+{
+    CHECK_TRUE(runner.addSuite(CPPUTEST_TEST_LIBRARY));
+    CHECK_TRUE(runner.addSuite(CPPUTEST_OTHER_TEST_LIBRARY));
+    const char* av[] = {"runner", "-j", "2"};
+
+    LONGS_EQUAL(0, runner.runAllSuites(3, av));
+
+    STRCMP_CONTAINS("OK (6 tests", runner.output.asCharString());
+    const char* output = runner.output.asCharString();
+    int first = nextProcess(output);
+    int second = nextProcess(output);
+    CHECK(first != 0 && second != 0);
+    CHECK(first != second);
+    CHECK(first != static_cast<int>(getpid()));
+    CHECK(second != static_cast<int>(getpid()));
+}
+
+#endif
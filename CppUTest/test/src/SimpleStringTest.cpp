@@ -1068,6 +1068,27 @@ TEST(SimpleString, MemCmpFirstLastNotMatching)
     CHECK(0 != SimpleString::MemCmp(base, lastNotMatching, sizeof(base)));
 }
 
+TEST(SimpleString, FirstMismatch)
+{
+    unsigned char base[] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                            0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+                            0x10, 0x11, 0x12};
+    unsigned char other[sizeof(base)];
+
+    for (size_t mismatch = 0; mismatch < sizeof(base); mismatch++) {
+        for (size_t i = 0; i < sizeof(base); i++)
+            other[i] = base[i];
+        other[mismatch] = 0xFF;
+        UNSIGNED_LONGS_EQUAL(
+            mismatch, SimpleString::FirstMismatch(base, other, sizeof(base))
+        );
+    }
+    UNSIGNED_LONGS_EQUAL(
+        sizeof(base), SimpleString::FirstMismatch(base, base, sizeof(base))
+    );
+    UNSIGNED_LONGS_EQUAL(0, SimpleString::FirstMismatch(nullptr, nullptr, 0));
+}
+
 #if (CHAR_BIT == 16)
 TEST(SimpleString, MaskedBitsChar)
 {
@@ -143,4 +143,21 @@ TEST(TestFailureNanAndInf, DoublesEqualThresholdIsInf)
     );
 }
 
+TEST(TestFailureNanAndInf, DoublesArrayEqualWithAnInfiniteError)
+{
+    const double expected[] = {1.0, 2.0};
+    const double actual[] = {1.5, static_cast<double>(INFINITY)};
+    cpputest::DoublesArrayEqualFailure f(
+        test, failFileName, failLineNumber, expected, actual, 2,
+        cpputest::DoublesTolerance::absolute(0.1), ""
+    );
+    FAILURE_EQUAL(
+        "expected <2> elements to be equal within absolute tolerance <0.1>\n"
+        "\tbut <2> differ, max absolute error <Inf - Infinity>\n"
+        "\tindex 0: expected <1> but was <1.5>\n"
+        "\tindex 1: expected <2> but was <Inf - Infinity>",
+        f
+    );
+}
+
 #endif
@@ -110,6 +110,54 @@ TEST(TestFailure, EqualsFailureWithNullAsExpected)
     FAILURE_EQUAL("expected <(null)>\n\tbut was  <actual>", f);
 }
 
+TEST(TestFailure, DoublesArrayEqualFailure)
+{
+    const double expected[] = {0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0};
+    const double actual[] = {0.0, 1.5, 2.0, 3.25, 4.5, 5.5, 6.5, 7.5};
+    cpputest::DoublesArrayEqualFailure f(
+        test, failFileName, failLineNumber, expected, actual, 8,
+        cpputest::DoublesTolerance::absolute(0.1), ""
+    );
+    FAILURE_EQUAL(
+        "expected <8> elements to be equal within absolute tolerance <0.1>\n"
+        "\tbut <6> differ, max absolute error <0.5>\n"
+        "\tindex 1: expected <1> but was <1.5>\n"
+        "\tindex 3: expected <3> but was <3.25>\n"
+        "\tindex 4: expected <4> but was <4.5>\n"
+        "\tindex 5: expected <5> but was <5.5>\n"
+        "\tindex 6: expected <6> but was <6.5>\n"
+        "\t...",
+        f
+    );
+}
+
+TEST(TestFailure, DoublesArrayEqualFailureWithNullActual)
+{
+    const double expected[] = {0.0};
+    cpputest::DoublesArrayEqualFailure f(
+        test, failFileName, failLineNumber, expected, nullptr, 1,
+        cpputest::DoublesTolerance::absolute(0.1), "text"
+    );
+    STRCMP_CONTAINS("Message: text\n", f.getMessage().asCharString());
+    STRCMP_CONTAINS("but was  <(null)>", f.getMessage().asCharString());
+}
+
+TEST(TestFailure, LongsArrayEqualFailure)
+{
+    const long expected[] = {1, 2, 3};
+    const long actual[] = {1, -2, 3};
+    cpputest::LongsArrayEqualFailure f(
+        test, failFileName, failLineNumber, expected, actual, 3, ""
+    );
+    cpputest::SimpleString expectedMessage = cpputest::StringFromFormat(
+        "expected <3> elements to be equal\n"
+        "\tbut <1> differ, max absolute difference <4>\n"
+        "\tindex 1: expected <2 (0x2)> but was <-2 %s>",
+        cpputest::BracketsFormattedHexStringFrom(-2L).asCharString()
+    );
+    FAILURE_EQUAL(expectedMessage.asCharString(), f);
+}
+
 TEST(TestFailure, CheckEqualFailureWithText)
 {
     cpputest::CheckEqualFailure f(
@@ -401,6 +449,104 @@ TEST(TestFailure, StringsEqualNoCaseFailure2)
     );
 }
 
+TEST(TestFailure, StringsEqualFailureOnLongStringsShowsExcerpt)
+{
+    cpputest::SimpleString expected("a", 300);
+    cpputest::SimpleString actual = cpputest::SimpleString("a", 150) + "b" +
+                                    cpputest::SimpleString("a", 149);
+    cpputest::StringEqualFailure f(
+        test, failFileName, failLineNumber, expected.asCharString(),
+        actual.asCharString(), ""
+    );
+    cpputest::SimpleString expectedMessage =
+        cpputest::SimpleString("expected <...") +
+        cpputest::SimpleString("a", 64) +
+        "...>\n"
+        "\tbut was  <..." +
+        cpputest::SimpleString("a", 32) + "b" +
+        cpputest::SimpleString("a", 31) +
+        "...>\n"
+        "\tdifference starts at position 150 at: <aaaaaaaaaabaaaaaaaaa>\n"
+        "\t                                                 ^";
+    FAILURE_EQUAL(expectedMessage.asCharString(), f);
+}
+
+TEST(TestFailure, StringsEqualFailureOnLongStringWithNullShowsExcerpt)
+{
+    cpputest::SimpleString expected("a", 300);
+    cpputest::StringEqualFailure f(
+        test, failFileName, failLineNumber, expected.asCharString(), nullptr,
+        ""
+    );
+    cpputest::SimpleString expectedMessage =
+        cpputest::SimpleString("expected <") + cpputest::SimpleString("a", 64) +
+        "...>\n"
+        "\tbut was  <(null)>";
+    FAILURE_EQUAL(expectedMessage.asCharString(), f);
+}
+
+TEST(TestFailure, StringsEqualNoCaseFailureOnLongStringsShowsExcerpt)
+{
+    cpputest::SimpleString expected("a", 300);
+    cpputest::SimpleString actual = cpputest::SimpleString("A", 10) + "b" +
+                                    cpputest::SimpleString("A", 289);
+    cpputest::StringEqualNoCaseFailure f(
+        test, failFileName, failLineNumber, expected.asCharString(),
+        actual.asCharString(), ""
+    );
+    cpputest::SimpleString expectedMessage =
+        cpputest::SimpleString("expected <") + cpputest::SimpleString("a", 64) +
+        "...>\n"
+        "\tbut was  <" +
+        cpputest::SimpleString("A", 10) + "b" +
+        cpputest::SimpleString("A", 53) +
+        "...>\n"
+        "\tdifference starts at position 10 at: <AAAAAAAAAAbAAAAAAAAA>\n"
+        "\t                                                ^";
+    FAILURE_EQUAL(expectedMessage.asCharString(), f);
+}
+
+static cpputest::SimpleString
+numberedLines(const char* prefix, int count, int changedLine = -1)
+{
+    cpputest::SimpleString lines;
+    for (int i = 0; i < count; i++)
+        lines += (i == changedLine)
+                     ? cpputest::SimpleString("changed\n")
+                     : cpputest::StringFromFormat("%s %d\n", prefix, i);
+    return lines;
+}
+
+TEST(TestFailure, StringsEqualFailureOnLongTextShowsLineDiff)
+{
+    cpputest::SimpleString expected = numberedLines("line", 40);
+    cpputest::SimpleString actual = numberedLines("line", 40, 20);
+    cpputest::StringEqualFailure f(
+        test, failFileName, failLineNumber, expected.asCharString(),
+        actual.asCharString(), ""
+    );
+    STRCMP_CONTAINS(
+        "\n\tline diff (- expected, + actual):\n"
+        "\t- 21: <line 20>\n"
+        "\t+ 21: <changed>",
+        f.getMessage().asCharString()
+    );
+}
+
+TEST(TestFailure, StringsEqualFailureOnVeryDifferentTextSkipsLineDiff)
+{
+    cpputest::SimpleString expected = numberedLines("expected", 100);
+    cpputest::SimpleString actual = numberedLines("actual", 100);
+    cpputest::StringEqualFailure f(
+        test, failFileName, failLineNumber, expected.asCharString(),
+        actual.asCharString(), ""
+    );
+    STRCMP_CONTAINS(
+        "\n\tline diff skipped: more than 64 lines differ",
+        f.getMessage().asCharString()
+    );
+}
+
 TEST(TestFailure, DoublesEqualNormalWithText)
 {
     cpputest::DoublesEqualFailure f(
@@ -555,6 +701,26 @@ TEST(TestFailure, BinaryEqualExpectedNull)
     FAILURE_EQUAL("expected <(null)>\n\tbut was  <00 00 00 00 00 00 01>", f);
 }
 
+TEST(TestFailure, BinaryEqualOnLargeBuffersShowsExcerpt)
+{
+    unsigned char expectedData[200] = {0};
+    unsigned char actualData[200] = {0};
+    actualData[100] = 0x01;
+    cpputest::BinaryEqualFailure f(
+        test, failFileName, failLineNumber, expectedData, actualData,
+        sizeof(expectedData), ""
+    );
+    FAILURE_EQUAL(
+        "expected <... 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 "
+        "00 00 00 00 00 00 00 00 00 00 00 00 00 00 ...>\n"
+        "\tbut was  <... 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 01 00 "
+        "00 00 00 00 00 00 00 00 00 00 00 00 00 00 ...>\n"
+        "\tdifference starts at position 100 at: <00 00 00 01 00 00 00>\n"
+        "\t                                                 ^",
+        f
+    );
+}
+
 TEST(TestFailure, BitsEqualWithText)
 {
     cpputest::BitsEqualFailure f(
@@ -408,6 +408,13 @@ TEST(CompositeTestOutput, TestStartedAndEnded)
     );
 }
 
+TEST(CompositeTestOutput, TestRun)
+{
+    compositeOutput.printTestRun(1, 2);
+    STRCMP_EQUAL("Test run 1 of 2\n", output1->getOutput().asCharString());
+    STRCMP_EQUAL("Test run 1 of 2\n", output2->getOutput().asCharString());
+}
+
 TEST(CompositeTestOutput, CurrentTestStartedAndEnded)
 {
     compositeOutput.printCurrentTestStarted(*test);
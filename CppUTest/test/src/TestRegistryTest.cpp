@@ -29,6 +29,7 @@
 #include "CppUTest/PlatformSpecificFunctions.hpp"
 #include "CppUTest/TestHarness.hpp"
 #include "CppUTest/TestOutput.hpp"
+#include "CppUTest/TestResultCache.hpp"
 
 using namespace cpputest;
 
@@ -42,15 +43,70 @@ class MockTest : public UtestShell
 public:
     MockTest(const char* group = "Group") :
         UtestShell(group, "Name", "File", testLineNumber),
-        hasRun_(false)
+        hasRun_(false),
+        willRun_(true),
+        fails_(false),
+        groupSetupFails_(false),
+        groupSetups_(0),
+        groupTeardowns_(0)
     {
     }
-    virtual void runOneTest(TestPlugin*, TestResult&) override
+    virtual void runOneTest(TestPlugin*, TestResult& result) override
     {
         hasRun_ = true;
+        if (fails_)
+            result.addFailure(TestFailure(this, "failed"));
+    }
+    virtual bool willRun() const override
+    {
+        return willRun_;
+    }
+    virtual bool runGroupSetupOnce(TestResult& result) override
+    {
+        groupSetups_++;
+        if (groupSetupFails_)
+            result.addFailure(TestFailure(this, "group setup failed"));
+        return !groupSetupFails_;
+    }
+    virtual void runGroupTeardownOnce(TestResult&) override
+    {
+        groupTeardowns_++;
     }
 
     bool hasRun_;
+    bool willRun_;
+    bool fails_;
+    bool groupSetupFails_;
+    int groupSetups_;
+    int groupTeardowns_;
+};
+
+class MockTestResultCache : public TestResultCache
+{
+public:
+    MockTestResultCache() :
+        TestResultCache("cache", ""),
+        cachedTest_(nullptr),
+        passedTest_(nullptr),
+        failedTest_(nullptr)
+    {
+    }
+    virtual bool hasPassed(const UtestShell& test) override
+    {
+        return &test == cachedTest_;
+    }
+    virtual void recordPass(const UtestShell& test) override
+    {
+        passedTest_ = &test;
+    }
+    virtual void recordFailure(const UtestShell& test) override
+    {
+        failedTest_ = &test;
+    }
+
+    const UtestShell* cachedTest_;
+    const UtestShell* passedTest_;
+    const UtestShell* failedTest_;
 };
 
 class MockTestResult : public TestResult
@@ -287,6 +343,70 @@ TEST(TestRegistry, groupFilterWorks)
     CHECK(!test2->hasRun_);
 }
 
+TEST(TestRegistry, groupFixtureIsSetUpOnceAroundTheTestsOfEachGroup)
+{
+    addAndRunAllTests();
+    LONGS_EQUAL(1, test3->groupSetups_);
+    LONGS_EQUAL(1, test3->groupTeardowns_);
+    LONGS_EQUAL(1, test1->groupSetups_ + test2->groupSetups_);
+    LONGS_EQUAL(1, test1->groupTeardowns_ + test2->groupTeardowns_);
+}
+
+TEST(TestRegistry, groupFixtureIsNotSetUpWhenNoTestOfTheGroupIsSelected)
+{
+    TestFilter groupFilter("group2");
+    myRegistry->setGroupFilters(&groupFilter);
+    addAndRunAllTests();
+    LONGS_EQUAL(1, test3->groupSetups_);
+    LONGS_EQUAL(0, test1->groupSetups_ + test2->groupSetups_);
+    LONGS_EQUAL(0, test1->groupTeardowns_ + test2->groupTeardowns_);
+}
+
+TEST(TestRegistry, groupFixtureIsNotSetUpForTestsThatWillNotRun)
+{
+    test3->willRun_ = false;
+    addAndRunAllTests();
+    LONGS_EQUAL(0, test3->groupSetups_);
+    LONGS_EQUAL(0, test3->groupTeardowns_);
+}
+
+TEST(TestRegistry, groupFixtureIsSetUpAgainForEachRepetition)
+{
+    myRegistry->addTest(test1);
+    myRegistry->runAllTests(*result);
+    myRegistry->runAllTests(*result);
+    LONGS_EQUAL(2, test1->groupSetups_);
+    LONGS_EQUAL(2, test1->groupTeardowns_);
+}
+
+TEST(TestRegistry, testsOfAGroupWhoseSetupFailedFailWithoutRunning)
+{
+    MockTestResultCache cache;
+    test1->groupSetupFails_ = true;
+    test2->groupSetupFails_ = true;
+    myRegistry->setResultCache(&cache);
+    addAndRunAllTests();
+    CHECK(!test1->hasRun_);
+    CHECK(!test2->hasRun_);
+    CHECK(test3->hasRun_);
+    LONGS_EQUAL(2, result->getFailureCount());
+    LONGS_EQUAL(3, mockResult->countCurrentTestEnded);
+    LONGS_EQUAL(1, test1->groupTeardowns_ + test2->groupTeardowns_);
+    POINTERS_EQUAL(test3, cache.passedTest_);
+    POINTERS_EQUAL(test1, cache.failedTest_);
+}
+
+TEST(TestRegistry, failedGroupSetupDoesNotAffectTheNextRepetition)
+{
+    myRegistry->addTest(test1);
+    test1->groupSetupFails_ = true;
+    myRegistry->runAllTests(*result);
+    test1->groupSetupFails_ = false;
+    myRegistry->runAllTests(*result);
+    CHECK(test1->hasRun_);
+    LONGS_EQUAL(1, result->getFailureCount());
+}
+
 TEST(TestRegistry, runTestInSeperateProcess)
 {
     myRegistry->setRunTestsInSeperateProcess();
@@ -419,3 +539,266 @@ TEST(TestRegistry, reverseZeroTests)
 
     CHECK(nullptr == myRegistry->getFirstTest());
 }
+
+TEST(TestRegistry, resumeAfterTestSkipsTheTestsUpToAndIncludingIt)
+{
+    myRegistry->addTest(test1);
+    myRegistry->addTest(test3);
+    myRegistry->resumeAfterTest("group2", "Name", true);
+    myRegistry->runAllTests(*result);
+    CHECK(!test3->hasRun_);
+    CHECK(test1->hasRun_);
+    LONGS_EQUAL(1, result->getSkippedCount());
+    LONGS_EQUAL(0, result->getFilteredOutCount());
+}
+
+TEST(TestRegistry, resumeAfterATestThatDidNotFinishReportsItAsAFailure)
+{
+    myRegistry->addTest(test1);
+    myRegistry->addTest(test3);
+    myRegistry->resumeAfterTest("group2", "Name", false);
+    myRegistry->runAllTests(*result);
+    CHECK(!test3->hasRun_);
+    CHECK(test1->hasRun_);
+    LONGS_EQUAL(1, result->getFailureCount());
+    LONGS_EQUAL(0, result->getSkippedCount());
+    STRCMP_CONTAINS("Crashed", output->getOutput().asCharString());
+}
+
+TEST(TestRegistry, resumeAfterTestOnlyAppliesToTheNextRun)
+{
+    myRegistry->addTest(test1);
+    myRegistry->addTest(test3);
+    myRegistry->resumeAfterTest("group2", "Name", true);
+    myRegistry->runAllTests(*result);
+    test1->hasRun_ = false;
+    myRegistry->runAllTests(*result);
+    CHECK(test3->hasRun_);
+    CHECK(test1->hasRun_);
+}
+
+TEST(TestRegistry, resumeAfterAnUnknownTestRunsAllTests)
+{
+    myRegistry->addTest(test1);
+    myRegistry->addTest(test3);
+    myRegistry->resumeAfterTest("group3", "Name", true);
+    myRegistry->runAllTests(*result);
+    CHECK(test3->hasRun_);
+    CHECK(test1->hasRun_);
+}
+
+TEST(TestRegistry, cachedPassIsCountedInsteadOfRun)
+{
+    MockTestResultCache cache;
+    cache.cachedTest_ = test1;
+    myRegistry->setResultCache(&cache);
+    addAndRunAllTests();
+    CHECK(!test1->hasRun_);
+    CHECK(test2->hasRun_);
+    LONGS_EQUAL(1, result->getCachedCount());
+    LONGS_EQUAL(3, mockResult->countCurrentTestEnded);
+}
+
+TEST(TestRegistry, resultOfEveryRunTestIsRecordedInTheCache)
+{
+    MockTestResultCache cache;
+    test2->fails_ = true;
+    myRegistry->setResultCache(&cache);
+    myRegistry->addTest(test1);
+    myRegistry->addTest(test2);
+    myRegistry->runAllTests(*result);
+    POINTERS_EQUAL(test1, cache.passedTest_);
+    POINTERS_EQUAL(test2, cache.failedTest_);
+}
+
+TEST(TestRegistry, testsThatWillNotRunAreNeitherCachedNorRecorded)
+{
+    MockTestResultCache cache;
+    cache.cachedTest_ = test1;
+    test1->willRun_ = false;
+    myRegistry->setResultCache(&cache);
+    myRegistry->addTest(test1);
+    myRegistry->runAllTests(*result);
+    CHECK(test1->hasRun_);
+    LONGS_EQUAL(0, result->getCachedCount());
+    POINTERS_EQUAL(nullptr, cache.passedTest_);
+}
+
+#ifdef CPPUTEST_HAVE_FORK
+
+static int changedByWorkerTest = 0;
+
+static void passingWorkerTest()
+{
+    changedByWorkerTest++;
+    CHECK(true);
+}
+
+static void failingWorkerTest()
+{
+    FAIL("worker test failed");
+}
+
+class WorkerTest : public ExecFunctionTestShell
+{
+public:
+    WorkerTest(const char* group, const char* name, void (*body)()) :
+        hasGroupFixture_(false),
+        body_(body)
+    {
+        setGroupName(group);
+        setTestName(name);
+        testFunction_ = &body_;
+    }
+
+    virtual bool hasGroupFixture() const override
+    {
+        return hasGroupFixture_;
+    }
+
+    bool hasGroupFixture_;
+
+private:
+    ExecFunctionWithoutParameters body_;
+};
+
+// Records the order in which the steps of a run are reported.
+class OrderRecordingTestResult : public TestResult
+{
+public:
+    OrderRecordingTestResult(TestOutput& output) : TestResult(output) {}
+
+    virtual void currentGroupStarted(UtestShell* test) override
+    {
+        TestResult::currentGroupStarted(test);
+        order += "[";
+        order += test->getGroup();
+    }
+    virtual void currentGroupEnded(UtestShell* test) override
+    {
+        TestResult::currentGroupEnded(test);
+        order += "]";
+    }
+    virtual void currentTestStarted(UtestShell* test) override
+    {
+        TestResult::currentTestStarted(test);
+        order += " ";
+        order += test->getName();
+    }
+
+    SimpleString order;
+};
+
+TEST_GROUP(TestRegistryWorkers)
+{
+    TestRegistry registry;
+    StringBufferTestOutput output;
+    OrderRecordingTestResult* result;
+    WorkerTest* first;
+    WorkerTest* second;
+    WorkerTest* third;
+
+    void setup() override
+    {
+        result = new OrderRecordingTestResult(output);
+        changedByWorkerTest = 0;
+        first = new WorkerTest("a", "first", passingWorkerTest);
+        second = new WorkerTest("a", "second", failingWorkerTest);
+        third = new WorkerTest("b", "third", passingWorkerTest);
+        registry.addTest(third);
+        registry.addTest(second);
+        registry.addTest(first);
+        registry.setWorkerCount(2);
+    }
+
+    void teardown() override
+    {
+        delete first;
+        delete second;
+        delete third;
+        delete result;
+    }
+};
+
+TEST(TestRegistryWorkers, testsRunInChildProcesses)
+{
+    registry.runAllTests(*result);
+
+    LONGS_EQUAL(0, changedByWorkerTest);
+    LONGS_EQUAL(3, result->getRunCount());
+    LONGS_EQUAL(3, result->getCheckCount());
+    LONGS_EQUAL(1, result->getFailureCount());
+    STRCMP_CONTAINS("worker test failed", output.getOutput().asCharString());
+}
+
+TEST(TestRegistryWorkers, resultsAreReportedInTestOrder)
+{
+    registry.runAllTests(*result);
+
+    STRCMP_EQUAL("[a first second][b third]", result->order.asCharString());
+}
+
+TEST(TestRegistryWorkers, groupWithAFixtureIsSetUpInOrder)
+{
+    first->hasGroupFixture_ = true;
+    registry.runAllTests(*result);
+
+    STRCMP_EQUAL("[a first second][b third]", result->order.asCharString());
+    LONGS_EQUAL(1, result->getFailureCount());
+}
+
+TEST(TestRegistryWorkers, testsAreNotLeftRunningInSeperateProcesses)
+{
+    registry.runAllTests(*result);
+
+    CHECK_FALSE(first->isRunInSeperateProcess());
+    CHECK_FALSE(second->isRunInSeperateProcess());
+    CHECK_FALSE(third->isRunInSeperateProcess());
+}
+
+static int (*originalWaitAnyChild)(int*) = nullptr;
+static int waitAnyChildCalls = 0;
+
+static int countingWaitAnyChild(int* status)
+{
+    waitAnyChildCalls++;
+    return originalWaitAnyChild(status);
+}
+
+static int unsupportedWaitAnyChild(int*)
+{
+    return -1;
+}
+
+TEST(TestRegistryWorkers, aWorkerIsFreedByAnyChildThatExits)
+{
+    originalWaitAnyChild = PlatformSpecificWaitAnyChild;
+    waitAnyChildCalls = 0;
+    UT_PTR_SET(PlatformSpecificWaitAnyChild, countingWaitAnyChild);
+    registry.runAllTests(*result);
+
+    LONGS_EQUAL(1, waitAnyChildCalls);
+    LONGS_EQUAL(3, result->getRunCount());
+    STRCMP_EQUAL("[a first second][b third]", result->order.asCharString());
+}
+
+TEST(TestRegistryWorkers, withoutWaitingForAnyChildStepsAreReportedInOrder)
+{
+    UT_PTR_SET(PlatformSpecificWaitAnyChild, unsupportedWaitAnyChild);
+    registry.runAllTests(*result);
+
+    LONGS_EQUAL(3, result->getRunCount());
+    LONGS_EQUAL(1, result->getFailureCount());
+    STRCMP_EQUAL("[a first second][b third]", result->order.asCharString());
+}
+
+TEST(TestRegistryWorkers, moreWorkersThanTestsRunThemAll)
+{
+    registry.setWorkerCount(8);
+    registry.runAllTests(*result);
+
+    LONGS_EQUAL(3, result->getRunCount());
+    STRCMP_EQUAL("[a first second][b third]", result->order.asCharString());
+}
+
+#endif
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "CppUTest/TestResultCache.hpp"
+#include "CppUTest/PlatformSpecificFunctions.hpp"
+#include "CppUTest/TestHarness.hpp"
+
+using cpputest::SimpleString;
+using cpputest::TestResultCache;
+
+struct FakeFile
+{
+    SimpleString contents;
+    bool exists;
+    size_t readPosition;
+};
+
+static FakeFile cacheFile;
+static FakeFile binaryFile;
+static const char* libraryPath = "tests";
+
+static PlatformSpecificFile mockFOpen(const char* name, const char* flag)
+{
+    FakeFile* file = (SimpleString(name) == "tests") ? &binaryFile : &cacheFile;
+    if (flag[0] == 'r') {
+        file->readPosition = 0;
+        return file->exists ? file : nullptr;
+    }
+    file->exists = true;
+    file->contents = "";
+    return file;
+}
+
+static size_t mockFRead(void* buffer, size_t size, PlatformSpecificFile file)
+{
+    FakeFile* fake = static_cast<FakeFile*>(file);
+    char* bytes = static_cast<char*>(buffer);
+    size_t length = 0;
+    while (length < size && fake->readPosition < fake->contents.size())
+        bytes[length++] = fake->contents.asCharString()[fake->readPosition++];
+    return length;
+}
+
+static void mockFPuts(const char* text, PlatformSpecificFile file)
+{
+    static_cast<FakeFile*>(file)->contents += text;
+}
+
+static void mockFClose(PlatformSpecificFile) {}
+
+static const char* mockLibraryPathOf(const void*)
+{
+    return libraryPath;
+}
+
+TEST_GROUP(TestResultCache)
+{
+    cpputest::UtestShell* test;
+    cpputest::UtestShell* otherTest;
+
+    void setup() override
+    {
+        UT_PTR_SET(PlatformSpecificFOpen, mockFOpen);
+        UT_PTR_SET(PlatformSpecificFRead, mockFRead);
+        UT_PTR_SET(PlatformSpecificFPuts, mockFPuts);
+        UT_PTR_SET(PlatformSpecificFClose, mockFClose);
+        UT_PTR_SET(PlatformSpecificLibraryPathOf, mockLibraryPathOf);
+        cacheFile.contents = "";
+        cacheFile.exists = false;
+        binaryFile.contents = "binary";
+        binaryFile.exists = true;
+        libraryPath = "tests";
+        test = new cpputest::UtestShell("group", "test", "file", 1);
+        otherTest = new cpputest::UtestShell("group", "other", "file", 2);
+    }
+
+    void teardown() override
+    {
+        delete otherTest;
+        delete test;
+    }
+
+    void runAndSavePassOf(
+        cpputest::UtestShell* passedTest, const char* runOptions = "-v"
+    )
+    {
+        TestResultCache cache("cache", runOptions);
+        cache.load();
+        cache.recordPass(*passedTest);
+        cache.save();
+    }
+};
+
+TEST(TestResultCache, missingCacheFileLeavesTheCacheEmpty)
+{
+    TestResultCache cache("cache", "-v");
+
+    CHECK_FALSE(cache.load());
+    CHECK_FALSE(cache.hasPassed(*test));
+}
+
+TEST(TestResultCache, passIsOnlySkippedInALaterRun)
+{
+    TestResultCache cache("cache", "-v");
+    cache.recordPass(*test);
+
+    CHECK_FALSE(cache.hasPassed(*test));
+}
+
+TEST(TestResultCache, savedPassIsFoundByTheNextRun)
+{
+    runAndSavePassOf(test);
+
+    TestResultCache cache("cache", "-v");
+    CHECK_TRUE(cache.load());
+
+    CHECK_TRUE(cache.hasPassed(*test));
+    CHECK_FALSE(cache.hasPassed(*otherTest));
+    STRCMP_CONTAINS(" group.test\n", cacheFile.contents.asCharString());
+}
+
+TEST(TestResultCache, rebuiltBinaryRunsItsTestsAgain)
+{
+    runAndSavePassOf(test);
+    binaryFile.contents = "rebuilt binary";
+
+    TestResultCache cache("cache", "-v");
+    cache.load();
+
+    CHECK_FALSE(cache.hasPassed(*test));
+}
+
+TEST(TestResultCache, otherRunOptionsRunTheTestsAgain)
+{
+    runAndSavePassOf(test, "-v");
+
+    TestResultCache cache("cache", "-v -f");
+    cache.load();
+
+    CHECK_FALSE(cache.hasPassed(*test));
+}
+
+TEST(TestResultCache, failureDropsTheEarlierPass)
+{
+    runAndSavePassOf(test);
+    TestResultCache failingRun("cache", "-v");
+    failingRun.load();
+    failingRun.recordFailure(*test);
+    failingRun.save();
+
+    TestResultCache cache("cache", "-v");
+    cache.load();
+
+    CHECK_FALSE(cache.hasPassed(*test));
+}
+
+TEST(TestResultCache, passesOfTestsThatDidNotRunAreKept)
+{
+    runAndSavePassOf(test);
+    runAndSavePassOf(otherTest);
+
+    TestResultCache cache("cache", "-v");
+    cache.load();
+
+    CHECK_TRUE(cache.hasPassed(*test));
+    CHECK_TRUE(cache.hasPassed(*otherTest));
+}
+
+TEST(TestResultCache, ignoredCacheStillRecordsThePasses)
+{
+    runAndSavePassOf(test);
+    TestResultCache ignoringRun("cache", "-v");
+    ignoringRun.load();
+    ignoringRun.ignoreCachedResults();
+
+    CHECK_FALSE(ignoringRun.hasPassed(*test));
+    ignoringRun.recordPass(*otherTest);
+    ignoringRun.save();
+
+    TestResultCache cache("cache", "-v");
+    cache.load();
+    CHECK_TRUE(cache.hasPassed(*test));
+    CHECK_TRUE(cache.hasPassed(*otherTest));
+}
+
+TEST(TestResultCache, testsOfAnUnknownBinaryAreNeverCached)
+{
+    libraryPath = nullptr;
+    runAndSavePassOf(test);
+
+    TestResultCache cache("cache", "-v");
+    cache.load();
+
+    CHECK_FALSE(cache.hasPassed(*test));
+}
+
+TEST(TestResultCache, cacheFileOfAnotherVersionIsNotRead)
+{
+    runAndSavePassOf(test);
+    cacheFile.contents.replace("cache 1", "cache 0");
+
+    TestResultCache cache("cache", "-v");
+
+    CHECK_FALSE(cache.load());
+    CHECK_FALSE(cache.hasPassed(*test));
+}
@@ -63,6 +63,13 @@ TEST(TestResult, TestEndedWillPrintResultsAndExecutionTime)
     CHECK(mock->getOutput().contains("10 ms"));
 }
 
+TEST(TestResult, ChecksCanBeAddedInBulk)
+{
+    res->countCheck();
+    res->addChecks(1000);
+    LONGS_EQUAL(1001, res->getCheckCount());
+}
+
 TEST(TestResult, ResultIsOkIfTestIsRunWithNoFailures)
 {
     res->countTest();
@@ -98,3 +105,11 @@ TEST(TestResult, ResultIsNotOkIfNoTestsRunOrIgnored)
     res->countTest();
     CHECK_TRUE(res->isFailure());
 }
+
+TEST(TestResult, CurrentTestAndGroupExecutionTimesCanBeSet)
+{
+    res->setCurrentTestTotalExecutionTime(7);
+    res->setCurrentGroupTotalExecutionTime(42);
+    LONGS_EQUAL(7, res->getCurrentTestTotalExecutionTime());
+    LONGS_EQUAL(42, res->getCurrentGroupTotalExecutionTime());
+}
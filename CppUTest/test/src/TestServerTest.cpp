@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestServer.hpp"
+#include "CppUTest/PlatformSpecificFunctions.hpp"
+#include "CppUTest/TestHarness.hpp"
+#include "CppUTest/TestRegistry.hpp"
+#include "QuietCommandLineTestRunner.h"
+
+using cpputest::SimpleString;
+using cpputest::TestRegistry;
+
+static cpputest::UtestShell libraryTest1("group", "first", "file", 1);
+static cpputest::UtestShell libraryTest2("group", "second", "file", 2);
+static int libraryHandle;
+static bool libraryCanBeOpened = true;
+static bool libraryRegistersTests = true;
+static int amountOfLibraryOpens = 0;
+static int amountOfLibraryCloses = 0;
+static long libraryStamp = 1;
+static const char* requestData = "";
+
+// Stands in for dlopen running the static TestInstallers of a library.
+static PlatformSpecificLibrary mockLibraryOpen(const char*)
+{
+    amountOfLibraryOpens++;
+    if (!libraryCanBeOpened)
+        return nullptr;
+    if (libraryRegistersTests) {
+        TestRegistry::getCurrentRegistry()->addTest(&libraryTest1);
+        TestRegistry::getCurrentRegistry()->addTest(&libraryTest2);
+    }
+    return &libraryHandle;
+}
+
+static void mockLibraryClose(PlatformSpecificLibrary)
+{
+    amountOfLibraryCloses++;
+}
+
+static long mockFileStamp(const char*)
+{
+    return libraryStamp;
+}
+
+static size_t mockFRead(void* buffer, size_t size, PlatformSpecificFile)
+{
+    char* bytes = static_cast<char*>(buffer);
+    size_t length = 0;
+    while (length < size && *requestData != '\0')
+        bytes[length++] = *requestData++;
+    return length;
+}
+
+class TestServerForTest : public cpputest::TestServer
+{
+public:
+    TestServerForTest() :
+        cpputest::TestServer("libtests.so"),
+        amountOfRuns(0),
+        registryDuringRun(nullptr)
+    {
+    }
+
+    int amountOfRuns;
+    SimpleString arguments;
+    TestRegistry* registryDuringRun;
+
+protected:
+    virtual int
+    runTests(int ac, const char* const* av, TestRegistry* registry) override
+    {
+        amountOfRuns++;
+        arguments = "";
+        for (int i = 0; i < ac; i++) {
+            arguments += (i == 0) ? "" : " ";
+            arguments += av[i];
+        }
+        registryDuringRun = TestRegistry::getCurrentRegistry();
+        return static_cast<int>(registry->countTests());
+    }
+};
+
+// The server flushes after every request, which would empty the buffer.
+class KeptStringBufferTestOutput : public cpputest::StringBufferTestOutput
+{
+public:
+    void flush() override {}
+};
+
+TEST_GROUP(TestServer)
+{
+    TestServerForTest* server;
+    KeptStringBufferTestOutput output;
+
+    void setup() override
+    {
+        UT_PTR_SET(PlatformSpecificLibraryOpen, mockLibraryOpen);
+        UT_PTR_SET(PlatformSpecificLibraryClose, mockLibraryClose);
+        UT_PTR_SET(PlatformSpecificFileStamp, mockFileStamp);
+        UT_PTR_SET(PlatformSpecificFRead, mockFRead);
+        libraryCanBeOpened = true;
+        libraryRegistersTests = true;
+        amountOfLibraryOpens = 0;
+        amountOfLibraryCloses = 0;
+        libraryStamp = 1;
+        server = new TestServerForTest;
+    }
+
+    void teardown() override
+    {
+        delete server;
+    }
+};
+
+TEST(TestServer, libraryTestsAreRegisteredInAFreshRegistry)
+{
+    TestRegistry* current = TestRegistry::getCurrentRegistry();
+
+    CHECK_TRUE(server->load());
+
+    LONGS_EQUAL(2, server->getRegistry()->countTests());
+    CHECK(server->getRegistry() != current);
+    POINTERS_EQUAL(current, TestRegistry::getCurrentRegistry());
+}
+
+TEST(TestServer, libraryThatCannotBeOpenedIsNotLoaded)
+{
+    libraryCanBeOpened = false;
+
+    CHECK_FALSE(server->load());
+
+    CHECK_FALSE(server->isLoaded());
+    POINTERS_EQUAL(nullptr, server->getRegistry());
+}
+
+TEST(TestServer, libraryThatRegistersNoTestsIsNotLoaded)
+{
+    libraryRegistersTests = false;
+
+    CHECK_FALSE(server->load());
+
+    POINTERS_EQUAL(nullptr, server->getRegistry());
+    LONGS_EQUAL(1, amountOfLibraryCloses);
+    STRCMP_CONTAINS(
+        "libtests.so registered no tests",
+        server->getLoadError().asCharString()
+    );
+}
+
+TEST(TestServer, unloadDropsTheRegistryAndClosesTheLibrary)
+{
+    server->load();
+    server->unload();
+
+    CHECK_FALSE(server->isLoaded());
+    POINTERS_EQUAL(nullptr, server->getRegistry());
+    LONGS_EQUAL(1, amountOfLibraryCloses);
+}
+
+TEST(TestServer, libraryIsReloadedOnlyWhenItsFileChanged)
+{
+    server->load();
+    CHECK_FALSE(server->reloadIfChanged());
+
+    libraryStamp++;
+    CHECK_TRUE(server->reloadIfChanged());
+
+    LONGS_EQUAL(2, amountOfLibraryOpens);
+    LONGS_EQUAL(1, amountOfLibraryCloses);
+    LONGS_EQUAL(2, server->getRegistry()->countTests());
+}
+
+TEST(TestServer, requestWordsAreTheArgumentsOfTheRun)
+{
+    server->load();
+
+    LONGS_EQUAL(2, server->runRequest(" -g  group\t-v "));
+
+    STRCMP_EQUAL("libtests.so -g group -v", server->arguments.asCharString());
+    POINTERS_EQUAL(server->getRegistry(), server->registryDuringRun);
+}
+
+TEST(TestServer, serveRunsEveryRequestUntilQuit)
+{
+    requestData = "-v\n-g group\r\nquit\n-n never\n";
+
+    LONGS_EQUAL(0, server->serve(nullptr, output));
+
+    LONGS_EQUAL(2, server->amountOfRuns);
+    LONGS_EQUAL(1, amountOfLibraryOpens);
+    STRCMP_CONTAINS("Loaded libtests.so\n", output.getOutput().asCharString());
+    STRCMP_EQUAL("libtests.so -g group", server->arguments.asCharString());
+    LONGS_EQUAL(2, output.getOutput().count("-- done 2\n"));
+}
+
+TEST(TestServer, serveStopsAtTheEndOfTheRequests)
+{
+    requestData = "-v";
+
+    server->serve(nullptr, output);
+
+    LONGS_EQUAL(1, server->amountOfRuns);
+}
+
+TEST(TestServer, serveReportsALibraryThatCannotBeLoaded)
+{
+    libraryCanBeOpened = false;
+    requestData = "-v\n";
+
+    server->serve(nullptr, output);
+
+    LONGS_EQUAL(0, server->amountOfRuns);
+    STRCMP_CONTAINS(
+        "Could not load libtests.so\n-- done 1\n",
+        output.getOutput().asCharString()
+    );
+}
+
+TEST(TestServer, serveReportsALibraryThatDidNotRegisterItsTestsAgain)
+{
+    requestData = "-v\n-v\n";
+    server->load();
+    libraryStamp++;
+    libraryRegistersTests = false;
+
+    server->serve(nullptr, output);
+
+    LONGS_EQUAL(0, server->amountOfRuns);
+    STRCMP_CONTAINS("STB_GNU_UNIQUE", output.getOutput().asCharString());
+}
+
+TEST(TestServer, requestsLongerThanTheReadBufferAreKeptWhole)
+{
+    SimpleString request;
+    for (int i = 0; i < 100; i++)
+        request += "-v ";
+    SimpleString data = request + "-n last\n";
+    requestData = data.asCharString();
+
+    server->serve(nullptr, output);
+
+    STRCMP_EQUAL(
+        (SimpleString("libtests.so ") + request + "-n last").asCharString(),
+        server->arguments.asCharString()
+    );
+}
+
+#ifdef CPPUTEST_TEST_LIBRARY
+
+// Runs the requests quietly, keeping the output of the last one.
+class QuietTestServer : public cpputest::TestServer
+{
+public:
+    QuietTestServer() : cpputest::TestServer(CPPUTEST_TEST_LIBRARY) {}
+
+    SimpleString runOutput;
+
+protected:
+    virtual int
+    runTests(int ac, const char* const* av, TestRegistry* registry) override
+    {
+        QuietCommandLineTestRunner runner(ac, av, registry, runOutput);
+        return runner.runAllTestsMain();
+    }
+};
+
+TEST_GROUP(TestServerWithALibrary)
+{
+    QuietTestServer server;
+};
+
+TEST(TestServerWithALibrary, testsOfTheLibraryRunOnRequest)
+{
+    CHECK_TRUE(server.load());
+
+    LONGS_EQUAL(3, server.getRegistry()->countTests());
+    LONGS_EQUAL(0, server.runRequest("-v"));
+    STRCMP_CONTAINS(
+        "TEST(LoadedLibrary, passes)", server.runOutput.asCharString()
+    );
+    STRCMP_CONTAINS("OK (3 tests", server.runOutput.asCharString());
+}
+
+TEST(TestServerWithALibrary, libraryRegistersItsTestsAgainWhenReloaded)
+{
+    server.load();
+    server.unload();
+
+    CHECK_TRUE(server.load());
+
+    LONGS_EQUAL(3, server.getRegistry()->countTests());
+}
+
+TEST(TestServerWithALibrary, libraryThatStayedLoadedIsReported)
+{
+    server.load();
+    PlatformSpecificLibrary kept =
+        PlatformSpecificLibraryOpen(CPPUTEST_TEST_LIBRARY);
+    server.unload();
+
+    bool loaded = server.load();
+    PlatformSpecificLibraryClose(kept);
+
+    CHECK_FALSE(loaded);
+    STRCMP_CONTAINS(
+        "registered no tests", server.getLoadError().asCharString()
+    );
+}
+
+#endif
@@ -1158,6 +1158,113 @@ TEST(UnitTestMacros, allMacrosFromFunctionThatReturnsAValue)
     functionThatReturnsAValue();
 }
 
+static void failingTestMethodWithDOUBLES_ARRAY_EQUAL_()
+{
+    const double expected[] = {1.0, 2.0, 3.0};
+    const double actual[] = {1.0, 2.5, 3.0};
+    DOUBLES_ARRAY_EQUAL(expected, actual, 3, 0.1);
+    cpputest::TestTestingFixture::lineExecutedAfterCheck(); // LCOV_EXCL_LINE
+} // LCOV_EXCL_LINE
+
+TEST(UnitTestMacros, FailureWithDOUBLES_ARRAY_EQUAL)
+{
+    fixture.runTestWithMethod(failingTestMethodWithDOUBLES_ARRAY_EQUAL_);
+    CHECK_TEST_FAILS_PROPER_WITH_TEXT(
+        "expected <3> elements to be equal within absolute tolerance <0.1>"
+    );
+    CHECK_TEST_FAILS_PROPER_WITH_TEXT("index 1: expected <2> but was <2.5>");
+}
+
+static void failingTestMethodWithDOUBLES_ARRAY_EQUAL_TOLERANCE_TEXT_()
+{
+    const double expected[] = {1.0, 2.0, 3.0};
+    const double actual[] = {1.0, 2.0, 3.5};
+    DOUBLES_ARRAY_EQUAL_TOLERANCE_TEXT(
+        expected, actual, 3, cpputest::DoublesTolerance::relative(0.1),
+        "Failed because it failed"
+    );
+    cpputest::TestTestingFixture::lineExecutedAfterCheck(); // LCOV_EXCL_LINE
+} // LCOV_EXCL_LINE
+
+TEST(UnitTestMacros, FailureWithDOUBLES_ARRAY_EQUAL_TOLERANCE_TEXT)
+{
+    fixture.runTestWithMethod(
+        failingTestMethodWithDOUBLES_ARRAY_EQUAL_TOLERANCE_TEXT_
+    );
+    CHECK_TEST_FAILS_PROPER_WITH_TEXT("relative tolerance <0.1>");
+    CHECK_TEST_FAILS_PROPER_WITH_TEXT("index 2: expected <3> but was <3.5>");
+    CHECK_TEST_FAILS_PROPER_WITH_TEXT("Failed because it failed");
+}
+
+TEST(UnitTestMacros, DOUBLES_ARRAY_EQUALBehavesAsProperMacro)
+{
+    const double expected[] = {1.0, 2.0};
+    const double actual[] = {1.0, 2.05};
+    if (false)
+        DOUBLES_ARRAY_EQUAL(expected, actual, 2, 0.0);
+    else
+        DOUBLES_ARRAY_EQUAL(expected, actual, 2, 0.1);
+}
+
+TEST(UnitTestMacros, DOUBLES_ARRAY_EQUALNullArrays)
+{
+    DOUBLES_ARRAY_EQUAL(nullptr, nullptr, 10, 0.1);
+    DOUBLES_ARRAY_EQUAL_TEXT(nullptr, nullptr, 10, 0.1, "Shouldn't fail");
+}
+
+IGNORE_TEST(UnitTestMacros, DOUBLES_ARRAY_EQUALWorksInAnIgnoredTest)
+{
+    const double expected[] = {1.0};
+    const double actual[] = {2.0};
+    DOUBLES_ARRAY_EQUAL(expected, actual, 1, 0.1); // LCOV_EXCL_LINE
+} // LCOV_EXCL_LINE
+
+static void failingTestMethodWithLONGS_ARRAY_EQUAL_()
+{
+    const long expected[] = {1, 2, 3, 4};
+    const long actual[] = {1, 2, 3, 5};
+    LONGS_ARRAY_EQUAL(expected, actual, 4);
+    cpputest::TestTestingFixture::lineExecutedAfterCheck(); // LCOV_EXCL_LINE
+} // LCOV_EXCL_LINE
+
+TEST(UnitTestMacros, FailureWithLONGS_ARRAY_EQUAL)
+{
+    fixture.runTestWithMethod(failingTestMethodWithLONGS_ARRAY_EQUAL_);
+    CHECK_TEST_FAILS_PROPER_WITH_TEXT("expected <4> elements to be equal");
+    CHECK_TEST_FAILS_PROPER_WITH_TEXT(
+        "index 3: expected <4 (0x4)> but was <5 (0x5)>"
+    );
+}
+
+static void failingTestMethodWithLONGS_ARRAY_EQUAL_TEXT_()
+{
+    const long expected[] = {1, 2};
+    LONGS_ARRAY_EQUAL_TEXT(expected, nullptr, 2, "Failed because it failed");
+    cpputest::TestTestingFixture::lineExecutedAfterCheck(); // LCOV_EXCL_LINE
+} // LCOV_EXCL_LINE
+
+TEST(UnitTestMacros, FailureWithLONGS_ARRAY_EQUAL_TEXT)
+{
+    fixture.runTestWithMethod(failingTestMethodWithLONGS_ARRAY_EQUAL_TEXT_);
+    CHECK_TEST_FAILS_PROPER_WITH_TEXT("but was  <(null)>");
+    CHECK_TEST_FAILS_PROPER_WITH_TEXT("Failed because it failed");
+}
+
+TEST(UnitTestMacros, LONGS_ARRAY_EQUALBehavesAsProperMacro)
+{
+    const long values[] = {1, 2, 3};
+    if (false)
+        LONGS_ARRAY_EQUAL(values, values + 1, 2);
+    else
+        LONGS_ARRAY_EQUAL(values, values, 3);
+}
+
+IGNORE_TEST(UnitTestMacros, LONGS_ARRAY_EQUALWorksInAnIgnoredTest)
+{
+    const long values[] = {1, 2, 3};
+    LONGS_ARRAY_EQUAL(values, values + 1, 2); // LCOV_EXCL_LINE
+} // LCOV_EXCL_LINE
+
 TEST(UnitTestMacros, MEMCMP_EQUALBehavesAsAProperMacro)
 {
     if (false)
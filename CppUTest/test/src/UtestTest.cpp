@@ -93,6 +93,68 @@ TEST(UtestShell, compareDoublesInf)
 }
 #endif
 
+TEST(UtestShell, doublesToleranceAbsolute)
+{
+    cpputest::DoublesTolerance tolerance =
+        cpputest::DoublesTolerance::absolute(0.01);
+    CHECK(tolerance.matches(1.0, 1.005));
+    CHECK(!tolerance.matches(1.0, 1.02));
+    STRCMP_EQUAL(
+        "absolute tolerance <0.01>", tolerance.toString().asCharString()
+    );
+}
+
+TEST(UtestShell, doublesToleranceRelative)
+{
+    cpputest::DoublesTolerance tolerance =
+        cpputest::DoublesTolerance::relative(0.01);
+    CHECK(tolerance.matches(1000.0, 1009.0));
+    CHECK(!tolerance.matches(1000.0, 1011.0));
+    CHECK(!tolerance.matches(0.0, 0.001));
+    STRCMP_EQUAL(
+        "relative tolerance <0.01>", tolerance.toString().asCharString()
+    );
+}
+
+TEST(UtestShell, doublesToleranceUlps)
+{
+    cpputest::DoublesTolerance tolerance = cpputest::DoublesTolerance::ulps(2);
+    double oneUlpAboveOne = 1.0 + 2.220446049250313e-16;
+    CHECK(tolerance.matches(1.0, oneUlpAboveOne));
+    CHECK(!tolerance.matches(1.0, 1.0 + 1e-15));
+    CHECK(tolerance.matches(0.0, -0.0));
+    STRCMP_EQUAL("tolerance of <2> ULPs", tolerance.toString().asCharString());
+}
+
+#ifdef NAN
+TEST(UtestShell, doublesToleranceNaN)
+{
+    double nan = static_cast<double>(NAN);
+    cpputest::DoublesTolerance tolerance =
+        cpputest::DoublesTolerance::absolute(0.01);
+    CHECK(!tolerance.matches(nan, nan));
+    CHECK(!tolerance.matches(nan, 1.0));
+    CHECK(tolerance.withNanEqualsNan().matches(nan, nan));
+    CHECK(!tolerance.withNanEqualsNan().matches(nan, 1.0));
+    STRCMP_EQUAL(
+        "absolute tolerance <0.01>, NaN equals NaN",
+        tolerance.withNanEqualsNan().toString().asCharString()
+    );
+}
+#endif
+
+#ifdef INFINITY
+TEST(UtestShell, doublesToleranceInf)
+{
+    double inf = static_cast<double>(INFINITY);
+    cpputest::DoublesTolerance tolerance =
+        cpputest::DoublesTolerance::relative(0.5);
+    CHECK(tolerance.matches(inf, inf));
+    CHECK(!tolerance.matches(inf, -inf));
+    CHECK(!tolerance.matches(inf, 1.0));
+}
+#endif
+
 TEST(UtestShell, FailWillIncreaseTheAmountOfChecks)
 {
     fixture.setTestFunction(failMethod_);
@@ -480,6 +542,178 @@ TEST(IgnoredUtestShell, runIgnoredOptionSpecifiedThenWillRunReturnTrue)
     CHECK_TRUE(ignoredTest.willRun());
 }
 
+class FailingGroupFixtureShell : public UtestShell
+{
+public:
+    virtual void setupGroupOnce() override
+    {
+        FAIL("group setup failed");
+    }
+};
+
+TEST(UtestShell, FailureInGroupSetupOnceIsReported)
+{
+    StringBufferTestOutput output;
+    TestResult result(output);
+    FailingGroupFixtureShell shell;
+    UtestShell* current = UtestShell::getCurrent();
+
+    shell.runGroupSetupOnce(result);
+
+    POINTERS_EQUAL(current, UtestShell::getCurrent());
+    LONGS_EQUAL(1, result.getFailureCount());
+    STRCMP_CONTAINS("group setup failed", output.getOutput().asCharString());
+}
+
+static int forkUnsupported()
+{
+    return -1;
+}
+
+TEST(UtestShell, TestRunsInThisProcessWhenItCannotFork)
+{
+    UT_PTR_SET(PlatformSpecificFork, forkUnsupported);
+    fixture.setRunTestsInSeperateProcess();
+    fixture.setTestFunction(failMethod_);
+    fixture.runAllTests();
+    LONGS_EQUAL(1, fixture.getFailureCount());
+    fixture.assertPrintContains("This test fails");
+}
+
+#ifdef CPPUTEST_HAVE_FORK
+
+static int changedInChildProcess = 0;
+
+static void changeStateAndPassMethod_()
+{
+    changedInChildProcess++;
+    CHECK(true);
+    CHECK(true);
+}
+
+static void crashMethod_()
+{
+    UtestShell::crash();
+}
+
+TEST(UtestShell, FailureInChildProcessIsReportedToTheParent)
+{
+    fixture.setRunTestsInSeperateProcess();
+    fixture.setTestFunction(failMethod_);
+    fixture.runAllTests();
+    LONGS_EQUAL(1, fixture.getFailureCount());
+    LONGS_EQUAL(1, fixture.getCheckCount());
+    fixture.assertPrintContains("This test fails");
+}
+
+static void longsEqualFailMethod_()
+{
+    LONGS_EQUAL(1, 2);
+}
+
+TEST(UtestShell, FailureMessageOfChildProcessKeepsItsDetails)
+{
+    fixture.setRunTestsInSeperateProcess();
+    fixture.setTestFunction(longsEqualFailMethod_);
+    fixture.runAllTests();
+    LONGS_EQUAL(1, fixture.getFailureCount());
+    fixture.assertPrintContains("expected <1 (0x1)>");
+    fixture.assertPrintContains("but was  <2 (0x2)>");
+}
+
+TEST(UtestShell, ChildProcessLeavesTheParentUnchanged)
+{
+    fixture.setRunTestsInSeperateProcess();
+    fixture.setTestFunction(changeStateAndPassMethod_);
+    fixture.runAllTests();
+    LONGS_EQUAL(0, fixture.getFailureCount());
+    LONGS_EQUAL(2, fixture.getCheckCount());
+    LONGS_EQUAL(0, changedInChildProcess);
+}
+
+TEST(UtestShell, CrashInChildProcessIsReportedAsAFailure)
+{
+    fixture.setRunTestsInSeperateProcess();
+    fixture.setTestFunction(crashMethod_);
+    fixture.runAllTests();
+    LONGS_EQUAL(1, fixture.getFailureCount());
+    fixture.assertPrintContains(
+        "Failed in separate process - killed by signal"
+    );
+}
+
+static void exitInTheMiddleMethod_()
+{
+    CHECK(true);
+    PlatformSpecificExitChild(0);
+}
+
+TEST(UtestShell, ChildProcessThatEndsWithoutReportingIsReportedAsAFailure)
+{
+    fixture.setRunTestsInSeperateProcess();
+    fixture.setTestFunction(exitInTheMiddleMethod_);
+    fixture.runAllTests();
+    LONGS_EQUAL(1, fixture.getFailureCount());
+    fixture.assertPrintContains(
+        "Failed in separate process - crashed before reporting back"
+    );
+}
+
+static int snapshotFixture = 0;
+
+TEST_GROUP(UtestGroupSnapshots)
+{
+    TEST_GROUP_SNAPSHOT_SETUP_ONCE()
+    {
+        snapshotFixture = 1;
+    }
+
+    TEST_GROUP_TEARDOWN_ONCE()
+    {
+        snapshotFixture = 0;
+    }
+};
+
+TEST(UtestGroupSnapshots, testStartsFromTheSetUpFixture)
+{
+    LONGS_EQUAL(1, snapshotFixture);
+    snapshotFixture = 2;
+}
+
+TEST(UtestGroupSnapshots, testDoesNotSeeChangesOfOtherTests)
+{
+    LONGS_EQUAL(1, snapshotFixture);
+    snapshotFixture = 3;
+}
+
+#endif
+
+static int groupSetupOnceCount = 0;
+static int groupTeardownOnceCount = 0;
+
+TEST_GROUP(UtestGroupSetupOnce)
+{
+    TEST_GROUP_SETUP_ONCE()
+    {
+        groupSetupOnceCount++;
+    }
+
+    TEST_GROUP_TEARDOWN_ONCE()
+    {
+        groupTeardownOnceCount++;
+    }
+};
+
+TEST(UtestGroupSetupOnce, groupIsSetUpOnceBeforeItsFirstTest)
+{
+    LONGS_EQUAL(groupTeardownOnceCount + 1, groupSetupOnceCount);
+}
+
+TEST(UtestGroupSetupOnce, groupIsNotSetUpAgainForItsSecondTest)
+{
+    LONGS_EQUAL(groupTeardownOnceCount + 1, groupSetupOnceCount);
+}
+
 TEST_BASE(MyOwnTest)
 {
     MyOwnTest() : inTest(false) {}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_MockArena_h
+#define D_MockArena_h
+
+#include <stddef.h>
+
+namespace cpputest
+{
+    namespace extensions
+    {
+        /*
+         * MockArena hands out memory from large blocks and gives all of it
+         * back at once in release(). MockSupport keeps its expectations in
+         * one, so making and clearing many expectations costs a few block
+         * allocations instead of several allocations per expectation.
+         * Objects placed in the arena still need their destructors run
+         * before release().
+         */
+
+        struct MockArenaBlock;
+        class MockArena
+        {
+        public:
+            MockArena();
+            ~MockArena();
+
+            void* allocate(size_t size);
+            void release();
+
+            size_t blockCount() const;
+
+            static const size_t blockSize = 16 * 1024;
+
+        private:
+            MockArenaBlock* blocks_;
+            char* next_;
+            size_t remaining_;
+
+            MockArena(const MockArena&);
+            MockArena& operator=(const MockArena&);
+        };
+    }
+}
+
+// Places an object in the arena: new (arena) Type(...). Its destructor
+// must be called explicitly; the memory goes back with release().
+void* operator new(size_t size, cpputest::extensions::MockArena& arena);
+void operator delete(void* memory, cpputest::extensions::MockArena& arena);
+
+#endif
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef D_MockCallHistory_h
+#define D_MockCallHistory_h
+
+#include "CppUTestExt/MockActualCall.hpp"
+#include "CppUTestExt/MockArena.hpp"
+
+/*
+ * Checks how often a spied function was called, in total or by the calls
+ * the predicate accepts.
+ */
+#define CHECK_CALL_COUNT(expected, history, function)                          \
+    UNSIGNED_LONGS_EQUAL_TEXT(                                                 \
+        (expected), (history).countCalls(function),                           \
+        (cpputest::SimpleString("calls to ") + (function)).asCharString()      \
+    )
+
+#define CHECK_MATCHING_CALL_COUNT(expected, history, function, matches)        \
+    UNSIGNED_LONGS_EQUAL_TEXT(                                                 \
+        (expected), (history).countCalls(function, matches),                   \
+        (cpputest::SimpleString("matching calls to ") + (function))            \
+            .asCharString()                                                    \
+    )
+
+namespace cpputest
+{
+    namespace extensions
+    {
+        class MockCallHistory;
+        struct MockCallHistoryCalls;
+        struct MockCallHistoryParameters;
+
+        union MockCallHistoryValue
+        {
+            bool boolValue_;
+            int intValue_;
+            unsigned int unsignedIntValue_;
+            long int longIntValue_;
+            unsigned long int unsignedLongIntValue_;
+            long long longLongIntValue_;
+            unsigned long long unsignedLongLongIntValue_;
+            double doubleValue_;
+            const char* stringValue_;
+            void* pointerValue_;
+            const void* constPointerValue_;
+            void (*functionPointerValue_)();
+            const unsigned char* memoryBufferValue_;
+        };
+
+        /*
+         * One call of a MockCallHistory. The parameters are turned back into
+         * MockNamedValues when they are asked for.
+         */
+        class MockSpiedCall
+        {
+        public:
+            MockSpiedCall(const MockCallHistory& history, size_t call);
+
+            bool isValid() const;
+            SimpleString getName() const;
+            size_t getSequenceNumber() const;
+            size_t getParameterCount() const;
+            bool hasParameter(const SimpleString& name) const;
+            MockNamedValue getParameter(const SimpleString& name) const;
+            MockNamedValue getParameter(size_t index) const;
+
+        private:
+            const MockCallHistory* history_;
+            size_t call_;
+        };
+
+        typedef bool (*MockSpiedCallPredicate)(const MockSpiedCall& call);
+
+        /*
+         * The calls made to a MockSupport in spy mode, kept in columns: the
+         * function of every call and where its parameters start, and the
+         * name, type and value of every parameter. Names are kept once,
+         * found through a hash index, and referred to by their position;
+         * everything else lives in an arena,
+         * so recording a call allocates nothing on its own. Strings and
+         * memory buffers are copied into the arena; the sequence number of
+         * a call is its position in the history.
+         */
+        class MockCallHistory
+        {
+        public:
+            MockCallHistory();
+            ~MockCallHistory();
+
+            void recordCall(const SimpleString& function);
+            MockCallHistoryValue& recordParameter(
+                const SimpleString& name, MockNamedValue::ValueType type
+            );
+            void
+            recordStringParameter(const SimpleString& name, const char* value);
+            void recordMemoryBufferParameter(
+                const SimpleString& name,
+                const unsigned char* value,
+                size_t size
+            );
+            void recordObjectParameter(
+                const SimpleString& type,
+                const SimpleString& name,
+                const void* value
+            );
+
+            size_t size() const;
+            size_t countCalls(const SimpleString& function) const;
+            size_t countCalls(
+                const SimpleString& function, MockSpiedCallPredicate matches
+            ) const;
+            MockSpiedCall getCall(size_t sequenceNumber) const;
+            // The n-th call to the function, counting from 0.
+            MockSpiedCall getCall(const SimpleString& function, size_t n) const;
+
+            void clear();
+
+        private:
+            friend class MockSpiedCall;
+
+            MockArena arena_;
+            SimpleString** names_;
+            unsigned long* nameHashes_;
+            // Open addressing over 2 * nameCapacity_ slots holding id + 1.
+            unsigned int* nameIndex_;
+            size_t nameCount_;
+            size_t nameCapacity_;
+            MockCallHistoryCalls** calls_;
+            size_t callChunkCapacity_;
+            size_t callCount_;
+            MockCallHistoryParameters** parameters_;
+            size_t parameterChunkCapacity_;
+            size_t parameterCount_;
+
+            unsigned int nameId(const SimpleString& name);
+            bool findNameId(const SimpleString& name, unsigned int& id) const;
+            void indexName(unsigned int id);
+            const SimpleString& nameOf(unsigned int id) const;
+            unsigned int functionOf(size_t call) const;
+            size_t firstParameterOf(size_t call) const;
+            size_t parameterCountOf(size_t call) const;
+            MockNamedValue parameterAt(size_t parameter) const;
+            unsigned int parameterNameOf(size_t parameter) const;
+            size_t addParameter(
+                const SimpleString& name, MockNamedValue::ValueType type
+            );
+
+            MockCallHistory(const MockCallHistory&);
+            MockCallHistory& operator=(const MockCallHistory&);
+        };
+
+        /*
+         * The actual call of a MockSupport in spy mode. It writes the call
+         * into the history and hands it on, to a stub when the function has
+         * one, so that the spied call can still return something.
+         */
+        class MockSpyActualCall : public MockActualCall
+        {
+        public:
+            MockSpyActualCall();
+            virtual ~MockSpyActualCall() override;
+
+            MockActualCall& start(
+                MockCallHistory& history,
+                const SimpleString& name,
+                MockActualCall& call
+            );
+
+            virtual MockActualCall& withName(const SimpleString&) override;
+            virtual MockActualCall& withCallOrder(unsigned int) override;
+            virtual MockActualCall&
+            withBoolParameter(const SimpleString& name, bool value) override;
+            virtual MockActualCall&
+            withIntParameter(const SimpleString& name, int value) override;
+            virtual MockActualCall& withUnsignedIntParameter(
+                const SimpleString& name, unsigned int value
+            ) override;
+            virtual MockActualCall&
+            withLongIntParameter(const SimpleString& name, long int value)
+                override;
+            virtual MockActualCall& withUnsignedLongIntParameter(
+                const SimpleString& name, unsigned long int value
+            ) override;
+            virtual MockActualCall& withLongLongIntParameter(
+                const SimpleString& name, long long value
+            ) override;
+            virtual MockActualCall& withUnsignedLongLongIntParameter(
+                const SimpleString& name, unsigned long long value
+            ) override;
+            virtual MockActualCall&
+            withDoubleParameter(const SimpleString& name, double value)
+                override;
+            virtual MockActualCall& withStringParameter(
+                const SimpleString& name, const char* value
+            ) override;
+            virtual MockActualCall&
+            withPointerParameter(const SimpleString& name, void* value)
+                override;
+            virtual MockActualCall& withConstPointerParameter(
+                const SimpleString& name, const void* value
+            ) override;
+            virtual MockActualCall& withFunctionPointerParameter(
+                const SimpleString& name, void (*value)()
+            ) override;
+            virtual MockActualCall& withMemoryBufferParameter(
+                const SimpleString& name,
+                const unsigned char* value,
+                size_t size
+            ) override;
+            virtual MockActualCall& withParameterOfType(
+                const SimpleString& typeName,
+                const SimpleString& name,
+                const void* value
+            ) override;
+            virtual MockActualCall&
+            withOutputParameter(const SimpleString& name, void* output)
+                override;
+            virtual MockActualCall& withOutputParameterOfType(
+                const SimpleString& typeName,
+                const SimpleString& name,
+                void* output
+            ) override;
+
+            virtual bool hasReturnValue() override;
+            virtual MockNamedValue returnValue() override;
+
+            virtual bool returnBoolValueOrDefault(bool default_value) override;
+            virtual bool returnBoolValue() override;
+
+            virtual int returnIntValueOrDefault(int default_value) override;
+            virtual int returnIntValue() override;
+
+            virtual unsigned long int returnUnsignedLongIntValue() override;
+            virtual unsigned long int returnUnsignedLongIntValueOrDefault(
+                unsigned long int default_value
+            ) override;
+
+            virtual long int returnLongIntValue() override;
+            virtual long int returnLongIntValueOrDefault(long int default_value
+            ) override;
+
+            virtual unsigned long long
+            returnUnsignedLongLongIntValue() override;
+            virtual unsigned long long returnUnsignedLongLongIntValueOrDefault(
+                unsigned long long default_value
+            ) override;
+
+            virtual long long returnLongLongIntValue() override;
+            virtual long long
+            returnLongLongIntValueOrDefault(long long default_value) override;
+
+            virtual unsigned int returnUnsignedIntValue() override;
+            virtual unsigned int
+            returnUnsignedIntValueOrDefault(unsigned int default_value
+            ) override;
+
+            virtual const char*
+            returnStringValueOrDefault(const char* default_value) override;
+            virtual const char* returnStringValue() override;
+
+            virtual double returnDoubleValue() override;
+            virtual double returnDoubleValueOrDefault(double default_value
+            ) override;
+
+            virtual void* returnPointerValue() override;
+            virtual void* returnPointerValueOrDefault(void* default_value
+            ) override;
+
+            virtual const void* returnConstPointerValue() override;
+            virtual const void*
+            returnConstPointerValueOrDefault(const void* default_value
+            ) override;
+
+            typedef void (*FunctionPointerReturnValue)();
+            virtual FunctionPointerReturnValue
+            returnFunctionPointerValue() override;
+            virtual FunctionPointerReturnValue
+            returnFunctionPointerValueOrDefault(void (*)()) override;
+
+            virtual MockActualCall& onObject(const void* objectPtr) override;
+
+        private:
+            MockCallHistory* history_;
+            MockActualCall* call_;
+        };
+    }
+}
+
+#endif
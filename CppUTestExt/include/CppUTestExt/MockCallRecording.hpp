@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef D_MockCallRecording_h
+#define D_MockCallRecording_h
+
+#include "CppUTestExt/MockNamedValue.hpp"
+
+namespace cpputest
+{
+    namespace extensions
+    {
+        class MockCheckedExpectedCall;
+        struct MockCallRecorderImpl;
+        struct MockCallReplayImpl;
+
+        /*
+         * Writes the calls made on a MockSupport to a compact binary file,
+         * installed with mock().record(&recorder). Every call is a name
+         * record followed by its input parameters, the output parameters
+         * it handed out and its return value. Function and parameter names
+         * are written once and referred to by index afterwards. Integers
+         * are LEB128 numbers, doubles their raw bytes, strings and memory
+         * buffers are length prefixed. Pointers and objects only keep
+         * their type, as their values mean nothing in another run.
+         */
+        class MockCallRecorder
+        {
+        public:
+            MockCallRecorder(const SimpleString& fileName);
+            virtual ~MockCallRecorder();
+
+            virtual void callStarted(const SimpleString& functionName);
+            virtual void inputParameter(const MockNamedValue& parameter);
+            virtual void outputParameter(
+                const SimpleString& name, const void* data, size_t size
+            );
+            virtual void returnValue(const MockNamedValue& value);
+
+            virtual void flush();
+
+        protected:
+            virtual void openFile();
+            virtual void writeToFile(const void* data, size_t size);
+            virtual void closeFile();
+
+        private:
+            MockCallRecorderImpl* impl_;
+
+            void writeByte(unsigned char byte);
+            void writeNumber(unsigned long long number);
+            void writeBytes(const void* data, size_t size);
+            void writeName(unsigned char kind, const SimpleString& name);
+            void writeValue(const MockNamedValue& value);
+
+            MockCallRecorder(const MockCallRecorder&);
+            MockCallRecorder& operator=(const MockCallRecorder&);
+        };
+
+        /*
+         * Plays a file written by MockCallRecorder back as expectations,
+         * installed with mock().replay(&replay). The file is read in chunks
+         * and only the next recorded call is turned into an expectation,
+         * once the previous one was called, so the calls have to happen in
+         * the recorded order. Pointer and object parameters are not
+         * compared.
+         */
+        class MockCallReplay
+        {
+        public:
+            MockCallReplay(const SimpleString& fileName);
+            virtual ~MockCallReplay();
+
+            // Fills in the next recorded call. False at the end of the
+            // recording or when it is damaged.
+            virtual bool nextCall(MockCheckedExpectedCall& call);
+
+        protected:
+            virtual void openFile();
+            virtual size_t readFromFile(void* data, size_t size);
+            virtual void closeFile();
+
+        private:
+            MockCallReplayImpl* impl_;
+
+            bool fill(size_t size);
+            bool readByte(unsigned char& byte);
+            bool readNumber(unsigned long long& number);
+            bool readBytes(const unsigned char*& data, size_t& size);
+            bool readName(SimpleString& name);
+            bool readValue(const SimpleString& name, MockNamedValue& value);
+            bool peekByte(unsigned char& byte);
+
+            MockCallReplay(const MockCallReplay&);
+            MockCallReplay& operator=(const MockCallReplay&);
+        };
+    }
+}
+
+#endif
@@ -29,7 +29,9 @@
 #define D_MockCheckedActualCall_h
 
 #include "CppUTestExt/MockActualCall.hpp"
+#include "CppUTestExt/MockCallRecording.hpp"
 #include "CppUTestExt/MockExpectedCallsList.hpp"
+#include "CppUTestExt/MockTraceSink.hpp"
 
 class UtestShell;
 
@@ -43,7 +45,8 @@ namespace cpputest
             MockCheckedActualCall(
                 unsigned int callOrder,
                 MockFailureReporter* reporter,
-                const MockExpectedCallsList& expectations
+                const MockExpectedCallsList& expectations,
+                unsigned int* outOfOrderCalls = nullptr
             );
             virtual ~MockCheckedActualCall() override;
 
@@ -162,10 +165,12 @@ namespace cpputest
             virtual void checkExpectations();
 
             virtual void setMockFailureReporter(MockFailureReporter* reporter);
+            virtual void recordTo(MockCallRecorder* recorder);
 
         protected:
             void setName(const SimpleString& name);
             SimpleString getName() const;
+            MockCheckedExpectedCall* getMatchingExpectation() const;
             virtual UtestShell* getTest() const;
             virtual void callHasSucceeded();
             virtual void copyOutputParameters(MockCheckedExpectedCall* call);
@@ -193,10 +198,16 @@ namespace cpputest
             ActualCallState state_;
             bool expectationsChecked_;
             MockCheckedExpectedCall* matchingExpectation_;
+            unsigned int* outOfOrderCalls_;
+            MockCallRecorder* recorder_;
 
             MockExpectedCallsList potentiallyMatchingExpectations_;
             const MockExpectedCallsList& allExpectations_;
 
+            void matchingExpectationWasCalled();
+            void matchExpectations();
+            void recordCallResult();
+
             class MockOutputParametersListNode
             {
             public:
@@ -347,12 +358,16 @@ namespace cpputest
             static MockActualCallTrace& instance();
             static void clearInstance();
 
+            // Sends the trace to sink instead of the built-in buffer;
+            // nullptr goes back to the buffer. The sink is not owned.
+            static void setSink(MockTraceSink* sink);
+
         private:
-            SimpleString traceBuffer_;
+            MockTraceBufferSink buffer_;
+            MockTraceSink* sink_;
 
             static MockActualCallTrace* instance_;
-
-            void addParameterName(const SimpleString& name);
+            static MockTraceSink* installedSink_;
         };
 
         class MockIgnoredActualCall : public MockActualCall
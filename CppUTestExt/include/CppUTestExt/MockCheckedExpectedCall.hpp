@@ -28,6 +28,7 @@
 #ifndef D_MockCheckedExpectedCall_h
 #define D_MockCheckedExpectedCall_h
 
+#include "CppUTestExt/MockArena.hpp"
 #include "CppUTestExt/MockExpectedCall.hpp"
 #include "CppUTestExt/MockNamedValue.hpp"
 
@@ -41,6 +42,9 @@ namespace cpputest
         public:
             MockCheckedExpectedCall();
             MockCheckedExpectedCall(unsigned int numCalls);
+            // Places the parameters in the arena too. Meant for calls that
+            // are themselves placed in the arena.
+            MockCheckedExpectedCall(unsigned int numCalls, MockArena& arena);
             virtual ~MockCheckedExpectedCall() override;
 
             virtual MockExpectedCall& withName(const SimpleString& name
@@ -129,6 +133,35 @@ namespace cpputest
             virtual MockExpectedCall& andReturnValue(const void* value
             ) override;
             virtual MockExpectedCall& andReturnValue(void (*value)()) override;
+            virtual MockExpectedCall&
+            andReturnValues(const bool* values, size_t count) override;
+            virtual MockExpectedCall&
+            andReturnValues(const int* values, size_t count) override;
+            virtual MockExpectedCall&
+            andReturnValues(const unsigned int* values, size_t count) override;
+            virtual MockExpectedCall&
+            andReturnValues(const long int* values, size_t count) override;
+            virtual MockExpectedCall& andReturnValues(
+                const unsigned long int* values, size_t count
+            ) override;
+            virtual MockExpectedCall&
+            andReturnValues(const long long* values, size_t count) override;
+            virtual MockExpectedCall& andReturnValues(
+                const unsigned long long* values, size_t count
+            ) override;
+            virtual MockExpectedCall&
+            andReturnValues(const double* values, size_t count) override;
+            virtual MockExpectedCall&
+            andReturnValues(const char* const* values, size_t count) override;
+            virtual MockExpectedCall&
+            andReturnValues(const void* const* values, size_t count) override;
+            virtual MockExpectedCall& withOutputParameterReturningSequence(
+                const SimpleString& name,
+                const void* values,
+                size_t size,
+                size_t count
+            ) override;
+            virtual MockExpectedCall& cycleValues() override;
 
             virtual MockNamedValue returnValue();
 
@@ -140,6 +173,9 @@ namespace cpputest
             );
             virtual SimpleString
             getInputParameterValueString(const SimpleString& name);
+            virtual MockNamedValueComparator* getInputParameterComparator(
+                const SimpleString& type, const SimpleString& name
+            );
 
             virtual bool hasInputParameterWithName(const SimpleString& name);
             virtual bool hasInputParameter(const MockNamedValue& parameter);
@@ -171,10 +207,16 @@ namespace cpputest
             };
 
             virtual unsigned int getActualCallsFulfilled() const;
+            SimpleString getName() const;
 
         protected:
             void setName(const SimpleString& name);
-            SimpleString getName() const;
+
+        private:
+            MockExpectedCall& setReturnValues(
+                const void* values, MockNamedValue::ValueType type, size_t count
+            );
+            size_t sequenceIndex(unsigned int call, size_t count) const;
 
         private:
             SimpleString functionName_;
@@ -185,21 +227,66 @@ namespace cpputest
                 MockExpectedFunctionParameter(const SimpleString& name);
                 void setMatchesActualCall(bool b);
                 bool isMatchingActualCall() const;
+                void setSequenceCount(size_t count);
+                size_t getSequenceCount() const;
 
             private:
                 bool matchesActualCall_;
+                size_t sequenceCount_;
             };
 
-            MockExpectedFunctionParameter* item(MockNamedValueListNode* node);
+            // Parameters in the order they were added, with their name
+            // hashes alongside so a lookup scans integers, not strings.
+            // Room for the usual number of parameters is kept inline.
+            class MockExpectedFunctionParameters
+            {
+            public:
+                MockExpectedFunctionParameters(MockArena* arena);
+                ~MockExpectedFunctionParameters();
+
+                MockExpectedFunctionParameter* add(const SimpleString& name);
+                MockExpectedFunctionParameter* find(const SimpleString& name
+                ) const;
+                MockExpectedFunctionParameter*
+                find(const SimpleString& name, unsigned long nameHash) const;
+                void wasPassed(const SimpleString& name);
+                MockExpectedFunctionParameter* at(size_t index) const;
+                size_t size() const;
+
+            private:
+                enum
+                {
+                    INLINE_CAPACITY = 8
+                };
+
+                MockExpectedFunctionParameter*
+                    inlineParameters_[INLINE_CAPACITY];
+                unsigned long inlineHashes_[INLINE_CAPACITY];
+                MockArena* arena_;
+                MockExpectedFunctionParameter** parameters_;
+                unsigned long* hashes_;
+                size_t size_;
+                size_t capacity_;
+
+                MockExpectedFunctionParameters(
+                    const MockExpectedFunctionParameters&
+                );
+                MockExpectedFunctionParameters&
+                operator=(const MockExpectedFunctionParameters&);
+            };
 
             bool ignoreOtherParameters_;
             bool isActualCallMatchFinalized_;
             unsigned int initialExpectedCallOrder_;
             unsigned int finalExpectedCallOrder_;
             bool outOfOrder_;
-            MockNamedValueList* inputParameters_;
-            MockNamedValueList* outputParameters_;
+            MockExpectedFunctionParameters inputParameters_;
+            MockExpectedFunctionParameters outputParameters_;
             MockNamedValue returnValue_;
+            const void* returnValues_;
+            MockNamedValue::ValueType returnValuesType_;
+            size_t returnValuesCount_;
+            bool cycleValues_;
             void* objectPtr_;
             bool isSpecificObjectExpected_;
             bool wasPassedToObject_;
@@ -374,6 +461,66 @@ namespace cpputest
             {
                 return *this;
             }
+            virtual MockExpectedCall&
+            andReturnValues(const bool*, size_t) override
+            {
+                return *this;
+            }
+            virtual MockExpectedCall&
+            andReturnValues(const int*, size_t) override
+            {
+                return *this;
+            }
+            virtual MockExpectedCall&
+            andReturnValues(const unsigned int*, size_t) override
+            {
+                return *this;
+            }
+            virtual MockExpectedCall&
+            andReturnValues(const long int*, size_t) override
+            {
+                return *this;
+            }
+            virtual MockExpectedCall&
+            andReturnValues(const unsigned long int*, size_t) override
+            {
+                return *this;
+            }
+            virtual MockExpectedCall&
+            andReturnValues(const long long*, size_t) override
+            {
+                return *this;
+            }
+            virtual MockExpectedCall&
+            andReturnValues(const unsigned long long*, size_t) override
+            {
+                return *this;
+            }
+            virtual MockExpectedCall&
+            andReturnValues(const double*, size_t) override
+            {
+                return *this;
+            }
+            virtual MockExpectedCall&
+            andReturnValues(const char* const*, size_t) override
+            {
+                return *this;
+            }
+            virtual MockExpectedCall&
+            andReturnValues(const void* const*, size_t) override
+            {
+                return *this;
+            }
+            virtual MockExpectedCall& withOutputParameterReturningSequence(
+                const SimpleString&, const void*, size_t, size_t
+            ) override
+            {
+                return *this;
+            }
+            virtual MockExpectedCall& cycleValues() override
+            {
+                return *this;
+            }
 
             virtual MockExpectedCall& onObject(void*) override
             {
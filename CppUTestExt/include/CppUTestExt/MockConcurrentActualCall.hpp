@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef D_MockConcurrentActualCall_h
+#define D_MockConcurrentActualCall_h
+
+#include "CppUTest/PlatformSpecificFunctions.h"
+#include "CppUTestExt/MockActualCall.hpp"
+#include "CppUTestExt/MockFailure.hpp"
+
+namespace cpputest
+{
+    namespace extensions
+    {
+        class MockConcurrentActualCall;
+        class MockReplayedActualCall;
+        struct MockConcurrentCallStep;
+        struct MockConcurrentCallsNode;
+
+        /*
+         * The shared state of a MockSupport in concurrent mode: the lock
+         * around its expectations and one actual call per thread.
+         *
+         * Failures found while the lock is held are kept, the first one is
+         * reported once the thread that turned concurrent mode on is back
+         * in the mock, or at checkExpectations(). Failing a test from
+         * another thread would jump out of that thread.
+         */
+        class MockConcurrentCalls : public MockFailureReporter
+        {
+        public:
+            MockConcurrentCalls(
+                MockExpectedCallsList& expectations,
+                unsigned int* outOfOrderCalls
+            );
+            virtual ~MockConcurrentCalls() override;
+
+            void lock();
+            void unlock();
+
+            // Needs the lock.
+            MockConcurrentActualCall& callOfThisThread();
+            // Ends the calls of all threads.
+            void finishAll();
+
+            MockExpectedCallsList& expectations();
+            unsigned int* outOfOrderCalls();
+
+            // The call whose matching state the expectations carry. Needs
+            // the lock.
+            MockConcurrentActualCall* matchingCall() const;
+            void setMatchingCall(MockConcurrentActualCall* call);
+            // Clears the matching state, e.g. when expectations are added.
+            void forgetMatchingCall();
+
+            virtual void failTest(const MockFailure& failure) override;
+            virtual UtestShell* getTestToFail() override;
+            void setReporter(MockFailureReporter* reporter);
+            bool isOwnerThread() const;
+            bool reportFailure();
+
+            // Identifies the calling thread, replaceable for tests.
+            static const void* (*currentThread)();
+
+        private:
+            PlatformSpecificMutex mutex_;
+            MockExpectedCallsList& expectations_;
+            unsigned int* outOfOrderCalls_;
+            MockFailureReporter* reporter_;
+            const void* owner_;
+            MockConcurrentCallsNode* calls_;
+            MockConcurrentActualCall* matchingCall_;
+            bool hasFailure_;
+            SimpleString failure_;
+
+            MockConcurrentCalls(const MockConcurrentCalls&);
+            MockConcurrentCalls& operator=(const MockConcurrentCalls&);
+        };
+
+        /*
+         * The actual call a thread builds in concurrent mode. It keeps what
+         * it was given and a checked call that it matches step by step,
+         * under the lock. The expectations carry the matching state of one
+         * call at a time: when another thread's call used them in between,
+         * the call resets them and replays its steps first. The call
+         * counts once it is finished: when its return value is asked for,
+         * when the thread makes its next call or at checkExpectations().
+         * Output parameters are copied then, from the expectation it
+         * claimed.
+         */
+        class MockConcurrentActualCall : public MockActualCall
+        {
+        public:
+            MockConcurrentActualCall(MockConcurrentCalls& calls);
+            virtual ~MockConcurrentActualCall() override;
+
+            void start(unsigned int callOrder, const SimpleString& name);
+            // Needs the lock.
+            void finish();
+
+            virtual MockActualCall& withName(const SimpleString& name) override;
+            virtual MockActualCall& withCallOrder(unsigned int) override;
+            virtual MockActualCall&
+            withBoolParameter(const SimpleString& name, bool value) override;
+            virtual MockActualCall&
+            withIntParameter(const SimpleString& name, int value) override;
+            virtual MockActualCall& withUnsignedIntParameter(
+                const SimpleString& name, unsigned int value
+            ) override;
+            virtual MockActualCall& withLongIntParameter(
+                const SimpleString& name, long int value
+            ) override;
+            virtual MockActualCall& withUnsignedLongIntParameter(
+                const SimpleString& name, unsigned long int value
+            ) override;
+            virtual MockActualCall& withLongLongIntParameter(
+                const SimpleString& name, long long value
+            ) override;
+            virtual MockActualCall& withUnsignedLongLongIntParameter(
+                const SimpleString& name, unsigned long long value
+            ) override;
+            virtual MockActualCall& withDoubleParameter(
+                const SimpleString& name, double value
+            ) override;
+            virtual MockActualCall& withStringParameter(
+                const SimpleString& name, const char* value
+            ) override;
+            virtual MockActualCall& withPointerParameter(
+                const SimpleString& name, void* value
+            ) override;
+            virtual MockActualCall& withConstPointerParameter(
+                const SimpleString& name, const void* value
+            ) override;
+            virtual MockActualCall& withFunctionPointerParameter(
+                const SimpleString& name, void (*value)()
+            ) override;
+            virtual MockActualCall& withMemoryBufferParameter(
+                const SimpleString& name,
+                const unsigned char* value,
+                size_t size
+            ) override;
+            virtual MockActualCall& withParameterOfType(
+                const SimpleString& type,
+                const SimpleString& name,
+                const void* value
+            ) override;
+            virtual MockActualCall& withOutputParameter(
+                const SimpleString& name, void* output
+            ) override;
+            virtual MockActualCall& withOutputParameterOfType(
+                const SimpleString& type, const SimpleString& name, void* output
+            ) override;
+
+            virtual bool hasReturnValue() override;
+            virtual MockNamedValue returnValue() override;
+
+            virtual bool returnBoolValueOrDefault(bool default_value) override;
+            virtual bool returnBoolValue() override;
+
+            virtual int returnIntValueOrDefault(int default_value) override;
+            virtual int returnIntValue() override;
+
+            virtual unsigned long int returnUnsignedLongIntValue() override;
+            virtual unsigned long int
+            returnUnsignedLongIntValueOrDefault(unsigned long int) override;
+
+            virtual long int returnLongIntValue() override;
+            virtual long int returnLongIntValueOrDefault(long int default_value
+            ) override;
+
+            virtual unsigned long long
+            returnUnsignedLongLongIntValue() override;
+            virtual unsigned long long returnUnsignedLongLongIntValueOrDefault(
+                unsigned long long default_value
+            ) override;
+
+            virtual long long returnLongLongIntValue() override;
+            virtual long long
+            returnLongLongIntValueOrDefault(long long default_value) override;
+
+            virtual unsigned int returnUnsignedIntValue() override;
+            virtual unsigned int
+            returnUnsignedIntValueOrDefault(unsigned int default_value
+            ) override;
+
+            virtual const char*
+            returnStringValueOrDefault(const char* default_value) override;
+            virtual const char* returnStringValue() override;
+
+            virtual double returnDoubleValue() override;
+            virtual double returnDoubleValueOrDefault(double default_value
+            ) override;
+
+            virtual const void* returnConstPointerValue() override;
+            virtual const void*
+            returnConstPointerValueOrDefault(const void* default_value
+            ) override;
+
+            virtual void* returnPointerValue() override;
+            virtual void* returnPointerValueOrDefault(void*) override;
+
+            typedef void (*FunctionPointerReturnValue)();
+            virtual FunctionPointerReturnValue
+            returnFunctionPointerValue() override;
+            virtual FunctionPointerReturnValue
+            returnFunctionPointerValueOrDefault(void (*)()) override;
+
+            virtual MockActualCall& onObject(const void* objectPtr) override;
+
+        private:
+            MockConcurrentCalls& calls_;
+            unsigned int callOrder_;
+            SimpleString name_;
+            MockConcurrentCallStep* steps_;
+            MockConcurrentCallStep* lastStep_;
+            MockReplayedActualCall* call_;
+            bool finished_;
+            bool failed_;
+            MockNamedValue returnValue_;
+
+            MockActualCall& addStep(MockConcurrentCallStep* step);
+            MockActualCall& addInputParameter(const MockNamedValue& value);
+            void match(const MockConcurrentCallStep* step);
+            void replay();
+            void release();
+            void finishAndReport();
+            void deleteSteps();
+
+            MockConcurrentActualCall(const MockConcurrentActualCall&);
+            MockConcurrentActualCall&
+            operator=(const MockConcurrentActualCall&);
+        };
+    }
+}
+
+#endif
@@ -190,6 +190,42 @@ namespace cpputest
             virtual MockExpectedCall& andReturnValue(const void* value) = 0;
             virtual MockExpectedCall& andReturnValue(void (*value)()) = 0;
 
+            /*
+             * A sequence gives the i-th of its values to the i-th actual
+             * call of the expectation, so expectNCalls(n, ...) needs one
+             * expectation instead of n. The arrays are not copied; output
+             * sequences hold count values of size bytes each. Sequences
+             * repeat their last value once they run out, or start over
+             * after cycleValues().
+             */
+            virtual MockExpectedCall&
+            andReturnValues(const bool* values, size_t count) = 0;
+            virtual MockExpectedCall&
+            andReturnValues(const int* values, size_t count) = 0;
+            virtual MockExpectedCall&
+            andReturnValues(const unsigned int* values, size_t count) = 0;
+            virtual MockExpectedCall&
+            andReturnValues(const long int* values, size_t count) = 0;
+            virtual MockExpectedCall&
+            andReturnValues(const unsigned long int* values, size_t count) = 0;
+            virtual MockExpectedCall&
+            andReturnValues(const long long* values, size_t count) = 0;
+            virtual MockExpectedCall&
+            andReturnValues(const unsigned long long* values, size_t count) = 0;
+            virtual MockExpectedCall&
+            andReturnValues(const double* values, size_t count) = 0;
+            virtual MockExpectedCall&
+            andReturnValues(const char* const* values, size_t count) = 0;
+            virtual MockExpectedCall&
+            andReturnValues(const void* const* values, size_t count) = 0;
+            virtual MockExpectedCall& withOutputParameterReturningSequence(
+                const SimpleString& name,
+                const void* values,
+                size_t size,
+                size_t count
+            ) = 0;
+            virtual MockExpectedCall& cycleValues() = 0;
+
             virtual MockExpectedCall& onObject(void* objectPtr) = 0;
         };
     }
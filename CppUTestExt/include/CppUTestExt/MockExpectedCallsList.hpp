@@ -42,6 +42,7 @@ namespace cpputest
 
         public:
             MockExpectedCallsList();
+            explicit MockExpectedCallsList(MockArena& arena);
             virtual ~MockExpectedCallsList();
             virtual void deleteAllExpectationsAndClearList();
 
@@ -54,6 +55,11 @@ namespace cpputest
             virtual bool
             hasUnmatchingExpectationsBecauseOfMissingParameters() const;
             virtual bool hasExpectationWithName(const SimpleString& name) const;
+            virtual MockNamedValueComparator* getComparatorForInputParameter(
+                const SimpleString& type, const SimpleString& name
+            ) const;
+            virtual MockNamedValue
+            getFirstInputParameter(const SimpleString& name) const;
             virtual bool hasCallsOutOfOrder() const;
             virtual bool isEmpty() const;
 
@@ -100,6 +106,24 @@ namespace cpputest
             unfulfilledCallsToString(const SimpleString& linePrefix = "") const;
             virtual SimpleString
             fulfilledCallsToString(const SimpleString& linePrefix = "") const;
+
+            /*
+             * The capped variants list at most maxCalls calls, the ones
+             * taking a parameter with the given name (and type) first, and
+             * summarize the rest as a count per function.
+             */
+            virtual SimpleString unfulfilledCallsToString(
+                const SimpleString& linePrefix,
+                size_t maxCalls,
+                const SimpleString& closestParameterName = "",
+                const SimpleString& closestParameterType = ""
+            ) const;
+            virtual SimpleString fulfilledCallsToString(
+                const SimpleString& linePrefix,
+                size_t maxCalls,
+                const SimpleString& closestParameterName = "",
+                const SimpleString& closestParameterType = ""
+            ) const;
             virtual SimpleString callsWithMissingParametersToString(
                 const SimpleString& linePrefix,
                 const SimpleString& missingParametersPrefix
@@ -124,6 +148,17 @@ namespace cpputest
 
         private:
             MockExpectedCallsListNode* head_;
+            MockArena* arena_;
+
+            MockExpectedCallsListNode* newNode(MockCheckedExpectedCall* call);
+            SimpleString cappedCallsToString(
+                const SimpleString& linePrefix,
+                bool fulfilled,
+                size_t maxCalls,
+                const SimpleString& closestParameterName,
+                const SimpleString& closestParameterType
+            ) const;
+            void deleteNode(MockExpectedCallsListNode* node);
 
             MockExpectedCallsList(const MockExpectedCallsList&);
         };
@@ -57,20 +57,53 @@ namespace cpputest
             }
         };
 
+        /*
+         * Mock failures list at most expectationsShownInReports expectations
+         * per section, closest candidates first, and count the rest per
+         * function. reportAllExpectations(true) lists all of them.
+         *
+         * The expectation lists are only turned into text when the message
+         * is first asked for, so a failure that is never printed (e.g.
+         * because the test already failed) costs little. The list is
+         * forgotten once rendered and a copy renders it first, so only the
+         * original failure refers to it. Failures built from lists that
+         * will not outlive the report call
+         * resolveExpectationsAndCallHistory() before handing them out.
+         */
         class MockFailure : public TestFailure
         {
         public:
             MockFailure(UtestShell* test);
+            MockFailure(const MockFailure& other);
             virtual ~MockFailure() override {}
 
+            virtual SimpleString getMessage() const override;
+            void resolveExpectationsAndCallHistory();
+
+            static void reportAllExpectations(bool all);
+
+            static const size_t expectationsShownInReports = 20;
+
         protected:
             void addExpectationsAndCallHistory(
                 const MockExpectedCallsList& expectations
             );
             void addExpectationsAndCallHistoryRelatedTo(
                 const SimpleString& function,
-                const MockExpectedCallsList& expectations
+                const MockExpectedCallsList& expectations,
+                const MockNamedValue* closestParameter = nullptr
             );
+
+        private:
+            mutable const MockExpectedCallsList* historyExpectations_;
+            SimpleString historyFunction_;
+            SimpleString historyParameterName_;
+            SimpleString historyParameterType_;
+            mutable SimpleString history_;
+            size_t historyPosition_;
+
+            void renderExpectationsAndCallHistory() const;
+            SimpleString expectationsAndCallHistory() const;
         };
 
         class MockExpectedCallsDidntHappenFailure : public MockFailure
@@ -168,6 +201,23 @@ namespace cpputest
                 const MockExpectedCallsList& expectations
             );
         };
+
+        // A failure found on another thread, reported later.
+        class MockConcurrentCallFailure : public MockFailure
+        {
+        public:
+            MockConcurrentCallFailure(
+                UtestShell* test, const SimpleString& message
+            );
+        };
+
+        class MockFunctionCallFailure : public MockFailure
+        {
+        public:
+            MockFunctionCallFailure(
+                UtestShell* test, const SimpleString& message
+            );
+        };
     }
 }
 
@@ -0,0 +1,491 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef D_MockFunction_h
+#define D_MockFunction_h
+
+#include "CppUTest/SimpleString.hpp"
+#include "CppUTestExt/MockFailure.hpp"
+
+namespace cpputest
+{
+    namespace extensions
+    {
+        /*
+         * Typed mocks for one function signature, e.g.
+         *
+         *   MockFunction<int(const char*, size_t)> halWrite("hal_write");
+         *   halWrite.expectCall().with("abc", 3).andReturnValue(3);
+         *   halWrite("abc", 3);
+         *
+         * Parameters are known by their position, so the expectations keep
+         * the values as they are, and an actual call compares them without
+         * going through MockNamedValue, strings or the mock() lookups.
+         * Text is only made when a failure is reported, through
+         * StringFrom() of the parameter types.
+         *
+         * Every MockFunction registers itself, MockSupportPlugin checks and
+         * clears all of them after each test like it does for mock().
+         * Typed functions take no part in strict ordering.
+         */
+        class MockFunctionBase
+        {
+        public:
+            MockFunctionBase(const SimpleString& name);
+            virtual ~MockFunctionBase();
+
+            const SimpleString& getName() const;
+
+            virtual void checkExpectations() = 0;
+            virtual void clear() = 0;
+
+            void setMockFailureReporter(MockFailureReporter* reporter);
+
+            static void checkAllExpectations();
+            static void clearAll();
+            static void setMockFailureStandardReporter(
+                MockFailureReporter* reporter
+            );
+
+        protected:
+            void failTest(const SimpleString& message);
+
+        private:
+            SimpleString name_;
+            MockFailureReporter* reporter_;
+            MockFunctionBase* next_;
+            MockFunctionBase* previous_;
+
+            MockFunctionBase(const MockFunctionBase&);
+            MockFunctionBase& operator=(const MockFunctionBase&);
+        };
+
+        template <typename T> struct MockFunctionValue
+        {
+            typedef T Type;
+        };
+
+        template <typename T> struct MockFunctionValue<const T>
+        {
+            typedef T Type;
+        };
+
+        template <typename T> struct MockFunctionValue<T&>
+        {
+            typedef typename MockFunctionValue<T>::Type Type;
+        };
+
+        template <typename T>
+        inline bool mockFunctionValuesEqual(const T& expected, const T& actual)
+        {
+            return expected == actual;
+        }
+
+        inline bool
+        mockFunctionValuesEqual(const char* expected, const char* actual)
+        {
+            if (expected == nullptr || actual == nullptr)
+                return expected == actual;
+            return SimpleString::StrCmp(expected, actual) == 0;
+        }
+
+        template <typename T> class MockFunctionParameter
+        {
+        public:
+            typedef T ValueType;
+            typedef bool (*Matcher)(const T&);
+
+            MockFunctionParameter() :
+                value_(),
+                matcher_(nullptr),
+                kind_(ANY_VALUE)
+            {
+            }
+
+            void expectValue(const T& value)
+            {
+                value_ = value;
+                kind_ = EXACT_VALUE;
+            }
+
+            void expectMatching(Matcher matcher)
+            {
+                matcher_ = matcher;
+                kind_ = MATCHING_VALUE;
+            }
+
+            bool matches(const T& actual) const
+            {
+                if (kind_ == EXACT_VALUE)
+                    return mockFunctionValuesEqual(value_, actual);
+                if (kind_ == MATCHING_VALUE)
+                    return matcher_(actual);
+                return true;
+            }
+
+            SimpleString toString() const
+            {
+                if (kind_ == EXACT_VALUE)
+                    return StringFrom(value_);
+                if (kind_ == MATCHING_VALUE)
+                    return "<matcher>";
+                return "<any>";
+            }
+
+        private:
+            enum Kind
+            {
+                ANY_VALUE,
+                EXACT_VALUE,
+                MATCHING_VALUE
+            };
+
+            T value_;
+            Matcher matcher_;
+            Kind kind_;
+        };
+
+        // The expected parameters of a call, one slot per position.
+        template <typename... Args> class MockFunctionParameters;
+
+        template <> class MockFunctionParameters<>
+        {
+        public:
+            void expectValues() {}
+            bool matches() const
+            {
+                return true;
+            }
+
+            SimpleString toString(unsigned int) const
+            {
+                return "";
+            }
+        };
+
+        template <typename Arg, typename... Rest>
+        class MockFunctionParameters<Arg, Rest...>
+        {
+        public:
+            typedef typename MockFunctionValue<Arg>::Type ValueType;
+
+            void expectValues(
+                const ValueType& value,
+                const typename MockFunctionValue<Rest>::Type&... rest
+            )
+            {
+                first_.expectValue(value);
+                rest_.expectValues(rest...);
+            }
+
+            bool matches(
+                const ValueType& value,
+                const typename MockFunctionValue<Rest>::Type&... rest
+            ) const
+            {
+                return first_.matches(value) && rest_.matches(rest...);
+            }
+
+            SimpleString toString(unsigned int position) const
+            {
+                SimpleString str = StringFrom(position) + ": " +
+                                   first_.toString();
+                if (sizeof...(Rest) > 0)
+                    str += SimpleString(", ") + rest_.toString(position + 1);
+                return str;
+            }
+
+            MockFunctionParameter<ValueType> first_;
+            MockFunctionParameters<Rest...> rest_;
+        };
+
+        template <unsigned int I, typename... Args>
+        struct MockFunctionParameterAt;
+
+        template <typename Arg, typename... Rest>
+        struct MockFunctionParameterAt<0, Arg, Rest...>
+        {
+            typedef MockFunctionParameter<typename MockFunctionValue<Arg>::Type>
+                Type;
+
+            static Type& get(MockFunctionParameters<Arg, Rest...>& parameters)
+            {
+                return parameters.first_;
+            }
+        };
+
+        template <unsigned int I, typename Arg, typename... Rest>
+        struct MockFunctionParameterAt<I, Arg, Rest...>
+        {
+            typedef typename MockFunctionParameterAt<I - 1, Rest...>::Type
+                Type;
+
+            static Type& get(MockFunctionParameters<Arg, Rest...>& parameters)
+            {
+                return MockFunctionParameterAt<I - 1, Rest...>::get(
+                    parameters.rest_
+                );
+            }
+        };
+
+        inline SimpleString mockFunctionValuesToString(unsigned int)
+        {
+            return "";
+        }
+
+        template <typename Arg, typename... Rest>
+        inline SimpleString mockFunctionValuesToString(
+            unsigned int position, const Arg& value, const Rest&... rest
+        )
+        {
+            SimpleString str = StringFrom(position) + ": " + StringFrom(value);
+            if (sizeof...(Rest) > 0)
+                str += SimpleString(", ") +
+                       mockFunctionValuesToString(position + 1, rest...);
+            return str;
+        }
+
+        struct MockFunctionNoValue
+        {
+        };
+
+        template <typename R> class MockFunctionReturnValue
+        {
+        public:
+            typedef typename MockFunctionValue<R>::Type ValueType;
+
+            MockFunctionReturnValue() : value_() {}
+
+            void set(const ValueType& value)
+            {
+                value_ = value;
+            }
+
+            R get() const
+            {
+                return value_;
+            }
+
+            static R none()
+            {
+                return ValueType();
+            }
+
+        private:
+            ValueType value_;
+        };
+
+        template <> class MockFunctionReturnValue<void>
+        {
+        public:
+            typedef MockFunctionNoValue ValueType;
+
+            void set(const ValueType&) {}
+            void get() const {}
+            static void none() {}
+        };
+
+        template <typename Signature> class MockFunction;
+
+        template <typename R, typename... Args>
+        class MockFunction<R(Args...)> : public MockFunctionBase
+        {
+        public:
+            typedef typename MockFunctionReturnValue<R>::ValueType ReturnType;
+
+            class Expectation
+            {
+            public:
+                Expectation& with(
+                    const typename MockFunctionValue<Args>::Type&... values
+                )
+                {
+                    parameters_.expectValues(values...);
+                    return *this;
+                }
+
+                template <unsigned int I>
+                Expectation& withParameter(
+                    const typename MockFunctionParameterAt<I, Args...>::Type::
+                        ValueType& value
+                )
+                {
+                    MockFunctionParameterAt<I, Args...>::get(parameters_)
+                        .expectValue(value);
+                    return *this;
+                }
+
+                template <unsigned int I>
+                Expectation& withParameterMatching(
+                    typename MockFunctionParameterAt<I, Args...>::Type::Matcher
+                        matcher
+                )
+                {
+                    MockFunctionParameterAt<I, Args...>::get(parameters_)
+                        .expectMatching(matcher);
+                    return *this;
+                }
+
+                Expectation& andReturnValue(const ReturnType& value)
+                {
+                    returnValue_.set(value);
+                    return *this;
+                }
+
+            private:
+                friend class MockFunction;
+
+                Expectation(unsigned int expectedCalls) :
+                    expectedCalls_(expectedCalls),
+                    actualCalls_(0),
+                    next_(nullptr)
+                {
+                }
+
+                bool isFulfilled() const
+                {
+                    return actualCalls_ >= expectedCalls_;
+                }
+
+                SimpleString toString(const SimpleString& name) const
+                {
+                    return StringFrom("\t\t") + name + " -> " +
+                           parameters_.toString(0) + " (expected " +
+                           StringFrom(expectedCalls_) + " call" +
+                           (expectedCalls_ == 1 ? "" : "s") + ", called " +
+                           StringFrom(actualCalls_) + " time" +
+                           (actualCalls_ == 1 ? "" : "s") + ")\n";
+                }
+
+                MockFunctionParameters<Args...> parameters_;
+                MockFunctionReturnValue<R> returnValue_;
+                unsigned int expectedCalls_;
+                unsigned int actualCalls_;
+                Expectation* next_;
+            };
+
+            MockFunction(const SimpleString& name) :
+                MockFunctionBase(name),
+                expectations_(nullptr),
+                lastExpectation_(nullptr)
+            {
+            }
+
+            virtual ~MockFunction() override
+            {
+                clear();
+            }
+
+            Expectation& expectCall()
+            {
+                return expectNCalls(1);
+            }
+
+            Expectation& expectNCalls(unsigned int amount)
+            {
+                Expectation* expectation = new Expectation(amount);
+                if (lastExpectation_)
+                    lastExpectation_->next_ = expectation;
+                else
+                    expectations_ = expectation;
+                lastExpectation_ = expectation;
+                return *expectation;
+            }
+
+            R operator()(Args... args)
+            {
+                for (Expectation* expectation = expectations_; expectation;
+                     expectation = expectation->next_) {
+                    if (!expectation->isFulfilled() &&
+                        expectation->parameters_.matches(args...)) {
+                        expectation->actualCalls_++;
+                        return expectation->returnValue_.get();
+                    }
+                }
+                SimpleString message(
+                    "Mock Failure: Unexpected call to function: "
+                );
+                message += getName() + "\n" + unfulfilledExpectations() +
+                           "\tACTUAL unexpected call:\n\t\t" + getName() +
+                           " -> " + mockFunctionValuesToString(0u, args...);
+                failTest(message);
+                return MockFunctionReturnValue<R>::none();
+            }
+
+            virtual void checkExpectations() override
+            {
+                for (Expectation* expectation = expectations_; expectation;
+                     expectation = expectation->next_) {
+                    if (!expectation->isFulfilled()) {
+                        failTest(
+                            SimpleString(
+                                "Mock Failure: Expected call WAS NOT "
+                                "fulfilled for function: "
+                            ) +
+                            getName() + "\n" + unfulfilledExpectations()
+                        );
+                        return;
+                    }
+                }
+            }
+
+            virtual void clear() override
+            {
+                while (expectations_) {
+                    Expectation* next = expectations_->next_;
+                    delete expectations_;
+                    expectations_ = next;
+                }
+                lastExpectation_ = nullptr;
+            }
+
+        private:
+            SimpleString unfulfilledExpectations() const
+            {
+                SimpleString str("\tEXPECTED calls that WERE NOT fulfilled "
+                                 "related to function: ");
+                str += getName() + "\n";
+                bool none = true;
+                for (Expectation* expectation = expectations_; expectation;
+                     expectation = expectation->next_) {
+                    if (!expectation->isFulfilled()) {
+                        str += expectation->toString(getName());
+                        none = false;
+                    }
+                }
+                if (none)
+                    str += "\t\t<none>\n";
+                return str;
+            }
+
+            Expectation* expectations_;
+            Expectation* lastExpectation_;
+        };
+    }
+}
+
+#endif
@@ -120,9 +120,31 @@ namespace cpputest
          */
 
         class MockNamedValueComparatorsAndCopiersRepository;
+        struct MockNamedValueEquality;
         class MockNamedValue
         {
         public:
+            // Built-in types carry a tag so comparing two values is a table
+            // lookup. Only user object types keep their type name.
+            enum ValueType
+            {
+                VALUE_BOOL,
+                VALUE_INT,
+                VALUE_UNSIGNED_INT,
+                VALUE_LONG_INT,
+                VALUE_UNSIGNED_LONG_INT,
+                VALUE_LONG_LONG_INT,
+                VALUE_UNSIGNED_LONG_LONG_INT,
+                VALUE_DOUBLE,
+                VALUE_STRING,
+                VALUE_POINTER,
+                VALUE_CONST_POINTER,
+                VALUE_FUNCTION_POINTER,
+                VALUE_MEMORY_BUFFER,
+                VALUE_OBJECT,
+                VALUE_TYPE_COUNT
+            };
+
             MockNamedValue(const SimpleString& name);
             MockNamedValue(const MockNamedValue&) = default;
             virtual ~MockNamedValue();
@@ -147,6 +169,14 @@ namespace cpputest
             );
             virtual void
             setObjectPointer(const SimpleString& type, void* objectPtr);
+            // Takes an already resolved comparator and copier instead of
+            // looking the type up in the default repository.
+            virtual void setConstObjectPointer(
+                const SimpleString& type,
+                const void* objectPtr,
+                MockNamedValueComparator* comparator,
+                MockNamedValueCopier* copier
+            );
             virtual void setSize(size_t size);
 
             virtual void setName(const char* name);
@@ -157,7 +187,10 @@ namespace cpputest
             virtual SimpleString toString() const;
 
             virtual SimpleString getName() const;
+            virtual unsigned long getNameHash() const;
+            virtual bool hasName(const SimpleString& name) const;
             virtual SimpleString getType() const;
+            virtual ValueType getValueType() const;
 
             virtual bool getBoolValue() const;
             virtual int getIntValue() const;
@@ -186,11 +219,19 @@ namespace cpputest
             static MockNamedValueComparatorsAndCopiersRepository*
             getDefaultComparatorsAndCopiersRepository();
 
+            static unsigned long hashName(const SimpleString& name);
+
             static const double defaultDoubleTolerance;
 
         private:
+            friend struct MockNamedValueEquality;
+
+            void checkValueType(ValueType expected) const;
+
             SimpleString name_;
-            SimpleString type_;
+            unsigned long nameHash_;
+            ValueType valueType_;
+            SimpleString objectType_;
             union
             {
                 bool boolValue_;
@@ -238,12 +279,21 @@ namespace cpputest
         private:
             MockNamedValue* data_;
             MockNamedValueListNode* next_;
+            MockNamedValueListNode* bucketNext_;
+
+            friend class MockNamedValueList;
         };
 
+        /*
+         * MockNamedValueList keeps its values in insertion order and indexes
+         * them by a hash of their name, so getValueByName does not walk the
+         * whole list.
+         */
         class MockNamedValueList
         {
         public:
             MockNamedValueList();
+            ~MockNamedValueList();
 
             MockNamedValueListNode* begin();
 
@@ -254,11 +304,78 @@ namespace cpputest
 
         private:
             MockNamedValueListNode* head_;
+            MockNamedValueListNode* tail_;
+            MockNamedValueListNode** buckets_;
+            size_t bucketCount_;
+            size_t nodeCount_;
+
+            void rebuildIndex(size_t bucketCount);
+
+            MockNamedValueList(const MockNamedValueList&);
+            MockNamedValueList& operator=(const MockNamedValueList&);
+        };
+
+        class MockNameIndexEntry
+        {
+        public:
+            const SimpleString& getName() const;
+            MockNameIndexEntry* next() const;
+
+            size_t getNumber() const;
+            void setNumber(size_t number);
+            void* getPointer() const;
+            void setPointer(void* pointer);
+
+        private:
+            MockNameIndexEntry(const SimpleString& name, unsigned long hash);
+
+            SimpleString name_;
+            unsigned long hash_;
+            size_t number_;
+            void* pointer_;
+            MockNameIndexEntry* next_;
+            MockNameIndexEntry* bucketNext_;
+
+            friend class MockNameIndex;
+        };
+
+        /*
+         * MockNameIndex keeps the bookkeeping of the mocks by name, such as
+         * a number or an object for every function. Unlike a
+         * MockNamedValueList it holds each name once and no typed value.
+         * Entries are kept in the order they were added.
+         */
+        class MockNameIndex
+        {
+        public:
+            MockNameIndex();
+            ~MockNameIndex();
+
+            MockNameIndexEntry* begin() const;
+            MockNameIndexEntry* find(const SimpleString& name) const;
+            // Returns the entry of the name, adding it with number 0 and a
+            // null pointer when it is not there yet.
+            MockNameIndexEntry& get(const SimpleString& name);
+            size_t size() const;
+            void clear();
+
+        private:
+            MockNameIndexEntry* head_;
+            MockNameIndexEntry* tail_;
+            MockNameIndexEntry** buckets_;
+            size_t bucketCount_;
+            size_t entryCount_;
+
+            void rebuildIndex(size_t bucketCount);
+
+            MockNameIndex(const MockNameIndex&);
+            MockNameIndex& operator=(const MockNameIndex&);
         };
 
         /*
          * MockParameterComparatorRepository is a class which stores comparators
-         * and copiers which can be used for comparing non-native types
+         * and copiers which can be used for comparing non-native types. The
+         * types are indexed by a hash of their name.
          *
          */
 
@@ -266,6 +383,21 @@ namespace cpputest
         class MockNamedValueComparatorsAndCopiersRepository
         {
             MockNamedValueComparatorsAndCopiersRepositoryNode* head_;
+            MockNamedValueComparatorsAndCopiersRepositoryNode** buckets_;
+            size_t bucketCount_;
+            size_t nodeCount_;
+
+            void add(
+                const SimpleString& name,
+                MockNamedValueComparator* comparator,
+                MockNamedValueCopier* copier
+            );
+            void rebuildIndex(size_t bucketCount);
+            MockNamedValueComparatorsAndCopiersRepositoryNode*
+            findFirst(const SimpleString& name) const;
+            MockNamedValueComparatorsAndCopiersRepositoryNode*
+            findNext(MockNamedValueComparatorsAndCopiersRepositoryNode* node
+            ) const;
 
         public:
             MockNamedValueComparatorsAndCopiersRepository();
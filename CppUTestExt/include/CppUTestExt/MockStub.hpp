@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef D_MockStub_h
+#define D_MockStub_h
+
+#include "CppUTestExt/MockActualCall.hpp"
+
+namespace cpputest
+{
+    namespace extensions
+    {
+        struct MockStubEntry;
+
+        // Fills returnValue, which is named and holds int 0 beforehand.
+        typedef void (*MockStubCallback)(
+            MockNamedValueList& parameters, MockNamedValue& returnValue
+        );
+
+        class MockStubBehavior
+        {
+        public:
+            MockStubBehavior();
+            virtual ~MockStubBehavior();
+
+            MockStubBehavior& andReturnValue(bool value);
+            MockStubBehavior& andReturnValue(int value);
+            MockStubBehavior& andReturnValue(unsigned int value);
+            MockStubBehavior& andReturnValue(long int value);
+            MockStubBehavior& andReturnValue(unsigned long int value);
+            MockStubBehavior& andReturnValue(long long value);
+            MockStubBehavior& andReturnValue(unsigned long long value);
+            MockStubBehavior& andReturnValue(double value);
+            MockStubBehavior& andReturnValue(const char* value);
+            MockStubBehavior& andReturnValue(void* value);
+            MockStubBehavior& andReturnValue(const void* value);
+            MockStubBehavior& andReturnValue(void (*value)());
+
+            const MockNamedValue& getReturnValue() const;
+
+        private:
+            MockNamedValue returnValue_;
+        };
+
+        /*
+         * A stub answers every call to one function, however often it is
+         * made, without expectations: with its own return value, the one
+         * of the first whenParameter() entry the call matches, or with
+         * what the callback gives. It counts the calls it answered.
+         */
+        class MockStub : public MockStubBehavior
+        {
+        public:
+            MockStub(const SimpleString& functionName);
+            virtual ~MockStub() override;
+
+            MockStubBehavior&
+            whenParameter(const SimpleString& name, int value);
+            MockStubBehavior&
+            whenParameter(const SimpleString& name, unsigned int value);
+            MockStubBehavior&
+            whenParameter(const SimpleString& name, long int value);
+            MockStubBehavior&
+            whenParameter(const SimpleString& name, unsigned long int value);
+            MockStubBehavior&
+            whenParameter(const SimpleString& name, long long value);
+            MockStubBehavior&
+            whenParameter(const SimpleString& name, unsigned long long value);
+            MockStubBehavior&
+            whenParameter(const SimpleString& name, double value);
+            MockStubBehavior&
+            whenParameter(const SimpleString& name, const char* value);
+            MockStubBehavior&
+            whenParameter(const SimpleString& name, const void* value);
+
+            MockStub& withCallback(MockStubCallback callback);
+
+            const SimpleString& getName() const;
+            unsigned int getCallCount() const;
+
+        private:
+            friend class MockStubActualCall;
+
+            SimpleString name_;
+            MockStubEntry* entries_;
+            MockStubEntry* lastEntry_;
+            // The first entry per parameter name, the others of the same
+            // name follow it.
+            mutable MockNamedValueList entriesByName_;
+            MockStubCallback callback_;
+            unsigned int callCount_;
+
+            MockStubEntry* addEntry(const SimpleString& name);
+            MockStubEntry* firstEntryFor(const SimpleString& name) const;
+            bool usesParameter(const SimpleString& name) const;
+            MockStubEntry* findEntry(const MockNamedValue& parameter) const;
+
+            MockStub(const MockStub&);
+            MockStub& operator=(const MockStub&);
+        };
+
+        /*
+         * The actual call of a stubbed function. Parameters are only kept
+         * when the stub looks at them, and nothing is checked.
+         */
+        class MockStubActualCall : public MockActualCall
+        {
+        public:
+            MockStubActualCall();
+            virtual ~MockStubActualCall() override;
+
+            MockActualCall& start(MockStub& stub);
+            void end();
+            bool isActive() const;
+
+            virtual MockActualCall& withName(const SimpleString&) override;
+            virtual MockActualCall& withCallOrder(unsigned int) override;
+            virtual MockActualCall&
+            withBoolParameter(const SimpleString& name, bool value) override;
+            virtual MockActualCall&
+            withIntParameter(const SimpleString& name, int value) override;
+            virtual MockActualCall& withUnsignedIntParameter(
+                const SimpleString& name, unsigned int value
+            ) override;
+            virtual MockActualCall&
+            withLongIntParameter(const SimpleString& name, long int value)
+                override;
+            virtual MockActualCall& withUnsignedLongIntParameter(
+                const SimpleString& name, unsigned long int value
+            ) override;
+            virtual MockActualCall& withLongLongIntParameter(
+                const SimpleString& name, long long value
+            ) override;
+            virtual MockActualCall& withUnsignedLongLongIntParameter(
+                const SimpleString& name, unsigned long long value
+            ) override;
+            virtual MockActualCall&
+            withDoubleParameter(const SimpleString& name, double value)
+                override;
+            virtual MockActualCall& withStringParameter(
+                const SimpleString& name, const char* value
+            ) override;
+            virtual MockActualCall&
+            withPointerParameter(const SimpleString& name, void* value)
+                override;
+            virtual MockActualCall& withConstPointerParameter(
+                const SimpleString& name, const void* value
+            ) override;
+            virtual MockActualCall& withFunctionPointerParameter(
+                const SimpleString& name, void (*value)()
+            ) override;
+            virtual MockActualCall& withMemoryBufferParameter(
+                const SimpleString&, const unsigned char*, size_t
+            ) override;
+            virtual MockActualCall& withParameterOfType(
+                const SimpleString&, const SimpleString&, const void*
+            ) override;
+            virtual MockActualCall&
+            withOutputParameter(const SimpleString&, void*) override;
+            virtual MockActualCall& withOutputParameterOfType(
+                const SimpleString&, const SimpleString&, void*
+            ) override;
+
+            virtual bool hasReturnValue() override;
+            virtual MockNamedValue returnValue() override;
+
+            virtual bool returnBoolValueOrDefault(bool default_value) override;
+            virtual bool returnBoolValue() override;
+
+            virtual int returnIntValueOrDefault(int default_value) override;
+            virtual int returnIntValue() override;
+
+            virtual unsigned long int returnUnsignedLongIntValue() override;
+            virtual unsigned long int returnUnsignedLongIntValueOrDefault(
+                unsigned long int default_value
+            ) override;
+
+            virtual long int returnLongIntValue() override;
+            virtual long int returnLongIntValueOrDefault(long int default_value
+            ) override;
+
+            virtual unsigned long long
+            returnUnsignedLongLongIntValue() override;
+            virtual unsigned long long returnUnsignedLongLongIntValueOrDefault(
+                unsigned long long default_value
+            ) override;
+
+            virtual long long returnLongLongIntValue() override;
+            virtual long long
+            returnLongLongIntValueOrDefault(long long default_value) override;
+
+            virtual unsigned int returnUnsignedIntValue() override;
+            virtual unsigned int
+            returnUnsignedIntValueOrDefault(unsigned int default_value
+            ) override;
+
+            virtual const char*
+            returnStringValueOrDefault(const char* default_value) override;
+            virtual const char* returnStringValue() override;
+
+            virtual double returnDoubleValue() override;
+            virtual double returnDoubleValueOrDefault(double default_value
+            ) override;
+
+            virtual void* returnPointerValue() override;
+            virtual void* returnPointerValueOrDefault(void* default_value
+            ) override;
+
+            virtual const void* returnConstPointerValue() override;
+            virtual const void*
+            returnConstPointerValueOrDefault(const void* default_value
+            ) override;
+
+            typedef void (*FunctionPointerReturnValue)();
+            virtual FunctionPointerReturnValue
+            returnFunctionPointerValue() override;
+            virtual FunctionPointerReturnValue
+            returnFunctionPointerValueOrDefault(void (*)()) override;
+
+            virtual MockActualCall& onObject(const void*) override;
+
+        private:
+            MockStub* stub_;
+            MockStubEntry* entry_;
+            MockNamedValueList parameters_;
+            MockNamedValue callbackValue_;
+            bool calledBack_;
+
+            MockActualCall& keepParameter(const MockNamedValue& parameter);
+        };
+    }
+}
+
+#endif
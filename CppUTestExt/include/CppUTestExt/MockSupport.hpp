@@ -28,9 +28,12 @@
 #ifndef D_MockSupport_h
 #define D_MockSupport_h
 
+#include "CppUTestExt/MockCallHistory.hpp"
 #include "CppUTestExt/MockCheckedActualCall.hpp"
+#include "CppUTestExt/MockConcurrentActualCall.hpp"
 #include "CppUTestExt/MockExpectedCallsList.hpp"
 #include "CppUTestExt/MockFailure.hpp"
+#include "CppUTestExt/MockStub.hpp"
 
 class UtestShell;
 
@@ -39,6 +42,7 @@ namespace cpputest
     namespace extensions
     {
         class MockSupport;
+        class MockScope;
         class MockExpectedCall;
 
         /* This allows access to "the global" mocking support for easier testing
@@ -62,6 +66,18 @@ namespace cpputest
             expectNCalls(unsigned int amount, const SimpleString& functionName);
             virtual MockActualCall& actualCall(const SimpleString& functionName
             );
+
+            /*
+             * stub() gives the behavior of a function for all its calls,
+             * e.g. mock().stub("read").andReturnValue(0), as long as the
+             * function has no expectations. Once it has, also fulfilled
+             * ones, its calls are matched against them and the stub is not
+             * used again until clear(). Stubbed calls do not go through the
+             * matching of expectations and are not traced, recorded or
+             * replayed. Stubs stay until clear() and are not used in
+             * concurrent mode.
+             */
+            virtual MockStub& stub(const SimpleString& functionName);
             virtual bool hasReturnValue();
             virtual MockNamedValue returnValue();
             virtual bool boolReturnValue();
@@ -117,8 +133,28 @@ namespace cpputest
             MockNamedValue getData(const SimpleString& name);
 
             MockSupport* getMockSupportScope(const SimpleString& name);
+            MockScope scope(const SimpleString& name);
 
             const char* getTraceOutput();
+            void setTraceSink(MockTraceSink* sink);
+
+            /*
+             * record() writes every checked call of this MockSupport to the
+             * recorder, replay() expects the calls of a recording in their
+             * recorded order instead of the expectations that were set.
+             * Neither goes through the scopes and both stop at clear().
+             */
+            void record(MockCallRecorder* recorder);
+            void replay(MockCallReplay* replay);
+            /*
+             * In spy mode the actual calls are not matched against the
+             * expectations but written to callHistory(), which can be
+             * queried once the code under test ran. A stubbed function
+             * still gets the answer of its stub. The history is kept after
+             * spy(false) until clear(); scopes keep their own.
+             */
+            void spy(bool enabled);
+            MockCallHistory& callHistory();
             /*
              * The following functions are recursively through the lower
              * MockSupports scopes This means, if you do mock().disable() it
@@ -130,6 +166,21 @@ namespace cpputest
             virtual void tracing(bool enabled);
             virtual void ignoreOtherCalls();
 
+            /*
+             * Concurrent mode lets the code under test make mock calls from
+             * several threads. Every thread builds its own actual call and
+             * only takes the lock of the mock while it is matched. The call
+             * order, also for strictOrder(), is the order in which the
+             * calls were started. Scopes are looked up and created under
+             * the lock. Looking up scopes and setting expectations count
+             * checks on the test, and the check count of a test is not
+             * thread-safe: when other threads do either, the number of
+             * checks reported for the test is unreliable. Set data and
+             * comparators from the thread of the test. Tracing, recording
+             * and replaying are not covered.
+             */
+            virtual void concurrent(bool enabled);
+
             virtual void checkExpectations();
             virtual bool expectedCallsLeft();
 
@@ -167,10 +218,12 @@ namespace cpputest
         private:
             unsigned int actualCallOrder_;
             unsigned int expectedCallOrder_;
+            unsigned int outOfOrderCalls_;
             bool strictOrdering_;
             MockFailureReporter* activeReporter_;
             MockFailureReporter* standardReporter_;
             MockFailureReporter defaultReporter_;
+            MockArena arena_;
             MockExpectedCallsList expectations_;
             bool ignoreOtherCalls_;
             bool enabled_;
@@ -179,10 +232,30 @@ namespace cpputest
                 comparatorsAndCopiersRepository_;
             MockNamedValueList data_;
             const SimpleString mockName_;
+            unsigned long scopeGeneration_;
 
             bool tracing_;
+            MockCallRecorder* recorder_;
+            MockCallReplay* replay_;
+            MockExpectedCallsList replayedCalls_;
+            MockConcurrentCalls* concurrentCalls_;
+            MockNameIndex stubs_;
+            // The functions with expectations, so stubbed and ignored calls
+            // do not search the expectations.
+            MockNameIndex expectedFunctions_;
+            MockStubActualCall stubCall_;
+            bool spying_;
+            MockCallHistory callHistory_;
+            MockSpyActualCall spyCall_;
 
             void checkExpectationsOfLastActualCall();
+            void endLastActualCall();
+            void loadNextReplayedCall();
+            MockActualCall& concurrentActualCall(const SimpleString& name);
+            MockStub* findStub(const SimpleString& functionName);
+            MockStub* stubbedCall(const SimpleString& functionName);
+            bool hasExpectationWithName(const SimpleString& name);
+            void deleteStubs();
             bool wasLastActualCallFulfilled();
             void failTestWithExpectedCallsNotFulfilled();
             void failTestWithOutOfOrderCalls();
@@ -193,8 +266,36 @@ namespace cpputest
 
             bool callIsIgnored(const SimpleString& functionName);
             bool hasCallsOutOfOrder();
+            bool isConfiguredForUse() const;
 
             SimpleString appendScopeToName(const SimpleString& functionName);
+
+            friend class MockScope;
+        };
+
+        /*
+         * MockScope is a handle to a named mocking scope that can be kept
+         * around, e.g. MockScope hal = mock().scope("hal"). It looks the
+         * scope up once and then only again after the owning MockSupport
+         * was cleared, so hal->actualCall("read") does the same as
+         * mock("hal").actualCall("read") without the lookup. When the
+         * scope is still set up for use, the reporter and comparators are
+         * not set again. The handle must not outlive the MockSupport it
+         * was taken from.
+         */
+        class MockScope
+        {
+        public:
+            MockScope(MockSupport& owner, const SimpleString& name);
+
+            MockSupport& get();
+            MockSupport* operator->();
+
+        private:
+            MockSupport* owner_;
+            SimpleString name_;
+            MockSupport* support_;
+            unsigned long generation_;
         };
     }
 }
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef D_MockTraceSink_h
+#define D_MockTraceSink_h
+
+#include "CppUTest/SimpleString.hpp"
+
+namespace cpputest
+{
+    namespace extensions
+    {
+        /*
+         * A MockTraceSink receives the calls recorded by mock().tracing(true).
+         * Every call is a function name followed by details such as
+         * parameters, each a label and a value. Install one with
+         * mock().setTraceSink(&sink); without one the trace is kept in
+         * memory and returned by mock().getTraceOutput().
+         */
+        class MockTraceSink
+        {
+        public:
+            virtual ~MockTraceSink() {}
+
+            virtual void callStarted(const SimpleString& functionName) = 0;
+            virtual void callDetail(
+                const SimpleString& label, const SimpleString& value
+            ) = 0;
+
+            virtual const char* getTraceOutput();
+            virtual void clear() {}
+            virtual void flush() {}
+        };
+
+        struct MockTraceBuffer;
+        struct MockTraceFileSinkImpl;
+
+        // Keeps the whole trace as text in a buffer that grows by doubling.
+        class MockTraceBufferSink : public MockTraceSink
+        {
+        public:
+            MockTraceBufferSink();
+            virtual ~MockTraceBufferSink() override;
+
+            virtual void callStarted(const SimpleString& functionName
+            ) override;
+            virtual void callDetail(
+                const SimpleString& label, const SimpleString& value
+            ) override;
+
+            virtual const char* getTraceOutput() override;
+            virtual void clear() override;
+
+        private:
+            MockTraceBuffer* buffer_;
+
+            MockTraceBufferSink(const MockTraceBufferSink&);
+            MockTraceBufferSink& operator=(const MockTraceBufferSink&);
+        };
+
+        // Keeps the text of only the last calls, oldest first.
+        class MockTraceRingSink : public MockTraceSink
+        {
+        public:
+            MockTraceRingSink(size_t calls);
+            virtual ~MockTraceRingSink() override;
+
+            virtual void callStarted(const SimpleString& functionName
+            ) override;
+            virtual void callDetail(
+                const SimpleString& label, const SimpleString& value
+            ) override;
+
+            virtual const char* getTraceOutput() override;
+            virtual void clear() override;
+
+        private:
+            SimpleString* calls_;
+            size_t capacity_;
+            size_t count_;
+            size_t current_;
+            SimpleString output_;
+
+            MockTraceRingSink(const MockTraceRingSink&);
+            MockTraceRingSink& operator=(const MockTraceRingSink&);
+        };
+
+        /*
+         * Streams the trace to a file through a write buffer. The text
+         * encoding is what getTraceOutput() shows. The binary encoding
+         * writes a magic header and then records: a kind byte followed by
+         * LEB128 numbers and length prefixed strings. Function names and
+         * labels are written once and referred to by index afterwards.
+         * decode() turns such a trace back into calls on another sink.
+         */
+        class MockTraceFileSink : public MockTraceSink
+        {
+        public:
+            enum Encoding
+            {
+                TEXT_ENCODING,
+                BINARY_ENCODING
+            };
+
+            MockTraceFileSink(
+                const SimpleString& fileName,
+                Encoding encoding = TEXT_ENCODING
+            );
+            virtual ~MockTraceFileSink() override;
+
+            virtual void callStarted(const SimpleString& functionName
+            ) override;
+            virtual void callDetail(
+                const SimpleString& label, const SimpleString& value
+            ) override;
+
+            virtual void flush() override;
+
+            static bool
+            decode(const void* data, size_t size, MockTraceSink& sink);
+            static bool
+            decodeFile(const SimpleString& fileName, MockTraceSink& sink);
+
+        protected:
+            virtual void openFile();
+            virtual void writeToFile(const void* data, size_t size);
+            virtual void closeFile();
+
+        private:
+            MockTraceFileSinkImpl* impl_;
+
+            void writeString(const SimpleString& text);
+            size_t nameIndex(const SimpleString& name);
+            void bufferWritten();
+
+            MockTraceFileSink(const MockTraceFileSink&);
+            MockTraceFileSink& operator=(const MockTraceFileSink&);
+        };
+    }
+}
+
+#endif
@@ -52,16 +52,25 @@ namespace cpputest
             return functionName_;
         }
 
+        MockCheckedExpectedCall*
+        MockCheckedActualCall::getMatchingExpectation() const
+        {
+            return matchingExpectation_;
+        }
+
         MockCheckedActualCall::MockCheckedActualCall(
             unsigned int callOrder,
             MockFailureReporter* reporter,
-            const MockExpectedCallsList& allExpectations
+            const MockExpectedCallsList& allExpectations,
+            unsigned int* outOfOrderCalls
         ) :
             callOrder_(callOrder),
             reporter_(reporter),
             state_(CALL_SUCCEED),
             expectationsChecked_(false),
             matchingExpectation_(nullptr),
+            outOfOrderCalls_(outOfOrderCalls),
+            recorder_(nullptr),
             allExpectations_(allExpectations),
             outputParameterExpectations_(nullptr)
         {
@@ -82,6 +91,11 @@ namespace cpputest
             reporter_ = reporter;
         }
 
+        void MockCheckedActualCall::recordTo(MockCallRecorder* recorder)
+        {
+            recorder_ = recorder;
+        }
+
         UtestShell* MockCheckedActualCall::getTest() const
         {
             return reporter_->getTestToFail();
@@ -108,7 +122,9 @@ namespace cpputest
                     copier->copy(
                         p->ptr_, outputParameter.getConstObjectPointer()
                     );
-                } else if ((outputParameter.getType() == "const void*") && (p->type_ == "void*")) {
+                } else if ((outputParameter.getValueType() ==
+                            MockNamedValue::VALUE_CONST_POINTER) &&
+                           (p->type_ == "void*")) {
                     const void* data = outputParameter.getConstPointerValue();
                     size_t size = outputParameter.getSize();
                     memcpy(p->ptr_, data, size);
@@ -164,6 +180,8 @@ namespace cpputest
         {
             setName(name);
             setState(CALL_IN_PROGRESS);
+            if (recorder_)
+                recorder_->callStarted(name);
 
             potentiallyMatchingExpectations_.onlyKeepExpectationsRelatedTo(name
             );
@@ -189,6 +207,9 @@ namespace cpputest
             const MockNamedValue& actualParameter
         )
         {
+            if (recorder_)
+                recorder_->inputParameter(actualParameter);
+
             if (hasFailed()) {
                 return;
             }
@@ -377,8 +398,19 @@ namespace cpputest
             const void* value
         )
         {
+            // The expectations resolved the comparator when they were made,
+            // so only look the type up when none of them has it.
             MockNamedValue actualParameter(name);
-            actualParameter.setConstObjectPointer(type, value);
+            MockNamedValueComparator* comparator =
+                potentiallyMatchingExpectations_.getComparatorForInputParameter(
+                    type, name
+                );
+            if (comparator)
+                actualParameter.setConstObjectPointer(
+                    type, value, comparator, nullptr
+                );
+            else
+                actualParameter.setConstObjectPointer(type, value);
 
             if (actualParameter.getComparator() == nullptr) {
                 MockNoWayToCompareCustomTypeFailure failure(getTest(), type);
@@ -408,8 +440,12 @@ namespace cpputest
         {
             addOutputParameter(name, type, output);
 
+            // Only the type is compared here; the copier used is the one
+            // the expectation resolved.
             MockNamedValue outputParameter(name);
-            outputParameter.setConstObjectPointer(type, output);
+            outputParameter.setConstObjectPointer(
+                type, output, nullptr, nullptr
+            );
             checkOutputParameter(outputParameter);
 
             return *this;
@@ -425,6 +461,17 @@ namespace cpputest
             return state_ == CALL_FAILED;
         }
 
+        // Counts expectations the moment they go out of order, so the owner
+        // does not have to search all expectations to find out.
+        void MockCheckedActualCall::matchingExpectationWasCalled()
+        {
+            bool wasOutOfOrder = matchingExpectation_->isOutOfOrder();
+            matchingExpectation_->callWasMade(callOrder_);
+            if (outOfOrderCalls_ && !wasOutOfOrder &&
+                matchingExpectation_->isOutOfOrder())
+                (*outOfOrderCalls_)++;
+        }
+
         void MockCheckedActualCall::checkExpectations()
         {
             if (expectationsChecked_) {
@@ -433,9 +480,16 @@ namespace cpputest
 
             expectationsChecked_ = true;
 
+            matchExpectations();
+            if (recorder_)
+                recordCallResult();
+        }
+
+        void MockCheckedActualCall::matchExpectations()
+        {
             if (state_ != CALL_IN_PROGRESS) {
                 if (state_ == CALL_SUCCEED) {
-                    matchingExpectation_->callWasMade(callOrder_);
+                    matchingExpectationWasCalled();
                 }
                 potentiallyMatchingExpectations_.resetActualCallMatchingState();
                 return;
@@ -456,7 +510,7 @@ namespace cpputest
             if (matchingExpectation_) {
                 matchingExpectation_->finalizeActualCallMatch();
                 callHasSucceeded();
-                matchingExpectation_->callWasMade(callOrder_);
+                matchingExpectationWasCalled();
                 potentiallyMatchingExpectations_.resetActualCallMatchingState();
                 return;
             }
@@ -476,6 +530,30 @@ namespace cpputest
             }
         }
 
+        // The sizes of the output parameters and the return value are the
+        // ones of the matching expectation, the call itself cannot tell
+        // them. The output bytes are the ones that were copied out.
+        void MockCheckedActualCall::recordCallResult()
+        {
+            if (state_ != CALL_SUCCEED || matchingExpectation_ == nullptr)
+                return;
+
+            for (MockOutputParametersListNode* p = outputParameterExpectations_;
+                 p; p = p->next_) {
+                MockNamedValue outputParameter =
+                    matchingExpectation_->getOutputParameter(p->name_);
+                if (outputParameter.getValueType() ==
+                    MockNamedValue::VALUE_CONST_POINTER)
+                    recorder_->outputParameter(
+                        p->name_, p->ptr_, outputParameter.getSize()
+                    );
+            }
+
+            MockNamedValue value = matchingExpectation_->returnValue();
+            if (!value.getName().isEmpty())
+                recorder_->returnValue(value);
+        }
+
         void MockCheckedActualCall::setState(ActualCallState state)
         {
             state_ = state;
@@ -734,38 +812,36 @@ namespace cpputest
             }
         }
 
-        MockActualCallTrace::MockActualCallTrace() {}
+        MockTraceSink* MockActualCallTrace::installedSink_ = nullptr;
 
-        MockActualCallTrace::~MockActualCallTrace() {}
+        MockActualCallTrace::MockActualCallTrace() :
+            sink_(installedSink_ ? installedSink_ : &buffer_)
+        {
+        }
+
+        MockActualCallTrace::~MockActualCallTrace()
+        {
+            sink_->flush();
+        }
 
         MockActualCall& MockActualCallTrace::withName(const SimpleString& name)
         {
-            traceBuffer_ += "\nFunction name:";
-            traceBuffer_ += name;
+            sink_->callStarted(name);
             return *this;
         }
 
         MockActualCall&
         MockActualCallTrace::withCallOrder(unsigned int callOrder)
         {
-            traceBuffer_ += " withCallOrder:";
-            traceBuffer_ += StringFrom(callOrder);
+            sink_->callDetail("withCallOrder", StringFrom(callOrder));
             return *this;
         }
 
-        void MockActualCallTrace::addParameterName(const SimpleString& name)
-        {
-            traceBuffer_ += " ";
-            traceBuffer_ += name;
-            traceBuffer_ += ":";
-        }
-
         MockActualCall& MockActualCallTrace::withBoolParameter(
             const SimpleString& name, bool value
         )
         {
-            addParameterName(name);
-            traceBuffer_ += StringFrom(value);
+            sink_->callDetail(name, StringFrom(value));
             return *this;
         }
 
@@ -773,9 +849,10 @@ namespace cpputest
             const SimpleString& name, unsigned int value
         )
         {
-            addParameterName(name);
-            traceBuffer_ +=
-                StringFrom(value) + " " + BracketsFormattedHexStringFrom(value);
+            sink_->callDetail(
+                name,
+                StringFrom(value) + " " + BracketsFormattedHexStringFrom(value)
+            );
             return *this;
         }
 
@@ -783,9 +860,10 @@ namespace cpputest
             const SimpleString& name, int value
         )
         {
-            addParameterName(name);
-            traceBuffer_ +=
-                StringFrom(value) + " " + BracketsFormattedHexStringFrom(value);
+            sink_->callDetail(
+                name,
+                StringFrom(value) + " " + BracketsFormattedHexStringFrom(value)
+            );
             return *this;
         }
 
@@ -793,9 +871,10 @@ namespace cpputest
             const SimpleString& name, unsigned long int value
         )
         {
-            addParameterName(name);
-            traceBuffer_ +=
-                StringFrom(value) + " " + BracketsFormattedHexStringFrom(value);
+            sink_->callDetail(
+                name,
+                StringFrom(value) + " " + BracketsFormattedHexStringFrom(value)
+            );
             return *this;
         }
 
@@ -803,9 +882,10 @@ namespace cpputest
             const SimpleString& name, long int value
         )
         {
-            addParameterName(name);
-            traceBuffer_ +=
-                StringFrom(value) + " " + BracketsFormattedHexStringFrom(value);
+            sink_->callDetail(
+                name,
+                StringFrom(value) + " " + BracketsFormattedHexStringFrom(value)
+            );
             return *this;
         }
 
@@ -813,9 +893,10 @@ namespace cpputest
             const SimpleString& name, unsigned long long value
         )
         {
-            addParameterName(name);
-            traceBuffer_ +=
-                StringFrom(value) + " " + BracketsFormattedHexStringFrom(value);
+            sink_->callDetail(
+                name,
+                StringFrom(value) + " " + BracketsFormattedHexStringFrom(value)
+            );
             return *this;
         }
 
@@ -823,9 +904,10 @@ namespace cpputest
             const SimpleString& name, long long value
         )
         {
-            addParameterName(name);
-            traceBuffer_ +=
-                StringFrom(value) + " " + BracketsFormattedHexStringFrom(value);
+            sink_->callDetail(
+                name,
+                StringFrom(value) + " " + BracketsFormattedHexStringFrom(value)
+            );
             return *this;
         }
 
@@ -833,8 +915,7 @@ namespace cpputest
             const SimpleString& name, double value
         )
         {
-            addParameterName(name);
-            traceBuffer_ += StringFrom(value);
+            sink_->callDetail(name, StringFrom(value));
             return *this;
         }
 
@@ -842,8 +923,7 @@ namespace cpputest
             const SimpleString& name, const char* value
         )
         {
-            addParameterName(name);
-            traceBuffer_ += StringFrom(value);
+            sink_->callDetail(name, StringFrom(value));
             return *this;
         }
 
@@ -851,8 +931,7 @@ namespace cpputest
             const SimpleString& name, void* value
         )
         {
-            addParameterName(name);
-            traceBuffer_ += StringFrom(value);
+            sink_->callDetail(name, StringFrom(value));
             return *this;
         }
 
@@ -860,8 +939,7 @@ namespace cpputest
             const SimpleString& name, const void* value
         )
         {
-            addParameterName(name);
-            traceBuffer_ += StringFrom(value);
+            sink_->callDetail(name, StringFrom(value));
             return *this;
         }
 
@@ -869,8 +947,7 @@ namespace cpputest
             const SimpleString& name, void (*value)()
         )
         {
-            addParameterName(name);
-            traceBuffer_ += StringFrom(value);
+            sink_->callDetail(name, StringFrom(value));
             return *this;
         }
 
@@ -878,8 +955,9 @@ namespace cpputest
             const SimpleString& name, const unsigned char* value, size_t size
         )
         {
-            addParameterName(name);
-            traceBuffer_ += StringFromBinaryWithSizeOrNull(value, size);
+            sink_->callDetail(
+                name, StringFromBinaryWithSizeOrNull(value, size)
+            );
             return *this;
         }
 
@@ -889,10 +967,7 @@ namespace cpputest
             const void* value
         )
         {
-            traceBuffer_ += " ";
-            traceBuffer_ += typeName;
-            addParameterName(name);
-            traceBuffer_ += StringFrom(value);
+            sink_->callDetail(typeName + " " + name, StringFrom(value));
             return *this;
         }
 
@@ -900,8 +975,7 @@ namespace cpputest
             const SimpleString& name, void* output
         )
         {
-            addParameterName(name);
-            traceBuffer_ += StringFrom(output);
+            sink_->callDetail(name, StringFrom(output));
             return *this;
         }
 
@@ -909,10 +983,7 @@ namespace cpputest
             const SimpleString& typeName, const SimpleString& name, void* output
         )
         {
-            traceBuffer_ += " ";
-            traceBuffer_ += typeName;
-            addParameterName(name);
-            traceBuffer_ += StringFrom(output);
+            sink_->callDetail(typeName + " " + name, StringFrom(output));
             return *this;
         }
 
@@ -1056,19 +1127,25 @@ namespace cpputest
 
         MockActualCall& MockActualCallTrace::onObject(const void* objectPtr)
         {
-            traceBuffer_ += " onObject:";
-            traceBuffer_ += StringFrom(objectPtr);
+            sink_->callDetail("onObject", StringFrom(objectPtr));
             return *this;
         }
 
         void MockActualCallTrace::clear()
         {
-            traceBuffer_ = "";
+            sink_->clear();
         }
 
         const char* MockActualCallTrace::getTraceOutput()
         {
-            return traceBuffer_.asCharString();
+            return sink_->getTraceOutput();
+        }
+
+        void MockActualCallTrace::setSink(MockTraceSink* sink)
+        {
+            installedSink_ = sink;
+            if (instance_)
+                instance_->sink_ = sink ? sink : &instance_->buffer_;
         }
 
         MockActualCallTrace* MockActualCallTrace::instance_ = nullptr;
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTestExt/MockArena.hpp"
+
+namespace cpputest
+{
+    namespace extensions
+    {
+        static const size_t arenaAlignment = 2 * sizeof(void*);
+
+        struct MockArenaBlock
+        {
+            MockArenaBlock* next_;
+        };
+
+        static size_t alignedSize(size_t size)
+        {
+            return (size + arenaAlignment - 1) & ~(arenaAlignment - 1);
+        }
+
+        MockArena::MockArena() : blocks_(nullptr), next_(nullptr), remaining_(0)
+        {
+        }
+
+        MockArena::~MockArena()
+        {
+            release();
+        }
+
+        void* MockArena::allocate(size_t size)
+        {
+            size = alignedSize(size);
+            if (size > remaining_) {
+                size_t header = alignedSize(sizeof(MockArenaBlock));
+                size_t capacity = (size > blockSize) ? size : blockSize;
+                char* memory = new char[header + capacity];
+                MockArenaBlock* block =
+                    reinterpret_cast<MockArenaBlock*>(memory);
+                block->next_ = blocks_;
+                blocks_ = block;
+                next_ = memory + header;
+                remaining_ = capacity;
+            }
+            void* result = next_;
+            next_ += size;
+            remaining_ -= size;
+            return result;
+        }
+
+        void MockArena::release()
+        {
+            while (blocks_) {
+                MockArenaBlock* next = blocks_->next_;
+                delete[] reinterpret_cast<char*>(blocks_);
+                blocks_ = next;
+            }
+            next_ = nullptr;
+            remaining_ = 0;
+        }
+
+        size_t MockArena::blockCount() const
+        {
+            size_t count = 0;
+            for (MockArenaBlock* block = blocks_; block; block = block->next_)
+                count++;
+            return count;
+        }
+    }
+}
+
+void* operator new(size_t size, cpputest::extensions::MockArena& arena)
+{
+    return arena.allocate(size);
+}
+
+void operator delete(void*, cpputest::extensions::MockArena&) {}
@@ -0,0 +1,801 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTestExt/MockCallHistory.hpp"
+
+#include <string.h>
+
+namespace cpputest
+{
+    namespace extensions
+    {
+        static const size_t historyChunkSize = 512;
+
+        struct MockCallHistoryCalls
+        {
+            unsigned int function_[historyChunkSize];
+            size_t firstParameter_[historyChunkSize];
+        };
+
+        struct MockCallHistoryParameters
+        {
+            unsigned int name_[historyChunkSize];
+            unsigned char type_[historyChunkSize];
+            size_t size_[historyChunkSize];
+            MockCallHistoryValue value_[historyChunkSize];
+        };
+
+        // Chunks are found through an index that doubles when it is full,
+        // so it grows a handful of times over a long history.
+        template <typename Chunk>
+        static Chunk* addChunk(
+            MockArena& arena, Chunk**& chunks, size_t count, size_t& capacity
+        )
+        {
+            if (count == capacity) {
+                size_t newCapacity = capacity ? 2 * capacity : 16;
+                Chunk** newChunks = new Chunk*[newCapacity];
+                for (size_t i = 0; i < count; i++)
+                    newChunks[i] = chunks[i];
+                delete[] chunks;
+                chunks = newChunks;
+                capacity = newCapacity;
+            }
+            Chunk* chunk = static_cast<Chunk*>(arena.allocate(sizeof(Chunk)));
+            chunks[count] = chunk;
+            return chunk;
+        }
+
+        MockSpiedCall::MockSpiedCall(
+            const MockCallHistory& history, size_t call
+        ) :
+            history_(&history),
+            call_(call)
+        {
+        }
+
+        bool MockSpiedCall::isValid() const
+        {
+            return call_ < history_->size();
+        }
+
+        SimpleString MockSpiedCall::getName() const
+        {
+            if (!isValid())
+                return "";
+            return history_->nameOf(history_->functionOf(call_));
+        }
+
+        size_t MockSpiedCall::getSequenceNumber() const
+        {
+            return call_;
+        }
+
+        size_t MockSpiedCall::getParameterCount() const
+        {
+            if (!isValid())
+                return 0;
+            return history_->parameterCountOf(call_);
+        }
+
+        bool MockSpiedCall::hasParameter(const SimpleString& name) const
+        {
+            return !getParameter(name).getName().isEmpty();
+        }
+
+        MockNamedValue MockSpiedCall::getParameter(const SimpleString& name
+        ) const
+        {
+            unsigned int id;
+            if (!isValid() || !history_->findNameId(name, id))
+                return MockNamedValue("");
+            size_t first = history_->firstParameterOf(call_);
+            size_t count = history_->parameterCountOf(call_);
+            for (size_t i = first; i < first + count; i++)
+                if (history_->parameterNameOf(i) == id)
+                    return history_->parameterAt(i);
+            return MockNamedValue("");
+        }
+
+        MockNamedValue MockSpiedCall::getParameter(size_t index) const
+        {
+            if (index >= getParameterCount())
+                return MockNamedValue("");
+            return history_->parameterAt(
+                history_->firstParameterOf(call_) + index
+            );
+        }
+
+        MockCallHistory::MockCallHistory() :
+            names_(nullptr),
+            nameHashes_(nullptr),
+            nameIndex_(nullptr),
+            nameCount_(0),
+            nameCapacity_(0),
+            calls_(nullptr),
+            callChunkCapacity_(0),
+            callCount_(0),
+            parameters_(nullptr),
+            parameterChunkCapacity_(0),
+            parameterCount_(0)
+        {
+        }
+
+        MockCallHistory::~MockCallHistory()
+        {
+            clear();
+        }
+
+        void MockCallHistory::clear()
+        {
+            for (size_t i = 0; i < nameCount_; i++)
+                delete names_[i];
+            delete[] names_;
+            delete[] nameHashes_;
+            delete[] nameIndex_;
+            names_ = nullptr;
+            nameHashes_ = nullptr;
+            nameIndex_ = nullptr;
+            nameCount_ = 0;
+            nameCapacity_ = 0;
+
+            delete[] calls_;
+            calls_ = nullptr;
+            callChunkCapacity_ = 0;
+            callCount_ = 0;
+            delete[] parameters_;
+            parameters_ = nullptr;
+            parameterChunkCapacity_ = 0;
+            parameterCount_ = 0;
+            arena_.release();
+        }
+
+        bool MockCallHistory::findNameId(
+            const SimpleString& name, unsigned int& id
+        ) const
+        {
+            if (nameIndex_ == nullptr)
+                return false;
+
+            size_t mask = 2 * nameCapacity_ - 1;
+            unsigned long hash = MockNamedValue::hashName(name);
+            for (size_t slot = hash & mask; nameIndex_[slot] != 0;
+                 slot = (slot + 1) & mask) {
+                unsigned int candidate = nameIndex_[slot] - 1;
+                if (nameHashes_[candidate] == hash &&
+                    *names_[candidate] == name) {
+                    id = candidate;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void MockCallHistory::indexName(unsigned int id)
+        {
+            size_t mask = 2 * nameCapacity_ - 1;
+            size_t slot = nameHashes_[id] & mask;
+            while (nameIndex_[slot] != 0)
+                slot = (slot + 1) & mask;
+            nameIndex_[slot] = id + 1;
+        }
+
+        unsigned int MockCallHistory::nameId(const SimpleString& name)
+        {
+            unsigned int id;
+            if (findNameId(name, id))
+                return id;
+
+            if (nameCount_ == nameCapacity_) {
+                size_t newCapacity = nameCapacity_ ? 2 * nameCapacity_ : 16;
+                SimpleString** newNames = new SimpleString*[newCapacity];
+                unsigned long* newHashes = new unsigned long[newCapacity];
+                for (size_t i = 0; i < nameCount_; i++) {
+                    newNames[i] = names_[i];
+                    newHashes[i] = nameHashes_[i];
+                }
+                delete[] names_;
+                delete[] nameHashes_;
+                delete[] nameIndex_;
+                names_ = newNames;
+                nameHashes_ = newHashes;
+                nameCapacity_ = newCapacity;
+
+                nameIndex_ = new unsigned int[2 * newCapacity];
+                for (size_t i = 0; i < 2 * newCapacity; i++)
+                    nameIndex_[i] = 0;
+                for (size_t i = 0; i < nameCount_; i++)
+                    indexName(static_cast<unsigned int>(i));
+            }
+            names_[nameCount_] = new SimpleString(name);
+            nameHashes_[nameCount_] = MockNamedValue::hashName(name);
+            indexName(static_cast<unsigned int>(nameCount_));
+            return static_cast<unsigned int>(nameCount_++);
+        }
+
+        const SimpleString& MockCallHistory::nameOf(unsigned int id) const
+        {
+            return *names_[id];
+        }
+
+        void MockCallHistory::recordCall(const SimpleString& function)
+        {
+            size_t chunk = callCount_ / historyChunkSize;
+            size_t slot = callCount_ % historyChunkSize;
+            MockCallHistoryCalls* calls =
+                (slot == 0)
+                    ? addChunk(arena_, calls_, chunk, callChunkCapacity_)
+                    : calls_[chunk];
+            calls->function_[slot] = nameId(function);
+            calls->firstParameter_[slot] = parameterCount_;
+            callCount_++;
+        }
+
+        size_t MockCallHistory::addParameter(
+            const SimpleString& name, MockNamedValue::ValueType type
+        )
+        {
+            size_t parameter = parameterCount_++;
+            size_t chunk = parameter / historyChunkSize;
+            size_t slot = parameter % historyChunkSize;
+            MockCallHistoryParameters* parameters =
+                (slot == 0)
+                    ? addChunk(
+                          arena_, parameters_, chunk, parameterChunkCapacity_
+                      )
+                    : parameters_[chunk];
+            parameters->name_[slot] = nameId(name);
+            parameters->type_[slot] = static_cast<unsigned char>(type);
+            parameters->size_[slot] = 0;
+            return parameter;
+        }
+
+        MockCallHistoryValue& MockCallHistory::recordParameter(
+            const SimpleString& name, MockNamedValue::ValueType type
+        )
+        {
+            size_t parameter = addParameter(name, type);
+            return parameters_[parameter / historyChunkSize]
+                ->value_[parameter % historyChunkSize];
+        }
+
+        void MockCallHistory::recordStringParameter(
+            const SimpleString& name, const char* value
+        )
+        {
+            char* copy = nullptr;
+            if (value) {
+                size_t size = SimpleString::StrLen(value) + 1;
+                copy = static_cast<char*>(arena_.allocate(size));
+                memcpy(copy, value, size);
+            }
+            recordParameter(name, MockNamedValue::VALUE_STRING).stringValue_ =
+                copy;
+        }
+
+        void MockCallHistory::recordMemoryBufferParameter(
+            const SimpleString& name, const unsigned char* value, size_t size
+        )
+        {
+            unsigned char* copy = nullptr;
+            if (value && size > 0) {
+                copy = static_cast<unsigned char*>(arena_.allocate(size));
+                memcpy(copy, value, size);
+            }
+            size_t parameter =
+                addParameter(name, MockNamedValue::VALUE_MEMORY_BUFFER);
+            MockCallHistoryParameters* parameters =
+                parameters_[parameter / historyChunkSize];
+            parameters->value_[parameter % historyChunkSize]
+                .memoryBufferValue_ = copy;
+            parameters->size_[parameter % historyChunkSize] = size;
+        }
+
+        void MockCallHistory::recordObjectParameter(
+            const SimpleString& type,
+            const SimpleString& name,
+            const void* value
+        )
+        {
+            size_t parameter = addParameter(name, MockNamedValue::VALUE_OBJECT);
+            MockCallHistoryParameters* parameters =
+                parameters_[parameter / historyChunkSize];
+            parameters->value_[parameter % historyChunkSize]
+                .constPointerValue_ = value;
+            parameters->size_[parameter % historyChunkSize] = nameId(type);
+        }
+
+        unsigned int MockCallHistory::functionOf(size_t call) const
+        {
+            return calls_[call / historyChunkSize]
+                ->function_[call % historyChunkSize];
+        }
+
+        size_t MockCallHistory::firstParameterOf(size_t call) const
+        {
+            return calls_[call / historyChunkSize]
+                ->firstParameter_[call % historyChunkSize];
+        }
+
+        size_t MockCallHistory::parameterCountOf(size_t call) const
+        {
+            size_t end = (call + 1 < callCount_) ? firstParameterOf(call + 1)
+                                                 : parameterCount_;
+            return end - firstParameterOf(call);
+        }
+
+        unsigned int MockCallHistory::parameterNameOf(size_t parameter) const
+        {
+            return parameters_[parameter / historyChunkSize]
+                ->name_[parameter % historyChunkSize];
+        }
+
+        MockNamedValue MockCallHistory::parameterAt(size_t parameter) const
+        {
+            const MockCallHistoryParameters* parameters =
+                parameters_[parameter / historyChunkSize];
+            size_t slot = parameter % historyChunkSize;
+            const MockCallHistoryValue& v = parameters->value_[slot];
+            unsigned char type = parameters->type_[slot];
+
+            MockNamedValue value(nameOf(parameters->name_[slot]));
+            if (type == MockNamedValue::VALUE_BOOL)
+                value.setValue(v.boolValue_);
+            else if (type == MockNamedValue::VALUE_INT)
+                value.setValue(v.intValue_);
+            else if (type == MockNamedValue::VALUE_UNSIGNED_INT)
+                value.setValue(v.unsignedIntValue_);
+            else if (type == MockNamedValue::VALUE_LONG_INT)
+                value.setValue(v.longIntValue_);
+            else if (type == MockNamedValue::VALUE_UNSIGNED_LONG_INT)
+                value.setValue(v.unsignedLongIntValue_);
+            else if (type == MockNamedValue::VALUE_LONG_LONG_INT)
+                value.setValue(v.longLongIntValue_);
+            else if (type == MockNamedValue::VALUE_UNSIGNED_LONG_LONG_INT)
+                value.setValue(v.unsignedLongLongIntValue_);
+            else if (type == MockNamedValue::VALUE_DOUBLE)
+                value.setValue(v.doubleValue_);
+            else if (type == MockNamedValue::VALUE_STRING)
+                value.setValue(v.stringValue_);
+            else if (type == MockNamedValue::VALUE_POINTER)
+                value.setValue(v.pointerValue_);
+            else if (type == MockNamedValue::VALUE_CONST_POINTER)
+                value.setValue(v.constPointerValue_);
+            else if (type == MockNamedValue::VALUE_FUNCTION_POINTER)
+                value.setValue(v.functionPointerValue_);
+            else if (type == MockNamedValue::VALUE_MEMORY_BUFFER)
+                value.setMemoryBuffer(
+                    v.memoryBufferValue_, parameters->size_[slot]
+                );
+            else
+                value.setConstObjectPointer(
+                    nameOf(static_cast<unsigned int>(parameters->size_[slot])),
+                    v.constPointerValue_
+                );
+            return value;
+        }
+
+        size_t MockCallHistory::size() const
+        {
+            return callCount_;
+        }
+
+        size_t MockCallHistory::countCalls(const SimpleString& function) const
+        {
+            unsigned int id;
+            if (!findNameId(function, id))
+                return 0;
+            size_t count = 0;
+            for (size_t call = 0; call < callCount_; call++)
+                if (functionOf(call) == id)
+                    count++;
+            return count;
+        }
+
+        size_t MockCallHistory::countCalls(
+            const SimpleString& function, MockSpiedCallPredicate matches
+        ) const
+        {
+            unsigned int id;
+            if (!findNameId(function, id))
+                return 0;
+            size_t count = 0;
+            for (size_t call = 0; call < callCount_; call++)
+                if (functionOf(call) == id &&
+                    matches(MockSpiedCall(*this, call)))
+                    count++;
+            return count;
+        }
+
+        MockSpiedCall MockCallHistory::getCall(size_t sequenceNumber) const
+        {
+            return MockSpiedCall(*this, sequenceNumber);
+        }
+
+        MockSpiedCall
+        MockCallHistory::getCall(const SimpleString& function, size_t n) const
+        {
+            unsigned int id;
+            if (findNameId(function, id))
+                for (size_t call = 0; call < callCount_; call++)
+                    if (functionOf(call) == id && n-- == 0)
+                        return MockSpiedCall(*this, call);
+            return MockSpiedCall(*this, callCount_);
+        }
+
+        MockSpyActualCall::MockSpyActualCall() :
+            history_(nullptr),
+            call_(nullptr)
+        {
+        }
+
+        MockSpyActualCall::~MockSpyActualCall() {}
+
+        MockActualCall& MockSpyActualCall::start(
+            MockCallHistory& history,
+            const SimpleString& name,
+            MockActualCall& call
+        )
+        {
+            history_ = &history;
+            call_ = &call;
+            history_->recordCall(name);
+            return *this;
+        }
+
+        MockActualCall& MockSpyActualCall::withName(const SimpleString&)
+        {
+            return *this;
+        }
+
+        MockActualCall& MockSpyActualCall::withCallOrder(unsigned int)
+        {
+            return *this;
+        }
+
+        MockActualCall& MockSpyActualCall::withBoolParameter(
+            const SimpleString& name, bool value
+        )
+        {
+            history_->recordParameter(name, MockNamedValue::VALUE_BOOL)
+                .boolValue_ = value;
+            call_->withBoolParameter(name, value);
+            return *this;
+        }
+
+        MockActualCall&
+        MockSpyActualCall::withIntParameter(const SimpleString& name, int value)
+        {
+            history_->recordParameter(name, MockNamedValue::VALUE_INT)
+                .intValue_ = value;
+            call_->withIntParameter(name, value);
+            return *this;
+        }
+
+        MockActualCall& MockSpyActualCall::withUnsignedIntParameter(
+            const SimpleString& name, unsigned int value
+        )
+        {
+            history_->recordParameter(name, MockNamedValue::VALUE_UNSIGNED_INT)
+                .unsignedIntValue_ = value;
+            call_->withUnsignedIntParameter(name, value);
+            return *this;
+        }
+
+        MockActualCall& MockSpyActualCall::withLongIntParameter(
+            const SimpleString& name, long int value
+        )
+        {
+            history_->recordParameter(name, MockNamedValue::VALUE_LONG_INT)
+                .longIntValue_ = value;
+            call_->withLongIntParameter(name, value);
+            return *this;
+        }
+
+        MockActualCall& MockSpyActualCall::withUnsignedLongIntParameter(
+            const SimpleString& name, unsigned long int value
+        )
+        {
+            history_
+                ->recordParameter(name, MockNamedValue::VALUE_UNSIGNED_LONG_INT)
+                .unsignedLongIntValue_ = value;
+            call_->withUnsignedLongIntParameter(name, value);
+            return *this;
+        }
+
+        MockActualCall& MockSpyActualCall::withLongLongIntParameter(
+            const SimpleString& name, long long value
+        )
+        {
+            history_->recordParameter(name, MockNamedValue::VALUE_LONG_LONG_INT)
+                .longLongIntValue_ = value;
+            call_->withLongLongIntParameter(name, value);
+            return *this;
+        }
+
+        MockActualCall& MockSpyActualCall::withUnsignedLongLongIntParameter(
+            const SimpleString& name, unsigned long long value
+        )
+        {
+            history_
+                ->recordParameter(
+                    name, MockNamedValue::VALUE_UNSIGNED_LONG_LONG_INT
+                )
+                .unsignedLongLongIntValue_ = value;
+            call_->withUnsignedLongLongIntParameter(name, value);
+            return *this;
+        }
+
+        MockActualCall& MockSpyActualCall::withDoubleParameter(
+            const SimpleString& name, double value
+        )
+        {
+            history_->recordParameter(name, MockNamedValue::VALUE_DOUBLE)
+                .doubleValue_ = value;
+            call_->withDoubleParameter(name, value);
+            return *this;
+        }
+
+        MockActualCall& MockSpyActualCall::withPointerParameter(
+            const SimpleString& name, void* value
+        )
+        {
+            history_->recordParameter(name, MockNamedValue::VALUE_POINTER)
+                .pointerValue_ = value;
+            call_->withPointerParameter(name, value);
+            return *this;
+        }
+
+        MockActualCall& MockSpyActualCall::withConstPointerParameter(
+            const SimpleString& name, const void* value
+        )
+        {
+            history_->recordParameter(name, MockNamedValue::VALUE_CONST_POINTER)
+                .constPointerValue_ = value;
+            call_->withConstPointerParameter(name, value);
+            return *this;
+        }
+
+        MockActualCall& MockSpyActualCall::withFunctionPointerParameter(
+            const SimpleString& name, void (*value)()
+        )
+        {
+            history_
+                ->recordParameter(name, MockNamedValue::VALUE_FUNCTION_POINTER)
+                .functionPointerValue_ = value;
+            call_->withFunctionPointerParameter(name, value);
+            return *this;
+        }
+
+        MockActualCall& MockSpyActualCall::withStringParameter(
+            const SimpleString& name, const char* value
+        )
+        {
+            history_->recordStringParameter(name, value);
+            call_->withStringParameter(name, value);
+            return *this;
+        }
+
+        MockActualCall& MockSpyActualCall::withMemoryBufferParameter(
+            const SimpleString& name, const unsigned char* value, size_t size
+        )
+        {
+            history_->recordMemoryBufferParameter(name, value, size);
+            call_->withMemoryBufferParameter(name, value, size);
+            return *this;
+        }
+
+        MockActualCall& MockSpyActualCall::withParameterOfType(
+            const SimpleString& typeName,
+            const SimpleString& name,
+            const void* value
+        )
+        {
+            history_->recordObjectParameter(typeName, name, value);
+            call_->withParameterOfType(typeName, name, value);
+            return *this;
+        }
+
+        MockActualCall& MockSpyActualCall::withOutputParameter(
+            const SimpleString& name, void* output
+        )
+        {
+            history_->recordParameter(name, MockNamedValue::VALUE_POINTER)
+                .pointerValue_ = output;
+            call_->withOutputParameter(name, output);
+            return *this;
+        }
+
+        MockActualCall& MockSpyActualCall::withOutputParameterOfType(
+            const SimpleString& typeName, const SimpleString& name, void* output
+        )
+        {
+            history_->recordParameter(name, MockNamedValue::VALUE_POINTER)
+                .pointerValue_ = output;
+            call_->withOutputParameterOfType(typeName, name, output);
+            return *this;
+        }
+
+        MockActualCall& MockSpyActualCall::onObject(const void* objectPtr)
+        {
+            call_->onObject(objectPtr);
+            return *this;
+        }
+
+        bool MockSpyActualCall::hasReturnValue()
+        {
+            return call_->hasReturnValue();
+        }
+
+        MockNamedValue MockSpyActualCall::returnValue()
+        {
+            return call_->returnValue();
+        }
+
+        bool MockSpyActualCall::returnBoolValueOrDefault(bool default_value)
+        {
+            return call_->returnBoolValueOrDefault(default_value);
+        }
+
+        bool MockSpyActualCall::returnBoolValue()
+        {
+            return call_->returnBoolValue();
+        }
+
+        int MockSpyActualCall::returnIntValueOrDefault(int default_value)
+        {
+            return call_->returnIntValueOrDefault(default_value);
+        }
+
+        int MockSpyActualCall::returnIntValue()
+        {
+            return call_->returnIntValue();
+        }
+
+        unsigned long int MockSpyActualCall::returnUnsignedLongIntValue()
+        {
+            return call_->returnUnsignedLongIntValue();
+        }
+
+        unsigned long int
+        MockSpyActualCall::returnUnsignedLongIntValueOrDefault(
+            unsigned long int default_value
+        )
+        {
+            return call_->returnUnsignedLongIntValueOrDefault(default_value);
+        }
+
+        long int MockSpyActualCall::returnLongIntValue()
+        {
+            return call_->returnLongIntValue();
+        }
+
+        long int
+        MockSpyActualCall::returnLongIntValueOrDefault(long int default_value)
+        {
+            return call_->returnLongIntValueOrDefault(default_value);
+        }
+
+        unsigned long long MockSpyActualCall::returnUnsignedLongLongIntValue()
+        {
+            return call_->returnUnsignedLongLongIntValue();
+        }
+
+        unsigned long long
+        MockSpyActualCall::returnUnsignedLongLongIntValueOrDefault(
+            unsigned long long default_value
+        )
+        {
+            return call_->returnUnsignedLongLongIntValueOrDefault(
+                default_value
+            );
+        }
+
+        long long MockSpyActualCall::returnLongLongIntValue()
+        {
+            return call_->returnLongLongIntValue();
+        }
+
+        long long MockSpyActualCall::returnLongLongIntValueOrDefault(
+            long long default_value
+        )
+        {
+            return call_->returnLongLongIntValueOrDefault(default_value);
+        }
+
+        unsigned int MockSpyActualCall::returnUnsignedIntValue()
+        {
+            return call_->returnUnsignedIntValue();
+        }
+
+        unsigned int MockSpyActualCall::returnUnsignedIntValueOrDefault(
+            unsigned int default_value
+        )
+        {
+            return call_->returnUnsignedIntValueOrDefault(default_value);
+        }
+
+        const char*
+        MockSpyActualCall::returnStringValueOrDefault(const char* default_value)
+        {
+            return call_->returnStringValueOrDefault(default_value);
+        }
+
+        const char* MockSpyActualCall::returnStringValue()
+        {
+            return call_->returnStringValue();
+        }
+
+        double MockSpyActualCall::returnDoubleValue()
+        {
+            return call_->returnDoubleValue();
+        }
+
+        double
+        MockSpyActualCall::returnDoubleValueOrDefault(double default_value)
+        {
+            return call_->returnDoubleValueOrDefault(default_value);
+        }
+
+        void* MockSpyActualCall::returnPointerValue()
+        {
+            return call_->returnPointerValue();
+        }
+
+        void*
+        MockSpyActualCall::returnPointerValueOrDefault(void* default_value)
+        {
+            return call_->returnPointerValueOrDefault(default_value);
+        }
+
+        const void* MockSpyActualCall::returnConstPointerValue()
+        {
+            return call_->returnConstPointerValue();
+        }
+
+        const void* MockSpyActualCall::returnConstPointerValueOrDefault(
+            const void* default_value
+        )
+        {
+            return call_->returnConstPointerValueOrDefault(default_value);
+        }
+
+        MockSpyActualCall::FunctionPointerReturnValue
+        MockSpyActualCall::returnFunctionPointerValue()
+        {
+            return call_->returnFunctionPointerValue();
+        }
+
+        MockSpyActualCall::FunctionPointerReturnValue
+        MockSpyActualCall::returnFunctionPointerValueOrDefault(
+            void (*default_value)()
+        )
+        {
+            return call_->returnFunctionPointerValueOrDefault(default_value);
+        }
+    }
+}
@@ -0,0 +1,646 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTestExt/MockCallRecording.hpp"
+#include "CppUTest/PlatformSpecificFunctions.h"
+#include "CppUTestExt/MockCheckedExpectedCall.hpp"
+
+#include <string.h>
+
+namespace cpputest
+{
+    namespace extensions
+    {
+        static const size_t recordingBufferSize = 64 * 1024;
+        static const size_t recordingMagicSize = 8;
+        static const unsigned char recordingVersion = 1;
+        static const unsigned char recordingMagic[recordingMagicSize] = {
+            'M', 'o', 'c', 'k', 'R', 'e', 'c', recordingVersion
+        };
+
+        enum MockCallRecordKind
+        {
+            record_name = 1,
+            record_call = 2,
+            record_input = 3,
+            record_output = 4,
+            record_return = 5
+        };
+
+        struct MockCallRecorderImpl
+        {
+            MockCallRecorderImpl(const SimpleString& fileName) :
+                fileName_(fileName),
+                file_(nullptr),
+                opened_(false),
+                size_(0)
+            {
+            }
+
+            SimpleString fileName_;
+            PlatformSpecificFile file_;
+            bool opened_;
+            unsigned char buffer_[recordingBufferSize];
+            size_t size_;
+            MockNameIndex names_;
+        };
+
+        MockCallRecorder::MockCallRecorder(const SimpleString& fileName) :
+            impl_(new MockCallRecorderImpl(fileName))
+        {
+            writeBytes(recordingMagic, recordingMagicSize);
+        }
+
+        MockCallRecorder::~MockCallRecorder()
+        {
+            flush();
+            if (impl_->file_ != nullptr)
+                closeFile();
+            delete impl_;
+        }
+
+        void MockCallRecorder::writeBytes(const void* data, size_t size)
+        {
+            const unsigned char* bytes =
+                static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; i++) {
+                if (impl_->size_ == recordingBufferSize)
+                    flush();
+                impl_->buffer_[impl_->size_++] = bytes[i];
+            }
+        }
+
+        void MockCallRecorder::writeByte(unsigned char byte)
+        {
+            writeBytes(&byte, 1);
+        }
+
+        void MockCallRecorder::writeNumber(unsigned long long number)
+        {
+            while (number >= 0x80) {
+                writeByte(static_cast<unsigned char>((number & 0x7f) | 0x80));
+                number >>= 7;
+            }
+            writeByte(static_cast<unsigned char>(number));
+        }
+
+        // Writes a name record the first time a name is seen.
+        void MockCallRecorder::writeName(
+            unsigned char kind, const SimpleString& name
+        )
+        {
+            size_t known = impl_->names_.size();
+            MockNameIndexEntry& index = impl_->names_.get(name);
+            if (impl_->names_.size() != known) {
+                index.setNumber(known);
+                writeByte(record_name);
+                writeNumber(name.size());
+                writeBytes(name.asCharString(), name.size());
+            }
+            writeByte(kind);
+            writeNumber(index.getNumber());
+        }
+
+        // Signed numbers are zigzag encoded so small negative numbers stay
+        // short.
+        static unsigned long long zigzag(long long number)
+        {
+            unsigned long long bits = static_cast<unsigned long long>(number);
+            return (number < 0) ? ~(bits << 1) : (bits << 1);
+        }
+
+        static long long unzigzag(unsigned long long number)
+        {
+            unsigned long long bits =
+                (number & 1) ? ~(number >> 1) : (number >> 1);
+            return static_cast<long long>(bits);
+        }
+
+        void MockCallRecorder::writeValue(const MockNamedValue& value)
+        {
+            MockNamedValue::ValueType type = value.getValueType();
+            writeByte(static_cast<unsigned char>(type));
+
+            if (type == MockNamedValue::VALUE_BOOL)
+                writeByte(value.getBoolValue() ? 1 : 0);
+            else if (type == MockNamedValue::VALUE_INT)
+                writeNumber(zigzag(value.getIntValue()));
+            else if (type == MockNamedValue::VALUE_LONG_INT)
+                writeNumber(zigzag(value.getLongIntValue()));
+            else if (type == MockNamedValue::VALUE_LONG_LONG_INT)
+                writeNumber(zigzag(value.getLongLongIntValue()));
+            else if (type == MockNamedValue::VALUE_UNSIGNED_INT)
+                writeNumber(value.getUnsignedIntValue());
+            else if (type == MockNamedValue::VALUE_UNSIGNED_LONG_INT)
+                writeNumber(value.getUnsignedLongIntValue());
+            else if (type == MockNamedValue::VALUE_UNSIGNED_LONG_LONG_INT)
+                writeNumber(value.getUnsignedLongLongIntValue());
+            else if (type == MockNamedValue::VALUE_DOUBLE) {
+                double number = value.getDoubleValue();
+                writeBytes(&number, sizeof(number));
+            } else if (type == MockNamedValue::VALUE_STRING) {
+                // The length is one more than the string, zero means NULL.
+                const char* text = value.getStringValue();
+                size_t length = text ? strlen(text) : 0;
+                writeNumber(text ? length + 1 : 0);
+                writeBytes(text, length);
+            } else if (type == MockNamedValue::VALUE_MEMORY_BUFFER) {
+                writeNumber(value.getSize());
+                writeBytes(value.getMemoryBuffer(), value.getSize());
+            } else if (type == MockNamedValue::VALUE_OBJECT) {
+                SimpleString typeName = value.getType();
+                writeNumber(typeName.size());
+                writeBytes(typeName.asCharString(), typeName.size());
+            }
+        }
+
+        void MockCallRecorder::callStarted(const SimpleString& functionName)
+        {
+            writeName(record_call, functionName);
+        }
+
+        void MockCallRecorder::inputParameter(const MockNamedValue& parameter)
+        {
+            writeName(record_input, parameter.getName());
+            writeValue(parameter);
+        }
+
+        void MockCallRecorder::outputParameter(
+            const SimpleString& name, const void* data, size_t size
+        )
+        {
+            writeName(record_output, name);
+            writeNumber(size);
+            writeBytes(data, size);
+        }
+
+        void MockCallRecorder::returnValue(const MockNamedValue& value)
+        {
+            writeByte(record_return);
+            writeValue(value);
+        }
+
+        void MockCallRecorder::flush()
+        {
+            if (impl_->size_ == 0)
+                return;
+            writeToFile(impl_->buffer_, impl_->size_);
+            impl_->size_ = 0;
+        }
+
+        void MockCallRecorder::openFile()
+        {
+            impl_->file_ =
+                PlatformSpecificFOpen(impl_->fileName_.asCharString(), "wb");
+        }
+
+        void MockCallRecorder::writeToFile(const void* data, size_t size)
+        {
+            if (!impl_->opened_) {
+                impl_->opened_ = true;
+                openFile();
+            }
+            if (impl_->file_ == nullptr)
+                return;
+            PlatformSpecificFWrite(data, size, impl_->file_);
+            PlatformSpecificFFlush(impl_->file_);
+        }
+
+        void MockCallRecorder::closeFile()
+        {
+            PlatformSpecificFClose(impl_->file_);
+            impl_->file_ = nullptr;
+        }
+
+        // Copies of the strings, buffers and output parameters an
+        // expectation points to.
+        struct MockCallReplayCopy
+        {
+            unsigned char* data_;
+            MockCallReplayCopy* next_;
+        };
+
+        struct MockCallReplayImpl
+        {
+            MockCallReplayImpl(const SimpleString& fileName) :
+                fileName_(fileName),
+                file_(nullptr),
+                opened_(false),
+                broken_(false),
+                data_(new unsigned char[recordingBufferSize]),
+                capacity_(recordingBufferSize),
+                start_(0),
+                end_(0),
+                names_(nullptr),
+                nameCount_(0),
+                nameCapacity_(0),
+                copies_(nullptr),
+                previousCopies_(nullptr)
+            {
+            }
+
+            ~MockCallReplayImpl()
+            {
+                delete[] data_;
+                delete[] names_;
+                deleteCopies(copies_);
+                deleteCopies(previousCopies_);
+            }
+
+            const unsigned char* copy(const unsigned char* data, size_t size)
+            {
+                MockCallReplayCopy* copy = new MockCallReplayCopy;
+                copy->data_ = new unsigned char[size + 1];
+                for (size_t i = 0; i < size; i++)
+                    copy->data_[i] = data[i];
+                copy->data_[size] = '\0';
+                copy->next_ = copies_;
+                copies_ = copy;
+                return copy->data_;
+            }
+
+            // The previous call may still be listed in a failure, so its
+            // copies live until the call after it is loaded.
+            void nextCallLoaded()
+            {
+                deleteCopies(previousCopies_);
+                previousCopies_ = copies_;
+                copies_ = nullptr;
+            }
+
+            void addName(const SimpleString& name)
+            {
+                if (nameCount_ == nameCapacity_) {
+                    nameCapacity_ = nameCapacity_ ? 2 * nameCapacity_ : 16;
+                    SimpleString* names = new SimpleString[nameCapacity_];
+                    for (size_t i = 0; i < nameCount_; i++)
+                        names[i] = names_[i];
+                    delete[] names_;
+                    names_ = names;
+                }
+                names_[nameCount_++] = name;
+            }
+
+            static void deleteCopies(MockCallReplayCopy* copy)
+            {
+                while (copy) {
+                    MockCallReplayCopy* next = copy->next_;
+                    delete[] copy->data_;
+                    delete copy;
+                    copy = next;
+                }
+            }
+
+            SimpleString fileName_;
+            PlatformSpecificFile file_;
+            bool opened_;
+            bool broken_;
+            unsigned char* data_;
+            size_t capacity_;
+            size_t start_;
+            size_t end_;
+            SimpleString* names_;
+            size_t nameCount_;
+            size_t nameCapacity_;
+            MockCallReplayCopy* copies_;
+            MockCallReplayCopy* previousCopies_;
+
+        private:
+            MockCallReplayImpl(const MockCallReplayImpl&);
+            MockCallReplayImpl& operator=(const MockCallReplayImpl&);
+        };
+
+        MockCallReplay::MockCallReplay(const SimpleString& fileName) :
+            impl_(new MockCallReplayImpl(fileName))
+        {
+        }
+
+        MockCallReplay::~MockCallReplay()
+        {
+            if (impl_->file_ != nullptr)
+                closeFile();
+            delete impl_;
+        }
+
+        // Makes sure the next size bytes are in the read buffer.
+        bool MockCallReplay::fill(size_t size)
+        {
+            if (impl_->end_ - impl_->start_ >= size)
+                return true;
+
+            size_t available = impl_->end_ - impl_->start_;
+            unsigned char* data = impl_->data_;
+            if (size > impl_->capacity_) {
+                data = new unsigned char[size];
+                impl_->capacity_ = size;
+            }
+            for (size_t i = 0; i < available; i++)
+                data[i] = impl_->data_[impl_->start_ + i];
+            if (data != impl_->data_) {
+                delete[] impl_->data_;
+                impl_->data_ = data;
+            }
+            impl_->start_ = 0;
+            impl_->end_ = available;
+
+            while (impl_->end_ < size) {
+                size_t read = readFromFile(
+                    impl_->data_ + impl_->end_, impl_->capacity_ - impl_->end_
+                );
+                if (read == 0)
+                    return false;
+                impl_->end_ += read;
+            }
+            return true;
+        }
+
+        bool MockCallReplay::peekByte(unsigned char& byte)
+        {
+            if (!fill(1))
+                return false;
+            byte = impl_->data_[impl_->start_];
+            return true;
+        }
+
+        bool MockCallReplay::readByte(unsigned char& byte)
+        {
+            if (!peekByte(byte))
+                return false;
+            impl_->start_++;
+            return true;
+        }
+
+        bool MockCallReplay::readNumber(unsigned long long& number)
+        {
+            number = 0;
+            unsigned char byte = 0x80;
+            for (unsigned shift = 0; byte & 0x80; shift += 7) {
+                if (shift >= 8 * sizeof(number) || !readByte(byte))
+                    return false;
+                number |= static_cast<unsigned long long>(byte & 0x7f) << shift;
+            }
+            return true;
+        }
+
+        bool
+        MockCallReplay::readBytes(const unsigned char*& data, size_t& size)
+        {
+            unsigned long long length;
+            if (!readNumber(length) || length > static_cast<size_t>(-1) - 1)
+                return false;
+            size = static_cast<size_t>(length);
+            if (!fill(size))
+                return false;
+            data = impl_->copy(impl_->data_ + impl_->start_, size);
+            impl_->start_ += size;
+            return true;
+        }
+
+        bool MockCallReplay::readName(SimpleString& name)
+        {
+            unsigned long long index;
+            if (!readNumber(index) || index >= impl_->nameCount_)
+                return false;
+            name = impl_->names_[index];
+            return true;
+        }
+
+        bool MockCallReplay::readValue(
+            const SimpleString& name, MockNamedValue& value
+        )
+        {
+            unsigned char type;
+            unsigned long long number = 0;
+            const unsigned char* data = nullptr;
+            size_t size = 0;
+            value = MockNamedValue(name);
+            if (!readByte(type))
+                return false;
+
+            if (type == MockNamedValue::VALUE_BOOL) {
+                unsigned char flag;
+                if (!readByte(flag))
+                    return false;
+                value.setValue(flag != 0);
+            } else if (type == MockNamedValue::VALUE_INT ||
+                       type == MockNamedValue::VALUE_LONG_INT ||
+                       type == MockNamedValue::VALUE_LONG_LONG_INT) {
+                if (!readNumber(number))
+                    return false;
+                long long signedNumber = unzigzag(number);
+                if (type == MockNamedValue::VALUE_INT)
+                    value.setValue(static_cast<int>(signedNumber));
+                else if (type == MockNamedValue::VALUE_LONG_INT)
+                    value.setValue(static_cast<long int>(signedNumber));
+                else
+                    value.setValue(signedNumber);
+            } else if (type == MockNamedValue::VALUE_UNSIGNED_INT ||
+                       type == MockNamedValue::VALUE_UNSIGNED_LONG_INT ||
+                       type == MockNamedValue::VALUE_UNSIGNED_LONG_LONG_INT) {
+                if (!readNumber(number))
+                    return false;
+                if (type == MockNamedValue::VALUE_UNSIGNED_INT)
+                    value.setValue(static_cast<unsigned int>(number));
+                else if (type == MockNamedValue::VALUE_UNSIGNED_LONG_INT)
+                    value.setValue(static_cast<unsigned long int>(number));
+                else
+                    value.setValue(number);
+            } else if (type == MockNamedValue::VALUE_DOUBLE) {
+                double doubleValue;
+                if (!fill(sizeof(doubleValue)))
+                    return false;
+                memcpy(
+                    &doubleValue, impl_->data_ + impl_->start_,
+                    sizeof(doubleValue)
+                );
+                impl_->start_ += sizeof(doubleValue);
+                value.setValue(doubleValue);
+            } else if (type == MockNamedValue::VALUE_STRING) {
+                if (!readNumber(number) || number > static_cast<size_t>(-1))
+                    return false;
+                size = (number > 0) ? static_cast<size_t>(number) - 1 : 0;
+                if (!fill(size))
+                    return false;
+                if (number > 0)
+                    data = impl_->copy(impl_->data_ + impl_->start_, size);
+                impl_->start_ += size;
+                value.setValue(reinterpret_cast<const char*>(data));
+            } else if (type == MockNamedValue::VALUE_MEMORY_BUFFER) {
+                if (!readBytes(data, size))
+                    return false;
+                value.setMemoryBuffer(data, size);
+            } else if (type == MockNamedValue::VALUE_OBJECT) {
+                if (!readBytes(data, size))
+                    return false;
+                value.setConstObjectPointer(
+                    reinterpret_cast<const char*>(data), nullptr
+                );
+            } else if (type == MockNamedValue::VALUE_POINTER ||
+                       type == MockNamedValue::VALUE_CONST_POINTER ||
+                       type == MockNamedValue::VALUE_FUNCTION_POINTER)
+                value.setValue(static_cast<void*>(nullptr));
+            else
+                return false;
+            return true;
+        }
+
+        static bool isComparedOnReplay(const MockNamedValue& value)
+        {
+            MockNamedValue::ValueType type = value.getValueType();
+            return type != MockNamedValue::VALUE_POINTER &&
+                   type != MockNamedValue::VALUE_CONST_POINTER &&
+                   type != MockNamedValue::VALUE_FUNCTION_POINTER &&
+                   type != MockNamedValue::VALUE_OBJECT;
+        }
+
+        static void addInputParameter(
+            MockCheckedExpectedCall& call, const MockNamedValue& p
+        )
+        {
+            MockNamedValue::ValueType type = p.getValueType();
+            const SimpleString name = p.getName();
+
+            if (!isComparedOnReplay(p))
+                call.ignoreOtherParameters();
+            else if (type == MockNamedValue::VALUE_BOOL)
+                call.withBoolParameter(name, p.getBoolValue());
+            else if (type == MockNamedValue::VALUE_INT)
+                call.withIntParameter(name, p.getIntValue());
+            else if (type == MockNamedValue::VALUE_LONG_INT)
+                call.withLongIntParameter(name, p.getLongIntValue());
+            else if (type == MockNamedValue::VALUE_LONG_LONG_INT)
+                call.withLongLongIntParameter(name, p.getLongLongIntValue());
+            else if (type == MockNamedValue::VALUE_UNSIGNED_INT)
+                call.withUnsignedIntParameter(name, p.getUnsignedIntValue());
+            else if (type == MockNamedValue::VALUE_UNSIGNED_LONG_INT)
+                call.withUnsignedLongIntParameter(
+                    name, p.getUnsignedLongIntValue()
+                );
+            else if (type == MockNamedValue::VALUE_UNSIGNED_LONG_LONG_INT)
+                call.withUnsignedLongLongIntParameter(
+                    name, p.getUnsignedLongLongIntValue()
+                );
+            else if (type == MockNamedValue::VALUE_DOUBLE)
+                call.withDoubleParameter(name, p.getDoubleValue());
+            else if (type == MockNamedValue::VALUE_STRING)
+                call.withStringParameter(name, p.getStringValue());
+            else
+                call.withMemoryBufferParameter(
+                    name, p.getMemoryBuffer(), p.getSize()
+                );
+        }
+
+        static void
+        addReturnValue(MockCheckedExpectedCall& call, const MockNamedValue& v)
+        {
+            MockNamedValue::ValueType type = v.getValueType();
+
+            if (type == MockNamedValue::VALUE_BOOL)
+                call.andReturnValue(v.getBoolValue());
+            else if (type == MockNamedValue::VALUE_INT)
+                call.andReturnValue(v.getIntValue());
+            else if (type == MockNamedValue::VALUE_LONG_INT)
+                call.andReturnValue(v.getLongIntValue());
+            else if (type == MockNamedValue::VALUE_LONG_LONG_INT)
+                call.andReturnValue(v.getLongLongIntValue());
+            else if (type == MockNamedValue::VALUE_UNSIGNED_INT)
+                call.andReturnValue(v.getUnsignedIntValue());
+            else if (type == MockNamedValue::VALUE_UNSIGNED_LONG_INT)
+                call.andReturnValue(v.getUnsignedLongIntValue());
+            else if (type == MockNamedValue::VALUE_UNSIGNED_LONG_LONG_INT)
+                call.andReturnValue(v.getUnsignedLongLongIntValue());
+            else if (type == MockNamedValue::VALUE_DOUBLE)
+                call.andReturnValue(v.getDoubleValue());
+            else if (type == MockNamedValue::VALUE_STRING)
+                call.andReturnValue(v.getStringValue());
+        }
+
+        bool MockCallReplay::nextCall(MockCheckedExpectedCall& call)
+        {
+            impl_->nextCallLoaded();
+            if (!impl_->opened_) {
+                impl_->opened_ = true;
+                openFile();
+                impl_->broken_ = !fill(recordingMagicSize) ||
+                                 memcmp(
+                                     impl_->data_, recordingMagic,
+                                     recordingMagicSize
+                                 ) != 0;
+                impl_->start_ += recordingMagicSize;
+            }
+
+            bool inCall = false;
+            unsigned char kind;
+            while (!impl_->broken_ && peekByte(kind)) {
+                if (kind == record_call && inCall)
+                    return true;
+                impl_->start_++;
+
+                SimpleString name;
+                MockNamedValue value("");
+                const unsigned char* data;
+                size_t size;
+                if (kind == record_name && readBytes(data, size))
+                    impl_->addName(reinterpret_cast<const char*>(data));
+                else if (kind == record_call && readName(name)) {
+                    call.withName(name);
+                    inCall = true;
+                } else if (kind == record_input && inCall && readName(name) &&
+                           readValue(name, value))
+                    addInputParameter(call, value);
+                else if (kind == record_output && inCall && readName(name) &&
+                         readBytes(data, size))
+                    call.withOutputParameterReturning(name, data, size);
+                else if (kind == record_return && inCall &&
+                         readValue("", value))
+                    addReturnValue(call, value);
+                else
+                    impl_->broken_ = true;
+            }
+            return inCall && !impl_->broken_;
+        }
+
+        void MockCallReplay::openFile()
+        {
+            impl_->file_ =
+                PlatformSpecificFOpen(impl_->fileName_.asCharString(), "rb");
+        }
+
+        size_t MockCallReplay::readFromFile(void* data, size_t size)
+        {
+            if (impl_->file_ == nullptr)
+                return 0;
+            return PlatformSpecificFRead(data, size, impl_->file_);
+        }
+
+        void MockCallReplay::closeFile()
+        {
+            PlatformSpecificFClose(impl_->file_);
+            impl_->file_ = nullptr;
+        }
+    }
+}
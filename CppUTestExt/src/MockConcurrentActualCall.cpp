@@ -0,0 +1,894 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTestExt/MockConcurrentActualCall.hpp"
+#include "CppUTest/TestHarness.hpp"
+#include "CppUTest/TestMemoryAllocator.hpp"
+#include "CppUTestExt/MockCheckedActualCall.hpp"
+#include "CppUTestExt/MockCheckedExpectedCall.hpp"
+
+namespace cpputest
+{
+    namespace extensions
+    {
+        static const void* currentThreadImplementation()
+        {
+            static CPPUTEST_THREAD_LOCAL char thread;
+            return &thread;
+        }
+
+        const void* (*MockConcurrentCalls::currentThread)() =
+            currentThreadImplementation;
+
+        /*
+         * SimpleStrings are made from several threads in concurrent mode,
+         * and the string allocator, like the SimpleString cache, is not
+         * thread-safe. While any mock is in concurrent mode the allocator
+         * is wrapped in one that takes a lock, so the rest of the time
+         * strings cost what they always did.
+         */
+        class MockConcurrentStringAllocator : public TestMemoryAllocator
+        {
+        public:
+            MockConcurrentStringAllocator(TestMemoryAllocator* original) :
+                TestMemoryAllocator(
+                    original->name(), original->alloc_name(),
+                    original->free_name()
+                ),
+                original_(original),
+                mutex_(PlatformSpecificMutexCreate())
+            {
+            }
+
+            virtual ~MockConcurrentStringAllocator() override
+            {
+                PlatformSpecificMutexDestroy(mutex_);
+            }
+
+            virtual char*
+            alloc_memory(size_t size, const char* file, size_t line) override
+            {
+                Lock lock(mutex_);
+                return original_->alloc_memory(size, file, line);
+            }
+
+            virtual void free_memory(
+                char* memory, size_t size, const char* file, size_t line
+            ) override
+            {
+                Lock lock(mutex_);
+                original_->free_memory(memory, size, file, line);
+            }
+
+            virtual TestMemoryAllocator* actualAllocator() override
+            {
+                return original_->actualAllocator();
+            }
+
+            TestMemoryAllocator* original() const
+            {
+                return original_;
+            }
+
+        private:
+            // The SimpleString cache prints its warnings with strings,
+            // which come back here while the thread holds the lock.
+            class Lock
+            {
+            public:
+                Lock(PlatformSpecificMutex mutex) :
+                    mutex_(holdsLock() ? nullptr : mutex)
+                {
+                    if (mutex_) {
+                        PlatformSpecificMutexLock(mutex_);
+                        holdsLock() = true;
+                    }
+                }
+
+                ~Lock()
+                {
+                    if (mutex_) {
+                        holdsLock() = false;
+                        PlatformSpecificMutexUnlock(mutex_);
+                    }
+                }
+
+            private:
+                static bool& holdsLock()
+                {
+                    static CPPUTEST_THREAD_LOCAL bool holds = false;
+                    return holds;
+                }
+
+                PlatformSpecificMutex mutex_;
+            };
+
+            TestMemoryAllocator* original_;
+            PlatformSpecificMutex mutex_;
+        };
+
+        // Turning concurrent mode on and off is done by the test thread,
+        // and scopes turn it on together with their parent, so a count of
+        // the concurrent mocks decides when the allocator is wrapped.
+        static MockConcurrentStringAllocator* concurrentStringAllocator =
+            nullptr;
+        static size_t concurrentMockCount = 0;
+
+        static void useConcurrentStringAllocator()
+        {
+            if (concurrentMockCount++ > 0)
+                return;
+            concurrentStringAllocator = new MockConcurrentStringAllocator(
+                SimpleString::getStringAllocator()
+            );
+            SimpleString::setStringAllocator(concurrentStringAllocator);
+        }
+
+        static void releaseConcurrentStringAllocator()
+        {
+            if (--concurrentMockCount > 0)
+                return;
+            TestMemoryAllocator* original =
+                concurrentStringAllocator->original();
+            if (original == defaultNewArrayAllocator())
+                original = nullptr;
+            if (SimpleString::getStringAllocator() == concurrentStringAllocator)
+                SimpleString::setStringAllocator(original);
+            delete concurrentStringAllocator;
+            concurrentStringAllocator = nullptr;
+        }
+
+        struct MockConcurrentCallsNode
+        {
+            const void* thread_;
+            MockConcurrentActualCall* call_;
+            MockConcurrentCallsNode* next_;
+        };
+
+        MockConcurrentCalls::MockConcurrentCalls(
+            MockExpectedCallsList& expectations, unsigned int* outOfOrderCalls
+        ) :
+            mutex_(PlatformSpecificMutexCreate()),
+            expectations_(expectations),
+            outOfOrderCalls_(outOfOrderCalls),
+            reporter_(nullptr),
+            owner_(currentThread()),
+            calls_(nullptr),
+            matchingCall_(nullptr),
+            hasFailure_(false)
+        {
+            useConcurrentStringAllocator();
+        }
+
+        MockConcurrentCalls::~MockConcurrentCalls()
+        {
+            while (calls_) {
+                MockConcurrentCallsNode* next = calls_->next_;
+                delete calls_->call_;
+                delete calls_;
+                calls_ = next;
+            }
+            PlatformSpecificMutexDestroy(mutex_);
+            releaseConcurrentStringAllocator();
+        }
+
+        void MockConcurrentCalls::lock()
+        {
+            PlatformSpecificMutexLock(mutex_);
+        }
+
+        void MockConcurrentCalls::unlock()
+        {
+            PlatformSpecificMutexUnlock(mutex_);
+        }
+
+        MockConcurrentActualCall& MockConcurrentCalls::callOfThisThread()
+        {
+            const void* thread = currentThread();
+            for (MockConcurrentCallsNode* p = calls_; p; p = p->next_)
+                if (p->thread_ == thread)
+                    return *p->call_;
+
+            MockConcurrentCallsNode* node = new MockConcurrentCallsNode;
+            node->thread_ = thread;
+            node->call_ = new MockConcurrentActualCall(*this);
+            node->next_ = calls_;
+            calls_ = node;
+            return *node->call_;
+        }
+
+        void MockConcurrentCalls::finishAll()
+        {
+            lock();
+            for (MockConcurrentCallsNode* p = calls_; p; p = p->next_)
+                p->call_->finish();
+            unlock();
+        }
+
+        MockExpectedCallsList& MockConcurrentCalls::expectations()
+        {
+            return expectations_;
+        }
+
+        unsigned int* MockConcurrentCalls::outOfOrderCalls()
+        {
+            return outOfOrderCalls_;
+        }
+
+        MockConcurrentActualCall* MockConcurrentCalls::matchingCall() const
+        {
+            return matchingCall_;
+        }
+
+        void MockConcurrentCalls::setMatchingCall(MockConcurrentActualCall* call
+        )
+        {
+            matchingCall_ = call;
+        }
+
+        void MockConcurrentCalls::forgetMatchingCall()
+        {
+            if (matchingCall_ == nullptr)
+                return;
+            expectations_.resetActualCallMatchingState();
+            matchingCall_ = nullptr;
+        }
+
+        void MockConcurrentCalls::failTest(const MockFailure& failure)
+        {
+            if (hasFailure_)
+                return;
+            hasFailure_ = true;
+            failure_ = failure.getMessage();
+        }
+
+        UtestShell* MockConcurrentCalls::getTestToFail()
+        {
+            return reporter_ ? reporter_->getTestToFail()
+                             : UtestShell::getCurrent();
+        }
+
+        void MockConcurrentCalls::setReporter(MockFailureReporter* reporter)
+        {
+            reporter_ = reporter;
+        }
+
+        bool MockConcurrentCalls::isOwnerThread() const
+        {
+            return currentThread() == owner_;
+        }
+
+        // Must not hold the lock, reporting may leave the test.
+        bool MockConcurrentCalls::reportFailure()
+        {
+            lock();
+            bool hasFailure = hasFailure_;
+            SimpleString message = failure_;
+            hasFailure_ = false;
+            unlock();
+
+            if (hasFailure) {
+                MockConcurrentCallFailure failure(getTestToFail(), message);
+                reporter_->failTest(failure);
+            }
+            return hasFailure;
+        }
+
+        enum MockConcurrentCallStepKind
+        {
+            STEP_INPUT,
+            STEP_INPUT_OF_TYPE,
+            STEP_OUTPUT,
+            STEP_OUTPUT_OF_TYPE,
+            STEP_OBJECT
+        };
+
+        struct MockConcurrentCallStep
+        {
+            MockConcurrentCallStep(
+                MockConcurrentCallStepKind kind,
+                const SimpleString& name,
+                const void* pointer = nullptr,
+                const SimpleString& type = ""
+            ) :
+                kind_(kind),
+                value_(name),
+                type_(type),
+                pointer_(pointer),
+                next_(nullptr)
+            {
+            }
+
+            MockConcurrentCallStepKind kind_;
+            MockNamedValue value_;
+            SimpleString type_;
+            const void* pointer_;
+            MockConcurrentCallStep* next_;
+        };
+
+        // Gives the steps access to the checks the parameters go through.
+        // Output parameters are only copied from the expectation the call
+        // claims when it finishes: until then another thread's call can
+        // still claim the expectation that matches now.
+        class MockReplayedActualCall : public MockCheckedActualCall
+        {
+        public:
+            MockReplayedActualCall(
+                unsigned int callOrder,
+                MockFailureReporter* reporter,
+                const MockExpectedCallsList& expectations,
+                unsigned int* outOfOrderCalls
+            ) :
+                MockCheckedActualCall(
+                    callOrder, reporter, expectations, outOfOrderCalls
+                )
+            {
+            }
+
+            void withInputParameter(const MockNamedValue& parameter)
+            {
+                checkInputParameter(parameter);
+            }
+
+            void copyOutputParametersOfClaimedExpectation()
+            {
+                if (isFulfilled() && getMatchingExpectation())
+                    MockCheckedActualCall::copyOutputParameters(
+                        getMatchingExpectation()
+                    );
+            }
+
+        protected:
+            virtual void copyOutputParameters(MockCheckedExpectedCall*) override
+            {
+            }
+        };
+
+        MockConcurrentActualCall::MockConcurrentActualCall(
+            MockConcurrentCalls& calls
+        ) :
+            calls_(calls),
+            callOrder_(0),
+            steps_(nullptr),
+            lastStep_(nullptr),
+            call_(nullptr),
+            finished_(true),
+            failed_(false),
+            returnValue_("")
+        {
+        }
+
+        MockConcurrentActualCall::~MockConcurrentActualCall()
+        {
+            delete call_;
+            deleteSteps();
+        }
+
+        void MockConcurrentActualCall::deleteSteps()
+        {
+            while (steps_) {
+                MockConcurrentCallStep* next = steps_->next_;
+                delete steps_;
+                steps_ = next;
+            }
+            lastStep_ = nullptr;
+        }
+
+        void MockConcurrentActualCall::start(
+            unsigned int callOrder, const SimpleString& name
+        )
+        {
+            calls_.lock();
+            release();
+            deleteSteps();
+            callOrder_ = callOrder;
+            name_ = name;
+            finished_ = false;
+            failed_ = false;
+            returnValue_ = MockNamedValue("");
+            match(nullptr);
+            calls_.unlock();
+            if (calls_.isOwnerThread())
+                calls_.reportFailure();
+        }
+
+        void MockConcurrentActualCall::finish()
+        {
+            match(nullptr);
+            if (finished_ || failed_)
+                return;
+
+            call_->checkExpectations();
+            call_->copyOutputParametersOfClaimedExpectation();
+            returnValue_ = call_->returnValue();
+            failed_ = call_->hasFailed();
+            finished_ = true;
+            release();
+        }
+
+        void MockConcurrentActualCall::finishAndReport()
+        {
+            calls_.lock();
+            finish();
+            calls_.unlock();
+            if (calls_.isOwnerThread())
+                calls_.reportFailure();
+        }
+
+        static void applyStep(
+            MockReplayedActualCall& call, const MockConcurrentCallStep& step
+        )
+        {
+            if (step.kind_ == STEP_INPUT)
+                call.withInputParameter(step.value_);
+            else if (step.kind_ == STEP_INPUT_OF_TYPE)
+                call.withParameterOfType(
+                    step.type_, step.value_.getName(), step.pointer_
+                );
+            else if (step.kind_ == STEP_OUTPUT)
+                call.withOutputParameter(
+                    step.value_.getName(), const_cast<void*>(step.pointer_)
+                );
+            else if (step.kind_ == STEP_OUTPUT_OF_TYPE)
+                call.withOutputParameterOfType(
+                    step.type_, step.value_.getName(),
+                    const_cast<void*>(step.pointer_)
+                );
+            else
+                call.onObject(step.pointer_);
+        }
+
+        // Needs the lock. Only the new step is matched while the
+        // expectations still carry the state of this call.
+        void MockConcurrentActualCall::match(const MockConcurrentCallStep* step)
+        {
+            if (finished_ || failed_)
+                return;
+
+            if (call_ && calls_.matchingCall() == this) {
+                if (step)
+                    applyStep(*call_, *step);
+            } else {
+                replay();
+            }
+
+            if (call_->hasFailed()) {
+                failed_ = true;
+                release();
+            }
+        }
+
+        void MockConcurrentActualCall::replay()
+        {
+            calls_.forgetMatchingCall();
+            delete call_;
+            call_ = new MockReplayedActualCall(
+                callOrder_, &calls_, calls_.expectations(),
+                calls_.outOfOrderCalls()
+            );
+            calls_.setMatchingCall(this);
+
+            call_->withName(name_);
+            for (MockConcurrentCallStep* p = steps_; p; p = p->next_)
+                applyStep(*call_, *p);
+        }
+
+        // Needs the lock. Leaves the expectations without matching state.
+        void MockConcurrentActualCall::release()
+        {
+            if (calls_.matchingCall() == this)
+                calls_.forgetMatchingCall();
+            delete call_;
+            call_ = nullptr;
+        }
+
+        MockActualCall&
+        MockConcurrentActualCall::addStep(MockConcurrentCallStep* step)
+        {
+            calls_.lock();
+            if (lastStep_)
+                lastStep_->next_ = step;
+            else
+                steps_ = step;
+            lastStep_ = step;
+            match(step);
+            calls_.unlock();
+            if (calls_.isOwnerThread())
+                calls_.reportFailure();
+            return *this;
+        }
+
+        MockActualCall&
+        MockConcurrentActualCall::addInputParameter(const MockNamedValue& value)
+        {
+            MockConcurrentCallStep* step =
+                new MockConcurrentCallStep(STEP_INPUT, value.getName());
+            step->value_ = value;
+            return addStep(step);
+        }
+
+        MockActualCall&
+        MockConcurrentActualCall::withName(const SimpleString& name)
+        {
+            start(callOrder_, name);
+            return *this;
+        }
+
+        MockActualCall& MockConcurrentActualCall::withCallOrder(unsigned int)
+        {
+            return *this;
+        }
+
+        MockActualCall& MockConcurrentActualCall::withBoolParameter(
+            const SimpleString& name, bool value
+        )
+        {
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return addInputParameter(parameter);
+        }
+
+        MockActualCall& MockConcurrentActualCall::withIntParameter(
+            const SimpleString& name, int value
+        )
+        {
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return addInputParameter(parameter);
+        }
+
+        MockActualCall& MockConcurrentActualCall::withUnsignedIntParameter(
+            const SimpleString& name, unsigned int value
+        )
+        {
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return addInputParameter(parameter);
+        }
+
+        MockActualCall& MockConcurrentActualCall::withLongIntParameter(
+            const SimpleString& name, long int value
+        )
+        {
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return addInputParameter(parameter);
+        }
+
+        MockActualCall& MockConcurrentActualCall::withUnsignedLongIntParameter(
+            const SimpleString& name, unsigned long int value
+        )
+        {
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return addInputParameter(parameter);
+        }
+
+        MockActualCall& MockConcurrentActualCall::withLongLongIntParameter(
+            const SimpleString& name, long long value
+        )
+        {
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return addInputParameter(parameter);
+        }
+
+        MockActualCall&
+        MockConcurrentActualCall::withUnsignedLongLongIntParameter(
+            const SimpleString& name, unsigned long long value
+        )
+        {
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return addInputParameter(parameter);
+        }
+
+        MockActualCall& MockConcurrentActualCall::withDoubleParameter(
+            const SimpleString& name, double value
+        )
+        {
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return addInputParameter(parameter);
+        }
+
+        MockActualCall& MockConcurrentActualCall::withStringParameter(
+            const SimpleString& name, const char* value
+        )
+        {
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return addInputParameter(parameter);
+        }
+
+        MockActualCall& MockConcurrentActualCall::withPointerParameter(
+            const SimpleString& name, void* value
+        )
+        {
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return addInputParameter(parameter);
+        }
+
+        MockActualCall& MockConcurrentActualCall::withConstPointerParameter(
+            const SimpleString& name, const void* value
+        )
+        {
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return addInputParameter(parameter);
+        }
+
+        MockActualCall& MockConcurrentActualCall::withFunctionPointerParameter(
+            const SimpleString& name, void (*value)()
+        )
+        {
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return addInputParameter(parameter);
+        }
+
+        MockActualCall& MockConcurrentActualCall::withMemoryBufferParameter(
+            const SimpleString& name, const unsigned char* value, size_t size
+        )
+        {
+            MockNamedValue parameter(name);
+            parameter.setMemoryBuffer(value, size);
+            return addInputParameter(parameter);
+        }
+
+        MockActualCall& MockConcurrentActualCall::withParameterOfType(
+            const SimpleString& type,
+            const SimpleString& name,
+            const void* value
+        )
+        {
+            return addStep(new MockConcurrentCallStep(
+                STEP_INPUT_OF_TYPE, name, value, type
+            ));
+        }
+
+        MockActualCall& MockConcurrentActualCall::withOutputParameter(
+            const SimpleString& name, void* output
+        )
+        {
+            return addStep(
+                new MockConcurrentCallStep(STEP_OUTPUT, name, output)
+            );
+        }
+
+        MockActualCall& MockConcurrentActualCall::withOutputParameterOfType(
+            const SimpleString& type, const SimpleString& name, void* output
+        )
+        {
+            return addStep(new MockConcurrentCallStep(
+                STEP_OUTPUT_OF_TYPE, name, output, type
+            ));
+        }
+
+        MockActualCall&
+        MockConcurrentActualCall::onObject(const void* objectPtr)
+        {
+            return addStep(
+                new MockConcurrentCallStep(STEP_OBJECT, "", objectPtr)
+            );
+        }
+
+        bool MockConcurrentActualCall::hasReturnValue()
+        {
+            return !returnValue().getName().isEmpty();
+        }
+
+        MockNamedValue MockConcurrentActualCall::returnValue()
+        {
+            finishAndReport();
+            return returnValue_;
+        }
+
+        bool
+        MockConcurrentActualCall::returnBoolValueOrDefault(bool default_value)
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnBoolValue();
+        }
+
+        bool MockConcurrentActualCall::returnBoolValue()
+        {
+            return returnValue().getBoolValue();
+        }
+
+        int MockConcurrentActualCall::returnIntValueOrDefault(int default_value)
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnIntValue();
+        }
+
+        int MockConcurrentActualCall::returnIntValue()
+        {
+            return returnValue().getIntValue();
+        }
+
+        unsigned long int MockConcurrentActualCall::returnUnsignedLongIntValue()
+        {
+            return returnValue().getUnsignedLongIntValue();
+        }
+
+        unsigned long int
+        MockConcurrentActualCall::returnUnsignedLongIntValueOrDefault(
+            unsigned long int default_value
+        )
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnUnsignedLongIntValue();
+        }
+
+        long int MockConcurrentActualCall::returnLongIntValue()
+        {
+            return returnValue().getLongIntValue();
+        }
+
+        long int MockConcurrentActualCall::returnLongIntValueOrDefault(
+            long int default_value
+        )
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnLongIntValue();
+        }
+
+        unsigned long long
+        MockConcurrentActualCall::returnUnsignedLongLongIntValue()
+        {
+            return returnValue().getUnsignedLongLongIntValue();
+        }
+
+        unsigned long long
+        MockConcurrentActualCall::returnUnsignedLongLongIntValueOrDefault(
+            unsigned long long default_value
+        )
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnUnsignedLongLongIntValue();
+        }
+
+        long long MockConcurrentActualCall::returnLongLongIntValue()
+        {
+            return returnValue().getLongLongIntValue();
+        }
+
+        long long MockConcurrentActualCall::returnLongLongIntValueOrDefault(
+            long long default_value
+        )
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnLongLongIntValue();
+        }
+
+        unsigned int MockConcurrentActualCall::returnUnsignedIntValue()
+        {
+            return returnValue().getUnsignedIntValue();
+        }
+
+        unsigned int MockConcurrentActualCall::returnUnsignedIntValueOrDefault(
+            unsigned int default_value
+        )
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnUnsignedIntValue();
+        }
+
+        const char* MockConcurrentActualCall::returnStringValueOrDefault(
+            const char* default_value
+        )
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnStringValue();
+        }
+
+        const char* MockConcurrentActualCall::returnStringValue()
+        {
+            return returnValue().getStringValue();
+        }
+
+        double MockConcurrentActualCall::returnDoubleValue()
+        {
+            return returnValue().getDoubleValue();
+        }
+
+        double MockConcurrentActualCall::returnDoubleValueOrDefault(
+            double default_value
+        )
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnDoubleValue();
+        }
+
+        const void* MockConcurrentActualCall::returnConstPointerValue()
+        {
+            return returnValue().getConstPointerValue();
+        }
+
+        const void* MockConcurrentActualCall::returnConstPointerValueOrDefault(
+            const void* default_value
+        )
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnConstPointerValue();
+        }
+
+        void* MockConcurrentActualCall::returnPointerValue()
+        {
+            return returnValue().getPointerValue();
+        }
+
+        void* MockConcurrentActualCall::returnPointerValueOrDefault(
+            void* default_value
+        )
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnPointerValue();
+        }
+
+        MockConcurrentActualCall::FunctionPointerReturnValue
+        MockConcurrentActualCall::returnFunctionPointerValue()
+        {
+            return returnValue().getFunctionPointerValue();
+        }
+
+        MockConcurrentActualCall::FunctionPointerReturnValue
+        MockConcurrentActualCall::returnFunctionPointerValueOrDefault(
+            void (*default_value)()
+        )
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnFunctionPointerValue();
+        }
+    }
+}
@@ -51,15 +51,19 @@ namespace cpputest
             initialExpectedCallOrder_(NO_EXPECTED_CALL_ORDER),
             finalExpectedCallOrder_(NO_EXPECTED_CALL_ORDER),
             outOfOrder_(false),
+            inputParameters_(nullptr),
+            outputParameters_(nullptr),
             returnValue_(""),
+            returnValues_(nullptr),
+            returnValuesType_(MockNamedValue::VALUE_INT),
+            returnValuesCount_(0),
+            cycleValues_(false),
             objectPtr_(nullptr),
             isSpecificObjectExpected_(false),
             wasPassedToObject_(true),
             actualCalls_(0),
             expectedCalls_(1)
         {
-            inputParameters_ = new MockNamedValueList();
-            outputParameters_ = new MockNamedValueList();
         }
 
         MockCheckedExpectedCall::MockCheckedExpectedCall(unsigned int numCalls
@@ -69,25 +73,46 @@ namespace cpputest
             initialExpectedCallOrder_(NO_EXPECTED_CALL_ORDER),
             finalExpectedCallOrder_(NO_EXPECTED_CALL_ORDER),
             outOfOrder_(false),
+            inputParameters_(nullptr),
+            outputParameters_(nullptr),
             returnValue_(""),
+            returnValues_(nullptr),
+            returnValuesType_(MockNamedValue::VALUE_INT),
+            returnValuesCount_(0),
+            cycleValues_(false),
             objectPtr_(nullptr),
             isSpecificObjectExpected_(false),
             wasPassedToObject_(true),
             actualCalls_(0),
             expectedCalls_(numCalls)
         {
-            inputParameters_ = new MockNamedValueList();
-            outputParameters_ = new MockNamedValueList();
         }
 
-        MockCheckedExpectedCall::~MockCheckedExpectedCall()
+        MockCheckedExpectedCall::MockCheckedExpectedCall(
+            unsigned int numCalls, MockArena& arena
+        ) :
+            ignoreOtherParameters_(false),
+            isActualCallMatchFinalized_(false),
+            initialExpectedCallOrder_(NO_EXPECTED_CALL_ORDER),
+            finalExpectedCallOrder_(NO_EXPECTED_CALL_ORDER),
+            outOfOrder_(false),
+            inputParameters_(&arena),
+            outputParameters_(&arena),
+            returnValue_(""),
+            returnValues_(nullptr),
+            returnValuesType_(MockNamedValue::VALUE_INT),
+            returnValuesCount_(0),
+            cycleValues_(false),
+            objectPtr_(nullptr),
+            isSpecificObjectExpected_(false),
+            wasPassedToObject_(true),
+            actualCalls_(0),
+            expectedCalls_(numCalls)
         {
-            inputParameters_->clear();
-            delete inputParameters_;
-            outputParameters_->clear();
-            delete outputParameters_;
         }
 
+        MockCheckedExpectedCall::~MockCheckedExpectedCall() {}
+
         MockExpectedCall&
         MockCheckedExpectedCall::withName(const SimpleString& name)
         {
@@ -99,9 +124,8 @@ namespace cpputest
             const SimpleString& name, bool value
         )
         {
-            MockNamedValue* newParameter =
-                new MockExpectedFunctionParameter(name);
-            inputParameters_->add(newParameter);
+            MockExpectedFunctionParameter* newParameter =
+                inputParameters_.add(name);
             newParameter->setValue(value);
             return *this;
         }
@@ -110,9 +134,8 @@ namespace cpputest
             const SimpleString& name, unsigned int value
         )
         {
-            MockNamedValue* newParameter =
-                new MockExpectedFunctionParameter(name);
-            inputParameters_->add(newParameter);
+            MockExpectedFunctionParameter* newParameter =
+                inputParameters_.add(name);
             newParameter->setValue(value);
             return *this;
         }
@@ -121,9 +144,8 @@ namespace cpputest
             const SimpleString& name, int value
         )
         {
-            MockNamedValue* newParameter =
-                new MockExpectedFunctionParameter(name);
-            inputParameters_->add(newParameter);
+            MockExpectedFunctionParameter* newParameter =
+                inputParameters_.add(name);
             newParameter->setValue(value);
             return *this;
         }
@@ -132,9 +154,8 @@ namespace cpputest
             const SimpleString& name, long int value
         )
         {
-            MockNamedValue* newParameter =
-                new MockExpectedFunctionParameter(name);
-            inputParameters_->add(newParameter);
+            MockExpectedFunctionParameter* newParameter =
+                inputParameters_.add(name);
             newParameter->setValue(value);
             return *this;
         }
@@ -143,9 +164,8 @@ namespace cpputest
             const SimpleString& name, unsigned long int value
         )
         {
-            MockNamedValue* newParameter =
-                new MockExpectedFunctionParameter(name);
-            inputParameters_->add(newParameter);
+            MockExpectedFunctionParameter* newParameter =
+                inputParameters_.add(name);
             newParameter->setValue(value);
             return *this;
         }
@@ -154,9 +174,8 @@ namespace cpputest
             const SimpleString& name, long long value
         )
         {
-            MockNamedValue* newParameter =
-                new MockExpectedFunctionParameter(name);
-            inputParameters_->add(newParameter);
+            MockExpectedFunctionParameter* newParameter =
+                inputParameters_.add(name);
             newParameter->setValue(value);
             return *this;
         }
@@ -166,9 +185,8 @@ namespace cpputest
             const SimpleString& name, unsigned long long value
         )
         {
-            MockNamedValue* newParameter =
-                new MockExpectedFunctionParameter(name);
-            inputParameters_->add(newParameter);
+            MockExpectedFunctionParameter* newParameter =
+                inputParameters_.add(name);
             newParameter->setValue(value);
             return *this;
         }
@@ -177,9 +195,8 @@ namespace cpputest
             const SimpleString& name, double value
         )
         {
-            MockNamedValue* newParameter =
-                new MockExpectedFunctionParameter(name);
-            inputParameters_->add(newParameter);
+            MockExpectedFunctionParameter* newParameter =
+                inputParameters_.add(name);
             newParameter->setValue(value);
             return *this;
         }
@@ -188,9 +205,8 @@ namespace cpputest
             const SimpleString& name, double value, double tolerance
         )
         {
-            MockNamedValue* newParameter =
-                new MockExpectedFunctionParameter(name);
-            inputParameters_->add(newParameter);
+            MockExpectedFunctionParameter* newParameter =
+                inputParameters_.add(name);
             newParameter->setValue(value, tolerance);
             return *this;
         }
@@ -199,9 +215,8 @@ namespace cpputest
             const SimpleString& name, const char* value
         )
         {
-            MockNamedValue* newParameter =
-                new MockExpectedFunctionParameter(name);
-            inputParameters_->add(newParameter);
+            MockExpectedFunctionParameter* newParameter =
+                inputParameters_.add(name);
             newParameter->setValue(value);
             return *this;
         }
@@ -210,9 +225,8 @@ namespace cpputest
             const SimpleString& name, void* value
         )
         {
-            MockNamedValue* newParameter =
-                new MockExpectedFunctionParameter(name);
-            inputParameters_->add(newParameter);
+            MockExpectedFunctionParameter* newParameter =
+                inputParameters_.add(name);
             newParameter->setValue(value);
             return *this;
         }
@@ -221,9 +235,8 @@ namespace cpputest
             const SimpleString& name, const void* value
         )
         {
-            MockNamedValue* newParameter =
-                new MockExpectedFunctionParameter(name);
-            inputParameters_->add(newParameter);
+            MockExpectedFunctionParameter* newParameter =
+                inputParameters_.add(name);
             newParameter->setValue(value);
             return *this;
         }
@@ -232,9 +245,8 @@ namespace cpputest
             const SimpleString& name, void (*value)()
         )
         {
-            MockNamedValue* newParameter =
-                new MockExpectedFunctionParameter(name);
-            inputParameters_->add(newParameter);
+            MockExpectedFunctionParameter* newParameter =
+                inputParameters_.add(name);
             newParameter->setValue(value);
             return *this;
         }
@@ -243,9 +255,8 @@ namespace cpputest
             const SimpleString& name, const unsigned char* value, size_t size
         )
         {
-            MockNamedValue* newParameter =
-                new MockExpectedFunctionParameter(name);
-            inputParameters_->add(newParameter);
+            MockExpectedFunctionParameter* newParameter =
+                inputParameters_.add(name);
             newParameter->setMemoryBuffer(value, size);
             return *this;
         }
@@ -256,9 +267,8 @@ namespace cpputest
             const void* value
         )
         {
-            MockNamedValue* newParameter =
-                new MockExpectedFunctionParameter(name);
-            inputParameters_->add(newParameter);
+            MockExpectedFunctionParameter* newParameter =
+                inputParameters_.add(name);
             newParameter->setConstObjectPointer(type, value);
             return *this;
         }
@@ -267,9 +277,8 @@ namespace cpputest
             const SimpleString& name, const void* value, size_t size
         )
         {
-            MockNamedValue* newParameter =
-                new MockExpectedFunctionParameter(name);
-            outputParameters_->add(newParameter);
+            MockExpectedFunctionParameter* newParameter =
+                outputParameters_.add(name);
             newParameter->setValue(value);
             newParameter->setSize(size);
             return *this;
@@ -282,9 +291,8 @@ namespace cpputest
             const void* value
         )
         {
-            MockNamedValue* newParameter =
-                new MockExpectedFunctionParameter(name);
-            outputParameters_->add(newParameter);
+            MockExpectedFunctionParameter* newParameter =
+                outputParameters_.add(name);
             newParameter->setConstObjectPointer(type, value);
             return *this;
         }
@@ -300,15 +308,27 @@ namespace cpputest
         SimpleString
         MockCheckedExpectedCall::getInputParameterType(const SimpleString& name)
         {
-            MockNamedValue* p = inputParameters_->getValueByName(name);
+            MockNamedValue* p = inputParameters_.find(name);
             return (p) ? p->getType() : StringFrom("");
         }
 
+        MockNamedValueComparator*
+        MockCheckedExpectedCall::getInputParameterComparator(
+            const SimpleString& type, const SimpleString& name
+        )
+        {
+            MockNamedValue* p = inputParameters_.find(name);
+            if (p && p->getValueType() == MockNamedValue::VALUE_OBJECT &&
+                p->getType() == type)
+                return p->getComparator();
+            return nullptr;
+        }
+
         bool MockCheckedExpectedCall::hasInputParameterWithName(
             const SimpleString& name
         )
         {
-            MockNamedValue* p = inputParameters_->getValueByName(name);
+            MockNamedValue* p = inputParameters_.find(name);
             return p != nullptr;
         }
 
@@ -316,32 +336,46 @@ namespace cpputest
             const SimpleString& name
         )
         {
-            MockNamedValue* p = outputParameters_->getValueByName(name);
+            MockNamedValue* p = outputParameters_.find(name);
             return p != nullptr;
         }
 
         MockNamedValue
         MockCheckedExpectedCall::getInputParameter(const SimpleString& name)
         {
-            MockNamedValue* p = inputParameters_->getValueByName(name);
+            MockNamedValue* p = inputParameters_.find(name);
             return (p) ? *p : MockNamedValue("");
         }
 
+        // Asked for while the call is matched, so a sequence gives the
+        // value of the call that is being made.
         MockNamedValue
         MockCheckedExpectedCall::getOutputParameter(const SimpleString& name)
         {
-            MockNamedValue* p = outputParameters_->getValueByName(name);
-            return (p) ? *p : MockNamedValue("");
+            MockExpectedFunctionParameter* p = outputParameters_.find(name);
+            if (p == nullptr)
+                return MockNamedValue("");
+
+            MockNamedValue value(*p);
+            if (p->getSequenceCount() > 0) {
+                size_t i = sequenceIndex(actualCalls_, p->getSequenceCount());
+                const unsigned char* values =
+                    static_cast<const unsigned char*>(p->getConstPointerValue()
+                    );
+                value.setValue(
+                    static_cast<const void*>(values + i * p->getSize())
+                );
+            }
+            return value;
         }
 
         bool MockCheckedExpectedCall::areParametersMatchingActualCall()
         {
-            MockNamedValueListNode* p;
-            for (p = inputParameters_->begin(); p; p = p->next())
-                if (!item(p)->isMatchingActualCall())
+            for (size_t i = 0; i < inputParameters_.size(); i++)
+                if (!inputParameters_.at(i)->isMatchingActualCall())
                     return false;
-            for (p = outputParameters_->begin(); p; p = p->next())
-                if (!item(p)->isMatchingActualCall())
+            for (size_t i = 0; i < outputParameters_.size(); i++)
+                if (!outputParameters_.at(i)->isMatchingActualCall())
                     return false;
             return true;
         }
@@ -401,41 +435,31 @@ namespace cpputest
             wasPassedToObject_ = !isSpecificObjectExpected_;
             isActualCallMatchFinalized_ = false;
 
-            MockNamedValueListNode* p;
-
-            for (p = inputParameters_->begin(); p; p = p->next())
-                item(p)->setMatchesActualCall(false);
-            for (p = outputParameters_->begin(); p; p = p->next())
-                item(p)->setMatchesActualCall(false);
+            for (size_t i = 0; i < inputParameters_.size(); i++)
+                inputParameters_.at(i)->setMatchesActualCall(false);
+            for (size_t i = 0; i < outputParameters_.size(); i++)
+                outputParameters_.at(i)->setMatchesActualCall(false);
         }
 
         void MockCheckedExpectedCall::inputParameterWasPassed(
             const SimpleString& name
         )
         {
-            for (MockNamedValueListNode* p = inputParameters_->begin(); p;
-                 p = p->next()) {
-                if (p->getName() == name)
-                    item(p)->setMatchesActualCall(true);
-            }
+            inputParameters_.wasPassed(name);
         }
 
         void MockCheckedExpectedCall::outputParameterWasPassed(
             const SimpleString& name
         )
         {
-            for (MockNamedValueListNode* p = outputParameters_->begin(); p;
-                 p = p->next()) {
-                if (p->getName() == name)
-                    item(p)->setMatchesActualCall(true);
-            }
+            outputParameters_.wasPassed(name);
         }
 
         SimpleString MockCheckedExpectedCall::getInputParameterValueString(
             const SimpleString& name
         )
         {
-            MockNamedValue* p = inputParameters_->getValueByName(name);
+            MockNamedValue* p = inputParameters_.find(name);
             return (p) ? StringFrom(*p) : StringFrom("failed");
         }
 
@@ -443,8 +467,9 @@ namespace cpputest
             const MockNamedValue& parameter
         )
         {
-            MockNamedValue* p =
-                inputParameters_->getValueByName(parameter.getName());
+            MockNamedValue* p = inputParameters_.find(
+                parameter.getName(), parameter.getNameHash()
+            );
             return (p) ? p->equals(parameter) : ignoreOtherParameters_;
         }
 
@@ -452,8 +477,9 @@ namespace cpputest
             const MockNamedValue& parameter
         )
         {
-            MockNamedValue* p =
-                outputParameters_->getValueByName(parameter.getName());
+            MockNamedValue* p = outputParameters_.find(
+                parameter.getName(), parameter.getNameHash()
+            );
             return (p) ? p->compatibleForCopying(parameter)
                        : ignoreOtherParameters_;
         }
@@ -480,34 +506,33 @@ namespace cpputest
                 }
             }
 
-            if (inputParameters_->begin() == nullptr &&
-                outputParameters_->begin() == nullptr) {
+            if (inputParameters_.size() == 0 && outputParameters_.size() == 0) {
                 str += (ignoreOtherParameters_) ? "all parameters ignored"
                                                 : "no parameters";
             } else {
-                MockNamedValueListNode* p;
-
-                for (p = inputParameters_->begin(); p; p = p->next()) {
+                for (size_t i = 0; i < inputParameters_.size(); i++) {
+                    MockNamedValue* p = inputParameters_.at(i);
                     str += StringFromFormat(
                         "%s %s: <%s>", p->getType().asCharString(),
                         p->getName().asCharString(),
                         getInputParameterValueString(p->getName())
                             .asCharString()
                     );
-                    if (p->next())
+                    if (i + 1 < inputParameters_.size())
                         str += ", ";
                 }
 
-                if (inputParameters_->begin() && outputParameters_->begin()) {
+                if (inputParameters_.size() && outputParameters_.size()) {
                     str += ", ";
                 }
 
-                for (p = outputParameters_->begin(); p; p = p->next()) {
+                for (size_t i = 0; i < outputParameters_.size(); i++) {
+                    MockNamedValue* p = outputParameters_.at(i);
                     str += StringFromFormat(
                         "%s %s: <output>", p->getType().asCharString(),
                         p->getName().asCharString()
                     );
-                    if (p->next())
+                    if (i + 1 < outputParameters_.size())
                         str += ", ";
                 }
 
@@ -527,10 +552,10 @@ namespace cpputest
         SimpleString MockCheckedExpectedCall::missingParametersToString()
         {
             SimpleString str;
-            MockNamedValueListNode* p;
 
-            for (p = inputParameters_->begin(); p; p = p->next()) {
-                if (!item(p)->isMatchingActualCall()) {
+            for (size_t i = 0; i < inputParameters_.size(); i++) {
+                MockExpectedFunctionParameter* p = inputParameters_.at(i);
+                if (!p->isMatchingActualCall()) {
                     if (str != "")
                         str += ", ";
                     str += StringFromFormat(
@@ -539,8 +564,9 @@ namespace cpputest
                     );
                 }
             }
-            for (p = outputParameters_->begin(); p; p = p->next()) {
-                if (!item(p)->isMatchingActualCall()) {
+            for (size_t i = 0; i < outputParameters_.size(); i++) {
+                MockExpectedFunctionParameter* p = outputParameters_.at(i);
+                if (!p->isMatchingActualCall()) {
                     if (str != "")
                         str += ", ";
                     str += StringFromFormat(
@@ -564,17 +590,110 @@ namespace cpputest
             return (!isSpecificObjectExpected_) || (objectPtr_ == objectPtr);
         }
 
+        MockCheckedExpectedCall::MockExpectedFunctionParameters::
+            MockExpectedFunctionParameters(MockArena* arena) :
+            arena_(arena),
+            parameters_(inlineParameters_),
+            hashes_(inlineHashes_),
+            size_(0),
+            capacity_(INLINE_CAPACITY)
+        {
+        }
+
+        MockCheckedExpectedCall::MockExpectedFunctionParameters::
+            ~MockExpectedFunctionParameters()
+        {
+            for (size_t i = 0; i < size_; i++) {
+                if (arena_)
+                    parameters_[i]->~MockExpectedFunctionParameter();
+                else
+                    delete parameters_[i];
+            }
+            if (parameters_ != inlineParameters_) {
+                delete[] parameters_;
+                delete[] hashes_;
+            }
+        }
+
         MockCheckedExpectedCall::MockExpectedFunctionParameter*
-        MockCheckedExpectedCall::item(MockNamedValueListNode* node)
+        MockCheckedExpectedCall::MockExpectedFunctionParameters::add(
+            const SimpleString& name
+        )
         {
-            return reinterpret_cast<MockExpectedFunctionParameter*>(node->item()
-            );
+            MockExpectedFunctionParameter* parameter =
+                arena_ ? new (*arena_) MockExpectedFunctionParameter(name)
+                       : new MockExpectedFunctionParameter(name);
+            if (size_ == capacity_) {
+                size_t capacity = 2 * capacity_;
+                MockExpectedFunctionParameter** parameters =
+                    new MockExpectedFunctionParameter*[capacity];
+                unsigned long* hashes = new unsigned long[capacity];
+                for (size_t i = 0; i < size_; i++) {
+                    parameters[i] = parameters_[i];
+                    hashes[i] = hashes_[i];
+                }
+                if (parameters_ != inlineParameters_) {
+                    delete[] parameters_;
+                    delete[] hashes_;
+                }
+                parameters_ = parameters;
+                hashes_ = hashes;
+                capacity_ = capacity;
+            }
+            parameters_[size_] = parameter;
+            hashes_[size_] = parameter->getNameHash();
+            size_++;
+            return parameter;
+        }
+
+        MockCheckedExpectedCall::MockExpectedFunctionParameter*
+        MockCheckedExpectedCall::MockExpectedFunctionParameters::find(
+            const SimpleString& name
+        ) const
+        {
+            return find(name, MockNamedValue::hashName(name));
+        }
+
+        MockCheckedExpectedCall::MockExpectedFunctionParameter*
+        MockCheckedExpectedCall::MockExpectedFunctionParameters::find(
+            const SimpleString& name, unsigned long nameHash
+        ) const
+        {
+            for (size_t i = 0; i < size_; i++)
+                if (hashes_[i] == nameHash && parameters_[i]->hasName(name))
+                    return parameters_[i];
+            return nullptr;
+        }
+
+        void MockCheckedExpectedCall::MockExpectedFunctionParameters::wasPassed(
+            const SimpleString& name
+        )
+        {
+            unsigned long nameHash = MockNamedValue::hashName(name);
+            for (size_t i = 0; i < size_; i++)
+                if (hashes_[i] == nameHash && parameters_[i]->hasName(name))
+                    parameters_[i]->setMatchesActualCall(true);
+        }
+
+        MockCheckedExpectedCall::MockExpectedFunctionParameter*
+        MockCheckedExpectedCall::MockExpectedFunctionParameters::at(
+            size_t index
+        ) const
+        {
+            return parameters_[index];
+        }
+
+        size_t MockCheckedExpectedCall::MockExpectedFunctionParameters::size(
+        ) const
+        {
+            return size_;
         }
 
         MockCheckedExpectedCall::MockExpectedFunctionParameter::
             MockExpectedFunctionParameter(const SimpleString& name) :
             MockNamedValue(name),
-            matchesActualCall_(false)
+            matchesActualCall_(false),
+            sequenceCount_(0)
         {
         }
 
@@ -590,6 +709,18 @@ namespace cpputest
             return matchesActualCall_;
         }
 
+        void MockCheckedExpectedCall::MockExpectedFunctionParameter::
+            setSequenceCount(size_t count)
+        {
+            sequenceCount_ = count;
+        }
+
+        size_t MockCheckedExpectedCall::MockExpectedFunctionParameter::
+            getSequenceCount() const
+        {
+            return sequenceCount_;
+        }
+
         MockExpectedCall& MockCheckedExpectedCall::andReturnValue(bool value)
         {
             returnValue_.setName("returnValue");
@@ -682,6 +813,130 @@ namespace cpputest
             return *this;
         }
 
+        MockExpectedCall& MockCheckedExpectedCall::andReturnValues(
+            const bool* values, size_t count
+        )
+        {
+            return setReturnValues(values, MockNamedValue::VALUE_BOOL, count);
+        }
+
+        MockExpectedCall& MockCheckedExpectedCall::andReturnValues(
+            const int* values, size_t count
+        )
+        {
+            return setReturnValues(values, MockNamedValue::VALUE_INT, count);
+        }
+
+        MockExpectedCall& MockCheckedExpectedCall::andReturnValues(
+            const unsigned int* values, size_t count
+        )
+        {
+            return setReturnValues(
+                values, MockNamedValue::VALUE_UNSIGNED_INT, count
+            );
+        }
+
+        MockExpectedCall& MockCheckedExpectedCall::andReturnValues(
+            const long int* values, size_t count
+        )
+        {
+            return setReturnValues(
+                values, MockNamedValue::VALUE_LONG_INT, count
+            );
+        }
+
+        MockExpectedCall& MockCheckedExpectedCall::andReturnValues(
+            const unsigned long int* values, size_t count
+        )
+        {
+            return setReturnValues(
+                values, MockNamedValue::VALUE_UNSIGNED_LONG_INT, count
+            );
+        }
+
+        MockExpectedCall& MockCheckedExpectedCall::andReturnValues(
+            const long long* values, size_t count
+        )
+        {
+            return setReturnValues(
+                values, MockNamedValue::VALUE_LONG_LONG_INT, count
+            );
+        }
+
+        MockExpectedCall& MockCheckedExpectedCall::andReturnValues(
+            const unsigned long long* values, size_t count
+        )
+        {
+            return setReturnValues(
+                values, MockNamedValue::VALUE_UNSIGNED_LONG_LONG_INT, count
+            );
+        }
+
+        MockExpectedCall& MockCheckedExpectedCall::andReturnValues(
+            const double* values, size_t count
+        )
+        {
+            return setReturnValues(values, MockNamedValue::VALUE_DOUBLE, count);
+        }
+
+        MockExpectedCall& MockCheckedExpectedCall::andReturnValues(
+            const char* const* values, size_t count
+        )
+        {
+            return setReturnValues(values, MockNamedValue::VALUE_STRING, count);
+        }
+
+        MockExpectedCall& MockCheckedExpectedCall::andReturnValues(
+            const void* const* values, size_t count
+        )
+        {
+            return setReturnValues(
+                values, MockNamedValue::VALUE_CONST_POINTER, count
+            );
+        }
+
+        MockExpectedCall& MockCheckedExpectedCall::setReturnValues(
+            const void* values, MockNamedValue::ValueType type, size_t count
+        )
+        {
+            returnValue_.setName("returnValue");
+            returnValues_ = (count > 0) ? values : nullptr;
+            returnValuesType_ = type;
+            returnValuesCount_ = count;
+            return *this;
+        }
+
+        MockExpectedCall&
+        MockCheckedExpectedCall::withOutputParameterReturningSequence(
+            const SimpleString& name,
+            const void* values,
+            size_t size,
+            size_t count
+        )
+        {
+            MockExpectedFunctionParameter* newParameter =
+                outputParameters_.add(name);
+            newParameter->setValue(values);
+            newParameter->setSize(size);
+            newParameter->setSequenceCount(count);
+            return *this;
+        }
+
+        MockExpectedCall& MockCheckedExpectedCall::cycleValues()
+        {
+            cycleValues_ = true;
+            return *this;
+        }
+
+        size_t MockCheckedExpectedCall::sequenceIndex(
+            unsigned int call, size_t count
+        ) const
+        {
+            if (call < count)
+                return call;
+            return cycleValues_ ? call % count : count - 1;
+        }
+
         MockExpectedCall& MockCheckedExpectedCall::onObject(void* objectPtr)
         {
             isSpecificObjectExpected_ = true;
@@ -690,9 +945,50 @@ namespace cpputest
             return *this;
         }
 
+        // Asked for once the call was made, so the value is the one of the
+        // last call.
         MockNamedValue MockCheckedExpectedCall::returnValue()
         {
-            return returnValue_;
+            if (returnValues_ == nullptr)
+                return returnValue_;
+
+            unsigned int call = (actualCalls_ > 0) ? actualCalls_ - 1 : 0;
+            size_t i = sequenceIndex(call, returnValuesCount_);
+            MockNamedValue value(returnValue_);
+            if (returnValuesType_ == MockNamedValue::VALUE_BOOL)
+                value.setValue(static_cast<const bool*>(returnValues_)[i]);
+            else if (returnValuesType_ == MockNamedValue::VALUE_INT)
+                value.setValue(static_cast<const int*>(returnValues_)[i]);
+            else if (returnValuesType_ == MockNamedValue::VALUE_UNSIGNED_INT)
+                value.setValue(
+                    static_cast<const unsigned int*>(returnValues_)[i]
+                );
+            else if (returnValuesType_ == MockNamedValue::VALUE_LONG_INT)
+                value.setValue(static_cast<const long int*>(returnValues_)[i]);
+            else if (returnValuesType_ ==
+                     MockNamedValue::VALUE_UNSIGNED_LONG_INT)
+                value.setValue(
+                    static_cast<const unsigned long int*>(returnValues_)[i]
+                );
+            else if (returnValuesType_ == MockNamedValue::VALUE_LONG_LONG_INT)
+                value.setValue(static_cast<const long long*>(returnValues_)[i]
+                );
+            else if (returnValuesType_ ==
+                     MockNamedValue::VALUE_UNSIGNED_LONG_LONG_INT)
+                value.setValue(
+                    static_cast<const unsigned long long*>(returnValues_)[i]
+                );
+            else if (returnValuesType_ == MockNamedValue::VALUE_DOUBLE)
+                value.setValue(static_cast<const double*>(returnValues_)[i]);
+            else if (returnValuesType_ == MockNamedValue::VALUE_STRING)
+                value.setValue(
+                    static_cast<const char* const*>(returnValues_)[i]
+                );
+            else
+                value.setValue(
+                    static_cast<const void* const*>(returnValues_)[i]
+                );
+            return value;
         }
 
         MockExpectedCall& MockCheckedExpectedCall::withCallOrder(
@@ -32,13 +32,23 @@ namespace cpputest
 {
     namespace extensions
     {
-        MockExpectedCallsList::MockExpectedCallsList() : head_(nullptr) {}
+        MockExpectedCallsList::MockExpectedCallsList() :
+            head_(nullptr),
+            arena_(nullptr)
+        {
+        }
+
+        MockExpectedCallsList::MockExpectedCallsList(MockArena& arena) :
+            head_(nullptr),
+            arena_(&arena)
+        {
+        }
 
         MockExpectedCallsList::~MockExpectedCallsList()
         {
             while (head_) {
                 MockExpectedCallsListNode* next = head_->next_;
-                delete head_;
+                deleteNode(head_);
                 head_ = next;
             }
         }
@@ -117,11 +127,35 @@ namespace cpputest
             return false;
         }
 
+        MockNamedValueComparator*
+        MockExpectedCallsList::getComparatorForInputParameter(
+            const SimpleString& type, const SimpleString& name
+        ) const
+        {
+            for (MockExpectedCallsListNode* p = head_; p; p = p->next_) {
+                MockNamedValueComparator* comparator =
+                    p->expectedCall_->getInputParameterComparator(type, name);
+                if (comparator)
+                    return comparator;
+            }
+            return nullptr;
+        }
+
+        MockNamedValue MockExpectedCallsList::getFirstInputParameter(
+            const SimpleString& name
+        ) const
+        {
+            for (MockExpectedCallsListNode* p = head_; p; p = p->next_) {
+                if (p->expectedCall_->hasInputParameterWithName(name))
+                    return p->expectedCall_->getInputParameter(name);
+            }
+            return MockNamedValue("");
+        }
+
         void
         MockExpectedCallsList::addExpectedCall(MockCheckedExpectedCall* call)
         {
-            MockExpectedCallsListNode* newCall =
-                new MockExpectedCallsListNode(call);
+            MockExpectedCallsListNode* newCall = newNode(call);
 
             if (head_ == nullptr)
                 head_ = newCall;
@@ -291,7 +325,7 @@ namespace cpputest
                         head_ = current = current->next_;
                     else
                         current = previous->next_ = current->next_;
-                    delete toBeDeleted;
+                    deleteNode(toBeDeleted);
                 } else {
                     previous = current;
                     current = current->next_;
@@ -303,12 +337,31 @@ namespace cpputest
         {
             while (head_) {
                 MockExpectedCallsListNode* next = head_->next_;
-                delete head_->expectedCall_;
-                delete head_;
+                if (arena_)
+                    head_->expectedCall_->~MockCheckedExpectedCall();
+                else
+                    delete head_->expectedCall_;
+                deleteNode(head_);
                 head_ = next;
             }
         }
 
+        MockExpectedCallsList::MockExpectedCallsListNode*
+        MockExpectedCallsList::newNode(MockCheckedExpectedCall* call)
+        {
+            if (arena_)
+                return new (*arena_) MockExpectedCallsListNode(call);
+            return new MockExpectedCallsListNode(call);
+        }
+
+        void MockExpectedCallsList::deleteNode(MockExpectedCallsListNode* node)
+        {
+            if (arena_)
+                node->~MockExpectedCallsListNode();
+            else
+                delete node;
+        }
+
         void MockExpectedCallsList::resetActualCallMatchingState()
         {
             for (MockExpectedCallsListNode* p = head_; p; p = p->next_)
@@ -391,6 +444,141 @@ namespace cpputest
             return stringOrNoneTextWhenEmpty(str, linePrefix);
         }
 
+        SimpleString MockExpectedCallsList::unfulfilledCallsToString(
+            const SimpleString& linePrefix,
+            size_t maxCalls,
+            const SimpleString& closestParameterName,
+            const SimpleString& closestParameterType
+        ) const
+        {
+            return cappedCallsToString(
+                linePrefix, false, maxCalls, closestParameterName,
+                closestParameterType
+            );
+        }
+
+        SimpleString MockExpectedCallsList::fulfilledCallsToString(
+            const SimpleString& linePrefix,
+            size_t maxCalls,
+            const SimpleString& closestParameterName,
+            const SimpleString& closestParameterType
+        ) const
+        {
+            return cappedCallsToString(
+                linePrefix, true, maxCalls, closestParameterName,
+                closestParameterType
+            );
+        }
+
+        static const int maxSimilarity = 2;
+
+        static int similarity(
+            MockCheckedExpectedCall* call,
+            const SimpleString& closestParameterName,
+            const SimpleString& closestParameterType
+        )
+        {
+            if (closestParameterName == "" ||
+                !call->hasInputParameterWithName(closestParameterName))
+                return 0;
+            if (call->getInputParameterType(closestParameterName) ==
+                closestParameterType)
+                return 2;
+            return 1;
+        }
+
+        static SimpleString omittedCallsSummary(
+            const MockNameIndex& omittedPerFunction,
+            size_t omitted,
+            size_t maxFunctions
+        )
+        {
+            SimpleString str = StringFromFormat(
+                "(%lu more not shown:",
+                static_cast<unsigned long>(omitted)
+            );
+            size_t functions = 0;
+            for (MockNameIndexEntry* p = omittedPerFunction.begin(); p;
+                 p = p->next(), functions++) {
+                if (functions == maxFunctions) {
+                    str += " ...";
+                    break;
+                }
+                str += (functions == 0) ? " " : ", ";
+                str += StringFrom(p->getNumber());
+                str += " x ";
+                str += p->getName();
+            }
+            str += ")";
+            return str;
+        }
+
+        // Lists the closest calls rank by rank, so that the calls of the
+        // lowest rank that made it are the first ones of that rank. The
+        // omitted calls are then exactly the ones after those.
+        SimpleString MockExpectedCallsList::cappedCallsToString(
+            const SimpleString& linePrefix,
+            bool fulfilled,
+            size_t maxCalls,
+            const SimpleString& closestParameterName,
+            const SimpleString& closestParameterType
+        ) const
+        {
+            SimpleString str;
+            size_t listed = 0;
+            int lowestListedScore = maxSimilarity + 1;
+            size_t listedWithLowestScore = 0;
+
+            for (int score = maxSimilarity; score >= 0 && listed < maxCalls;
+                 score--) {
+                for (MockExpectedCallsListNode* p = head_;
+                     p && listed < maxCalls; p = p->next_) {
+                    if (p->expectedCall_->isFulfilled() != fulfilled ||
+                        similarity(
+                            p->expectedCall_, closestParameterName,
+                            closestParameterType
+                        ) != score)
+                        continue;
+                    str = appendStringOnANewLine(
+                        str, linePrefix, p->expectedCall_->callToString()
+                    );
+                    if (lowestListedScore != score)
+                        listedWithLowestScore = 0;
+                    lowestListedScore = score;
+                    listedWithLowestScore++;
+                    listed++;
+                }
+            }
+
+            MockNameIndex omittedPerFunction;
+            size_t omitted = 0;
+            size_t seenWithLowestScore = 0;
+            for (MockExpectedCallsListNode* p = head_; p; p = p->next_) {
+                if (p->expectedCall_->isFulfilled() != fulfilled)
+                    continue;
+                int score = similarity(
+                    p->expectedCall_, closestParameterName, closestParameterType
+                );
+                if (score > lowestListedScore)
+                    continue;
+                if (score == lowestListedScore &&
+                    seenWithLowestScore++ < listedWithLowestScore)
+                    continue;
+
+                MockNameIndexEntry& count =
+                    omittedPerFunction.get(p->expectedCall_->getName());
+                count.setNumber(count.getNumber() + 1);
+                omitted++;
+            }
+
+            if (omitted)
+                str = appendStringOnANewLine(
+                    str, linePrefix,
+                    omittedCallsSummary(omittedPerFunction, omitted, maxCalls)
+                );
+            return stringOrNoneTextWhenEmpty(str, linePrefix);
+        }
+
         SimpleString MockExpectedCallsList::callsWithMissingParametersToString(
             const SimpleString& linePrefix,
             const SimpleString& missingParametersPrefix
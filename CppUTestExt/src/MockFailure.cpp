@@ -71,49 +71,151 @@ namespace cpputest
             return UtestShell::getCurrent();
         }
 
+        static bool reportAllExpectations_ = false;
+
         MockFailure::MockFailure(UtestShell* test) :
             TestFailure(
                 test,
                 "Test failed with MockFailure without an error! Something went "
                 "seriously wrong."
-            )
+            ),
+            historyExpectations_(nullptr),
+            historyPosition_(0)
+        {
+        }
+
+        // TestFailure copies the rendered message, so the copy does not
+        // need the history of the original.
+        MockFailure::MockFailure(const MockFailure& other) :
+            TestFailure(other),
+            historyExpectations_(nullptr),
+            historyPosition_(0)
+        {
+        }
+
+        void MockFailure::reportAllExpectations(bool all)
+        {
+            reportAllExpectations_ = all;
+        }
+
+        SimpleString MockFailure::getMessage() const
+        {
+            renderExpectationsAndCallHistory();
+            if (history_.isEmpty())
+                return message_;
+            SimpleString message = message_.subString(0, historyPosition_);
+            message += history_;
+            message += message_.subString(historyPosition_);
+            return message;
+        }
+
+        void MockFailure::resolveExpectationsAndCallHistory()
         {
+            message_ = getMessage();
+            history_ = "";
+            historyPosition_ = 0;
         }
 
         void MockFailure::addExpectationsAndCallHistory(
             const MockExpectedCallsList& expectations
         )
         {
-            message_ += "\tEXPECTED calls that WERE NOT fulfilled:\n";
-            message_ += expectations.unfulfilledCallsToString("\t\t");
-            message_ += "\n\tEXPECTED calls that WERE fulfilled:\n";
-            message_ += expectations.fulfilledCallsToString("\t\t");
+            addExpectationsAndCallHistoryRelatedTo("", expectations);
         }
 
         void MockFailure::addExpectationsAndCallHistoryRelatedTo(
-            const SimpleString& name, const MockExpectedCallsList& expectations
+            const SimpleString& name,
+            const MockExpectedCallsList& expectations,
+            const MockNamedValue* closestParameter
         )
         {
+            historyExpectations_ = &expectations;
+            historyFunction_ = name;
+            historyParameterName_ = "";
+            historyParameterType_ = "";
+            if (closestParameter) {
+                historyParameterName_ = closestParameter->getName();
+                historyParameterType_ = closestParameter->getType();
+            }
+            history_ = "";
+            historyPosition_ = message_.size();
+        }
+
+        static SimpleString unfulfilledCalls(
+            const MockExpectedCallsList& expectations,
+            const SimpleString& closestParameterName,
+            const SimpleString& closestParameterType
+        )
+        {
+            if (reportAllExpectations_)
+                return expectations.unfulfilledCallsToString("\t\t");
+            return expectations.unfulfilledCallsToString(
+                "\t\t", MockFailure::expectationsShownInReports,
+                closestParameterName, closestParameterType
+            );
+        }
+
+        static SimpleString fulfilledCalls(
+            const MockExpectedCallsList& expectations,
+            const SimpleString& closestParameterName,
+            const SimpleString& closestParameterType
+        )
+        {
+            if (reportAllExpectations_)
+                return expectations.fulfilledCallsToString("\t\t");
+            return expectations.fulfilledCallsToString(
+                "\t\t", MockFailure::expectationsShownInReports,
+                closestParameterName, closestParameterType
+            );
+        }
+
+        // Renders the history at most once and forgets the list, so that
+        // neither this failure nor its copies look at it afterwards.
+        void MockFailure::renderExpectationsAndCallHistory() const
+        {
+            if (historyExpectations_ == nullptr)
+                return;
+            history_ = expectationsAndCallHistory();
+            historyExpectations_ = nullptr;
+        }
+
+        SimpleString MockFailure::expectationsAndCallHistory() const
+        {
+            SimpleString str;
+            if (historyFunction_ == "") {
+                str += "\tEXPECTED calls that WERE NOT fulfilled:\n";
+                str += unfulfilledCalls(*historyExpectations_, "", "");
+                str += "\n\tEXPECTED calls that WERE fulfilled:\n";
+                str += fulfilledCalls(*historyExpectations_, "", "");
+                return str;
+            }
+
             MockExpectedCallsList expectationsForFunction;
             expectationsForFunction.addExpectationsRelatedTo(
-                name, expectations
+                historyFunction_, *historyExpectations_
             );
 
-            message_ +=
+            str +=
                 "\tEXPECTED calls that WERE NOT fulfilled related to "
                 "function: ";
-            message_ += name;
-            message_ += "\n";
+            str += historyFunction_;
+            str += "\n";
 
-            message_ +=
-                expectationsForFunction.unfulfilledCallsToString("\t\t");
+            str += unfulfilledCalls(
+                expectationsForFunction, historyParameterName_,
+                historyParameterType_
+            );
 
-            message_ +=
+            str +=
                 "\n\tEXPECTED calls that WERE fulfilled related to function: ";
-            message_ += name;
-            message_ += "\n";
+            str += historyFunction_;
+            str += "\n";
 
-            message_ += expectationsForFunction.fulfilledCallsToString("\t\t");
+            str += fulfilledCalls(
+                expectationsForFunction, historyParameterName_,
+                historyParameterType_
+            );
+            return str;
         }
 
         MockExpectedCallsDidntHappenFailure::
@@ -124,6 +226,7 @@ namespace cpputest
         {
             message_ = "Mock Failure: Expected call WAS NOT fulfilled.\n";
             addExpectationsAndCallHistory(expectations);
+            resolveExpectationsAndCallHistory();
         }
 
         MockUnexpectedCallHappenedFailure::MockUnexpectedCallHappenedFailure(
@@ -163,6 +266,57 @@ namespace cpputest
             message_ = "Mock Failure: Out of order calls";
             message_ += "\n";
             addExpectationsAndCallHistory(expectationsForOutOfOrder);
+            resolveExpectationsAndCallHistory();
+        }
+
+        static const size_t memoryBufferWindowSize = 32;
+
+        // Buffers too large to be shown whole are shown as a window around
+        // their first difference.
+        static SimpleString memoryBufferDifference(
+            const MockNamedValue& expected, const MockNamedValue& actual
+        )
+        {
+            const MockNamedValue::ValueType buffer =
+                MockNamedValue::VALUE_MEMORY_BUFFER;
+            size_t size = actual.getSize();
+
+            if (expected.getValueType() != buffer ||
+                actual.getValueType() != buffer || expected.getSize() != size ||
+                size <= 128)
+                return "";
+            const unsigned char* expectedBuffer = expected.getMemoryBuffer();
+            const unsigned char* actualBuffer = actual.getMemoryBuffer();
+            if (expectedBuffer == nullptr || actualBuffer == nullptr)
+                return "";
+
+            size_t offset = 0;
+            while (offset < size &&
+                   expectedBuffer[offset] == actualBuffer[offset])
+                offset++;
+            if (offset == size)
+                return "";
+
+            size_t start = (offset > memoryBufferWindowSize / 2)
+                               ? offset - memoryBufferWindowSize / 2
+                               : 0;
+            size_t length = (size - start > memoryBufferWindowSize)
+                                ? memoryBufferWindowSize
+                                : size - start;
+
+            SimpleString str = StringFromFormat(
+                "\n\tFIRST difference to the first expected buffer at offset "
+                "%lu, showing bytes %lu to %lu:",
+                static_cast<unsigned long>(offset),
+                static_cast<unsigned long>(start),
+                static_cast<unsigned long>(start + length - 1)
+            );
+            str += "\n\t\texpected: <";
+            str += StringFromBinary(expectedBuffer + start, length);
+            str += ">\n\t\tactual:   <";
+            str += StringFromBinary(actualBuffer + start, length);
+            str += ">";
+            return str;
         }
 
         MockUnexpectedInputParameterFailure::
@@ -200,7 +354,9 @@ namespace cpputest
             }
 
             message_ += "\n";
-            addExpectationsAndCallHistoryRelatedTo(functionName, expectations);
+            addExpectationsAndCallHistoryRelatedTo(
+                functionName, expectations, &parameter
+            );
 
             message_ += "\n\tACTUAL unexpected parameter passed to function: ";
             message_ += functionName;
@@ -213,6 +369,12 @@ namespace cpputest
             message_ += ": <";
             message_ += StringFrom(parameter);
             message_ += ">";
+            message_ += memoryBufferDifference(
+                expectationsForFunctionWithParameterName.getFirstInputParameter(
+                    parameter.getName()
+                ),
+                parameter
+            );
         }
 
         MockUnexpectedOutputParameterFailure::
@@ -348,5 +510,21 @@ namespace cpputest
             );
             addExpectationsAndCallHistoryRelatedTo(functionName, expectations);
         }
+
+        MockConcurrentCallFailure::MockConcurrentCallFailure(
+            UtestShell* test, const SimpleString& message
+        ) :
+            MockFailure(test)
+        {
+            message_ = message;
+        }
+
+        MockFunctionCallFailure::MockFunctionCallFailure(
+            UtestShell* test, const SimpleString& message
+        ) :
+            MockFailure(test)
+        {
+            message_ = message;
+        }
     }
 }
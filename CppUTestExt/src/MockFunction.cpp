@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTestExt/MockFunction.hpp"
+#include "CppUTest/TestHarness.hpp"
+
+namespace cpputest
+{
+    namespace extensions
+    {
+        static MockFunctionBase* mockFunctions = nullptr;
+        static MockFailureReporter defaultReporter;
+        static MockFailureReporter* standardReporter = &defaultReporter;
+
+        MockFunctionBase::MockFunctionBase(const SimpleString& name) :
+            name_(name),
+            reporter_(nullptr),
+            next_(mockFunctions),
+            previous_(nullptr)
+        {
+            if (mockFunctions)
+                mockFunctions->previous_ = this;
+            mockFunctions = this;
+        }
+
+        MockFunctionBase::~MockFunctionBase()
+        {
+            if (previous_)
+                previous_->next_ = next_;
+            else
+                mockFunctions = next_;
+            if (next_)
+                next_->previous_ = previous_;
+        }
+
+        const SimpleString& MockFunctionBase::getName() const
+        {
+            return name_;
+        }
+
+        void
+        MockFunctionBase::setMockFailureReporter(MockFailureReporter* reporter)
+        {
+            reporter_ = reporter;
+        }
+
+        void MockFunctionBase::checkAllExpectations()
+        {
+            for (MockFunctionBase* function = mockFunctions; function;
+                 function = function->next_)
+                function->checkExpectations();
+        }
+
+        void MockFunctionBase::clearAll()
+        {
+            for (MockFunctionBase* function = mockFunctions; function;
+                 function = function->next_)
+                function->clear();
+        }
+
+        void MockFunctionBase::setMockFailureStandardReporter(
+            MockFailureReporter* reporter
+        )
+        {
+            standardReporter = (reporter != nullptr) ? reporter
+                                                     : &defaultReporter;
+        }
+
+        void MockFunctionBase::failTest(const SimpleString& message)
+        {
+            MockFailureReporter* reporter =
+                (reporter_ != nullptr) ? reporter_ : standardReporter;
+            reporter->failTest(
+                MockFunctionCallFailure(reporter->getTestToFail(), message)
+            );
+        }
+    }
+}
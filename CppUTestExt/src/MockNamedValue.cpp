@@ -40,7 +40,8 @@ namespace cpputest
             MockNamedValueComparatorsAndCopiersRepository* repository
         )
         {
-            defaultRepository_ = repository;
+            if (defaultRepository_ != repository)
+                defaultRepository_ = repository;
         }
 
         MockNamedValueComparatorsAndCopiersRepository*
@@ -49,9 +50,34 @@ namespace cpputest
             return defaultRepository_;
         }
 
+        static const char* const builtinTypeNames[] = {
+            "bool",
+            "int",
+            "unsigned int",
+            "long int",
+            "unsigned long int",
+            "long long int",
+            "unsigned long long int",
+            "double",
+            "const char*",
+            "void*",
+            "const void*",
+            "void (*)()",
+            "const unsigned char*",
+        };
+
+        unsigned long MockNamedValue::hashName(const SimpleString& name)
+        {
+            unsigned long hash = 2166136261UL;
+            for (const char* c = name.asCharString(); *c; c++)
+                hash = (hash ^ static_cast<unsigned char>(*c)) * 16777619UL;
+            return hash;
+        }
+
         MockNamedValue::MockNamedValue(const SimpleString& name) :
             name_(name),
-            type_("int"),
+            nameHash_(hashName(name)),
+            valueType_(VALUE_INT),
             size_(0),
             comparator_(nullptr),
             copier_(nullptr)
@@ -63,43 +89,43 @@ namespace cpputest
 
         void MockNamedValue::setValue(bool value)
         {
-            type_ = "bool";
+            valueType_ = VALUE_BOOL;
             value_.boolValue_ = value;
         }
 
         void MockNamedValue::setValue(unsigned int value)
         {
-            type_ = "unsigned int";
+            valueType_ = VALUE_UNSIGNED_INT;
             value_.unsignedIntValue_ = value;
         }
 
         void MockNamedValue::setValue(int value)
         {
-            type_ = "int";
+            valueType_ = VALUE_INT;
             value_.intValue_ = value;
         }
 
         void MockNamedValue::setValue(long int value)
         {
-            type_ = "long int";
+            valueType_ = VALUE_LONG_INT;
             value_.longIntValue_ = value;
         }
 
         void MockNamedValue::setValue(unsigned long int value)
         {
-            type_ = "unsigned long int";
+            valueType_ = VALUE_UNSIGNED_LONG_INT;
             value_.unsignedLongIntValue_ = value;
         }
 
         void MockNamedValue::setValue(long long value)
         {
-            type_ = "long long int";
+            valueType_ = VALUE_LONG_LONG_INT;
             value_.longLongIntValue_ = value;
         }
 
         void MockNamedValue::setValue(unsigned long long value)
         {
-            type_ = "unsigned long long int";
+            valueType_ = VALUE_UNSIGNED_LONG_LONG_INT;
             value_.unsignedLongLongIntValue_ = value;
         }
 
@@ -110,39 +136,39 @@ namespace cpputest
 
         void MockNamedValue::setValue(double value, double tolerance)
         {
-            type_ = "double";
+            valueType_ = VALUE_DOUBLE;
             value_.doubleValue_.value = value;
             value_.doubleValue_.tolerance = tolerance;
         }
 
         void MockNamedValue::setValue(void* value)
         {
-            type_ = "void*";
+            valueType_ = VALUE_POINTER;
             value_.pointerValue_ = value;
         }
 
         void MockNamedValue::setValue(const void* value)
         {
-            type_ = "const void*";
+            valueType_ = VALUE_CONST_POINTER;
             value_.constPointerValue_ = value;
         }
 
         void MockNamedValue::setValue(void (*value)())
         {
-            type_ = "void (*)()";
+            valueType_ = VALUE_FUNCTION_POINTER;
             value_.functionPointerValue_ = value;
         }
 
         void MockNamedValue::setValue(const char* value)
         {
-            type_ = "const char*";
+            valueType_ = VALUE_STRING;
             value_.stringValue_ = value;
         }
 
         void
         MockNamedValue::setMemoryBuffer(const unsigned char* value, size_t size)
         {
-            type_ = "const unsigned char*";
+            valueType_ = VALUE_MEMORY_BUFFER;
             value_.memoryBufferValue_ = value;
             size_ = size;
         }
@@ -151,7 +177,8 @@ namespace cpputest
             const SimpleString& type, const void* objectPtr
         )
         {
-            type_ = type;
+            valueType_ = VALUE_OBJECT;
+            objectType_ = type;
             value_.constObjectPointerValue_ = objectPtr;
             if (defaultRepository_) {
                 comparator_ = defaultRepository_->getComparatorForType(type);
@@ -159,11 +186,26 @@ namespace cpputest
             }
         }
 
+        void MockNamedValue::setConstObjectPointer(
+            const SimpleString& type,
+            const void* objectPtr,
+            MockNamedValueComparator* comparator,
+            MockNamedValueCopier* copier
+        )
+        {
+            valueType_ = VALUE_OBJECT;
+            objectType_ = type;
+            value_.constObjectPointerValue_ = objectPtr;
+            comparator_ = comparator;
+            copier_ = copier;
+        }
+
         void MockNamedValue::setObjectPointer(
             const SimpleString& type, void* objectPtr
         )
         {
-            type_ = type;
+            valueType_ = VALUE_OBJECT;
+            objectType_ = type;
             value_.objectPointerValue_ = objectPtr;
             if (defaultRepository_) {
                 comparator_ = defaultRepository_->getComparatorForType(type);
@@ -179,6 +221,7 @@ namespace cpputest
         void MockNamedValue::setName(const char* name)
         {
             name_ = name;
+            nameHash_ = hashName(name_);
         }
 
         SimpleString MockNamedValue::getName() const
@@ -186,135 +229,161 @@ namespace cpputest
             return name_;
         }
 
+        unsigned long MockNamedValue::getNameHash() const
+        {
+            return nameHash_;
+        }
+
+        bool MockNamedValue::hasName(const SimpleString& name) const
+        {
+            return name_ == name;
+        }
+
         SimpleString MockNamedValue::getType() const
         {
-            return type_;
+            if (valueType_ == VALUE_OBJECT)
+                return objectType_;
+            return builtinTypeNames[valueType_];
+        }
+
+        MockNamedValue::ValueType MockNamedValue::getValueType() const
+        {
+            return valueType_;
+        }
+
+        void MockNamedValue::checkValueType(ValueType expected) const
+        {
+            if (valueType_ != expected)
+                STRCMP_EQUAL(
+                    builtinTypeNames[expected], getType().asCharString()
+                );
         }
 
         bool MockNamedValue::getBoolValue() const
         {
-            STRCMP_EQUAL("bool", type_.asCharString());
+            checkValueType(VALUE_BOOL);
             return value_.boolValue_;
         }
 
         unsigned int MockNamedValue::getUnsignedIntValue() const
         {
-            if (type_ == "int" && value_.intValue_ >= 0)
+            if (valueType_ == VALUE_INT && value_.intValue_ >= 0)
                 return static_cast<unsigned int>(value_.intValue_);
             else {
-                STRCMP_EQUAL("unsigned int", type_.asCharString());
+                checkValueType(VALUE_UNSIGNED_INT);
                 return value_.unsignedIntValue_;
             }
         }
 
         int MockNamedValue::getIntValue() const
         {
-            STRCMP_EQUAL("int", type_.asCharString());
+            checkValueType(VALUE_INT);
             return value_.intValue_;
         }
 
         long int MockNamedValue::getLongIntValue() const
         {
-            if (type_ == "int")
+            if (valueType_ == VALUE_INT)
                 return value_.intValue_;
-            else if (type_ == "unsigned int")
+            else if (valueType_ == VALUE_UNSIGNED_INT)
                 return static_cast<long int>(value_.unsignedIntValue_);
             else {
-                STRCMP_EQUAL("long int", type_.asCharString());
+                checkValueType(VALUE_LONG_INT);
                 return value_.longIntValue_;
             }
         }
 
         unsigned long int MockNamedValue::getUnsignedLongIntValue() const
         {
-            if (type_ == "unsigned int")
+            if (valueType_ == VALUE_UNSIGNED_INT)
                 return value_.unsignedIntValue_;
-            else if (type_ == "int" && value_.intValue_ >= 0)
+            else if (valueType_ == VALUE_INT && value_.intValue_ >= 0)
                 return static_cast<unsigned long int>(value_.intValue_);
-            else if (type_ == "long int" && value_.longIntValue_ >= 0)
+            else if (valueType_ == VALUE_LONG_INT && value_.longIntValue_ >= 0)
                 return static_cast<unsigned long int>(value_.longIntValue_);
             else {
-                STRCMP_EQUAL("unsigned long int", type_.asCharString());
+                checkValueType(VALUE_UNSIGNED_LONG_INT);
                 return value_.unsignedLongIntValue_;
             }
         }
 
         long long MockNamedValue::getLongLongIntValue() const
         {
-            if (type_ == "int")
+            if (valueType_ == VALUE_INT)
                 return value_.intValue_;
-            else if (type_ == "unsigned int")
+            else if (valueType_ == VALUE_UNSIGNED_INT)
                 return static_cast<long long int>(value_.unsignedIntValue_);
-            else if (type_ == "long int")
+            else if (valueType_ == VALUE_LONG_INT)
                 return value_.longIntValue_;
-            else if (type_ == "unsigned long int")
+            else if (valueType_ == VALUE_UNSIGNED_LONG_INT)
                 return static_cast<long long int>(value_.unsignedLongIntValue_);
             else {
-                STRCMP_EQUAL("long long int", type_.asCharString());
+                checkValueType(VALUE_LONG_LONG_INT);
                 return value_.longLongIntValue_;
             }
         }
 
         unsigned long long MockNamedValue::getUnsignedLongLongIntValue() const
         {
-            if (type_ == "unsigned int")
+            if (valueType_ == VALUE_UNSIGNED_INT)
                 return value_.unsignedIntValue_;
-            else if (type_ == "int" && value_.intValue_ >= 0)
+            else if (valueType_ == VALUE_INT && value_.intValue_ >= 0)
                 return static_cast<unsigned long long int>(value_.intValue_);
-            else if (type_ == "long int" && value_.longIntValue_ >= 0)
+            else if (valueType_ == VALUE_LONG_INT && value_.longIntValue_ >= 0)
                 return static_cast<unsigned long long int>(value_.longIntValue_
                 );
-            else if (type_ == "unsigned long int")
+            else if (valueType_ == VALUE_UNSIGNED_LONG_INT)
                 return value_.unsignedLongIntValue_;
-            else if (type_ == "long long int" && value_.longLongIntValue_ >= 0)
+            else if (valueType_ == VALUE_LONG_LONG_INT &&
+                     value_.longLongIntValue_ >= 0)
                 return static_cast<unsigned long long int>(
                     value_.longLongIntValue_
                 );
             else {
-                STRCMP_EQUAL("unsigned long long int", type_.asCharString());
+                checkValueType(VALUE_UNSIGNED_LONG_LONG_INT);
                 return value_.unsignedLongLongIntValue_;
             }
         }
 
         double MockNamedValue::getDoubleValue() const
         {
-            STRCMP_EQUAL("double", type_.asCharString());
+            checkValueType(VALUE_DOUBLE);
             return value_.doubleValue_.value;
         }
 
         double MockNamedValue::getDoubleTolerance() const
         {
-            STRCMP_EQUAL("double", type_.asCharString());
+            checkValueType(VALUE_DOUBLE);
             return value_.doubleValue_.tolerance;
         }
 
         const char* MockNamedValue::getStringValue() const
         {
-            STRCMP_EQUAL("const char*", type_.asCharString());
+            checkValueType(VALUE_STRING);
             return value_.stringValue_;
         }
 
         void* MockNamedValue::getPointerValue() const
         {
-            STRCMP_EQUAL("void*", type_.asCharString());
+            checkValueType(VALUE_POINTER);
             return value_.pointerValue_;
         }
 
         const void* MockNamedValue::getConstPointerValue() const
         {
-            STRCMP_EQUAL("const void*", type_.asCharString());
+            checkValueType(VALUE_CONST_POINTER);
             return value_.pointerValue_;
         }
 
         void (*MockNamedValue::getFunctionPointerValue() const)()
         {
-            STRCMP_EQUAL("void (*)()", type_.asCharString());
+            checkValueType(VALUE_FUNCTION_POINTER);
             return value_.functionPointerValue_;
         }
 
         const unsigned char* MockNamedValue::getMemoryBuffer() const
         {
-            STRCMP_EQUAL("const unsigned char*", type_.asCharString());
+            checkValueType(VALUE_MEMORY_BUFFER);
             return value_.memoryBufferValue_;
         }
 
@@ -343,219 +412,257 @@ namespace cpputest
             return copier_;
         }
 
-        bool MockNamedValue::equals(const MockNamedValue& p) const
+        /*
+         * The equality rule for every pair of value types. Integers of any
+         * width and signedness are equal when they hold the same number;
+         * every other pair of different types is unequal.
+         */
+        struct MockNamedValueEquality
         {
-            if ((type_ == "long int") && (p.type_ == "int"))
-                return value_.longIntValue_ == p.value_.intValue_;
-            else if ((type_ == "int") && (p.type_ == "long int"))
-                return value_.intValue_ == p.value_.longIntValue_;
-            else if ((type_ == "unsigned int") && (p.type_ == "int"))
-                return (p.value_.intValue_ >= 0) &&
-                       (value_.unsignedIntValue_ ==
-                        static_cast<unsigned int>(p.value_.intValue_));
-            else if ((type_ == "int") && (p.type_ == "unsigned int"))
-                return (value_.intValue_ >= 0) &&
-                       (static_cast<unsigned int>(value_.intValue_) ==
-                        p.value_.unsignedIntValue_);
-            else if ((type_ == "unsigned long int") && (p.type_ == "int"))
-                return (p.value_.intValue_ >= 0) &&
-                       (value_.unsignedLongIntValue_ ==
-                        static_cast<unsigned long>(p.value_.intValue_));
-            else if ((type_ == "int") && (p.type_ == "unsigned long int"))
-                return (value_.intValue_ >= 0) &&
-                       (static_cast<unsigned long>(value_.intValue_) ==
-                        p.value_.unsignedLongIntValue_);
-            else if ((type_ == "unsigned int") && (p.type_ == "long int"))
-                return (p.value_.longIntValue_ >= 0) &&
-                       (value_.unsignedIntValue_ ==
-                        static_cast<unsigned long>(p.value_.longIntValue_));
-            else if ((type_ == "long int") && (p.type_ == "unsigned int"))
-                return (value_.longIntValue_ >= 0) &&
-                       (static_cast<unsigned long>(value_.longIntValue_) ==
-                        p.value_.unsignedIntValue_);
-            else if ((type_ == "unsigned int") && (p.type_ == "unsigned long int"))
-                return value_.unsignedIntValue_ ==
-                       p.value_.unsignedLongIntValue_;
-            else if ((type_ == "unsigned long int") && (p.type_ == "unsigned int"))
-                return value_.unsignedLongIntValue_ ==
-                       p.value_.unsignedIntValue_;
-            else if ((type_ == "long int") && (p.type_ == "unsigned long int"))
-                return (value_.longIntValue_ >= 0) &&
-                       (static_cast<unsigned long>(value_.longIntValue_) ==
-                        p.value_.unsignedLongIntValue_);
-            else if ((type_ == "unsigned long int") && (p.type_ == "long int"))
-                return (p.value_.longIntValue_ >= 0) &&
-                       (value_.unsignedLongIntValue_ ==
-                        static_cast<unsigned long>(p.value_.longIntValue_));
-            else if ((type_ == "long long int") && (p.type_ == "int"))
-                return value_.longLongIntValue_ == p.value_.intValue_;
-            else if ((type_ == "int") && (p.type_ == "long long int"))
-                return value_.intValue_ == p.value_.longLongIntValue_;
-            else if ((type_ == "long long int") && (p.type_ == "long int"))
-                return value_.longLongIntValue_ == p.value_.longIntValue_;
-            else if ((type_ == "long int") && (p.type_ == "long long int"))
-                return value_.longIntValue_ == p.value_.longLongIntValue_;
-            else if ((type_ == "long long int") && (p.type_ == "unsigned int"))
-                return (value_.longLongIntValue_ >= 0) &&
-                       (static_cast<unsigned long long>(value_.longLongIntValue_
-                        ) == p.value_.unsignedIntValue_);
-            else if ((type_ == "unsigned int") && (p.type_ == "long long int"))
-                return (p.value_.longLongIntValue_ >= 0) &&
-                       (value_.unsignedIntValue_ ==
-                        static_cast<unsigned long long>(
-                            p.value_.longLongIntValue_
-                        ));
-            else if ((type_ == "long long int") && (p.type_ == "unsigned long int"))
-                return (value_.longLongIntValue_ >= 0) &&
-                       (static_cast<unsigned long long>(value_.longLongIntValue_
-                        ) == p.value_.unsignedLongIntValue_);
-            else if ((type_ == "unsigned long int") && (p.type_ == "long long int"))
-                return (p.value_.longLongIntValue_ >= 0) &&
-                       (value_.unsignedLongIntValue_ ==
-                        static_cast<unsigned long long>(
-                            p.value_.longLongIntValue_
-                        ));
-            else if ((type_ == "long long int") && (p.type_ == "unsigned long long int"))
-                return (value_.longLongIntValue_ >= 0) &&
-                       (static_cast<unsigned long long>(value_.longLongIntValue_
-                        ) == p.value_.unsignedLongLongIntValue_);
-            else if ((type_ == "unsigned long long int") && (p.type_ == "long long int"))
-                return (p.value_.longLongIntValue_ >= 0) &&
-                       (value_.unsignedLongLongIntValue_ ==
-                        static_cast<unsigned long long>(
-                            p.value_.longLongIntValue_
-                        ));
-            else if ((type_ == "unsigned long long int") && (p.type_ == "int"))
-                return (p.value_.intValue_ >= 0) &&
-                       (value_.unsignedLongLongIntValue_ ==
-                        static_cast<unsigned long long>(p.value_.intValue_));
-            else if ((type_ == "int") && (p.type_ == "unsigned long long int"))
-                return (value_.intValue_ >= 0) &&
-                       (static_cast<unsigned long long>(value_.intValue_) ==
-                        p.value_.unsignedLongLongIntValue_);
-            else if ((type_ == "unsigned long long int") && (p.type_ == "unsigned int"))
-                return value_.unsignedLongLongIntValue_ ==
-                       p.value_.unsignedIntValue_;
-            else if ((type_ == "unsigned int") && (p.type_ == "unsigned long long int"))
-                return value_.unsignedIntValue_ ==
-                       p.value_.unsignedLongLongIntValue_;
-            else if ((type_ == "unsigned long long int") && (p.type_ == "long int"))
-                return (p.value_.longIntValue_ >= 0) &&
-                       (value_.unsignedLongLongIntValue_ ==
-                        static_cast<unsigned long long>(p.value_.longIntValue_)
-                       );
-            else if ((type_ == "long int") && (p.type_ == "unsigned long long int"))
-                return (value_.longIntValue_ >= 0) &&
-                       (static_cast<unsigned long long>(value_.longIntValue_) ==
-                        p.value_.unsignedLongLongIntValue_);
-            else if ((type_ == "unsigned long long int") && (p.type_ == "unsigned long int"))
-                return value_.unsignedLongLongIntValue_ ==
-                       p.value_.unsignedLongIntValue_;
-            else if ((type_ == "unsigned long int") && (p.type_ == "unsigned long long int"))
-                return value_.unsignedLongIntValue_ ==
-                       p.value_.unsignedLongLongIntValue_;
-
-            if (type_ != p.type_)
+            typedef bool (*Rule)(const MockNamedValue&, const MockNamedValue&);
+
+            Rule rules[MockNamedValue::VALUE_TYPE_COUNT]
+                      [MockNamedValue::VALUE_TYPE_COUNT];
+
+            MockNamedValueEquality();
+
+            static bool isSignedInteger(MockNamedValue::ValueType type);
+            static bool isUnsignedInteger(MockNamedValue::ValueType type);
+            static long long signedValue(const MockNamedValue& v);
+            static unsigned long long unsignedValue(const MockNamedValue& v);
+
+            static bool
+            differentTypes(const MockNamedValue&, const MockNamedValue&)
+            {
                 return false;
+            }
+
+            static bool
+            signedIntegers(const MockNamedValue& a, const MockNamedValue& b)
+            {
+                return signedValue(a) == signedValue(b);
+            }
+
+            static bool
+            unsignedIntegers(const MockNamedValue& a, const MockNamedValue& b)
+            {
+                return unsignedValue(a) == unsignedValue(b);
+            }
+
+            static bool signedAndUnsignedIntegers(
+                const MockNamedValue& a, const MockNamedValue& b
+            )
+            {
+                long long value = signedValue(a);
+                return (value >= 0) &&
+                       (static_cast<unsigned long long>(value) ==
+                        unsignedValue(b));
+            }
+
+            static bool unsignedAndSignedIntegers(
+                const MockNamedValue& a, const MockNamedValue& b
+            )
+            {
+                return signedAndUnsignedIntegers(b, a);
+            }
 
-            if (type_ == "bool")
-                return value_.boolValue_ == p.value_.boolValue_;
-            else if (type_ == "int")
-                return value_.intValue_ == p.value_.intValue_;
-            else if (type_ == "unsigned int")
-                return value_.unsignedIntValue_ == p.value_.unsignedIntValue_;
-            else if (type_ == "long int")
-                return value_.longIntValue_ == p.value_.longIntValue_;
-            else if (type_ == "unsigned long int")
-                return value_.unsignedLongIntValue_ ==
-                       p.value_.unsignedLongIntValue_;
-            else if (type_ == "long long int")
-                return value_.longLongIntValue_ == p.value_.longLongIntValue_;
-            else if (type_ == "unsigned long long int")
-                return value_.unsignedLongLongIntValue_ ==
-                       p.value_.unsignedLongLongIntValue_;
-            else if (type_ == "const char*")
-                return SimpleString(value_.stringValue_) ==
-                       SimpleString(p.value_.stringValue_);
-            else if (type_ == "void*")
-                return value_.pointerValue_ == p.value_.pointerValue_;
-            else if (type_ == "const void*")
-                return value_.constPointerValue_ == p.value_.constPointerValue_;
-            else if (type_ == "void (*)()")
-                return value_.functionPointerValue_ ==
-                       p.value_.functionPointerValue_;
-            else if (type_ == "double")
-                return (doubles_equal(
-                    value_.doubleValue_.value, p.value_.doubleValue_.value,
-                    value_.doubleValue_.tolerance
-                ));
-            else if (type_ == "const unsigned char*") {
-                if (size_ != p.size_) {
+            static bool bools(const MockNamedValue& a, const MockNamedValue& b)
+            {
+                return a.value_.boolValue_ == b.value_.boolValue_;
+            }
+
+            static bool
+            doubles(const MockNamedValue& a, const MockNamedValue& b)
+            {
+                return doubles_equal(
+                    a.value_.doubleValue_.value, b.value_.doubleValue_.value,
+                    a.value_.doubleValue_.tolerance
+                );
+            }
+
+            static bool
+            strings(const MockNamedValue& a, const MockNamedValue& b)
+            {
+                const char* s1 = a.value_.stringValue_;
+                const char* s2 = b.value_.stringValue_;
+                return SimpleString::StrCmp(s1 ? s1 : "", s2 ? s2 : "") == 0;
+            }
+
+            static bool
+            pointers(const MockNamedValue& a, const MockNamedValue& b)
+            {
+                return a.value_.pointerValue_ == b.value_.pointerValue_;
+            }
+
+            static bool
+            constPointers(const MockNamedValue& a, const MockNamedValue& b)
+            {
+                return a.value_.constPointerValue_ ==
+                       b.value_.constPointerValue_;
+            }
+
+            static bool
+            functionPointers(const MockNamedValue& a, const MockNamedValue& b)
+            {
+                return a.value_.functionPointerValue_ ==
+                       b.value_.functionPointerValue_;
+            }
+
+            static bool
+            memoryBuffers(const MockNamedValue& a, const MockNamedValue& b)
+            {
+                if (a.size_ != b.size_)
                     return false;
-                }
+                if (a.value_.memoryBufferValue_ == b.value_.memoryBufferValue_)
+                    return true;
                 return SimpleString::MemCmp(
-                           value_.memoryBufferValue_,
-                           p.value_.memoryBufferValue_, size_
+                           a.value_.memoryBufferValue_,
+                           b.value_.memoryBufferValue_, a.size_
                        ) == 0;
             }
 
-            if (comparator_)
-                return comparator_->isEqual(
-                    value_.constObjectPointerValue_,
-                    p.value_.constObjectPointerValue_
+            static bool
+            objects(const MockNamedValue& a, const MockNamedValue& b)
+            {
+                if (a.comparator_ == nullptr || a.objectType_ != b.objectType_)
+                    return false;
+                return a.comparator_->isEqual(
+                    a.value_.constObjectPointerValue_,
+                    b.value_.constObjectPointerValue_
                 );
+            }
+        };
 
-            return false;
+        MockNamedValueEquality::MockNamedValueEquality()
+        {
+            for (int i = 0; i < MockNamedValue::VALUE_TYPE_COUNT; i++) {
+                MockNamedValue::ValueType a =
+                    static_cast<MockNamedValue::ValueType>(i);
+                for (int j = 0; j < MockNamedValue::VALUE_TYPE_COUNT; j++) {
+                    MockNamedValue::ValueType b =
+                        static_cast<MockNamedValue::ValueType>(j);
+                    if (isSignedInteger(a) && isSignedInteger(b))
+                        rules[a][b] = signedIntegers;
+                    else if (isUnsignedInteger(a) && isUnsignedInteger(b))
+                        rules[a][b] = unsignedIntegers;
+                    else if (isSignedInteger(a) && isUnsignedInteger(b))
+                        rules[a][b] = signedAndUnsignedIntegers;
+                    else if (isUnsignedInteger(a) && isSignedInteger(b))
+                        rules[a][b] = unsignedAndSignedIntegers;
+                    else
+                        rules[a][b] = differentTypes;
+                }
+            }
+            rules[MockNamedValue::VALUE_BOOL][MockNamedValue::VALUE_BOOL] =
+                bools;
+            rules[MockNamedValue::VALUE_DOUBLE][MockNamedValue::VALUE_DOUBLE] =
+                doubles;
+            rules[MockNamedValue::VALUE_STRING][MockNamedValue::VALUE_STRING] =
+                strings;
+            rules[MockNamedValue::VALUE_POINTER]
+                 [MockNamedValue::VALUE_POINTER] = pointers;
+            rules[MockNamedValue::VALUE_CONST_POINTER]
+                 [MockNamedValue::VALUE_CONST_POINTER] = constPointers;
+            rules[MockNamedValue::VALUE_FUNCTION_POINTER]
+                 [MockNamedValue::VALUE_FUNCTION_POINTER] = functionPointers;
+            rules[MockNamedValue::VALUE_MEMORY_BUFFER]
+                 [MockNamedValue::VALUE_MEMORY_BUFFER] = memoryBuffers;
+            rules[MockNamedValue::VALUE_OBJECT][MockNamedValue::VALUE_OBJECT] =
+                objects;
+        }
+
+        bool
+        MockNamedValueEquality::isSignedInteger(MockNamedValue::ValueType type)
+        {
+            return type == MockNamedValue::VALUE_INT ||
+                   type == MockNamedValue::VALUE_LONG_INT ||
+                   type == MockNamedValue::VALUE_LONG_LONG_INT;
+        }
+
+        bool MockNamedValueEquality::isUnsignedInteger(
+            MockNamedValue::ValueType type
+        )
+        {
+            return type == MockNamedValue::VALUE_UNSIGNED_INT ||
+                   type == MockNamedValue::VALUE_UNSIGNED_LONG_INT ||
+                   type == MockNamedValue::VALUE_UNSIGNED_LONG_LONG_INT;
+        }
+
+        long long MockNamedValueEquality::signedValue(const MockNamedValue& v)
+        {
+            if (v.valueType_ == MockNamedValue::VALUE_INT)
+                return v.value_.intValue_;
+            if (v.valueType_ == MockNamedValue::VALUE_LONG_INT)
+                return v.value_.longIntValue_;
+            return v.value_.longLongIntValue_;
+        }
+
+        unsigned long long
+        MockNamedValueEquality::unsignedValue(const MockNamedValue& v)
+        {
+            if (v.valueType_ == MockNamedValue::VALUE_UNSIGNED_INT)
+                return v.value_.unsignedIntValue_;
+            if (v.valueType_ == MockNamedValue::VALUE_UNSIGNED_LONG_INT)
+                return v.value_.unsignedLongIntValue_;
+            return v.value_.unsignedLongLongIntValue_;
+        }
+
+        static const MockNamedValueEquality equality;
+
+        bool MockNamedValue::equals(const MockNamedValue& p) const
+        {
+            return equality.rules[valueType_][p.valueType_](*this, p);
         }
 
         bool MockNamedValue::compatibleForCopying(const MockNamedValue& p) const
         {
-            if (type_ == p.type_)
-                return true;
+            if (valueType_ != p.valueType_)
+                return (valueType_ == VALUE_CONST_POINTER) &&
+                       (p.valueType_ == VALUE_POINTER);
 
-            if ((type_ == "const void*") && (p.type_ == "void*"))
-                return true;
+            if (valueType_ == VALUE_OBJECT)
+                return objectType_ == p.objectType_;
 
-            return false;
+            return true;
         }
 
         SimpleString MockNamedValue::toString() const
         {
-            if (type_ == "bool")
+            if (valueType_ == VALUE_BOOL)
                 return StringFrom(value_.boolValue_);
-            else if (type_ == "int")
+            else if (valueType_ == VALUE_INT)
                 return StringFrom(value_.intValue_) + " " +
                        BracketsFormattedHexStringFrom(value_.intValue_);
-            else if (type_ == "unsigned int")
+            else if (valueType_ == VALUE_UNSIGNED_INT)
                 return StringFrom(value_.unsignedIntValue_) + " " +
                        BracketsFormattedHexStringFrom(value_.unsignedIntValue_);
-            else if (type_ == "long int")
+            else if (valueType_ == VALUE_LONG_INT)
                 return StringFrom(value_.longIntValue_) + " " +
                        BracketsFormattedHexStringFrom(value_.longIntValue_);
-            else if (type_ == "unsigned long int")
+            else if (valueType_ == VALUE_UNSIGNED_LONG_INT)
                 return StringFrom(value_.unsignedLongIntValue_) + " " +
                        BracketsFormattedHexStringFrom(
                            value_.unsignedLongIntValue_
                        );
-            else if (type_ == "long long int")
+            else if (valueType_ == VALUE_LONG_LONG_INT)
                 return StringFrom(value_.longLongIntValue_) + " " +
                        BracketsFormattedHexStringFrom(value_.longLongIntValue_);
-            else if (type_ == "unsigned long long int")
+            else if (valueType_ == VALUE_UNSIGNED_LONG_LONG_INT)
                 return StringFrom(value_.unsignedLongLongIntValue_) + " " +
                        BracketsFormattedHexStringFrom(
                            value_.unsignedLongLongIntValue_
                        );
-            else if (type_ == "const char*")
+            else if (valueType_ == VALUE_STRING)
                 return value_.stringValue_;
-            else if (type_ == "void*")
+            else if (valueType_ == VALUE_POINTER)
                 return StringFrom(value_.pointerValue_);
-            else if (type_ == "void (*)()")
+            else if (valueType_ == VALUE_FUNCTION_POINTER)
                 return StringFrom(value_.functionPointerValue_);
-            else if (type_ == "const void*")
+            else if (valueType_ == VALUE_CONST_POINTER)
                 return StringFrom(value_.constPointerValue_);
-            else if (type_ == "double")
+            else if (valueType_ == VALUE_DOUBLE)
                 return StringFrom(value_.doubleValue_.value);
-            else if (type_ == "const unsigned char*")
+            else if (valueType_ == VALUE_MEMORY_BUFFER)
                 return StringFromBinaryWithSizeOrNull(
                     value_.memoryBufferValue_, size_
                 );
@@ -566,7 +673,8 @@ namespace cpputest
                 );
 
             return StringFromFormat(
-                "No comparator found for type: \"%s\"", type_.asCharString()
+                "No comparator found for type: \"%s\"",
+                objectType_.asCharString()
             );
         }
 
@@ -593,7 +701,8 @@ namespace cpputest
         MockNamedValueListNode::MockNamedValueListNode(MockNamedValue* newValue
         ) :
             data_(newValue),
-            next_(nullptr)
+            next_(nullptr),
+            bucketNext_(nullptr)
         {
         }
 
@@ -607,7 +716,19 @@ namespace cpputest
             return data_->getType();
         }
 
-        MockNamedValueList::MockNamedValueList() : head_(nullptr) {}
+        MockNamedValueList::MockNamedValueList() :
+            head_(nullptr),
+            tail_(nullptr),
+            buckets_(nullptr),
+            bucketCount_(0),
+            nodeCount_(0)
+        {
+        }
+
+        MockNamedValueList::~MockNamedValueList()
+        {
+            clear();
+        }
 
         void MockNamedValueList::clear()
         {
@@ -617,6 +738,11 @@ namespace cpputest
                 delete head_;
                 head_ = n;
             }
+            tail_ = nullptr;
+            delete[] buckets_;
+            buckets_ = nullptr;
+            bucketCount_ = 0;
+            nodeCount_ = 0;
         }
 
         void MockNamedValueList::add(MockNamedValue* newValue)
@@ -625,19 +751,55 @@ namespace cpputest
                 new MockNamedValueListNode(newValue);
             if (head_ == nullptr)
                 head_ = newNode;
-            else {
-                MockNamedValueListNode* lastNode = head_;
-                while (lastNode->next())
-                    lastNode = lastNode->next();
-                lastNode->setNext(newNode);
+            else
+                tail_->setNext(newNode);
+            tail_ = newNode;
+
+            if (++nodeCount_ > bucketCount_) {
+                rebuildIndex(bucketCount_ ? 2 * bucketCount_ : 16);
+                return;
+            }
+            MockNamedValueListNode** chain =
+                &buckets_[newValue->getNameHash() % bucketCount_];
+            while (*chain)
+                chain = &(*chain)->bucketNext_;
+            *chain = newNode;
+        }
+
+        // Chains keep the insertion order, so the first value added under
+        // a name is found first, as with the plain list.
+        void MockNamedValueList::rebuildIndex(size_t bucketCount)
+        {
+            delete[] buckets_;
+            buckets_ = new MockNamedValueListNode*[bucketCount];
+            bucketCount_ = bucketCount;
+            for (size_t i = 0; i < bucketCount_; i++)
+                buckets_[i] = nullptr;
+
+            MockNamedValueListNode** tails =
+                new MockNamedValueListNode*[bucketCount_];
+            for (MockNamedValueListNode* p = head_; p; p = p->next()) {
+                size_t bucket = p->item()->getNameHash() % bucketCount_;
+                p->bucketNext_ = nullptr;
+                if (buckets_[bucket])
+                    tails[bucket]->bucketNext_ = p;
+                else
+                    buckets_[bucket] = p;
+                tails[bucket] = p;
             }
+            delete[] tails;
         }
 
         MockNamedValue*
         MockNamedValueList::getValueByName(const SimpleString& name)
         {
-            for (MockNamedValueListNode* p = head_; p; p = p->next())
-                if (p->getName() == name)
+            if (bucketCount_ == 0)
+                return nullptr;
+            unsigned long hash = MockNamedValue::hashName(name);
+            for (MockNamedValueListNode* p = buckets_[hash % bucketCount_]; p;
+                 p = p->bucketNext_)
+                if (p->item()->getNameHash() == hash &&
+                    p->item()->hasName(name))
                     return p->item();
             return nullptr;
         }
@@ -647,30 +809,138 @@ namespace cpputest
             return head_;
         }
 
-        struct MockNamedValueComparatorsAndCopiersRepositoryNode
+        MockNameIndexEntry::MockNameIndexEntry(
+            const SimpleString& name, unsigned long hash
+        ) :
+            name_(name),
+            hash_(hash),
+            number_(0),
+            pointer_(nullptr),
+            next_(nullptr),
+            bucketNext_(nullptr)
         {
-            MockNamedValueComparatorsAndCopiersRepositoryNode(
-                const SimpleString& name,
-                MockNamedValueComparator* comparator,
-                MockNamedValueComparatorsAndCopiersRepositoryNode* next
-            ) :
-                name_(name),
-                comparator_(comparator),
-                copier_(nullptr),
-                next_(next)
-            {
+        }
+
+        const SimpleString& MockNameIndexEntry::getName() const
+        {
+            return name_;
+        }
+
+        MockNameIndexEntry* MockNameIndexEntry::next() const
+        {
+            return next_;
+        }
+
+        size_t MockNameIndexEntry::getNumber() const
+        {
+            return number_;
+        }
+
+        void MockNameIndexEntry::setNumber(size_t number)
+        {
+            number_ = number;
+        }
+
+        void* MockNameIndexEntry::getPointer() const
+        {
+            return pointer_;
+        }
+
+        void MockNameIndexEntry::setPointer(void* pointer)
+        {
+            pointer_ = pointer;
+        }
+
+        MockNameIndex::MockNameIndex() :
+            head_(nullptr),
+            tail_(nullptr),
+            buckets_(nullptr),
+            bucketCount_(0),
+            entryCount_(0)
+        {
+        }
+
+        MockNameIndex::~MockNameIndex()
+        {
+            clear();
+        }
+
+        void MockNameIndex::clear()
+        {
+            while (head_) {
+                MockNameIndexEntry* next = head_->next_;
+                delete head_;
+                head_ = next;
             }
-            MockNamedValueComparatorsAndCopiersRepositoryNode(
-                const SimpleString& name,
-                MockNamedValueCopier* copier,
-                MockNamedValueComparatorsAndCopiersRepositoryNode* next
-            ) :
-                name_(name),
-                comparator_(nullptr),
-                copier_(copier),
-                next_(next)
-            {
+            tail_ = nullptr;
+            delete[] buckets_;
+            buckets_ = nullptr;
+            bucketCount_ = 0;
+            entryCount_ = 0;
+        }
+
+        MockNameIndexEntry* MockNameIndex::begin() const
+        {
+            return head_;
+        }
+
+        size_t MockNameIndex::size() const
+        {
+            return entryCount_;
+        }
+
+        MockNameIndexEntry* MockNameIndex::find(const SimpleString& name) const
+        {
+            if (bucketCount_ == 0)
+                return nullptr;
+            unsigned long hash = MockNamedValue::hashName(name);
+            for (MockNameIndexEntry* p = buckets_[hash % bucketCount_]; p;
+                 p = p->bucketNext_)
+                if (p->hash_ == hash && p->name_ == name)
+                    return p;
+            return nullptr;
+        }
+
+        MockNameIndexEntry& MockNameIndex::get(const SimpleString& name)
+        {
+            MockNameIndexEntry* entry = find(name);
+            if (entry)
+                return *entry;
+
+            entry =
+                new MockNameIndexEntry(name, MockNamedValue::hashName(name));
+            if (head_ == nullptr)
+                head_ = entry;
+            else
+                tail_->next_ = entry;
+            tail_ = entry;
+
+            if (++entryCount_ > bucketCount_)
+                rebuildIndex(bucketCount_ ? 2 * bucketCount_ : 16);
+            else {
+                size_t bucket = entry->hash_ % bucketCount_;
+                entry->bucketNext_ = buckets_[bucket];
+                buckets_[bucket] = entry;
+            }
+            return *entry;
+        }
+
+        void MockNameIndex::rebuildIndex(size_t bucketCount)
+        {
+            delete[] buckets_;
+            buckets_ = new MockNameIndexEntry*[bucketCount];
+            bucketCount_ = bucketCount;
+            for (size_t i = 0; i < bucketCount_; i++)
+                buckets_[i] = nullptr;
+            for (MockNameIndexEntry* p = head_; p; p = p->next_) {
+                size_t bucket = p->hash_ % bucketCount_;
+                p->bucketNext_ = buckets_[bucket];
+                buckets_[bucket] = p;
             }
+        }
+
+        struct MockNamedValueComparatorsAndCopiersRepositoryNode
+        {
             MockNamedValueComparatorsAndCopiersRepositoryNode(
                 const SimpleString& name,
                 MockNamedValueComparator* comparator,
@@ -678,20 +948,27 @@ namespace cpputest
                 MockNamedValueComparatorsAndCopiersRepositoryNode* next
             ) :
                 name_(name),
+                hash_(MockNamedValue::hashName(name)),
                 comparator_(comparator),
                 copier_(copier),
-                next_(next)
+                next_(next),
+                bucketNext_(nullptr)
             {
             }
             SimpleString name_;
+            unsigned long hash_;
             MockNamedValueComparator* comparator_;
             MockNamedValueCopier* copier_;
             MockNamedValueComparatorsAndCopiersRepositoryNode* next_;
+            MockNamedValueComparatorsAndCopiersRepositoryNode* bucketNext_;
         };
 
         MockNamedValueComparatorsAndCopiersRepository::
             MockNamedValueComparatorsAndCopiersRepository() :
-            head_(nullptr)
+            head_(nullptr),
+            buckets_(nullptr),
+            bucketCount_(0),
+            nodeCount_(0)
         {
         }
 
@@ -709,24 +986,98 @@ namespace cpputest
                 delete head_;
                 head_ = next;
             }
+            delete[] buckets_;
+            buckets_ = nullptr;
+            bucketCount_ = 0;
+            nodeCount_ = 0;
         }
 
-        void MockNamedValueComparatorsAndCopiersRepository::installComparator(
-            const SimpleString& name, MockNamedValueComparator& comparator
+        void MockNamedValueComparatorsAndCopiersRepository::add(
+            const SimpleString& name,
+            MockNamedValueComparator* comparator,
+            MockNamedValueCopier* copier
         )
         {
             head_ = new MockNamedValueComparatorsAndCopiersRepositoryNode(
-                name, &comparator, head_
+                name, comparator, copier, head_
             );
+            if (++nodeCount_ > bucketCount_) {
+                rebuildIndex(bucketCount_ ? 2 * bucketCount_ : 16);
+                return;
+            }
+            size_t bucket = head_->hash_ % bucketCount_;
+            head_->bucketNext_ = buckets_[bucket];
+            buckets_[bucket] = head_;
+        }
+
+        // Chains keep the list order, so the newest installation of a type
+        // is found first, as with the plain list.
+        void MockNamedValueComparatorsAndCopiersRepository::rebuildIndex(
+            size_t bucketCount
+        )
+        {
+            delete[] buckets_;
+            buckets_ = new MockNamedValueComparatorsAndCopiersRepositoryNode*
+                [bucketCount];
+            bucketCount_ = bucketCount;
+            for (size_t i = 0; i < bucketCount_; i++)
+                buckets_[i] = nullptr;
+
+            MockNamedValueComparatorsAndCopiersRepositoryNode** tails =
+                new MockNamedValueComparatorsAndCopiersRepositoryNode*
+                    [bucketCount_];
+            for (MockNamedValueComparatorsAndCopiersRepositoryNode* p = head_;
+                 p; p = p->next_) {
+                size_t bucket = p->hash_ % bucketCount_;
+                p->bucketNext_ = nullptr;
+                if (buckets_[bucket])
+                    tails[bucket]->bucketNext_ = p;
+                else
+                    buckets_[bucket] = p;
+                tails[bucket] = p;
+            }
+            delete[] tails;
+        }
+
+        MockNamedValueComparatorsAndCopiersRepositoryNode*
+        MockNamedValueComparatorsAndCopiersRepository::findFirst(
+            const SimpleString& name
+        ) const
+        {
+            if (bucketCount_ == 0)
+                return nullptr;
+            unsigned long hash = MockNamedValue::hashName(name);
+            MockNamedValueComparatorsAndCopiersRepositoryNode* p =
+                buckets_[hash % bucketCount_];
+            while (p && (p->hash_ != hash || p->name_ != name))
+                p = p->bucketNext_;
+            return p;
+        }
+
+        MockNamedValueComparatorsAndCopiersRepositoryNode*
+        MockNamedValueComparatorsAndCopiersRepository::findNext(
+            MockNamedValueComparatorsAndCopiersRepositoryNode* node
+        ) const
+        {
+            MockNamedValueComparatorsAndCopiersRepositoryNode* p =
+                node->bucketNext_;
+            while (p && (p->hash_ != node->hash_ || p->name_ != node->name_))
+                p = p->bucketNext_;
+            return p;
+        }
+
+        void MockNamedValueComparatorsAndCopiersRepository::installComparator(
+            const SimpleString& name, MockNamedValueComparator& comparator
+        )
+        {
+            add(name, &comparator, nullptr);
         }
 
         void MockNamedValueComparatorsAndCopiersRepository::installCopier(
             const SimpleString& name, MockNamedValueCopier& copier
         )
         {
-            head_ = new MockNamedValueComparatorsAndCopiersRepositoryNode(
-                name, &copier, head_
-            );
+            add(name, nullptr, &copier);
         }
 
         MockNamedValueComparator*
@@ -734,9 +1085,10 @@ namespace cpputest
             const SimpleString& name
         )
         {
-            for (MockNamedValueComparatorsAndCopiersRepositoryNode* p = head_;
-                 p; p = p->next_)
-                if (p->name_ == name && p->comparator_)
+            for (MockNamedValueComparatorsAndCopiersRepositoryNode* p =
+                     findFirst(name);
+                 p; p = findNext(p))
+                if (p->comparator_)
                     return p->comparator_;
             return nullptr;
         }
@@ -746,9 +1098,10 @@ namespace cpputest
             const SimpleString& name
         )
         {
-            for (MockNamedValueComparatorsAndCopiersRepositoryNode* p = head_;
-                 p; p = p->next_)
-                if (p->name_ == name && p->copier_)
+            for (MockNamedValueComparatorsAndCopiersRepositoryNode* p =
+                     findFirst(name);
+                 p; p = findNext(p))
+                if (p->copier_)
                     return p->copier_;
             return nullptr;
         }
@@ -761,9 +1114,7 @@ namespace cpputest
             for (MockNamedValueComparatorsAndCopiersRepositoryNode* p =
                      repository.head_;
                  p; p = p->next_)
-                head_ = new MockNamedValueComparatorsAndCopiersRepositoryNode(
-                    p->name_, p->comparator_, p->copier_, head_
-                );
+                add(p->name_, p->comparator_, p->copier_);
         }
     }
 }
@@ -0,0 +1,719 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTestExt/MockStub.hpp"
+
+namespace cpputest
+{
+    namespace extensions
+    {
+        struct MockStubEntry : public MockStubBehavior
+        {
+            MockStubEntry(const SimpleString& name, unsigned int index) :
+                parameter_(name),
+                index_(index),
+                next_(nullptr),
+                nextWithSameName_(nullptr)
+            {
+            }
+
+            MockNamedValue parameter_;
+            unsigned int index_;
+            MockStubEntry* next_;
+            MockStubEntry* nextWithSameName_;
+        };
+
+        MockStubBehavior::MockStubBehavior() : returnValue_("") {}
+
+        MockStubBehavior::~MockStubBehavior() {}
+
+        MockStubBehavior& MockStubBehavior::andReturnValue(bool value)
+        {
+            returnValue_.setName("returnValue");
+            returnValue_.setValue(value);
+            return *this;
+        }
+
+        MockStubBehavior& MockStubBehavior::andReturnValue(int value)
+        {
+            returnValue_.setName("returnValue");
+            returnValue_.setValue(value);
+            return *this;
+        }
+
+        MockStubBehavior& MockStubBehavior::andReturnValue(unsigned int value)
+        {
+            returnValue_.setName("returnValue");
+            returnValue_.setValue(value);
+            return *this;
+        }
+
+        MockStubBehavior& MockStubBehavior::andReturnValue(long int value)
+        {
+            returnValue_.setName("returnValue");
+            returnValue_.setValue(value);
+            return *this;
+        }
+
+        MockStubBehavior&
+        MockStubBehavior::andReturnValue(unsigned long int value)
+        {
+            returnValue_.setName("returnValue");
+            returnValue_.setValue(value);
+            return *this;
+        }
+
+        MockStubBehavior& MockStubBehavior::andReturnValue(long long value)
+        {
+            returnValue_.setName("returnValue");
+            returnValue_.setValue(value);
+            return *this;
+        }
+
+        MockStubBehavior&
+        MockStubBehavior::andReturnValue(unsigned long long value)
+        {
+            returnValue_.setName("returnValue");
+            returnValue_.setValue(value);
+            return *this;
+        }
+
+        MockStubBehavior& MockStubBehavior::andReturnValue(double value)
+        {
+            returnValue_.setName("returnValue");
+            returnValue_.setValue(value);
+            return *this;
+        }
+
+        MockStubBehavior& MockStubBehavior::andReturnValue(const char* value)
+        {
+            returnValue_.setName("returnValue");
+            returnValue_.setValue(value);
+            return *this;
+        }
+
+        MockStubBehavior& MockStubBehavior::andReturnValue(void* value)
+        {
+            returnValue_.setName("returnValue");
+            returnValue_.setValue(value);
+            return *this;
+        }
+
+        MockStubBehavior& MockStubBehavior::andReturnValue(const void* value)
+        {
+            returnValue_.setName("returnValue");
+            returnValue_.setValue(value);
+            return *this;
+        }
+
+        MockStubBehavior& MockStubBehavior::andReturnValue(void (*value)())
+        {
+            returnValue_.setName("returnValue");
+            returnValue_.setValue(value);
+            return *this;
+        }
+
+        const MockNamedValue& MockStubBehavior::getReturnValue() const
+        {
+            return returnValue_;
+        }
+
+        MockStub::MockStub(const SimpleString& functionName) :
+            name_(functionName),
+            entries_(nullptr),
+            lastEntry_(nullptr),
+            callback_(nullptr),
+            callCount_(0)
+        {
+        }
+
+        MockStub::~MockStub()
+        {
+            while (entries_) {
+                MockStubEntry* next = entries_->next_;
+                delete entries_;
+                entries_ = next;
+            }
+        }
+
+        MockStubEntry* MockStub::addEntry(const SimpleString& name)
+        {
+            unsigned int index = lastEntry_ ? lastEntry_->index_ + 1 : 0;
+            MockStubEntry* entry = new MockStubEntry(name, index);
+            if (lastEntry_)
+                lastEntry_->next_ = entry;
+            else
+                entries_ = entry;
+            lastEntry_ = entry;
+
+            MockStubEntry* first = firstEntryFor(name);
+            if (first == nullptr) {
+                MockNamedValue* value = new MockNamedValue(name);
+                value->setObjectPointer("MockStubEntry", entry);
+                entriesByName_.add(value);
+                return entry;
+            }
+            while (first->nextWithSameName_)
+                first = first->nextWithSameName_;
+            first->nextWithSameName_ = entry;
+            return entry;
+        }
+
+        MockStubEntry* MockStub::firstEntryFor(const SimpleString& name) const
+        {
+            MockNamedValue* value = entriesByName_.getValueByName(name);
+            if (value == nullptr)
+                return nullptr;
+            return static_cast<MockStubEntry*>(value->getObjectPointer());
+        }
+
+        MockStubBehavior&
+        MockStub::whenParameter(const SimpleString& name, int value)
+        {
+            MockStubEntry* entry = addEntry(name);
+            entry->parameter_.setValue(value);
+            return *entry;
+        }
+
+        MockStubBehavior&
+        MockStub::whenParameter(const SimpleString& name, unsigned int value)
+        {
+            MockStubEntry* entry = addEntry(name);
+            entry->parameter_.setValue(value);
+            return *entry;
+        }
+
+        MockStubBehavior&
+        MockStub::whenParameter(const SimpleString& name, long int value)
+        {
+            MockStubEntry* entry = addEntry(name);
+            entry->parameter_.setValue(value);
+            return *entry;
+        }
+
+        MockStubBehavior& MockStub::whenParameter(
+            const SimpleString& name, unsigned long int value
+        )
+        {
+            MockStubEntry* entry = addEntry(name);
+            entry->parameter_.setValue(value);
+            return *entry;
+        }
+
+        MockStubBehavior&
+        MockStub::whenParameter(const SimpleString& name, long long value)
+        {
+            MockStubEntry* entry = addEntry(name);
+            entry->parameter_.setValue(value);
+            return *entry;
+        }
+
+        MockStubBehavior& MockStub::whenParameter(
+            const SimpleString& name, unsigned long long value
+        )
+        {
+            MockStubEntry* entry = addEntry(name);
+            entry->parameter_.setValue(value);
+            return *entry;
+        }
+
+        MockStubBehavior&
+        MockStub::whenParameter(const SimpleString& name, double value)
+        {
+            MockStubEntry* entry = addEntry(name);
+            entry->parameter_.setValue(value);
+            return *entry;
+        }
+
+        MockStubBehavior&
+        MockStub::whenParameter(const SimpleString& name, const char* value)
+        {
+            MockStubEntry* entry = addEntry(name);
+            entry->parameter_.setValue(value);
+            return *entry;
+        }
+
+        MockStubBehavior&
+        MockStub::whenParameter(const SimpleString& name, const void* value)
+        {
+            MockStubEntry* entry = addEntry(name);
+            entry->parameter_.setValue(value);
+            return *entry;
+        }
+
+        MockStub& MockStub::withCallback(MockStubCallback callback)
+        {
+            callback_ = callback;
+            return *this;
+        }
+
+        const SimpleString& MockStub::getName() const
+        {
+            return name_;
+        }
+
+        unsigned int MockStub::getCallCount() const
+        {
+            return callCount_;
+        }
+
+        bool MockStub::usesParameter(const SimpleString& name) const
+        {
+            return callback_ || firstEntryFor(name);
+        }
+
+        MockStubEntry* MockStub::findEntry(const MockNamedValue& parameter
+        ) const
+        {
+            for (MockStubEntry* entry = firstEntryFor(parameter.getName());
+                 entry; entry = entry->nextWithSameName_)
+                if (entry->parameter_.equals(parameter))
+                    return entry;
+            return nullptr;
+        }
+
+        MockStubActualCall::MockStubActualCall() :
+            stub_(nullptr),
+            entry_(nullptr),
+            callbackValue_("returnValue"),
+            calledBack_(false)
+        {
+        }
+
+        MockStubActualCall::~MockStubActualCall() {}
+
+        MockActualCall& MockStubActualCall::start(MockStub& stub)
+        {
+            end();
+            stub_ = &stub;
+            stub_->callCount_++;
+            return *this;
+        }
+
+        void MockStubActualCall::end()
+        {
+            stub_ = nullptr;
+            entry_ = nullptr;
+            parameters_.clear();
+            callbackValue_ = MockNamedValue("returnValue");
+            calledBack_ = false;
+        }
+
+        bool MockStubActualCall::isActive() const
+        {
+            return stub_ != nullptr;
+        }
+
+        MockActualCall&
+        MockStubActualCall::keepParameter(const MockNamedValue& parameter)
+        {
+            MockStubEntry* entry = stub_->findEntry(parameter);
+            if (entry && (entry_ == nullptr || entry->index_ < entry_->index_))
+                entry_ = entry;
+            if (stub_->callback_)
+                parameters_.add(new MockNamedValue(parameter));
+            return *this;
+        }
+
+        MockActualCall& MockStubActualCall::withName(const SimpleString&)
+        {
+            return *this;
+        }
+
+        MockActualCall& MockStubActualCall::withCallOrder(unsigned int)
+        {
+            return *this;
+        }
+
+        MockActualCall& MockStubActualCall::withBoolParameter(
+            const SimpleString& name, bool value
+        )
+        {
+            if (!stub_->usesParameter(name))
+                return *this;
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return keepParameter(parameter);
+        }
+
+        MockActualCall& MockStubActualCall::withIntParameter(
+            const SimpleString& name, int value
+        )
+        {
+            if (!stub_->usesParameter(name))
+                return *this;
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return keepParameter(parameter);
+        }
+
+        MockActualCall& MockStubActualCall::withUnsignedIntParameter(
+            const SimpleString& name, unsigned int value
+        )
+        {
+            if (!stub_->usesParameter(name))
+                return *this;
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return keepParameter(parameter);
+        }
+
+        MockActualCall& MockStubActualCall::withLongIntParameter(
+            const SimpleString& name, long int value
+        )
+        {
+            if (!stub_->usesParameter(name))
+                return *this;
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return keepParameter(parameter);
+        }
+
+        MockActualCall& MockStubActualCall::withUnsignedLongIntParameter(
+            const SimpleString& name, unsigned long int value
+        )
+        {
+            if (!stub_->usesParameter(name))
+                return *this;
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return keepParameter(parameter);
+        }
+
+        MockActualCall& MockStubActualCall::withLongLongIntParameter(
+            const SimpleString& name, long long value
+        )
+        {
+            if (!stub_->usesParameter(name))
+                return *this;
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return keepParameter(parameter);
+        }
+
+        MockActualCall& MockStubActualCall::withUnsignedLongLongIntParameter(
+            const SimpleString& name, unsigned long long value
+        )
+        {
+            if (!stub_->usesParameter(name))
+                return *this;
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return keepParameter(parameter);
+        }
+
+        MockActualCall& MockStubActualCall::withDoubleParameter(
+            const SimpleString& name, double value
+        )
+        {
+            if (!stub_->usesParameter(name))
+                return *this;
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return keepParameter(parameter);
+        }
+
+        MockActualCall& MockStubActualCall::withStringParameter(
+            const SimpleString& name, const char* value
+        )
+        {
+            if (!stub_->usesParameter(name))
+                return *this;
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return keepParameter(parameter);
+        }
+
+        MockActualCall& MockStubActualCall::withPointerParameter(
+            const SimpleString& name, void* value
+        )
+        {
+            if (!stub_->usesParameter(name))
+                return *this;
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return keepParameter(parameter);
+        }
+
+        MockActualCall& MockStubActualCall::withConstPointerParameter(
+            const SimpleString& name, const void* value
+        )
+        {
+            if (!stub_->usesParameter(name))
+                return *this;
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return keepParameter(parameter);
+        }
+
+        MockActualCall& MockStubActualCall::withFunctionPointerParameter(
+            const SimpleString& name, void (*value)()
+        )
+        {
+            if (!stub_->usesParameter(name))
+                return *this;
+            MockNamedValue parameter(name);
+            parameter.setValue(value);
+            return keepParameter(parameter);
+        }
+
+        MockActualCall& MockStubActualCall::withMemoryBufferParameter(
+            const SimpleString&, const unsigned char*, size_t
+        )
+        {
+            return *this;
+        }
+
+        MockActualCall& MockStubActualCall::withParameterOfType(
+            const SimpleString&, const SimpleString&, const void*
+        )
+        {
+            return *this;
+        }
+
+        MockActualCall&
+        MockStubActualCall::withOutputParameter(const SimpleString&, void*)
+        {
+            return *this;
+        }
+
+        MockActualCall& MockStubActualCall::withOutputParameterOfType(
+            const SimpleString&, const SimpleString&, void*
+        )
+        {
+            return *this;
+        }
+
+        MockActualCall& MockStubActualCall::onObject(const void*)
+        {
+            return *this;
+        }
+
+        bool MockStubActualCall::hasReturnValue()
+        {
+            return !returnValue().getName().isEmpty();
+        }
+
+        MockNamedValue MockStubActualCall::returnValue()
+        {
+            if (stub_ == nullptr)
+                return MockNamedValue("");
+            if (stub_->callback_) {
+                if (!calledBack_) {
+                    calledBack_ = true;
+                    stub_->callback_(parameters_, callbackValue_);
+                }
+                return callbackValue_;
+            }
+            if (entry_)
+                return entry_->getReturnValue();
+            return stub_->getReturnValue();
+        }
+
+        bool
+        MockStubActualCall::returnBoolValueOrDefault(bool default_value)
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnBoolValue();
+        }
+
+        bool MockStubActualCall::returnBoolValue()
+        {
+            return returnValue().getBoolValue();
+        }
+
+        int MockStubActualCall::returnIntValueOrDefault(int default_value)
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnIntValue();
+        }
+
+        int MockStubActualCall::returnIntValue()
+        {
+            return returnValue().getIntValue();
+        }
+
+        unsigned long int MockStubActualCall::returnUnsignedLongIntValue()
+        {
+            return returnValue().getUnsignedLongIntValue();
+        }
+
+        unsigned long int
+        MockStubActualCall::returnUnsignedLongIntValueOrDefault(
+            unsigned long int default_value
+        )
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnUnsignedLongIntValue();
+        }
+
+        long int MockStubActualCall::returnLongIntValue()
+        {
+            return returnValue().getLongIntValue();
+        }
+
+        long int MockStubActualCall::returnLongIntValueOrDefault(
+            long int default_value
+        )
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnLongIntValue();
+        }
+
+        unsigned long long
+        MockStubActualCall::returnUnsignedLongLongIntValue()
+        {
+            return returnValue().getUnsignedLongLongIntValue();
+        }
+
+        unsigned long long
+        MockStubActualCall::returnUnsignedLongLongIntValueOrDefault(
+            unsigned long long default_value
+        )
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnUnsignedLongLongIntValue();
+        }
+
+        long long MockStubActualCall::returnLongLongIntValue()
+        {
+            return returnValue().getLongLongIntValue();
+        }
+
+        long long MockStubActualCall::returnLongLongIntValueOrDefault(
+            long long default_value
+        )
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnLongLongIntValue();
+        }
+
+        unsigned int MockStubActualCall::returnUnsignedIntValue()
+        {
+            return returnValue().getUnsignedIntValue();
+        }
+
+        unsigned int MockStubActualCall::returnUnsignedIntValueOrDefault(
+            unsigned int default_value
+        )
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnUnsignedIntValue();
+        }
+
+        const char* MockStubActualCall::returnStringValueOrDefault(
+            const char* default_value
+        )
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnStringValue();
+        }
+
+        const char* MockStubActualCall::returnStringValue()
+        {
+            return returnValue().getStringValue();
+        }
+
+        double MockStubActualCall::returnDoubleValue()
+        {
+            return returnValue().getDoubleValue();
+        }
+
+        double MockStubActualCall::returnDoubleValueOrDefault(
+            double default_value
+        )
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnDoubleValue();
+        }
+
+        const void* MockStubActualCall::returnConstPointerValue()
+        {
+            return returnValue().getConstPointerValue();
+        }
+
+        const void* MockStubActualCall::returnConstPointerValueOrDefault(
+            const void* default_value
+        )
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnConstPointerValue();
+        }
+
+        void* MockStubActualCall::returnPointerValue()
+        {
+            return returnValue().getPointerValue();
+        }
+
+        void* MockStubActualCall::returnPointerValueOrDefault(
+            void* default_value
+        )
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnPointerValue();
+        }
+
+        MockStubActualCall::FunctionPointerReturnValue
+        MockStubActualCall::returnFunctionPointerValue()
+        {
+            return returnValue().getFunctionPointerValue();
+        }
+
+        MockStubActualCall::FunctionPointerReturnValue
+        MockStubActualCall::returnFunctionPointerValueOrDefault(
+            void (*default_value)()
+        )
+        {
+            if (!hasReturnValue()) {
+                return default_value;
+            }
+            return returnFunctionPointerValue();
+        }
+    }
+}
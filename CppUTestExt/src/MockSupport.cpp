@@ -56,18 +56,29 @@ namespace cpputest
         MockSupport::MockSupport(const SimpleString& mockName) :
             actualCallOrder_(0),
             expectedCallOrder_(0),
+            outOfOrderCalls_(0),
             strictOrdering_(false),
             activeReporter_(nullptr),
             standardReporter_(&defaultReporter_),
+            expectations_(arena_),
             ignoreOtherCalls_(false),
             enabled_(true),
             lastActualFunctionCall_(nullptr),
             mockName_(mockName),
-            tracing_(false)
+            scopeGeneration_(0),
+            tracing_(false),
+            recorder_(nullptr),
+            replay_(nullptr),
+            concurrentCalls_(nullptr),
+            spying_(false)
         {
         }
 
-        MockSupport::~MockSupport() {}
+        MockSupport::~MockSupport()
+        {
+            delete concurrentCalls_;
+            deleteStubs();
+        }
 
         void MockSupport::crashOnFailure(bool shouldCrash)
         {
@@ -95,7 +106,16 @@ namespace cpputest
 
         void MockSupport::setActiveReporter(MockFailureReporter* reporter)
         {
-            activeReporter_ = (reporter) ? reporter : standardReporter_;
+            // Threads call mock() in concurrent mode, and their calls read
+            // the reporter under the lock.
+            MockFailureReporter* active =
+                (reporter) ? reporter : standardReporter_;
+            if (concurrentCalls_)
+                concurrentCalls_->lock();
+            if (activeReporter_ != active)
+                activeReporter_ = active;
+            if (concurrentCalls_)
+                concurrentCalls_->unlock();
         }
 
         void MockSupport::setDefaultComparatorsAndCopiersRepository()
@@ -158,11 +178,26 @@ namespace cpputest
             tracing_ = false;
             MockActualCallTrace::clearInstance();
 
+            delete concurrentCalls_;
+            concurrentCalls_ = nullptr;
+
+            stubCall_.end();
+            deleteStubs();
+
+            spying_ = false;
+            callHistory_.clear();
+
             expectations_.deleteAllExpectationsAndClearList();
+            expectedFunctions_.clear();
+            arena_.release();
+            replayedCalls_.deleteAllExpectationsAndClearList();
+            recorder_ = nullptr;
+            replay_ = nullptr;
             ignoreOtherCalls_ = false;
             enabled_ = true;
             actualCallOrder_ = 0;
             expectedCallOrder_ = 0;
+            outOfOrderCalls_ = 0;
             strictOrdering_ = false;
 
             for (MockNamedValueListNode* p = data_.begin(); p; p = p->next()) {
@@ -173,6 +208,7 @@ namespace cpputest
                 }
             }
             data_.clear();
+            scopeGeneration_++;
         }
 
         void MockSupport::strictOrder()
@@ -206,10 +242,17 @@ namespace cpputest
             if (!enabled_)
                 return MockIgnoredExpectedCall::instance();
 
+            if (concurrentCalls_) {
+                concurrentCalls_->lock();
+                concurrentCalls_->forgetMatchingCall();
+            }
             countCheck();
-
-            MockCheckedExpectedCall* call = new MockCheckedExpectedCall(amount);
-            call->withName(appendScopeToName(functionName));
+            MockCheckedExpectedCall* call =
+                new (arena_) MockCheckedExpectedCall(amount, arena_);
+            const SimpleString scopeFunctionName =
+                appendScopeToName(functionName);
+            call->withName(scopeFunctionName);
+            expectedFunctions_.get(scopeFunctionName);
             if (strictOrdering_) {
                 call->withCallOrder(
                     expectedCallOrder_ + 1, expectedCallOrder_ + amount
@@ -217,34 +260,47 @@ namespace cpputest
                 expectedCallOrder_ += amount;
             }
             expectations_.addExpectedCall(call);
+            if (concurrentCalls_)
+                concurrentCalls_->unlock();
             return *call;
         }
 
         MockCheckedActualCall* MockSupport::createActualCall()
         {
             lastActualFunctionCall_ = new MockCheckedActualCall(
-                ++actualCallOrder_, activeReporter_, expectations_
+                ++actualCallOrder_,
+                activeReporter_,
+                replay_ ? replayedCalls_ : expectations_,
+                &outOfOrderCalls_
             );
+            lastActualFunctionCall_->recordTo(recorder_);
             return lastActualFunctionCall_;
         }
 
         bool MockSupport::callIsIgnored(const SimpleString& functionName)
         {
-            return ignoreOtherCalls_ &&
-                   !expectations_.hasExpectationWithName(functionName);
+            return ignoreOtherCalls_ && !hasExpectationWithName(functionName);
         }
 
-        MockActualCall& MockSupport::actualCall(const SimpleString& functionName
-        )
+        void MockSupport::endLastActualCall()
         {
-            const SimpleString scopeFunctionName =
-                appendScopeToName(functionName);
-
             if (lastActualFunctionCall_) {
                 lastActualFunctionCall_->checkExpectations();
                 delete lastActualFunctionCall_;
                 lastActualFunctionCall_ = nullptr;
             }
+            stubCall_.end();
+        }
+
+        MockActualCall& MockSupport::actualCall(const SimpleString& functionName
+        )
+        {
+            const SimpleString scopeFunctionName =
+                appendScopeToName(functionName);
+
+            // Threads do not share the previous call in concurrent mode.
+            if (concurrentCalls_ == nullptr)
+                endLastActualCall();
 
             if (!enabled_)
                 return MockIgnoredActualCall::instance();
@@ -252,16 +308,109 @@ namespace cpputest
                 return MockActualCallTrace::instance().withName(
                     scopeFunctionName
                 );
+            if (concurrentCalls_)
+                return concurrentActualCall(scopeFunctionName);
+
+            if (spying_) {
+                MockStub* stub = findStub(scopeFunctionName);
+                return spyCall_.start(
+                    callHistory_, scopeFunctionName,
+                    stub ? stubCall_.start(*stub)
+                         : MockIgnoredActualCall::instance()
+                );
+            }
+
+            MockStub* stub = stubbedCall(scopeFunctionName);
+            if (stub)
+                return stubCall_.start(*stub);
 
             if (callIsIgnored(scopeFunctionName)) {
                 return MockIgnoredActualCall::instance();
             }
 
+            if (replay_ && !replayedCalls_.hasUnfulfilledExpectations()) {
+                replayedCalls_.deleteAllExpectationsAndClearList();
+                loadNextReplayedCall();
+            }
+
             MockCheckedActualCall* call = createActualCall();
             call->withName(scopeFunctionName);
             return *call;
         }
 
+        MockStub& MockSupport::stub(const SimpleString& functionName)
+        {
+            const SimpleString scopeFunctionName =
+                appendScopeToName(functionName);
+
+            MockStub* stub = findStub(scopeFunctionName);
+            if (stub)
+                return *stub;
+
+            stub = new MockStub(scopeFunctionName);
+            stubs_.get(scopeFunctionName).setPointer(stub);
+            return *stub;
+        }
+
+        MockStub* MockSupport::findStub(const SimpleString& functionName)
+        {
+            MockNameIndexEntry* entry = stubs_.find(functionName);
+            if (entry == nullptr)
+                return nullptr;
+            return static_cast<MockStub*>(entry->getPointer());
+        }
+
+        MockStub* MockSupport::stubbedCall(const SimpleString& functionName)
+        {
+            MockStub* stub = findStub(functionName);
+            if (stub && hasExpectationWithName(functionName))
+                return nullptr;
+            return stub;
+        }
+
+        bool MockSupport::hasExpectationWithName(const SimpleString& name)
+        {
+            return expectedFunctions_.find(name) != nullptr;
+        }
+
+        void MockSupport::spy(bool enabled)
+        {
+            spying_ = enabled;
+        }
+
+        MockCallHistory& MockSupport::callHistory()
+        {
+            return callHistory_;
+        }
+
+        void MockSupport::deleteStubs()
+        {
+            for (MockNameIndexEntry* p = stubs_.begin(); p; p = p->next())
+                delete static_cast<MockStub*>(p->getPointer());
+            stubs_.clear();
+        }
+
+        // Finishes the previous call of this thread before starting the
+        // next one, so a thread has one call in progress at a time.
+        MockActualCall&
+        MockSupport::concurrentActualCall(const SimpleString& name)
+        {
+            concurrentCalls_->lock();
+            concurrentCalls_->setReporter(activeReporter_);
+            if (callIsIgnored(name)) {
+                concurrentCalls_->unlock();
+                return MockIgnoredActualCall::instance();
+            }
+            MockConcurrentActualCall& call =
+                concurrentCalls_->callOfThisThread();
+            call.finish();
+            unsigned int callOrder = ++actualCallOrder_;
+            concurrentCalls_->unlock();
+
+            call.start(callOrder, name);
+            return call;
+        }
+
         void MockSupport::ignoreOtherCalls()
         {
             ignoreOtherCalls_ = true;
@@ -298,14 +447,61 @@ namespace cpputest
                     getMockSupport(p)->tracing(enabled);
         }
 
+        void MockSupport::concurrent(bool enabled)
+        {
+            if (enabled && concurrentCalls_ == nullptr) {
+                endLastActualCall();
+                concurrentCalls_ =
+                    new MockConcurrentCalls(expectations_, &outOfOrderCalls_);
+            }
+            if (!enabled && concurrentCalls_) {
+                concurrentCalls_->finishAll();
+                delete concurrentCalls_;
+                concurrentCalls_ = nullptr;
+            }
+
+            for (MockNamedValueListNode* p = data_.begin(); p; p = p->next())
+                if (getMockSupport(p))
+                    getMockSupport(p)->concurrent(enabled);
+        }
+
         const char* MockSupport::getTraceOutput()
         {
             return MockActualCallTrace::instance().getTraceOutput();
         }
 
+        void MockSupport::setTraceSink(MockTraceSink* sink)
+        {
+            MockActualCallTrace::setSink(sink);
+        }
+
+        void MockSupport::record(MockCallRecorder* recorder)
+        {
+            recorder_ = recorder;
+        }
+
+        void MockSupport::replay(MockCallReplay* replay)
+        {
+            replayedCalls_.deleteAllExpectationsAndClearList();
+            replay_ = replay;
+        }
+
+        // Only one recorded call is an expectation at a time. Adding the
+        // next one does not delete the previous one, as the last actual
+        // call may still refer to it.
+        void MockSupport::loadNextReplayedCall()
+        {
+            MockCheckedExpectedCall* call = new MockCheckedExpectedCall(1);
+            if (replay_->nextCall(*call))
+                replayedCalls_.addExpectedCall(call);
+            else
+                delete call;
+        }
+
         bool MockSupport::expectedCallsLeft()
         {
             int callsLeft = expectations_.hasUnfulfilledExpectations();
+            callsLeft += replayedCalls_.hasUnfulfilledExpectations();
 
             for (MockNamedValueListNode* p = data_.begin(); p; p = p->next())
                 if (getMockSupport(p))
@@ -332,6 +528,7 @@ namespace cpputest
         {
             MockExpectedCallsList expectationsList;
             expectationsList.addExpectations(expectations_);
+            expectationsList.addExpectations(replayedCalls_);
 
             for (MockNamedValueListNode* p = data_.begin(); p; p = p->next())
                 if (getMockSupport(p))
@@ -387,7 +584,7 @@ namespace cpputest
 
         bool MockSupport::hasCallsOutOfOrder()
         {
-            if (expectations_.hasCallsOutOfOrder()) {
+            if (outOfOrderCalls_ > 0) {
                 return true;
             }
             for (MockNamedValueListNode* p = data_.begin(); p; p = p->next())
@@ -400,8 +597,18 @@ namespace cpputest
 
         void MockSupport::checkExpectations()
         {
+            if (concurrentCalls_) {
+                concurrentCalls_->setReporter(activeReporter_);
+                concurrentCalls_->finishAll();
+                if (concurrentCalls_->reportFailure())
+                    return;
+            }
+
             checkExpectationsOfLastActualCall();
 
+            if (replay_ && !replayedCalls_.hasUnfulfilledExpectations())
+                loadNextReplayedCall();
+
             if (wasLastActualCallFulfilled() && expectedCallsLeft())
                 failTestWithExpectedCallsNotFulfilled();
 
@@ -513,6 +720,7 @@ namespace cpputest
                 newMock->strictOrder();
 
             newMock->tracing(tracing_);
+            newMock->concurrent(concurrentCalls_ != nullptr);
             newMock->installComparatorsAndCopiers(
                 comparatorsAndCopiersRepository_
             );
@@ -524,20 +732,67 @@ namespace cpputest
             SimpleString mockingSupportName = MOCK_SUPPORT_SCOPE_PREFIX;
             mockingSupportName += name;
 
-            if (hasData(mockingSupportName)) {
-                STRCMP_EQUAL(
-                    "MockSupport",
-                    getData(mockingSupportName).getType().asCharString()
-                );
+            // Threads may look up scopes in concurrent mode.
+            if (concurrentCalls_)
+                concurrentCalls_->lock();
+            MockNamedValue* existing = data_.getValueByName(mockingSupportName);
+            MockSupport* newMock = nullptr;
+            if (existing == nullptr) {
+                newMock = clone(name);
+                setDataObject(mockingSupportName, "MockSupport", newMock);
+            }
+            if (concurrentCalls_)
+                concurrentCalls_->unlock();
+
+            if (existing) {
+                STRCMP_EQUAL("MockSupport", existing->getType().asCharString());
                 return reinterpret_cast<MockSupport*>(
-                    getData(mockingSupportName).getObjectPointer()
+                    existing->getObjectPointer()
                 );
             }
+            return newMock;
+        }
 
-            MockSupport* newMock = clone(name);
+        // Whether mock() would leave this mock as it is. Other threads may
+        // change the reporter in concurrent mode, so it is then always set
+        // under the lock.
+        bool MockSupport::isConfiguredForUse() const
+        {
+            return concurrentCalls_ == nullptr &&
+                   activeReporter_ == standardReporter_ &&
+                   MockNamedValue::getDefaultComparatorsAndCopiersRepository(
+                   ) == &comparatorsAndCopiersRepository_;
+        }
 
-            setDataObject(mockingSupportName, "MockSupport", newMock);
-            return newMock;
+        MockScope MockSupport::scope(const SimpleString& name)
+        {
+            return MockScope(*this, name);
+        }
+
+        MockScope::MockScope(MockSupport& owner, const SimpleString& name) :
+            owner_(&owner),
+            name_(name),
+            support_(nullptr),
+            generation_(0)
+        {
+        }
+
+        MockSupport& MockScope::get()
+        {
+            if (support_ == nullptr ||
+                generation_ != owner_->scopeGeneration_) {
+                support_ = owner_->getMockSupportScope(name_);
+                generation_ = owner_->scopeGeneration_;
+            } else if (support_->isConfiguredForUse())
+                return *support_;
+            support_->setActiveReporter(nullptr);
+            support_->setDefaultComparatorsAndCopiersRepository();
+            return *support_;
+        }
+
+        MockSupport* MockScope::operator->()
+        {
+            return &get();
         }
 
         MockSupport* MockSupport::getMockSupport(MockNamedValueListNode* node)
@@ -554,6 +809,8 @@ namespace cpputest
         {
             if (lastActualFunctionCall_)
                 return lastActualFunctionCall_->returnValue();
+            if (stubCall_.isActive())
+                return stubCall_.returnValue();
             return MockNamedValue("");
         }
 
@@ -726,6 +983,8 @@ namespace cpputest
         {
             if (lastActualFunctionCall_)
                 return lastActualFunctionCall_->hasReturnValue();
+            if (stubCall_.isActive())
+                return stubCall_.hasReturnValue();
             return false;
         }
     }
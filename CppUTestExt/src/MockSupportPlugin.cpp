@@ -26,6 +26,7 @@
  */
 
 #include "CppUTestExt/MockSupportPlugin.hpp"
+#include "CppUTestExt/MockFunction.hpp"
 #include "CppUTestExt/MockSupport.hpp"
 
 namespace cpputest
@@ -80,11 +81,17 @@ namespace cpputest
         {
             MockSupportPluginReporter reporter(test, result);
             mock().setMockFailureStandardReporter(&reporter);
-            if (!test.hasFailed())
+            MockFunctionBase::setMockFailureStandardReporter(&reporter);
+            if (!test.hasFailed()) {
                 mock().checkExpectations();
+                MockFunctionBase::checkAllExpectations();
+            }
             mock().clear();
+            MockFunctionBase::clearAll();
             mock().setMockFailureStandardReporter(nullptr);
+            MockFunctionBase::setMockFailureStandardReporter(nullptr);
             mock().removeAllComparatorsAndCopiers();
+            MockFailure::reportAllExpectations(false);
         }
 
         void MockSupportPlugin::installComparator(
@@ -74,9 +74,10 @@ public:
     } // LCOV_EXCL_LINE
 };
 
-static MockSupport* currentMockSupport = nullptr;
-static MockExpectedCall* expectedCall = nullptr;
-static MockActualCall* actualCall = nullptr;
+// Per thread, so call chains from several threads do not mix.
+static CPPUTEST_THREAD_LOCAL MockSupport* currentMockSupport = nullptr;
+static CPPUTEST_THREAD_LOCAL MockExpectedCall* expectedCall = nullptr;
+static CPPUTEST_THREAD_LOCAL MockActualCall* actualCall = nullptr;
 static MockFailureReporterForInCOnlyCode failureReporterForC;
 
 class MockCFunctionComparatorNode : public MockNamedValueComparator
@@ -646,57 +647,47 @@ MockExpectedCall_c* andReturnFunctionPointerValue_c(void (*value)())
 static MockValue_c getMockValueCFromNamedValue(const MockNamedValue& namedValue)
 {
     MockValue_c returnValue;
-    if (cpputest::SimpleString::StrCmp(
-            namedValue.getType().asCharString(), "bool"
-        ) == 0) {
+    MockNamedValue::ValueType type = namedValue.getValueType();
+    if (type == MockNamedValue::VALUE_BOOL) {
         returnValue.type = MOCKVALUETYPE_BOOL;
         returnValue.value.boolValue = namedValue.getBoolValue() ? 1 : 0;
-    } else if (cpputest::SimpleString::StrCmp(namedValue.getType().asCharString(), "int") == 0) {
+    } else if (type == MockNamedValue::VALUE_INT) {
         returnValue.type = MOCKVALUETYPE_INTEGER;
         returnValue.value.intValue = namedValue.getIntValue();
-    }
-            else if (cpputest::SimpleString::StrCmp(namedValue.getType().asCharString(), "unsigned int") == 0) {
+    } else if (type == MockNamedValue::VALUE_UNSIGNED_INT) {
         returnValue.type = MOCKVALUETYPE_UNSIGNED_INTEGER;
         returnValue.value.unsignedIntValue = namedValue.getUnsignedIntValue();
-    }
-            else if (cpputest::SimpleString::StrCmp(namedValue.getType().asCharString(), "long int") == 0) {
+    } else if (type == MockNamedValue::VALUE_LONG_INT) {
         returnValue.type = MOCKVALUETYPE_LONG_INTEGER;
         returnValue.value.longIntValue = namedValue.getLongIntValue();
-    }
-            else if (cpputest::SimpleString::StrCmp(namedValue.getType().asCharString(), "unsigned long int") == 0) {
+    } else if (type == MockNamedValue::VALUE_UNSIGNED_LONG_INT) {
         returnValue.type = MOCKVALUETYPE_UNSIGNED_LONG_INTEGER;
         returnValue.value.unsignedLongIntValue =
             namedValue.getUnsignedLongIntValue();
-    }
-            else if (cpputest::SimpleString::StrCmp(namedValue.getType().asCharString(), "long long int") == 0) {
+    } else if (type == MockNamedValue::VALUE_LONG_LONG_INT) {
         returnValue.type = MOCKVALUETYPE_LONG_LONG_INTEGER;
         returnValue.value.longLongIntValue = namedValue.getLongLongIntValue();
-    }
-            else if (cpputest::SimpleString::StrCmp(namedValue.getType().asCharString(), "unsigned long long int") == 0) {
+    } else if (type == MockNamedValue::VALUE_UNSIGNED_LONG_LONG_INT) {
         returnValue.type = MOCKVALUETYPE_UNSIGNED_LONG_LONG_INTEGER;
         returnValue.value.unsignedLongLongIntValue =
             namedValue.getUnsignedLongLongIntValue();
-    } else if (cpputest::SimpleString::StrCmp(namedValue.getType().asCharString(), "double") == 0) {
+    } else if (type == MockNamedValue::VALUE_DOUBLE) {
         returnValue.type = MOCKVALUETYPE_DOUBLE;
         returnValue.value.doubleValue = namedValue.getDoubleValue();
-    }
-            else if (cpputest::SimpleString::StrCmp(namedValue.getType().asCharString(), "const char*") == 0) {
+    } else if (type == MockNamedValue::VALUE_STRING) {
         returnValue.type = MOCKVALUETYPE_STRING;
         returnValue.value.stringValue = namedValue.getStringValue();
-    } else if (cpputest::SimpleString::StrCmp(namedValue.getType().asCharString(), "void*") == 0) {
+    } else if (type == MockNamedValue::VALUE_POINTER) {
         returnValue.type = MOCKVALUETYPE_POINTER;
         returnValue.value.pointerValue = namedValue.getPointerValue();
-    }
-            else if (cpputest::SimpleString::StrCmp(namedValue.getType().asCharString(), "const void*") == 0) {
+    } else if (type == MockNamedValue::VALUE_CONST_POINTER) {
         returnValue.type = MOCKVALUETYPE_CONST_POINTER;
         returnValue.value.constPointerValue = namedValue.getConstPointerValue();
-    }
-            else if (cpputest::SimpleString::StrCmp(namedValue.getType().asCharString(), "void (*)()") == 0) {
+    } else if (type == MockNamedValue::VALUE_FUNCTION_POINTER) {
         returnValue.type = MOCKVALUETYPE_FUNCTIONPOINTER;
         returnValue.value.functionPointerValue =
             reinterpret_cast<void (*)()>(namedValue.getFunctionPointerValue());
-    }
-            else if (cpputest::SimpleString::StrCmp(namedValue.getType().asCharString(), "const unsigned char*") == 0) {
+    } else if (type == MockNamedValue::VALUE_MEMORY_BUFFER) {
         returnValue.type = MOCKVALUETYPE_MEMORYBUFFER;
         returnValue.value.memoryBufferValue = namedValue.getMemoryBuffer();
     } else {
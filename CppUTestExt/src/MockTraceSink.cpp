@@ -0,0 +1,511 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTestExt/MockTraceSink.hpp"
+#include "CppUTest/PlatformSpecificFunctions.h"
+#include "CppUTestExt/MockNamedValue.hpp"
+
+namespace cpputest
+{
+    namespace extensions
+    {
+        static const size_t traceFileFlushThreshold = 64 * 1024;
+        static const size_t traceMagicSize = 8;
+        static const unsigned char traceVersion = 1;
+        static const unsigned char traceMagic[traceMagicSize] = {
+            'M', 'o', 'c', 'k', 'T', 'r', 'c', traceVersion
+        };
+
+        enum MockTraceRecordKind
+        {
+            record_name = 1,
+            record_call = 2,
+            record_detail = 3
+        };
+
+        struct MockTraceBuffer
+        {
+            MockTraceBuffer() : data_(nullptr), size_(0), capacity_(0) {}
+            ~MockTraceBuffer()
+            {
+                delete[] data_;
+            }
+
+            void append(const void* bytes, size_t length)
+            {
+                reserve(size_ + length + 1);
+                const char* source = static_cast<const char*>(bytes);
+                for (size_t i = 0; i < length; i++)
+                    data_[size_ + i] = source[i];
+                size_ += length;
+                data_[size_] = '\0';
+            }
+
+            void append(const SimpleString& text)
+            {
+                append(text.asCharString(), text.size());
+            }
+
+            void appendByte(unsigned char byte)
+            {
+                append(&byte, 1);
+            }
+
+            void appendNumber(size_t number)
+            {
+                while (number >= 0x80) {
+                    appendByte(
+                        static_cast<unsigned char>((number & 0x7f) | 0x80)
+                    );
+                    number >>= 7;
+                }
+                appendByte(static_cast<unsigned char>(number));
+            }
+
+            const char* text() const
+            {
+                return data_ ? data_ : "";
+            }
+
+            size_t size() const
+            {
+                return size_;
+            }
+
+            void clear()
+            {
+                size_ = 0;
+                if (data_)
+                    data_[0] = '\0';
+            }
+
+        private:
+            char* data_;
+            size_t size_;
+            size_t capacity_;
+
+            void reserve(size_t capacity)
+            {
+                if (capacity <= capacity_)
+                    return;
+                size_t newCapacity = (capacity_ == 0) ? 256 : capacity_;
+                while (newCapacity < capacity)
+                    newCapacity *= 2;
+
+                char* newData = new char[newCapacity];
+                for (size_t i = 0; i < size_; i++)
+                    newData[i] = data_[i];
+                delete[] data_;
+                data_ = newData;
+                capacity_ = newCapacity;
+            }
+
+            MockTraceBuffer(const MockTraceBuffer&);
+            MockTraceBuffer& operator=(const MockTraceBuffer&);
+        };
+
+        static void appendCallText(
+            MockTraceBuffer& buffer, const SimpleString& functionName
+        )
+        {
+            buffer.append("\nFunction name:", 15);
+            buffer.append(functionName);
+        }
+
+        static void appendDetailText(
+            MockTraceBuffer& buffer,
+            const SimpleString& label,
+            const SimpleString& value
+        )
+        {
+            buffer.appendByte(' ');
+            buffer.append(label);
+            buffer.appendByte(':');
+            buffer.append(value);
+        }
+
+        const char* MockTraceSink::getTraceOutput()
+        {
+            return "";
+        }
+
+        MockTraceBufferSink::MockTraceBufferSink() :
+            buffer_(new MockTraceBuffer)
+        {
+        }
+
+        MockTraceBufferSink::~MockTraceBufferSink()
+        {
+            delete buffer_;
+        }
+
+        void MockTraceBufferSink::callStarted(const SimpleString& functionName)
+        {
+            appendCallText(*buffer_, functionName);
+        }
+
+        void MockTraceBufferSink::callDetail(
+            const SimpleString& label, const SimpleString& value
+        )
+        {
+            appendDetailText(*buffer_, label, value);
+        }
+
+        const char* MockTraceBufferSink::getTraceOutput()
+        {
+            return buffer_->text();
+        }
+
+        void MockTraceBufferSink::clear()
+        {
+            buffer_->clear();
+        }
+
+        MockTraceRingSink::MockTraceRingSink(size_t calls) :
+            calls_(new SimpleString[calls ? calls : 1]),
+            capacity_(calls ? calls : 1),
+            count_(0),
+            current_(0)
+        {
+        }
+
+        MockTraceRingSink::~MockTraceRingSink()
+        {
+            delete[] calls_;
+        }
+
+        void MockTraceRingSink::callStarted(const SimpleString& functionName)
+        {
+            if (count_ > 0)
+                current_ = (current_ + 1) % capacity_;
+            if (count_ < capacity_)
+                count_++;
+            calls_[current_] = "\nFunction name:";
+            calls_[current_] += functionName;
+        }
+
+        void MockTraceRingSink::callDetail(
+            const SimpleString& label, const SimpleString& value
+        )
+        {
+            if (count_ == 0)
+                return;
+            calls_[current_] += " ";
+            calls_[current_] += label;
+            calls_[current_] += ":";
+            calls_[current_] += value;
+        }
+
+        const char* MockTraceRingSink::getTraceOutput()
+        {
+            output_ = "";
+            size_t oldest = (current_ + capacity_ + 1 - count_) % capacity_;
+            for (size_t i = 0; i < count_; i++)
+                output_ += calls_[(oldest + i) % capacity_];
+            return output_.asCharString();
+        }
+
+        void MockTraceRingSink::clear()
+        {
+            count_ = 0;
+            current_ = 0;
+        }
+
+        struct MockTraceFileSinkImpl
+        {
+            MockTraceFileSinkImpl(
+                const SimpleString& fileName,
+                MockTraceFileSink::Encoding encoding
+            ) :
+                fileName_(fileName),
+                encoding_(encoding),
+                file_(nullptr),
+                opened_(false)
+            {
+            }
+
+            SimpleString fileName_;
+            MockTraceFileSink::Encoding encoding_;
+            PlatformSpecificFile file_;
+            bool opened_;
+            MockTraceBuffer buffer_;
+            MockNameIndex names_;
+        };
+
+        MockTraceFileSink::MockTraceFileSink(
+            const SimpleString& fileName, Encoding encoding
+        ) :
+            impl_(new MockTraceFileSinkImpl(fileName, encoding))
+        {
+            if (encoding == BINARY_ENCODING)
+                impl_->buffer_.append(traceMagic, traceMagicSize);
+        }
+
+        MockTraceFileSink::~MockTraceFileSink()
+        {
+            flush();
+            if (impl_->file_ != nullptr)
+                closeFile();
+            delete impl_;
+        }
+
+        void MockTraceFileSink::writeString(const SimpleString& text)
+        {
+            impl_->buffer_.appendNumber(text.size());
+            impl_->buffer_.append(text);
+        }
+
+        // Writes a name record the first time a name is seen.
+        size_t MockTraceFileSink::nameIndex(const SimpleString& name)
+        {
+            size_t known = impl_->names_.size();
+            MockNameIndexEntry& index = impl_->names_.get(name);
+            if (impl_->names_.size() != known) {
+                index.setNumber(known);
+                impl_->buffer_.appendByte(record_name);
+                writeString(name);
+            }
+            return index.getNumber();
+        }
+
+        void MockTraceFileSink::bufferWritten()
+        {
+            if (impl_->buffer_.size() >= traceFileFlushThreshold)
+                flush();
+        }
+
+        void MockTraceFileSink::callStarted(const SimpleString& functionName)
+        {
+            if (impl_->encoding_ == TEXT_ENCODING)
+                appendCallText(impl_->buffer_, functionName);
+            else {
+                size_t index = nameIndex(functionName);
+                impl_->buffer_.appendByte(record_call);
+                impl_->buffer_.appendNumber(index);
+            }
+            bufferWritten();
+        }
+
+        void MockTraceFileSink::callDetail(
+            const SimpleString& label, const SimpleString& value
+        )
+        {
+            if (impl_->encoding_ == TEXT_ENCODING)
+                appendDetailText(impl_->buffer_, label, value);
+            else {
+                size_t index = nameIndex(label);
+                impl_->buffer_.appendByte(record_detail);
+                impl_->buffer_.appendNumber(index);
+                writeString(value);
+            }
+            bufferWritten();
+        }
+
+        void MockTraceFileSink::flush()
+        {
+            if (impl_->buffer_.size() == 0)
+                return;
+            writeToFile(impl_->buffer_.text(), impl_->buffer_.size());
+            impl_->buffer_.clear();
+        }
+
+        void MockTraceFileSink::openFile()
+        {
+            impl_->file_ =
+                PlatformSpecificFOpen(impl_->fileName_.asCharString(), "wb");
+        }
+
+        void MockTraceFileSink::writeToFile(const void* data, size_t size)
+        {
+            if (!impl_->opened_) {
+                impl_->opened_ = true;
+                openFile();
+            }
+            if (impl_->file_ == nullptr)
+                return;
+            PlatformSpecificFWrite(data, size, impl_->file_);
+            PlatformSpecificFFlush(impl_->file_);
+        }
+
+        void MockTraceFileSink::closeFile()
+        {
+            PlatformSpecificFClose(impl_->file_);
+            impl_->file_ = nullptr;
+        }
+
+        class MockTraceReader
+        {
+        public:
+            MockTraceReader(const void* data, size_t size) :
+                data_(static_cast<const unsigned char*>(data)),
+                size_(size),
+                position_(0),
+                names_(nullptr),
+                nameCount_(0),
+                nameCapacity_(0)
+            {
+            }
+
+            ~MockTraceReader()
+            {
+                delete[] names_;
+            }
+
+            bool atEnd() const
+            {
+                return position_ == size_;
+            }
+
+            bool readByte(unsigned char& byte)
+            {
+                if (position_ == size_)
+                    return false;
+                byte = data_[position_++];
+                return true;
+            }
+
+            bool readNumber(size_t& number)
+            {
+                number = 0;
+                unsigned char byte = 0x80;
+                for (unsigned shift = 0; byte & 0x80; shift += 7) {
+                    if (shift >= 8 * sizeof(size_t) || !readByte(byte))
+                        return false;
+                    number |= static_cast<size_t>(byte & 0x7f) << shift;
+                }
+                return true;
+            }
+
+            bool readString(SimpleString& text)
+            {
+                size_t length;
+                if (!readNumber(length) || length > size_ - position_)
+                    return false;
+                char* characters = new char[length + 1];
+                for (size_t i = 0; i < length; i++)
+                    characters[i] = static_cast<char>(data_[position_ + i]);
+                characters[length] = '\0';
+                position_ += length;
+                text = characters;
+                delete[] characters;
+                return true;
+            }
+
+            bool readName(SimpleString& name)
+            {
+                size_t index;
+                if (!readNumber(index) || index >= nameCount_)
+                    return false;
+                name = names_[index];
+                return true;
+            }
+
+            void addName(const SimpleString& name)
+            {
+                if (nameCount_ == nameCapacity_) {
+                    nameCapacity_ = nameCapacity_ ? 2 * nameCapacity_ : 16;
+                    SimpleString* names = new SimpleString[nameCapacity_];
+                    for (size_t i = 0; i < nameCount_; i++)
+                        names[i] = names_[i];
+                    delete[] names_;
+                    names_ = names;
+                }
+                names_[nameCount_++] = name;
+            }
+
+        private:
+            const unsigned char* data_;
+            size_t size_;
+            size_t position_;
+            SimpleString* names_;
+            size_t nameCount_;
+            size_t nameCapacity_;
+
+            MockTraceReader(const MockTraceReader&);
+            MockTraceReader& operator=(const MockTraceReader&);
+        };
+
+        bool MockTraceFileSink::decode(
+            const void* data, size_t size, MockTraceSink& sink
+        )
+        {
+            const unsigned char* magic =
+                static_cast<const unsigned char*>(data);
+            if (size < traceMagicSize)
+                return false;
+            for (size_t i = 0; i < traceMagicSize; i++)
+                if (magic[i] != traceMagic[i])
+                    return false;
+
+            MockTraceReader reader(
+                magic + traceMagicSize, size - traceMagicSize
+            );
+            while (!reader.atEnd()) {
+                unsigned char kind = 0;
+                SimpleString name;
+                SimpleString value;
+                reader.readByte(kind);
+                if (kind == record_name) {
+                    if (!reader.readString(name))
+                        return false;
+                    reader.addName(name);
+                } else if (kind == record_call) {
+                    if (!reader.readName(name))
+                        return false;
+                    sink.callStarted(name);
+                } else if (kind == record_detail) {
+                    if (!reader.readName(name) || !reader.readString(value))
+                        return false;
+                    sink.callDetail(name, value);
+                } else
+                    return false;
+            }
+            return true;
+        }
+
+        bool MockTraceFileSink::decodeFile(
+            const SimpleString& fileName, MockTraceSink& sink
+        )
+        {
+            PlatformSpecificFile file =
+                PlatformSpecificFOpen(fileName.asCharString(), "rb");
+            if (file == nullptr)
+                return false;
+
+            MockTraceBuffer contents;
+            char chunk[4096];
+            size_t read = PlatformSpecificFRead(chunk, sizeof(chunk), file);
+            while (read > 0) {
+                contents.append(chunk, read);
+                read = PlatformSpecificFRead(chunk, sizeof(chunk), file);
+            }
+            PlatformSpecificFClose(file);
+
+            return decode(contents.text(), contents.size(), sink);
+        }
+    }
+}
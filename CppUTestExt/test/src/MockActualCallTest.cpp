@@ -129,6 +129,27 @@ TEST(
     CHECK_EXPECTED_MOCK_FAILURE(expectedFailure);
 }
 
+TEST(MockCheckedActualCall, countsExpectationsThatGoOutOfOrder)
+{
+    unsigned int outOfOrderCalls = 0;
+    cpputest::extensions::MockCheckedExpectedCall call1(2);
+    call1.withName("func").withCallOrder(2, 3);
+    list->addExpectedCall(&call1);
+
+    cpputest::extensions::MockCheckedActualCall actualCall1(
+        1, reporter, *list, &outOfOrderCalls
+    );
+    actualCall1.withName("func");
+    actualCall1.checkExpectations();
+    cpputest::extensions::MockCheckedActualCall actualCall2(
+        4, reporter, *list, &outOfOrderCalls
+    );
+    actualCall2.withName("func");
+    actualCall2.checkExpectations();
+
+    LONGS_EQUAL(1, outOfOrderCalls);
+}
+
 TEST(MockCheckedActualCall, unExpectedParameterName)
 {
     cpputest::extensions::MockCheckedExpectedCall call1;
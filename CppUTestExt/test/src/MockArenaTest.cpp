@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTestExt/MockArena.hpp"
+#include "CppUTestExt/MockSupport.hpp"
+#include "CppUTest/TestHarness.hpp"
+
+using cpputest::extensions::mock;
+using cpputest::extensions::MockArena;
+
+TEST_GROUP(MockArena)
+{
+    MockArena arena;
+};
+
+TEST(MockArena, startsWithoutBlocks)
+{
+    LONGS_EQUAL(0, arena.blockCount());
+}
+
+TEST(MockArena, smallAllocationsShareOneBlock)
+{
+    char* first = static_cast<char*>(arena.allocate(1));
+    char* second = static_cast<char*>(arena.allocate(24));
+
+    LONGS_EQUAL(1, arena.blockCount());
+    LONGS_EQUAL(0, static_cast<size_t>(second - first) % (2 * sizeof(void*)));
+    CHECK(second > first);
+}
+
+TEST(MockArena, allocationsAreAligned)
+{
+    arena.allocate(3);
+    void* memory = arena.allocate(5);
+
+    LONGS_EQUAL(0, reinterpret_cast<size_t>(memory) % (2 * sizeof(void*)));
+}
+
+TEST(MockArena, largeAllocationGetsItsOwnBlock)
+{
+    arena.allocate(MockArena::blockSize * 2);
+
+    LONGS_EQUAL(1, arena.blockCount());
+    arena.allocate(8);
+    LONGS_EQUAL(2, arena.blockCount());
+}
+
+TEST(MockArena, fullBlockStartsANewOne)
+{
+    arena.allocate(MockArena::blockSize);
+    arena.allocate(8);
+
+    LONGS_EQUAL(2, arena.blockCount());
+}
+
+TEST(MockArena, releaseFreesAllBlocks)
+{
+    arena.allocate(MockArena::blockSize);
+    arena.allocate(8);
+    arena.release();
+
+    LONGS_EQUAL(0, arena.blockCount());
+}
+
+TEST(MockArena, placementNewConstructsInTheArena)
+{
+    int* value = new (arena) int(42);
+
+    LONGS_EQUAL(42, *value);
+    LONGS_EQUAL(1, arena.blockCount());
+}
+
+TEST(MockArena, clearingManyExpectationsReleasesTheArena)
+{
+    for (int i = 0; i < 500; i++)
+        mock().expectOneCall("foo").withParameter("value", i);
+    for (int i = 0; i < 500; i++)
+        mock().actualCall("foo").withParameter("value", i);
+
+    mock().checkExpectations();
+    CHECK_FALSE(mock().expectedCallsLeft());
+    mock().clear();
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTestExt/MockCallHistory.hpp"
+#include "CppUTest/TestHarness.hpp"
+#include "CppUTestExt/MockSupport.hpp"
+#include "MockFailureReporterForTest.hpp"
+
+using cpputest::extensions::mock;
+using cpputest::extensions::MockCallHistory;
+using cpputest::extensions::MockSpiedCall;
+
+TEST_GROUP(MockCallHistory)
+{
+    void setup() override
+    {
+        mock().spy(true);
+    }
+
+    void teardown() override
+    {
+        mock().clear();
+    }
+};
+
+static bool isLongPacket(const MockSpiedCall& call)
+{
+    return call.getParameter("len").getUnsignedIntValue() > 1500;
+}
+
+TEST(MockCallHistory, spiedCallsAreNotMatched)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+
+    mock().actualCall("send").withParameter("len", 10u);
+    mock().checkExpectations();
+
+    CHECK_NO_MOCK_FAILURE();
+    LONGS_EQUAL(1, mock().callHistory().size());
+}
+
+TEST(MockCallHistory, callsAreCountedPerFunction)
+{
+    mock().actualCall("send").withParameter("len", 1000u);
+    mock().actualCall("recv");
+    mock().actualCall("send").withParameter("len", 2000u);
+    mock().actualCall("send").withParameter("len", 1600u);
+
+    CHECK_CALL_COUNT(3, mock().callHistory(), "send");
+    CHECK_CALL_COUNT(1, mock().callHistory(), "recv");
+    CHECK_CALL_COUNT(0, mock().callHistory(), "close");
+    CHECK_MATCHING_CALL_COUNT(2, mock().callHistory(), "send", isLongPacket);
+}
+
+TEST(MockCallHistory, callCountsTakeFunctionNamesThatAreNotLiterals)
+{
+    for (int i = 0; i < 40; i++)
+        mock().actualCall(cpputest::StringFromFormat("irq%d", i % 20));
+
+    for (int i = 0; i < 20; i++) {
+        cpputest::SimpleString function =
+            cpputest::StringFromFormat("irq%d", i);
+        CHECK_CALL_COUNT(2, mock().callHistory(), function);
+    }
+    CHECK_MATCHING_CALL_COUNT(
+        0, mock().callHistory(), cpputest::SimpleString("irq3"), isLongPacket
+    );
+}
+
+TEST(MockCallHistory, callsKeepTheirOrderAndParameters)
+{
+    char buffer[] = "abc";
+    mock().actualCall("open").withParameter("path", buffer);
+    buffer[0] = 'x';
+    mock()
+        .actualCall("write")
+        .withParameter("fd", 3)
+        .withParameter("data", reinterpret_cast<const unsigned char*>("12"), 2)
+        .withParameter("flush", true);
+
+    MockCallHistory& history = mock().callHistory();
+    MockSpiedCall write = history.getCall("write", 0);
+    STRCMP_EQUAL("open", history.getCall(0).getName().asCharString());
+    STRCMP_EQUAL(
+        "abc", history.getCall(0).getParameter("path").getStringValue()
+    );
+    LONGS_EQUAL(1, write.getSequenceNumber());
+    LONGS_EQUAL(3, write.getParameterCount());
+    LONGS_EQUAL(3, write.getParameter("fd").getIntValue());
+    LONGS_EQUAL(2, write.getParameter("data").getSize());
+    CHECK(write.getParameter(2).getBoolValue());
+    CHECK_FALSE(write.hasParameter("path"));
+    CHECK_FALSE(history.getCall("write", 1).isValid());
+}
+
+TEST(MockCallHistory, spiedCallsGetTheAnswerOfTheirStub)
+{
+    mock().stub("read").andReturnValue(5);
+
+    LONGS_EQUAL(5, mock().actualCall("read").returnIntValue());
+    LONGS_EQUAL(1, mock().callHistory().countCalls("read"));
+}
+
+TEST(MockCallHistory, longHistoriesSpanSeveralChunks)
+{
+    for (unsigned int i = 0; i < 2000; i++)
+        mock().actualCall("sample").withParameter("value", i);
+
+    MockCallHistory& history = mock().callHistory();
+    LONGS_EQUAL(2000, history.countCalls("sample"));
+    LONGS_EQUAL(
+        1234, history.getCall(1234).getParameter("value").getUnsignedIntValue()
+    );
+}
+
+TEST(MockCallHistory, historyIsKeptUntilClear)
+{
+    mock().actualCall("foo");
+    mock().spy(false);
+
+    LONGS_EQUAL(1, mock().callHistory().size());
+    mock().clear();
+    LONGS_EQUAL(0, mock().callHistory().size());
+}
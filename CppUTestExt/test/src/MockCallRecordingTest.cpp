@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTestExt/MockCallRecording.hpp"
+#include "CppUTest/TestHarness.hpp"
+#include "CppUTestExt/MockCheckedExpectedCall.hpp"
+#include "CppUTestExt/MockSupport.hpp"
+#include "MockFailureReporterForTest.hpp"
+
+using cpputest::extensions::mock;
+using cpputest::extensions::MockCallRecorder;
+using cpputest::extensions::MockCallReplay;
+using cpputest::extensions::MockCheckedExpectedCall;
+
+class MockCallRecorderForTest : public MockCallRecorder
+{
+public:
+    MockCallRecorderForTest() : MockCallRecorder("recording"), size(0) {}
+
+    virtual ~MockCallRecorderForTest() override
+    {
+        flush();
+    }
+
+    unsigned char written[1024];
+    size_t size;
+
+protected:
+    virtual void writeToFile(const void* data, size_t length) override
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < length && size < sizeof(written); i++)
+            written[size++] = bytes[i];
+    }
+};
+
+class MockCallReplayForTest : public MockCallReplay
+{
+public:
+    MockCallReplayForTest(const unsigned char* data, size_t size) :
+        MockCallReplay("recording"),
+        reads(0),
+        data_(data),
+        size_(size)
+    {
+    }
+
+    virtual ~MockCallReplayForTest() override {}
+
+    size_t reads;
+
+protected:
+    virtual void openFile() override {}
+    virtual void closeFile() override {}
+
+    // Hands the data out in small chunks to exercise the refilling.
+    virtual size_t readFromFile(void* data, size_t size) override
+    {
+        unsigned char* bytes = static_cast<unsigned char*>(data);
+        size_t read = 0;
+        while (read < size && read < 7 && size_ > 0) {
+            bytes[read++] = *data_++;
+            size_--;
+        }
+        reads++;
+        return read;
+    }
+
+private:
+    const unsigned char* data_;
+    size_t size_;
+};
+
+static void callReadAndWrite(int& bytesRead, char* buffer)
+{
+    bytesRead = mock()
+                    .actualCall("read")
+                    .withParameter("fd", 3)
+                    .withParameter("size", 4ul)
+                    .withOutputParameter("buffer", buffer)
+                    .returnIntValue();
+    mock()
+        .actualCall("write")
+        .withParameter("text", "hello")
+        .withParameter("offset", -2.5)
+        .withParameter("last", true);
+}
+
+static void expectReadAndWrite()
+{
+    mock()
+        .expectOneCall("read")
+        .withParameter("fd", 3)
+        .withParameter("size", 4ul)
+        .withOutputParameterReturning("buffer", "abc", 4)
+        .andReturnValue(-4);
+    mock()
+        .expectOneCall("write")
+        .withParameter("text", "hello")
+        .withParameter("offset", -2.5)
+        .withParameter("last", true);
+}
+
+TEST_GROUP(MockCallRecording)
+{
+    MockCallRecorderForTest recorder;
+
+    void record()
+    {
+        mock().record(&recorder);
+        expectReadAndWrite();
+        int bytesRead;
+        char buffer[4];
+        callReadAndWrite(bytesRead, buffer);
+        mock().checkExpectations();
+        mock().clear();
+        recorder.flush();
+    }
+
+    void teardown() override
+    {
+        mock().clear();
+    }
+};
+
+TEST(MockCallRecording, replayedCallsBehaveLikeTheRecordedOnes)
+{
+    record();
+    MockCallReplayForTest replay(recorder.written, recorder.size);
+    mock().replay(&replay);
+
+    int bytesRead = 0;
+    char buffer[4] = "";
+    callReadAndWrite(bytesRead, buffer);
+    mock().checkExpectations();
+
+    LONGS_EQUAL(-4, bytesRead);
+    STRCMP_EQUAL("abc", buffer);
+    CHECK(replay.reads > 1);
+}
+
+TEST(MockCallRecording, recordingWritesNamesOnce)
+{
+    record();
+    size_t firstSize = recorder.size;
+    record();
+
+    // no second magic header and no names, only the calls and values
+    CHECK(recorder.size - firstSize < firstSize - 40);
+}
+
+TEST(MockCallRecording, replayLoadsOneCallAtATime)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    record();
+    MockCallReplayForTest replay(recorder.written, recorder.size);
+    mock().replay(&replay);
+
+    char buffer[4] = "";
+    mock()
+        .actualCall("read")
+        .withParameter("fd", 3)
+        .withParameter("size", 4ul)
+        .withOutputParameter("buffer", buffer);
+    mock().checkExpectations();
+
+    STRCMP_CONTAINS(
+        "EXPECTED calls that WERE NOT fulfilled:\n"
+        "\t\twrite -> const char* text: <hello>",
+        mockFailureString().asCharString()
+    );
+}
+
+TEST(MockCallRecording, replayFailsOnCallsOutOfTheRecordedOrder)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    record();
+    MockCallReplayForTest replay(recorder.written, recorder.size);
+    mock().replay(&replay);
+
+    mock().actualCall("write");
+
+    STRCMP_CONTAINS(
+        "Unexpected call to function: write",
+        mockFailureString().asCharString()
+    );
+}
+
+TEST(MockCallRecording, pointerParametersAreNotCompared)
+{
+    int first;
+    int second;
+    mock().record(&recorder);
+    mock().expectOneCall("free").withParameter("p", &first);
+    mock().actualCall("free").withParameter("p", &first);
+    mock().checkExpectations();
+    mock().clear();
+    recorder.flush();
+
+    MockCallReplayForTest replay(recorder.written, recorder.size);
+    mock().replay(&replay);
+    mock().actualCall("free").withParameter("p", &second);
+    mock().checkExpectations();
+}
+
+TEST(MockCallRecording, valuesSurviveTheRoundTrip)
+{
+    MockCallRecorderForTest direct;
+    const unsigned char bytes[] = { 0, 1, 0xff };
+    cpputest::extensions::MockNamedValue value("small");
+    direct.callStarted("values");
+    value.setValue(-1);
+    direct.inputParameter(value);
+    value = cpputest::extensions::MockNamedValue("big");
+    value.setValue(18446744073709551615ull);
+    direct.inputParameter(value);
+    value = cpputest::extensions::MockNamedValue("bytes");
+    value.setMemoryBuffer(bytes, sizeof(bytes));
+    direct.inputParameter(value);
+    value = cpputest::extensions::MockNamedValue("null");
+    value.setValue(static_cast<const char*>(nullptr));
+    direct.inputParameter(value);
+    direct.flush();
+
+    MockCallReplayForTest replay(direct.written, direct.size);
+    MockCheckedExpectedCall call;
+    CHECK(replay.nextCall(call));
+    STRCMP_EQUAL(
+        "values -> int small: <-1 (0xffffffff)>, "
+        "unsigned long long int big: <18446744073709551615 "
+        "(0xffffffffffffffff)>, const unsigned char* bytes: "
+        "<Size = 3 | HexContents = 00 01 FF>, const char* null: <> "
+        "(expected 1 call, called 0 times)",
+        call.callToString().asCharString()
+    );
+    CHECK_FALSE(replay.nextCall(call));
+}
+
+TEST(MockCallRecording, damagedRecordingEndsTheReplay)
+{
+    record();
+    recorder.written[recorder.size - 1] = 0x7f;
+    MockCallReplayForTest truncated(recorder.written, 9);
+    MockCallReplayForTest foreign(
+        reinterpret_cast<const unsigned char*>("not a recording"), 15
+    );
+    MockCheckedExpectedCall call;
+
+    CHECK_FALSE(truncated.nextCall(call));
+    CHECK_FALSE(foreign.nextCall(call));
+}
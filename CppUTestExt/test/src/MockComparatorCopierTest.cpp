@@ -833,3 +833,20 @@ TEST(MockComparatorCopierTest, shouldSupportConstParameters)
 
     mock().checkExpectations();
 }
+
+TEST(MockComparatorCopierTest, actualCallUsesTheComparatorOfTheExpectation)
+{
+    MyTypeForTesting object(1);
+    MyTypeForTestingComparator comparator;
+    mock().installComparator("MyTypeForTesting", comparator);
+    mock()
+        .expectOneCall("function")
+        .withParameterOfType("MyTypeForTesting", "parameterName", &object);
+    mock().removeAllComparatorsAndCopiers();
+
+    mock()
+        .actualCall("function")
+        .withParameterOfType("MyTypeForTesting", "parameterName", &object);
+
+    mock().checkExpectations();
+}
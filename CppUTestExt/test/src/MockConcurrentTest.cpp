@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTestExt/MockConcurrentActualCall.hpp"
+#include "CppUTest/TestHarness.hpp"
+#include "CppUTestExt/MockSupport.hpp"
+#include "MockFailureReporterForTest.hpp"
+
+#ifdef CPPUTEST_HAVE_PTHREAD_MUTEX_LOCK
+    #include <thread>
+#endif
+
+using cpputest::extensions::mock;
+using cpputest::extensions::MockActualCall;
+using cpputest::extensions::MockConcurrentCalls;
+
+static const char threads[2] = { 0, 0 };
+static const char* currentThread = &threads[0];
+
+static const void* currentThreadForTest()
+{
+    return currentThread;
+}
+
+static void switchToThread(int thread)
+{
+    currentThread = &threads[thread];
+}
+
+TEST_GROUP(MockConcurrent)
+{
+    void setup() override
+    {
+        UT_PTR_SET(MockConcurrentCalls::currentThread, currentThreadForTest);
+        switchToThread(0);
+        mock().concurrent(true);
+    }
+
+    void teardown() override
+    {
+        mock().clear();
+    }
+};
+
+TEST(MockConcurrent, interleavedCallsOfTwoThreadsDoNotMix)
+{
+    mock().expectOneCall("read").withParameter("fd", 1).andReturnValue(10);
+    mock().expectOneCall("read").withParameter("fd", 2).andReturnValue(20);
+
+    MockActualCall& first = mock().actualCall("read");
+    switchToThread(1);
+    MockActualCall& second = mock().actualCall("read").withParameter("fd", 2);
+    switchToThread(0);
+    first.withParameter("fd", 1);
+
+    switchToThread(1);
+    LONGS_EQUAL(20, second.returnIntValue());
+    switchToThread(0);
+    LONGS_EQUAL(10, first.returnIntValue());
+    mock().checkExpectations();
+}
+
+TEST(MockConcurrent, callCountsWhenTheThreadMakesItsNextCall)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock().expectOneCall("open");
+    mock().expectOneCall("close");
+
+    mock().actualCall("open");
+    LONGS_EQUAL(true, mock().expectedCallsLeft());
+    mock().actualCall("close");
+    mock().checkExpectations();
+
+    CHECK_NO_MOCK_FAILURE();
+}
+
+TEST(MockConcurrent, outputParametersAreCopiedWhenTheCallFinishes)
+{
+    int value = 0;
+    int output = 42;
+    mock().expectOneCall("get").withOutputParameterReturning(
+        "value", &output, sizeof(output)
+    );
+
+    mock().actualCall("get").withOutputParameter("value", &value);
+    LONGS_EQUAL(0, value);
+    mock().checkExpectations();
+
+    LONGS_EQUAL(42, value);
+}
+
+TEST(MockConcurrent, outputParametersComeFromTheExpectationTheCallClaims)
+{
+    int first = 1;
+    int second = 2;
+    int valueOfThreadOne = 0;
+    int valueOfThreadZero = 0;
+    mock().expectOneCall("get").withOutputParameterReturning(
+        "value", &first, sizeof(first)
+    );
+    mock()
+        .expectOneCall("get")
+        .withParameter("fd", 2)
+        .withOutputParameterReturning("value", &second, sizeof(second));
+
+    switchToThread(1);
+    MockActualCall& call = mock().actualCall("get").withOutputParameter(
+        "value", &valueOfThreadOne
+    );
+    switchToThread(0);
+    mock()
+        .actualCall("get")
+        .withOutputParameter("value", &valueOfThreadZero)
+        .returnIntValueOrDefault(0);
+    LONGS_EQUAL(1, valueOfThreadZero);
+    LONGS_EQUAL(0, valueOfThreadOne);
+
+    switchToThread(1);
+    call.withParameter("fd", 2);
+    switchToThread(0);
+    mock().checkExpectations();
+
+    LONGS_EQUAL(2, valueOfThreadOne);
+}
+
+TEST(MockConcurrent, expectationsAddedDuringACallAreMatched)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock().expectOneCall("read").withParameter("fd", 1);
+
+    MockActualCall& call = mock().actualCall("read");
+    mock().expectOneCall("read").withParameter("fd", 2);
+    call.withParameter("fd", 2);
+
+    CHECK_NO_MOCK_FAILURE();
+}
+
+TEST(MockConcurrent, failureOfAnotherThreadIsReportedAtCheckExpectations)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+
+    switchToThread(1);
+    mock().actualCall("unexpected");
+    STRCMP_EQUAL("", mockFailureString().asCharString());
+
+    switchToThread(0);
+    mock().checkExpectations();
+    STRCMP_CONTAINS(
+        "Unexpected call to function: unexpected",
+        mockFailureString().asCharString()
+    );
+}
+
+TEST(MockConcurrent, failureOfTheOwningThreadIsReportedRightAway)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock().expectOneCall("foo").withParameter("value", 1);
+
+    mock().actualCall("foo").withParameter("value", 2);
+
+    STRCMP_CONTAINS(
+        "Unexpected parameter value to parameter \"value\" to function "
+        "\"foo\"",
+        mockFailureString().asCharString()
+    );
+}
+
+TEST(MockConcurrent, callOrderIsTheOrderTheCallsStarted)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock().strictOrder();
+    mock().expectOneCall("first").withParameter("value", 1);
+    mock().expectOneCall("second");
+
+    MockActualCall& first = mock().actualCall("first");
+    switchToThread(1);
+    mock().actualCall("second");
+    switchToThread(0);
+    first.withParameter("value", 1);
+    mock().checkExpectations();
+
+    CHECK_NO_MOCK_FAILURE();
+}
+
+TEST(MockConcurrent, callsStartedOutOfOrderFail)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock().strictOrder();
+    mock().expectOneCall("first");
+    mock().expectOneCall("second");
+
+    switchToThread(1);
+    mock().actualCall("second");
+    switchToThread(0);
+    mock().actualCall("first");
+    mock().checkExpectations();
+
+    STRCMP_CONTAINS(
+        "Mock Failure: Out of order calls", mockFailureString().asCharString()
+    );
+}
+
+TEST(MockConcurrent, turningConcurrentModeOffFinishesTheCalls)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock().expectOneCall("foo");
+    switchToThread(1);
+    mock().actualCall("foo");
+    switchToThread(0);
+
+    mock().concurrent(false);
+    mock().checkExpectations();
+
+    CHECK_NO_MOCK_FAILURE();
+}
+
+TEST(MockConcurrent, stringsAreOnlyAllocatedUnderALockInConcurrentMode)
+{
+    cpputest::TestMemoryAllocator* concurrentAllocator =
+        cpputest::SimpleString::getStringAllocator();
+    mock().concurrent(false);
+    cpputest::TestMemoryAllocator* allocator =
+        cpputest::SimpleString::getStringAllocator();
+
+    CHECK(allocator != concurrentAllocator);
+    mock().concurrent(true);
+    CHECK(cpputest::SimpleString::getStringAllocator() != allocator);
+}
+
+#ifdef CPPUTEST_HAVE_PTHREAD_MUTEX_LOCK
+
+TEST_GROUP(MockConcurrentThreads)
+{
+    void setup() override
+    {
+        mock().concurrent(true);
+    }
+
+    void teardown() override
+    {
+        mock().clear();
+    }
+};
+
+static void readManyTimes(int fd, int* sum)
+{
+    for (int i = 0; i < 200; i++)
+        *sum += mock()
+                    .actualCall("read")
+                    .withParameter("fd", fd)
+                    .withParameter("size", 16)
+                    .returnIntValue();
+}
+
+TEST(MockConcurrentThreads, callsOfRealThreadsMatchTheirOwnExpectations)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock()
+        .expectNCalls(200, "read")
+        .withParameter("fd", 1)
+        .withParameter("size", 16)
+        .andReturnValue(1);
+    mock()
+        .expectNCalls(200, "read")
+        .withParameter("fd", 2)
+        .withParameter("size", 16)
+        .andReturnValue(2);
+
+    int first = 0;
+    int second = 0;
+    std::thread one(readManyTimes, 1, &first);
+    std::thread two(readManyTimes, 2, &second);
+    one.join();
+    two.join();
+    mock().checkExpectations();
+
+    LONGS_EQUAL(200, first);
+    LONGS_EQUAL(400, second);
+    CHECK_NO_MOCK_FAILURE();
+}
+
+#endif
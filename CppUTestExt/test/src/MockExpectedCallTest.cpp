@@ -984,6 +984,35 @@ TEST(MockExpectedCall, hasNoOutputParameterOfTypeDifferentType)
     CHECK_FALSE(call->hasOutputParameter(foo));
 }
 
+TEST(MockExpectedCall, manyParametersAreAllFoundAndListedInOrder)
+{
+    for (int i = 0; i < 12; i++)
+        call->withParameter(cpputest::StringFromFormat("p%d", i), i);
+
+    for (int i = 0; i < 12; i++) {
+        MockNamedValue parameter(cpputest::StringFromFormat("p%d", i));
+        parameter.setValue(i);
+        CHECK(call->hasInputParameter(parameter));
+        call->inputParameterWasPassed(parameter.getName());
+    }
+    CHECK(call->isMatchingActualCall());
+    STRCMP_CONTAINS(
+        "int p10: <10 (0xa)>, int p11: <11 (0xb)> (expected",
+        call->callToString().asCharString()
+    );
+}
+
+TEST(MockExpectedCall, onlyPassedParametersMatch)
+{
+    call->withParameter("a", 1);
+    call->withParameter("b", 2);
+
+    call->inputParameterWasPassed("b");
+
+    CHECK_FALSE(call->isMatchingActualCall());
+    STRCMP_EQUAL("int a", call->missingParametersToString().asCharString());
+}
+
 TEST_GROUP(MockIgnoredExpectedCall)
 {
     MockIgnoredExpectedCall ignored;
@@ -28,10 +28,12 @@
 #include "MockFailureReporterForTest.hpp"
 #include "CppUTest/Utest.hpp"
 #include "CppUTest/UtestMacros.hpp"
+#include "CppUTestExt/MockFunction.hpp"
 
 using cpputest::extensions::mock;
 using cpputest::extensions::MockCheckedExpectedCall;
 using cpputest::extensions::MockFailure;
+using cpputest::extensions::MockFunctionBase;
 
 void MockFailureReporterForTest::failTest(const MockFailure& failure)
 {
@@ -59,11 +61,15 @@ MockFailureReporterInstaller::MockFailureReporterInstaller()
     mock().setMockFailureStandardReporter(
         MockFailureReporterForTest::getReporter()
     );
+    MockFunctionBase::setMockFailureStandardReporter(
+        MockFailureReporterForTest::getReporter()
+    );
 }
 
 MockFailureReporterInstaller::~MockFailureReporterInstaller()
 {
     mock().setMockFailureStandardReporter(nullptr);
+    MockFunctionBase::setMockFailureStandardReporter(nullptr);
     MockFailureReporterForTest::clearReporter();
 }
 
@@ -306,6 +306,33 @@ TEST(MockFailureTest, MockUnexpectedParameterValueFailure)
     );
 }
 
+TEST(MockFailureTest, MockUnexpectedLargeMemoryBufferShowsTheFirstDifference)
+{
+    unsigned char expected[256];
+    unsigned char actual[256];
+    for (size_t i = 0; i < sizeof(expected); i++)
+        expected[i] = actual[i] = static_cast<unsigned char>(i);
+    actual[200] = 0;
+    call1->withName("foo").withParameter("buf", expected, sizeof(expected));
+    addThreeCallsToList();
+
+    MockNamedValue actualParameter("buf");
+    actualParameter.setMemoryBuffer(actual, sizeof(actual));
+
+    cpputest::extensions::MockUnexpectedInputParameterFailure failure(
+        cpputest::UtestShell::getCurrent(), "foo", actualParameter, *list
+    );
+    STRCMP_CONTAINS(
+        "\n\tFIRST difference to the first expected buffer at offset 200, "
+        "showing bytes 184 to 215:\n"
+        "\t\texpected: <B8 B9 BA BB BC BD BE BF C0 C1 C2 C3 C4 C5 C6 C7 "
+        "C8 C9 CA CB CC CD CE CF D0 D1 D2 D3 D4 D5 D6 D7>\n"
+        "\t\tactual:   <B8 B9 BA BB BC BD BE BF C0 C1 C2 C3 C4 C5 C6 C7 "
+        "00 C9 CA CB CC CD CE CF D0 D1 D2 D3 D4 D5 D6 D7>",
+        failure.getMessage().asCharString()
+    );
+}
+
 TEST(MockFailureTest, MockExpectedParameterDidntHappenFailure)
 {
     call1->withName("foo").withParameter("bar", 2).withParameter("boo", "str");
@@ -428,3 +455,99 @@ TEST(MockFailureTest, MockExpectedObjectDidntHappenFailure)
         failure.getMessage().asCharString()
     );
 }
+
+TEST_GROUP(MockFailureWithManyExpectations)
+{
+    MockExpectedCallsList list;
+    MockCheckedExpectedCall calls[30];
+
+    void teardown() override
+    {
+        MockFailure::reportAllExpectations(false);
+    }
+};
+
+TEST(MockFailureWithManyExpectations, reportIsCappedWithCountsPerFunction)
+{
+    for (size_t i = 0; i < 25; i++) {
+        calls[i].withName((i < 22) ? "foo" : "bar");
+        list.addExpectedCall(&calls[i]);
+    }
+
+    cpputest::extensions::MockExpectedCallsDidntHappenFailure failure(
+        cpputest::UtestShell::getCurrent(), list
+    );
+
+    STRCMP_CONTAINS(
+        "\t\t(5 more not shown: 2 x foo, 3 x bar)\n",
+        failure.getMessage().asCharString()
+    );
+}
+
+TEST(MockFailureWithManyExpectations, closestCandidatesAreListedFirst)
+{
+    for (size_t i = 0; i < 25; i++) {
+        calls[i].withName("foo");
+        list.addExpectedCall(&calls[i]);
+    }
+    calls[24].withParameter("value", 1);
+    MockNamedValue parameter("value");
+    parameter.setValue(2);
+
+    cpputest::extensions::MockUnexpectedInputParameterFailure failure(
+        cpputest::UtestShell::getCurrent(), "foo", parameter, list
+    );
+
+    STRCMP_CONTAINS(
+        "related to function: foo\n"
+        "\t\tfoo -> int value: <1 (0x1)> (expected 1 call, called 0 times)\n",
+        failure.getMessage().asCharString()
+    );
+    STRCMP_CONTAINS(
+        "(5 more not shown: 5 x foo)", failure.getMessage().asCharString()
+    );
+}
+
+TEST(MockFailureWithManyExpectations, allExpectationsCanBeReported)
+{
+    for (size_t i = 0; i < 25; i++) {
+        calls[i].withName("foo");
+        list.addExpectedCall(&calls[i]);
+    }
+    MockFailure::reportAllExpectations(true);
+
+    cpputest::extensions::MockExpectedCallsDidntHappenFailure failure(
+        cpputest::UtestShell::getCurrent(), list
+    );
+
+    CHECK_FALSE(failure.getMessage().contains("not shown"));
+}
+
+TEST(MockFailureWithManyExpectations, historyIsRenderedWhenTheMessageIsAsked)
+{
+    cpputest::extensions::MockUnexpectedCallHappenedFailure failure(
+        cpputest::UtestShell::getCurrent(), "bar", list
+    );
+    calls[0].withName("foo");
+    list.addExpectedCall(&calls[0]);
+
+    STRCMP_CONTAINS("\t\tfoo -> ", failure.getMessage().asCharString());
+}
+
+TEST(MockFailureWithManyExpectations, copyKeepsTheHistoryOfAListThatIsGone)
+{
+    MockExpectedCallsList* expectations = new MockExpectedCallsList;
+    calls[0].withName("foo");
+    expectations->addExpectedCall(&calls[0]);
+    cpputest::extensions::MockUnexpectedCallHappenedFailure failure(
+        cpputest::UtestShell::getCurrent(), "foo", *expectations
+    );
+
+    MockFailure copy(failure);
+    delete expectations;
+
+    STRCMP_CONTAINS("\t\tfoo -> ", copy.getMessage().asCharString());
+    STRCMP_EQUAL(
+        failure.getMessage().asCharString(), copy.getMessage().asCharString()
+    );
+}
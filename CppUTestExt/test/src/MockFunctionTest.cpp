@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTestExt/MockFunction.hpp"
+#include "CppUTest/TestHarness.hpp"
+#include "CppUTest/TestOutput.hpp"
+#include "CppUTestExt/MockSupportPlugin.hpp"
+#include "MockFailureReporterForTest.hpp"
+
+using cpputest::extensions::MockFunction;
+
+static MockFunction<int(const char*, size_t)> halWrite("hal_write");
+static MockFunction<void(int)> halReset("hal_reset");
+
+static bool isEven(const int& value)
+{
+    return value % 2 == 0;
+}
+
+TEST_GROUP(MockFunction)
+{
+    void teardown() override
+    {
+        halWrite.clear();
+        halReset.clear();
+    }
+};
+
+TEST(MockFunction, expectedCallReturnsItsValue)
+{
+    halWrite.expectCall().with("abc", 3).andReturnValue(3);
+
+    LONGS_EQUAL(3, halWrite("abc", 3));
+    halWrite.checkExpectations();
+}
+
+TEST(MockFunction, stringsAreComparedByContent)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    char buffer[] = "abc";
+    halWrite.expectCall().with("abc", 3);
+
+    halWrite(buffer, 3);
+    halWrite.checkExpectations();
+
+    CHECK_NO_MOCK_FAILURE();
+}
+
+TEST(MockFunction, unexpectedParameterValueIsReported)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    halWrite.expectCall().with("abc", 3);
+
+    halWrite("abc", 4);
+
+    STRCMP_CONTAINS(
+        "Unexpected call to function: hal_write",
+        mockFailureString().asCharString()
+    );
+    STRCMP_CONTAINS(
+        "hal_write -> 0: abc, 1: 3 (expected 1 call, called 0 times)",
+        mockFailureString().asCharString()
+    );
+    STRCMP_CONTAINS(
+        "ACTUAL unexpected call:\n\t\thal_write -> 0: abc, 1: 4",
+        mockFailureString().asCharString()
+    );
+}
+
+TEST(MockFunction, missingCallIsReportedAtCheckExpectations)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    halReset.expectNCalls(2).with(1);
+
+    halReset(1);
+    halReset.checkExpectations();
+
+    STRCMP_CONTAINS(
+        "Expected call WAS NOT fulfilled for function: hal_reset",
+        mockFailureString().asCharString()
+    );
+    STRCMP_CONTAINS(
+        "hal_reset -> 0: 1 (expected 2 calls, called 1 time)",
+        mockFailureString().asCharString()
+    );
+}
+
+TEST(MockFunction, parametersCanBeLeftOpenOrMatched)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    halWrite.expectCall().withParameter<1>(5).andReturnValue(1);
+    halReset.expectCall().withParameterMatching<0>(isEven);
+
+    LONGS_EQUAL(1, halWrite("anything", 5));
+    halReset(4);
+    halWrite.checkExpectations();
+    halReset.checkExpectations();
+
+    CHECK_NO_MOCK_FAILURE();
+}
+
+TEST(MockFunction, expectationsAreUsedInTheOrderTheyWereMade)
+{
+    halWrite.expectCall().andReturnValue(1);
+    halWrite.expectCall().andReturnValue(2);
+
+    LONGS_EQUAL(1, halWrite("a", 1));
+    LONGS_EQUAL(2, halWrite("a", 1));
+}
+
+TEST(MockFunction, pluginChecksAndClearsAllFunctions)
+{
+    cpputest::StringBufferTestOutput output;
+    cpputest::TestResult result(output);
+    cpputest::UtestShell test("group", "name", "file", 1);
+    cpputest::extensions::MockSupportPlugin plugin;
+    halReset.expectCall();
+
+    plugin.postTestAction(test, result);
+
+    STRCMP_CONTAINS(
+        "Expected call WAS NOT fulfilled for function: hal_reset",
+        output.getOutput().asCharString()
+    );
+    MockFailureReporterInstaller failureReporterInstaller;
+    halReset.checkExpectations();
+    CHECK_NO_MOCK_FAILURE();
+}
@@ -152,3 +152,249 @@ TEST(MockNamedValue, DoublesNotEqualIfOutsideTolerance)
 
     CHECK_FALSE(value->equals(other));
 }
+
+TEST(MockNamedValue, BuiltinTypesAreTagged)
+{
+    value->setValue(3UL);
+    LONGS_EQUAL(
+        cpputest::extensions::MockNamedValue::VALUE_UNSIGNED_LONG_INT,
+        value->getValueType()
+    );
+    STRCMP_EQUAL("unsigned long int", value->getType().asCharString());
+}
+
+TEST(MockNamedValue, IntegersOfDifferentTypesAreEqualWhenTheirValuesAre)
+{
+    value->setValue(7LL);
+    cpputest::extensions::MockNamedValue other("param2");
+    other.setValue(7U);
+
+    CHECK_TRUE(value->equals(other));
+    CHECK_TRUE(other.equals(*value));
+}
+
+TEST(MockNamedValue, NegativeIntegerIsNeverEqualToAnUnsignedInteger)
+{
+    value->setValue(-1);
+    cpputest::extensions::MockNamedValue other("param2");
+    other.setValue(~0ULL);
+
+    CHECK_FALSE(value->equals(other));
+    CHECK_FALSE(other.equals(*value));
+}
+
+TEST(MockNamedValue, IntegerIsNotEqualToADouble)
+{
+    value->setValue(1);
+    cpputest::extensions::MockNamedValue other("param2");
+    other.setValue(1.0);
+
+    CHECK_FALSE(value->equals(other));
+}
+
+TEST(MockNamedValue, NullStringEqualsEmptyString)
+{
+    value->setValue(static_cast<const char*>(nullptr));
+    cpputest::extensions::MockNamedValue other("param2");
+    other.setValue("");
+
+    CHECK_TRUE(value->equals(other));
+}
+
+static bool alwaysEqual(const void*, const void*)
+{
+    return true;
+}
+
+static cpputest::SimpleString emptyString(const void*)
+{
+    return "";
+}
+
+TEST(MockNamedValue, ObjectsOfDifferentTypesAreNotEqual)
+{
+    cpputest::extensions::MockFunctionComparator comparator(
+        alwaysEqual, emptyString
+    );
+    cpputest::extensions::MockNamedValueComparatorsAndCopiersRepository
+        repository;
+    repository.installComparator("MyType", comparator);
+    cpputest::extensions::MockNamedValue::
+        setDefaultComparatorsAndCopiersRepository(&repository);
+    int object = 1;
+    value->setConstObjectPointer("MyType", &object);
+    cpputest::extensions::MockNamedValue other("param2");
+    other.setConstObjectPointer("OtherType", &object);
+    cpputest::extensions::MockNamedValue::
+        setDefaultComparatorsAndCopiersRepository(nullptr);
+
+    LONGS_EQUAL(
+        cpputest::extensions::MockNamedValue::VALUE_OBJECT,
+        value->getValueType()
+    );
+    CHECK_FALSE(value->equals(other));
+    other.setConstObjectPointer("MyType", &object);
+    CHECK_TRUE(value->equals(other));
+}
+
+TEST(ComparatorsAndCopiersRepository, FindsEveryTypeAfterTheIndexGrows)
+{
+    MyComparator comparators[40];
+    cpputest::extensions::MockNamedValueComparatorsAndCopiersRepository
+        repository;
+    for (int i = 0; i < 40; i++)
+        repository.installComparator(
+            cpputest::StringFromFormat("Type%d", i), comparators[i]
+        );
+
+    for (int i = 0; i < 40; i++)
+        POINTERS_EQUAL(
+            &comparators[i],
+            repository.getComparatorForType(
+                cpputest::StringFromFormat("Type%d", i)
+            )
+        );
+    POINTERS_EQUAL(nullptr, repository.getComparatorForType("Type40"));
+}
+
+TEST(ComparatorsAndCopiersRepository, LatestInstalledComparatorIsUsed)
+{
+    MyComparator first;
+    MyComparator second;
+    MyCopier copier;
+    cpputest::extensions::MockNamedValueComparatorsAndCopiersRepository
+        repository;
+    repository.installComparator("MyType", first);
+    for (int i = 0; i < 20; i++)
+        repository.installCopier(
+            cpputest::StringFromFormat("Type%d", i), copier
+        );
+    repository.installComparator("MyType", second);
+    repository.installCopier("MyType", copier);
+
+    POINTERS_EQUAL(&second, repository.getComparatorForType("MyType"));
+    POINTERS_EQUAL(&copier, repository.getCopierForType("MyType"));
+}
+
+TEST(MockNamedValue, LargeMemoryBuffersWithTheSameContentsAreEqual)
+{
+    unsigned char buffer1[1024];
+    unsigned char buffer2[1024];
+    for (size_t i = 0; i < sizeof(buffer1); i++)
+        buffer1[i] = buffer2[i] = static_cast<unsigned char>(i * 7);
+    value->setMemoryBuffer(buffer1, sizeof(buffer1));
+    cpputest::extensions::MockNamedValue other("param2");
+    other.setMemoryBuffer(buffer2, sizeof(buffer2));
+
+    CHECK_TRUE(value->equals(other));
+    CHECK_TRUE(other.equals(*value));
+}
+
+TEST(MockNamedValue, LargeMemoryBuffersDifferingInTheirLastByteAreNotEqual)
+{
+    unsigned char buffer1[1023];
+    unsigned char buffer2[1023];
+    for (size_t i = 0; i < sizeof(buffer1); i++)
+        buffer1[i] = buffer2[i] = static_cast<unsigned char>(i * 7);
+    buffer2[sizeof(buffer2) - 1]++;
+    value->setMemoryBuffer(buffer1, sizeof(buffer1));
+    cpputest::extensions::MockNamedValue other("param2");
+    other.setMemoryBuffer(buffer2, sizeof(buffer2));
+
+    CHECK_FALSE(value->equals(other));
+    CHECK_FALSE(other.equals(*value));
+}
+
+TEST_GROUP(MockNamedValueList)
+{
+    cpputest::extensions::MockNamedValueList list;
+
+    void addValue(const char* name, int number)
+    {
+        cpputest::extensions::MockNamedValue* value =
+            new cpputest::extensions::MockNamedValue(name);
+        value->setValue(number);
+        list.add(value);
+    }
+};
+
+TEST(MockNamedValueList, FirstValueAddedUnderANameIsFound)
+{
+    addValue("duplicate", 1);
+    addValue("duplicate", 2);
+
+    LONGS_EQUAL(1, list.getValueByName("duplicate")->getIntValue());
+}
+
+TEST(MockNamedValueList, FirstValueAddedUnderANameIsFoundAfterTheIndexGrew)
+{
+    addValue("duplicate", 1);
+    addValue("duplicate", 2);
+    for (int i = 0; i < 40; i++)
+        addValue(cpputest::StringFrom(i).asCharString(), i);
+    addValue("duplicate", 3);
+
+    LONGS_EQUAL(1, list.getValueByName("duplicate")->getIntValue());
+}
+
+TEST_GROUP(MockNameIndex)
+{
+    cpputest::extensions::MockNameIndex index;
+};
+
+TEST(MockNameIndex, NameIsAddedOnce)
+{
+    index.get("name").setNumber(1);
+    index.get("name").setNumber(index.get("name").getNumber() + 1);
+
+    LONGS_EQUAL(1, index.size());
+    LONGS_EQUAL(2, index.find("name")->getNumber());
+    POINTERS_EQUAL(nullptr, index.find("name")->getPointer());
+    POINTERS_EQUAL(nullptr, index.find("other"));
+}
+
+TEST(MockNameIndex, EntriesKeepTheOrderTheyWereAddedInAfterTheIndexGrew)
+{
+    for (size_t i = 0; i < 40; i++)
+        index.get(cpputest::StringFrom(i)).setNumber(i);
+
+    size_t expected = 0;
+    for (cpputest::extensions::MockNameIndexEntry* p = index.begin(); p;
+         p = p->next(), expected++) {
+        STRCMP_EQUAL(
+            cpputest::StringFrom(expected).asCharString(),
+            p->getName().asCharString()
+        );
+        POINTERS_EQUAL(p, index.find(p->getName()));
+    }
+    LONGS_EQUAL(40, expected);
+}
+
+TEST(MockNameIndex, ClearForgetsEveryName)
+{
+    int object;
+    index.get("name").setPointer(&object);
+    index.clear();
+
+    LONGS_EQUAL(0, index.size());
+    POINTERS_EQUAL(nullptr, index.find("name"));
+    POINTERS_EQUAL(nullptr, index.get("name").getPointer());
+}
+
+TEST(MockNamedValue, LargeMemoryBufferChangedBetweenComparisonsIsComparedAgain)
+{
+    unsigned char buffer1[512];
+    unsigned char buffer2[512];
+    for (size_t i = 0; i < sizeof(buffer1); i++)
+        buffer1[i] = buffer2[i] = static_cast<unsigned char>(i * 7);
+    buffer2[300]++;
+    value->setMemoryBuffer(buffer1, sizeof(buffer1));
+    cpputest::extensions::MockNamedValue other("param2");
+    other.setMemoryBuffer(buffer2, sizeof(buffer2));
+
+    CHECK_FALSE(value->equals(other));
+    buffer1[300]++;
+    CHECK_TRUE(value->equals(other));
+    buffer1[0]++;
+    CHECK_FALSE(value->equals(other));
+}
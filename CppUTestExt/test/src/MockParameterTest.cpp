@@ -1084,6 +1084,38 @@ TEST(MockParameterTest, properOutputParametersAreCopied)
     mock().checkExpectations();
 }
 
+TEST(MockParameterTest, outputParameterSequenceIsCopiedOnePerCall)
+{
+    const short samples[] = { 10, 20, 30 };
+    mock()
+        .expectNCalls(3, "read")
+        .withOutputParameterReturningSequence(
+            "sample", samples, sizeof(samples[0]), 3
+        )
+        .andReturnValue(0);
+
+    short sample = 0;
+    for (int i = 0; i < 3; i++) {
+        mock().actualCall("read").withOutputParameter("sample", &sample);
+        LONGS_EQUAL(samples[i], sample);
+    }
+}
+
+TEST(MockParameterTest, outputParameterSequenceRepeatsItsLastValue)
+{
+    const int values[] = { 1, 2 };
+    mock().expectNCalls(3, "read").withOutputParameterReturningSequence(
+        "value", values, sizeof(values[0]), 2
+    );
+
+    int value = 0;
+    mock().actualCall("read").withOutputParameter("value", &value);
+    mock().actualCall("read").withOutputParameter("value", &value);
+    mock().actualCall("read").withOutputParameter("value", &value);
+
+    LONGS_EQUAL(2, value);
+}
+
 TEST(MockParameterTest, ignoreOtherCallsIgnoresWithAllKindsOfParameters)
 {
     void* ptr = nullptr;
@@ -206,3 +206,18 @@ TEST(MockPlugin, shouldNotFailAgainWhenTestAlreadyFailed)
     fixture.runAllTests();
     fixture.assertPrintContains("1 failures, 1 tests, 1 ran, 2 checks,");
 }
+
+TEST(MockPlugin, reportingAllExpectationsIsResetAfterTheTest)
+{
+    cpputest::extensions::MockFailure::reportAllExpectations(true);
+
+    plugin.postTestAction(*test, *result);
+
+    MockExpectedCallsListForTest expectations;
+    for (size_t i = 0; i < 25; i++)
+        expectations.addFunction("foobar");
+    cpputest::extensions::MockExpectedCallsDidntHappenFailure failure(
+        test, expectations
+    );
+    CHECK(failure.getMessage().contains("not shown"));
+}
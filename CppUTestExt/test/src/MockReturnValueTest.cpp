@@ -1319,6 +1319,27 @@ TEST(MockReturnValueTest, FunctionPointerReturnValue)
     FUNCTIONPOINTERS_EQUAL(ptr, mock().functionPointerReturnValue());
 }
 
+TEST(MockReturnValueTest, ReturnValuesAreGivenOnePerCall)
+{
+    const int values[] = { 1, 2, 3 };
+    mock().expectNCalls(4, "foo").andReturnValues(values, 3);
+
+    LONGS_EQUAL(1, mock().actualCall("foo").returnIntValue());
+    LONGS_EQUAL(2, mock().actualCall("foo").returnIntValue());
+    LONGS_EQUAL(3, mock().actualCall("foo").returnIntValue());
+    LONGS_EQUAL(3, mock().actualCall("foo").returnIntValue());
+}
+
+TEST(MockReturnValueTest, ReturnValuesCanCycle)
+{
+    const char* const values[] = { "a", "b" };
+    mock().expectNCalls(3, "foo").andReturnValues(values, 2).cycleValues();
+
+    STRCMP_EQUAL("a", mock().actualCall("foo").returnStringValue());
+    STRCMP_EQUAL("b", mock().actualCall("foo").returnStringValue());
+    STRCMP_EQUAL("a", mock().actualCall("foo").returnStringValue());
+}
+
 TEST(
     MockReturnValueTest,
     whenCallingDisabledOrIgnoredActualCallsThenTheyDontReturnPreviousCallsValues
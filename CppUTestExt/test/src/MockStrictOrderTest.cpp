@@ -200,3 +200,23 @@ TEST(MockStrictOrderTest, orderUsingNCalls)
 
     mock().checkExpectations();
 }
+
+TEST(MockStrictOrderTest, orderViolatedAfterManyCalls)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock().strictOrder();
+
+    for (int i = 0; i < 100; i++)
+        mock().expectOneCall("tick");
+    mock().expectOneCall("foo1");
+    mock().expectOneCall("foo2");
+    for (int i = 0; i < 100; i++)
+        mock().actualCall("tick");
+    mock().actualCall("foo2");
+    mock().actualCall("foo1");
+
+    mock().checkExpectations();
+    STRCMP_CONTAINS(
+        "Mock Failure: Out of order calls", mockFailureString().asCharString()
+    );
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTestExt/MockStub.hpp"
+#include "CppUTest/TestHarness.hpp"
+#include "CppUTestExt/MockSupport.hpp"
+#include "MockFailureReporterForTest.hpp"
+
+using cpputest::extensions::mock;
+using cpputest::extensions::MockNamedValue;
+using cpputest::extensions::MockNamedValueList;
+
+TEST_GROUP(MockStub)
+{
+    void teardown() override
+    {
+        mock().clear();
+    }
+};
+
+TEST(MockStub, stubAnswersAnyNumberOfCalls)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock().stub("hal_read_reg").andReturnValue(7);
+
+    for (int i = 0; i < 3; i++)
+        LONGS_EQUAL(
+            7,
+            mock()
+                .actualCall("hal_read_reg")
+                .withParameter("addr", i)
+                .returnIntValue()
+        );
+    mock().checkExpectations();
+
+    LONGS_EQUAL(3, mock().stub("hal_read_reg").getCallCount());
+    CHECK_NO_MOCK_FAILURE();
+}
+
+TEST(MockStub, stubWithoutReturnValueGivesTheDefault)
+{
+    mock().stub("hal_write_reg");
+
+    LONGS_EQUAL(
+        5, mock().actualCall("hal_write_reg").returnIntValueOrDefault(5)
+    );
+}
+
+TEST(MockStub, eachFunctionGetsItsOwnStub)
+{
+    for (int i = 0; i < 50; i++)
+        mock().stub(cpputest::StringFromFormat("read%d", i)).andReturnValue(i);
+
+    LONGS_EQUAL(37, mock().actualCall("read37").returnIntValue());
+    LONGS_EQUAL(1, mock().stub("read37").getCallCount());
+    LONGS_EQUAL(0, mock().stub("read36").getCallCount());
+}
+
+TEST(MockStub, tableIsLookedUpByParameter)
+{
+    mock().stub("hal_read_reg").andReturnValue(0);
+    mock().stub("hal_read_reg").whenParameter("addr", 0x10).andReturnValue(1);
+    mock().stub("hal_read_reg").whenParameter("addr", 0x14).andReturnValue(2);
+
+    LONGS_EQUAL(
+        2,
+        mock()
+            .actualCall("hal_read_reg")
+            .withParameter("addr", 0x14u)
+            .returnIntValue()
+    );
+    LONGS_EQUAL(
+        1,
+        mock()
+            .actualCall("hal_read_reg")
+            .withParameter("addr", 0x10)
+            .returnIntValue()
+    );
+    LONGS_EQUAL(
+        0,
+        mock()
+            .actualCall("hal_read_reg")
+            .withParameter("addr", 0x18)
+            .returnIntValue()
+    );
+}
+
+TEST(MockStub, firstMatchingEntryWins)
+{
+    mock().stub("read").whenParameter("fd", 1).andReturnValue("by fd");
+    mock().stub("read").whenParameter("size", 4).andReturnValue("by size");
+
+    STRCMP_EQUAL(
+        "by fd",
+        mock()
+            .actualCall("read")
+            .withParameter("size", 4)
+            .withParameter("fd", 1)
+            .returnStringValue()
+    );
+}
+
+static void readRegister(MockNamedValueList& parameters, MockNamedValue& value)
+{
+    value.setValue(parameters.getValueByName("addr")->getIntValue() * 2);
+}
+
+TEST(MockStub, callbackGivesTheReturnValue)
+{
+    mock().stub("hal_read_reg").withCallback(readRegister);
+
+    mock().actualCall("hal_read_reg").withParameter("addr", 21);
+
+    LONGS_EQUAL(42, mock().intReturnValue());
+}
+
+TEST(MockStub, expectationsReplaceTheStub)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock().stub("read").andReturnValue(1);
+    mock().expectOneCall("read").andReturnValue(2);
+
+    LONGS_EQUAL(2, mock().actualCall("read").returnIntValue());
+    mock().actualCall("read");
+
+    LONGS_EQUAL(0, mock().stub("read").getCallCount());
+    STRCMP_CONTAINS(
+        "Unexpected additional (2nd) call to function: read",
+        mockFailureString().asCharString()
+    );
+}
+
+TEST(MockStub, stubsAreKeptPerScopeAndRemovedByClear)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock("hal").stub("read").andReturnValue(3);
+
+    LONGS_EQUAL(3, mock("hal").actualCall("read").returnIntValue());
+    mock().clear();
+    mock("hal").actualCall("read");
+
+    STRCMP_CONTAINS(
+        "Unexpected call to function: hal::read",
+        mockFailureString().asCharString()
+    );
+}
@@ -148,6 +148,53 @@ TEST(MockSupportTest, setDataConstObject)
     STRCMP_EQUAL("type", mock().getData("data").getType().asCharString());
 }
 
+TEST(MockSupportTest, manyDataValuesCanBeFound)
+{
+    for (int i = 0; i < 100; i++)
+        mock().setData(cpputest::StringFrom(i), i);
+    for (int i = 0; i < 100; i++)
+        LONGS_EQUAL(i, mock().getData(cpputest::StringFrom(i)).getIntValue());
+}
+
+TEST(MockSupportTest, scopeHandleRefersToTheNamedScope)
+{
+    cpputest::extensions::MockScope hal = mock().scope("hal");
+
+    POINTERS_EQUAL(&mock("hal"), &hal.get());
+    hal->expectOneCall("read");
+    mock("hal").actualCall("read");
+}
+
+TEST(MockSupportTest, scopeHandleSurvivesClear)
+{
+    cpputest::extensions::MockScope hal = mock().scope("hal");
+    hal->expectOneCall("read");
+    mock().clear();
+
+    CHECK_FALSE(hal->expectedCallsLeft());
+    POINTERS_EQUAL(&mock("hal"), &hal.get());
+}
+
+TEST(MockSupportTest, scopeHandleSetsUpTheScopeAgainAfterOtherMocksWereUsed)
+{
+    cpputest::extensions::MockScope hal = mock().scope("hal");
+    hal.get();
+    cpputest::extensions::MockNamedValueComparatorsAndCopiersRepository*
+        halRepository = cpputest::extensions::MockNamedValue::
+            getDefaultComparatorsAndCopiersRepository();
+    mock();
+    CHECK(
+        halRepository != cpputest::extensions::MockNamedValue::
+                             getDefaultComparatorsAndCopiersRepository()
+    );
+
+    hal.get();
+    POINTERS_EQUAL(
+        halRepository, cpputest::extensions::MockNamedValue::
+                           getDefaultComparatorsAndCopiersRepository()
+    );
+}
+
 TEST(MockSupportTest, tracing)
 {
     mock().tracing(true);
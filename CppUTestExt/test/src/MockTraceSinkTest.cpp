@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTestExt/MockTraceSink.hpp"
+#include "CppUTest/TestHarness.hpp"
+#include "CppUTestExt/MockSupport.hpp"
+
+using cpputest::extensions::mock;
+using cpputest::extensions::MockTraceBufferSink;
+using cpputest::extensions::MockTraceFileSink;
+using cpputest::extensions::MockTraceRingSink;
+using cpputest::extensions::MockTraceSink;
+
+class MockTraceFileSinkForTest : public MockTraceFileSink
+{
+public:
+    MockTraceFileSinkForTest(Encoding encoding = TEXT_ENCODING) :
+        MockTraceFileSink("trace", encoding),
+        size(0),
+        writes(0)
+    {
+    }
+
+    virtual ~MockTraceFileSinkForTest() override {}
+
+    char written[1024];
+    size_t size;
+    size_t writes;
+
+protected:
+    virtual void writeToFile(const void* data, size_t length) override
+    {
+        const char* bytes = static_cast<const char*>(data);
+        for (size_t i = 0; i < length && size < sizeof(written); i++)
+            written[size++] = bytes[i];
+        writes++;
+    }
+};
+
+static void traceTwoCalls(MockTraceSink& sink)
+{
+    sink.callStarted("foo");
+    sink.callDetail("value", "1 (0x1)");
+    sink.callStarted("bar");
+    sink.callDetail("onObject", "0x2");
+}
+
+static const char* twoCallsText =
+    "\nFunction name:foo value:1 (0x1)\nFunction name:bar onObject:0x2";
+
+TEST_GROUP(MockTraceSink)
+{
+    void teardown() override
+    {
+        mock().setTraceSink(nullptr);
+        mock().clear();
+    }
+};
+
+TEST(MockTraceSink, bufferSinkKeepsTheTraceAsText)
+{
+    MockTraceBufferSink sink;
+    traceTwoCalls(sink);
+
+    STRCMP_EQUAL(twoCallsText, sink.getTraceOutput());
+    sink.clear();
+    STRCMP_EQUAL("", sink.getTraceOutput());
+}
+
+TEST(MockTraceSink, ringSinkKeepsOnlyTheLastCalls)
+{
+    MockTraceRingSink sink(2);
+    sink.callStarted("first");
+    traceTwoCalls(sink);
+
+    STRCMP_EQUAL(twoCallsText, sink.getTraceOutput());
+}
+
+TEST(MockTraceSink, ringSinkThatWasNotFilledYet)
+{
+    MockTraceRingSink sink(5);
+    sink.callDetail("ignored", "before any call");
+    traceTwoCalls(sink);
+
+    STRCMP_EQUAL(twoCallsText, sink.getTraceOutput());
+    sink.clear();
+    STRCMP_EQUAL("", sink.getTraceOutput());
+}
+
+TEST(MockTraceSink, fileSinkWritesTextWhenFlushed)
+{
+    MockTraceFileSinkForTest sink;
+    traceTwoCalls(sink);
+    LONGS_EQUAL(0, sink.writes);
+
+    sink.flush();
+    LONGS_EQUAL(1, sink.writes);
+    sink.written[sink.size] = '\0';
+    STRCMP_EQUAL(twoCallsText, sink.written);
+}
+
+TEST(MockTraceSink, binaryTraceDecodesToTheSameCalls)
+{
+    MockTraceFileSinkForTest sink(MockTraceFileSink::BINARY_ENCODING);
+    traceTwoCalls(sink);
+    traceTwoCalls(sink);
+    sink.flush();
+
+    MockTraceBufferSink decoded;
+    CHECK(MockTraceFileSink::decode(sink.written, sink.size, decoded));
+    cpputest::SimpleString expected = twoCallsText;
+    STRCMP_EQUAL(
+        (expected + expected).asCharString(), decoded.getTraceOutput()
+    );
+}
+
+TEST(MockTraceSink, binaryTraceWritesNamesOnce)
+{
+    MockTraceFileSinkForTest sink(MockTraceFileSink::BINARY_ENCODING);
+    traceTwoCalls(sink);
+    sink.flush();
+    size_t firstSize = sink.size;
+    traceTwoCalls(sink);
+    sink.flush();
+
+    // two calls of two bytes and details of 10 and 6 bytes, no names
+    LONGS_EQUAL(20, sink.size - firstSize);
+}
+
+TEST(MockTraceSink, decodingRejectsForeignAndTruncatedData)
+{
+    MockTraceFileSinkForTest sink(MockTraceFileSink::BINARY_ENCODING);
+    traceTwoCalls(sink);
+    sink.flush();
+    MockTraceBufferSink decoded;
+
+    CHECK_FALSE(MockTraceFileSink::decode("not a trace", 11, decoded));
+    CHECK_FALSE(
+        MockTraceFileSink::decode(sink.written, sink.size - 1, decoded)
+    );
+}
+
+TEST(MockTraceSink, mockTracingGoesToTheInstalledSink)
+{
+    MockTraceRingSink sink(1);
+    mock().setTraceSink(&sink);
+    mock().tracing(true);
+
+    mock().actualCall("foo").withParameter("value", 1);
+    mock().actualCall("bar").withParameter("value", 2);
+
+    STRCMP_EQUAL("\nFunction name:bar value:2 (0x2)", mock().getTraceOutput());
+}